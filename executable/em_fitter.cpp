@@ -33,6 +33,7 @@ int main(int argc, char const *argv[]) {
     app.add_option("--charge-levels", settings::em::charge_levels, "Number of charge levels to use for the EM map.");
     app.add_option("--frequency", settings::em::sample_frequency, "Sampling frequency of the EM map.");
     app.add_option("--max-iterations", settings::fit::max_iterations, "Maximum number of iterations to perform. This is only approximate.");
+    app.add_option("--scan-threads", settings::em::scan_threads, "Number of cutoff values to evaluate concurrently. Each keeps its own copy of the generated structure, so the memory use grows accordingly.")->default_val(settings::em::scan_threads)->check(CLI::PositiveNumber);
     app.add_flag("--hydrate,!--no-hydrate", settings::em::hydrate, "Generate a hydration shell for the protein before fitting.");
     app.add_flag("--fixed-weight,!--dynamic-weight", settings::em::fixed_weights, "Use a fixed weight for the fit.");
     app.add_flag("--verbose,!--quiet", settings::fit::verbose, "Print the progress of the fit to the console.");
@@ -24,6 +24,7 @@ using namespace ausaxs;
 int main(int argc, char const *argv[]) {
     std::ios_base::sync_with_stdio(false);
     io::ExistingFile pdb, mfile, settings;
+    std::vector<io::ExistingFile> extra_mfiles;
     settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::HistogramManagerMT;
     bool use_existing_hydration = false, save_settings = false;
 
@@ -32,6 +33,10 @@ int main(int argc, char const *argv[]) {
     auto input_s = app.add_option("input_structure", pdb, "Path to the structure file.")->check(CLI::ExistingFile);
     auto input_m = app.add_option("input_measurement", mfile, "Path to the measured SAXS data.")->check(CLI::ExistingFile);
     app.add_option("--output,-o", settings::general::output, "Output folder to write the results to.")->default_val("output/saxs_fitter/")->group("General options");
+    app.add_option("--datasets,-d", extra_mfiles, 
+        "Additional measured SAXS data to fit with the same structure. The scattering histogram is only calculated once, and all datasets are fitted in parallel when possible. "
+        "The results of each dataset are written to a separate subfolder of the output folder."
+    )->check(CLI::ExistingFile)->group("General options");
     auto p_settings = app.add_option("-s,--settings", settings, "Path to the settings file.")->check(CLI::ExistingFile)->group("General options");
     app.add_flag_callback("--licence", [] () {std::cout << constants::licence << std::endl; exit(0);}, "Print the licence.");
     app.add_flag_callback("-v,--version", [] () {std::cout << constants::version << std::endl; exit(0);}, "Print the AUSAXS version.");
@@ -168,11 +173,16 @@ int main(int argc, char const *argv[]) {
                 throw except::invalid_argument("Unknown PDB extensions: " + pdb.str() + " and " + mfile.str());
             }
         }
-        if (!constants::filetypes::saxs_data.check(mfile)) {
-            throw except::invalid_argument("Unknown SAXS data extension: " + mfile.str());
+        std::vector<io::ExistingFile> mfiles = {mfile};
+        mfiles.insert(mfiles.end(), extra_mfiles.begin(), extra_mfiles.end());
+        for (const auto& file : mfiles) {
+            if (!constants::filetypes::saxs_data.check(file)) {
+                throw except::invalid_argument("Unknown SAXS data extension: " + file.str());
+            }
         }
 
-        settings::general::output += mfile.stem() + "/";
+        // with multiple datasets, the results of each are written to a subfolder instead
+        if (mfiles.size() == 1) {settings::general::output += mfile.stem() + "/";}
 
         //######################//
         //### ACTUAL PROGRAM ###//
@@ -184,32 +194,46 @@ int main(int argc, char const *argv[]) {
             protein.generate_new_hydration();
         }
 
-        SimpleDataset saxs_data(mfile);
-        if (settings::flags::data_rebin) {console::indent(); saxs_data.rebin(); console::unindent();}
-
-        fitter::SmartFitter fitter(std::move(saxs_data), protein.get_histogram());
-        auto result = fitter.fit();
-        fitter::FitReporter::report(result.get());
-        fitter::FitReporter::save(result.get(), settings::general::output + "report.txt", argc, argv);
+        std::vector<SimpleDataset> datasets;
+        for (const auto& file : mfiles) {
+            auto& saxs_data = datasets.emplace_back(file);
+            if (settings::flags::data_rebin) {console::indent(); saxs_data.rebin(); console::unindent();}
+        }
 
+        fitter::SmartFitter fitter(datasets.front(), protein.get_histogram());
+        std::vector<std::unique_ptr<fitter::FitResult>> results;
+        if (datasets.size() == 1) {results.push_back(fitter.fit());}
+        else {results = fitter.fit(datasets);}
+
+        for (unsigned int i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            std::string output = settings::general::output + (results.size() == 1 ? "" : mfiles[i].stem() + "/");
+            if (results.size() != 1) {console::print_info("\nResults for " + mfiles[i].str());}
+            fitter::FitReporter::report(result.get());
+            fitter::FitReporter::save(result.get(), output + "report.txt", argc, argv);
+            result->curves.select_columns({0, 1, 2, 3}).save(
+                output + "ausaxs.fit", 
+                "chi2=" + std::to_string(result->fval/result->dof) + " dof=" + std::to_string(result->dof)
+            );
+        }
         plots::PlotDistance::quick_plot(fitter.get_model(), settings::general::output + "p(r)." + settings::plots::format);
         plots::PlotProfiles::quick_plot(fitter.get_model(), settings::general::output + "profiles." + settings::plots::format);
-        result->curves.select_columns({0, 1, 2, 3}).save(
-            settings::general::output + "ausaxs.fit", 
-            "chi2=" + std::to_string(result->fval/result->dof) + " dof=" + std::to_string(result->dof)
-        );
 
         // calculate extra stuff
         console::print_info("\nExtra informaton");
         console::indent();
         double rhoM = protein.get_absolute_mass()/protein.get_volume_grid()*constants::unit::gm/(std::pow(constants::unit::cm, 3));
-        double d = settings::fit::fit_excluded_volume ? result->get_parameter(constants::fit::Parameters::SCALING_EXV) : 1;
         console::print_text("Volume (vdW):    " + std::to_string((int) std::round(protein.get_volume_vdw()))  + " A^3");
         console::print_text("Volume (grid):   " + std::to_string((int) std::round(protein.get_volume_grid())) + " A^3");
-        console::print_text("Volume (exv):    " + std::to_string((int) std::round(protein.get_volume_exv(d)))  + " A^3");
         console::print_text("RhoM:            " + std::to_string(rhoM) + " g/cm^3");
-        if (settings::fit::fit_solvent_density) {
-            console::print_text("Solvent density: " + std::to_string(constants::charge::density::water*result->get_parameter(constants::fit::Parameters::SCALING_RHO)) + " e/A^3");
+        for (unsigned int i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            if (results.size() != 1) {console::print_text(mfiles[i].stem() + ":");}
+            double d = settings::fit::fit_excluded_volume ? result->get_parameter(constants::fit::Parameters::SCALING_EXV) : 1;
+            console::print_text("Volume (exv):    " + std::to_string((int) std::round(protein.get_volume_exv(d)))  + " A^3");
+            if (settings::fit::fit_solvent_density) {
+                console::print_text("Solvent density: " + std::to_string(constants::charge::density::water*result->get_parameter(constants::fit::Parameters::SCALING_RHO)) + " e/A^3");
+            }
         }
         console::unindent();
 
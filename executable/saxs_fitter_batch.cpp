@@ -0,0 +1,131 @@
+#include <CLI/CLI.hpp>
+
+#include <data/Molecule.h>
+#include <dataset/SimpleDataset.h>
+#include <fitter/SmartFitter.h>
+#include <fitter/BatchJobLoader.h>
+#include <fitter/FitReporter.h>
+#include <fitter/FitResult.h>
+#include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
+#include <settings/All.h>
+#include <io/ExistingFile.h>
+#include <constants/Constants.h>
+#include <utility/Console.h>
+#include <utility/Logging.h>
+#include <utility/Exceptions.h>
+
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace ausaxs;
+
+int main(int argc, char const *argv[]) {
+    std::ios_base::sync_with_stdio(false);
+    io::ExistingFile settings;
+    std::string manifest_path = "-";
+    settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::HistogramManagerMT;
+    bool use_existing_hydration = false, verbose = false;
+    unsigned int prefetch = 2;
+
+    CLI::App app{
+        "Fit many structures to their SAXS measurements in a single process. "
+        "Each line of the manifest contains the path to a structure file followed by the path to its measurement. "
+        "Empty lines and lines starting with '#' are ignored."
+    };
+    app.add_option("manifest", manifest_path, "Path to the manifest file. If omitted or '-', the manifest is read from stdin.");
+    app.add_option("--output,-o", settings::general::output, "Output folder to write the results to.")->default_val("output/saxs_fitter_batch/");
+    auto p_settings = app.add_option("-s,--settings", settings, "Path to the settings file. It is applied to all jobs.")->check(CLI::ExistingFile);
+    app.add_option("--threads,-t", settings::general::threads, "Number of threads to use.")->default_val(settings::general::threads);
+    app.add_option("--prefetch", prefetch, "Maximum number of structures prepared ahead of the one currently being fitted.")->default_val(prefetch)->check(CLI::PositiveNumber);
+    app.add_flag("--keep-hydration", use_existing_hydration, "Keep the water molecules from the structure files instead of generating new hydration shells.")->default_val(use_existing_hydration);
+    app.add_flag("--fit-exv", settings::fit::fit_excluded_volume, "Fit the excluded volume.")->default_val(settings::fit::fit_excluded_volume);
+    app.add_flag("--rebin", settings::flags::data_rebin, "Rebin the data to increase the information content of each data point.")->default_val(settings::flags::data_rebin);
+    app.add_flag("--verbose", verbose, "Print the full output of each job.")->default_val(verbose);
+    app.add_flag_callback("--log", [] () {logging::start("saxs_fitter_batch");}, "Enable logging to a file.");
+    app.add_flag_callback("-v,--version", [] () {std::cout << constants::version << std::endl; exit(0);}, "Print the AUSAXS version.");
+    CLI11_PARSE(app, argc, argv);
+
+    if (p_settings->count() != 0) {
+        settings::read(settings);
+        CLI11_PARSE(app, argc, argv);
+    }
+    settings::validate_settings();
+    settings::general::verbose = verbose;
+    console::print_info("Running AUSAXS " + std::string(constants::version));
+
+    std::ifstream manifest_file;
+    if (manifest_path != "-") {
+        manifest_file.open(io::ExistingFile(manifest_path).path());
+        if (!manifest_file.is_open()) {throw except::io_error("saxs_fitter_batch: Could not open manifest \"" + manifest_path + "\".");}
+    }
+    std::istream& manifest = manifest_path == "-" ? std::cin : manifest_file;
+
+    // the settings, form factor tables and thread pool are only initialized once for all jobs
+    // the files of the next jobs are read on a separate thread, overlapping with the multi-threaded fits of the previous ones
+    utility::BoundedQueue<fitter::BatchJob> queue(prefetch);
+    std::exception_ptr loader_error;
+    std::thread loader([&manifest, &queue, &loader_error] () {
+        try {
+            fitter::load_batch_jobs(manifest, queue);
+        } catch (...) {
+            loader_error = std::current_exception();
+        }
+    });
+
+    // the hydration and histogram of the next job are prepared while the current one is fitted
+    // this uses a separate thread instead of a pool task, since the preparation itself waits for the global pool, which would deadlock inside a worker
+    // both threads only wait for the pool from the outside, so at worst they also wait for the tasks of each other
+    auto prepare = [use_existing_hydration] (fitter::BatchJob job) {
+        if (!job.error.empty()) {return job;}
+        try {
+            if (!use_existing_hydration || job.protein->size_water() == 0) {job.protein->generate_new_hydration();}
+            job.histogram = job.protein->get_histogram();
+        } catch (const std::exception& e) {
+            job.error = e.what();
+        }
+        return job;
+    };
+    auto prepare_next = [&queue, &prepare] () {
+        auto job = queue.pop();
+        return job ? std::async(std::launch::async, prepare, std::move(*job)) : std::future<fitter::BatchJob>();
+    };
+
+    unsigned int succeeded = 0, failed = 0;
+    for (auto next = prepare_next(); next.valid();) {
+        auto job = next.get();
+        next = prepare_next();
+
+        std::string name = job.structure + " " + job.measurement;
+        if (!job.error.empty()) {
+            std::cerr << "line " << job.line << " (" << name << ") failed: " << job.error << std::endl;
+            ++failed;
+            continue;
+        }
+
+        try {
+            std::string output = settings::general::output + io::File(job.structure).stem() + "/" + io::File(job.measurement).stem() + "/";
+            fitter::SmartFitter fitter(*job.data, std::move(job.histogram));
+            auto result = fitter.fit();
+            fitter::FitReporter::save(result.get(), output + "report.txt", argc, argv);
+            result->curves.select_columns({0, 1, 2, 3}).save(
+                output + "ausaxs.fit",
+                "chi2=" + std::to_string(result->fval/result->dof) + " dof=" + std::to_string(result->dof)
+            );
+            std::cout << name << " chi2/dof=" << result->fval/result->dof << std::endl;
+            ++succeeded;
+        } catch (const std::exception& e) {
+            std::cerr << "line " << job.line << " (" << name << ") failed: " << e.what() << std::endl;
+            ++failed;
+        }
+    }
+    loader.join();
+    if (loader_error) {std::rethrow_exception(loader_error);}
+
+    std::cout << "fitted " << succeeded << " of " << succeeded + failed << " jobs" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+PlotDataset
+  1.00000000e+00   1.10363832e+00   0.00000000e+00 
+  1.05050505e+00   8.93691069e-01   0.00000000e+00 
+  1.10101010e+00   6.74604000e-01   0.00000000e+00 
+  1.15151515e+00   4.49123477e-01   0.00000000e+00 
+  1.20202020e+00   2.19681670e-01   0.00000000e+00 
+  1.25252525e+00  -1.15759145e-02   0.00000000e+00 
+  1.30303030e+00  -2.42765009e-01   0.00000000e+00 
+  1.35353535e+00  -4.72239129e-01   0.00000000e+00 
+  1.40404040e+00  -6.98567933e-01   0.00000000e+00 
+  1.45454545e+00  -9.20517277e-01   0.00000000e+00 
+  1.50505051e+00  -1.13703084e+00   0.00000000e+00 
+  1.55555556e+00  -1.34721320e+00   0.00000000e+00 
+  1.60606061e+00  -1.55031429e+00   0.00000000e+00 
+  1.65656566e+00  -1.74571506e+00   0.00000000e+00 
+  1.70707071e+00  -1.93291435e+00   0.00000000e+00 
+  1.75757576e+00  -2.11151682e+00   0.00000000e+00 
+  1.80808081e+00  -2.28122189e+00   0.00000000e+00 
+  1.85858586e+00  -2.44181357e+00   0.00000000e+00 
+  1.90909091e+00  -2.59315120e+00   0.00000000e+00 
+  1.95959596e+00  -2.73516095e+00   0.00000000e+00 
+  2.01010101e+00  -2.86782805e+00   0.00000000e+00 
+  2.06060606e+00  -2.99118970e+00   0.00000000e+00 
+  2.11111111e+00  -3.10532866e+00   0.00000000e+00 
+  2.16161616e+00  -3.21036729e+00   0.00000000e+00 
+  2.21212121e+00  -3.30646226e+00   0.00000000e+00 
+  2.26262626e+00  -3.39379968e+00   0.00000000e+00 
+  2.31313131e+00  -3.47259070e+00   0.00000000e+00 
+  2.36363636e+00  -3.54306752e+00   0.00000000e+00 
+  2.41414141e+00  -3.60547977e+00   0.00000000e+00 
+  2.46464646e+00  -3.66009132e+00   0.00000000e+00 
+  2.51515152e+00  -3.70717729e+00   0.00000000e+00 
+  2.56565657e+00  -3.74702146e+00   0.00000000e+00 
+  2.61616162e+00  -3.77991395e+00   0.00000000e+00 
+  2.66666667e+00  -3.80614905e+00   0.00000000e+00 
+  2.71717172e+00  -3.82602342e+00   0.00000000e+00 
+  2.76767677e+00  -3.83983438e+00   0.00000000e+00 
+  2.81818182e+00  -3.84787851e+00   0.00000000e+00 
+  2.86868687e+00  -3.85045028e+00   0.00000000e+00 
+  2.91919192e+00  -3.84784098e+00   0.00000000e+00 
+  2.96969697e+00  -3.84033773e+00   0.00000000e+00 
+  3.02020202e+00  -3.82822262e+00   0.00000000e+00 
+  3.07070707e+00  -3.81177197e+00   0.00000000e+00 
+  3.12121212e+00  -3.79125575e+00   0.00000000e+00 
+  3.17171717e+00  -3.76693703e+00   0.00000000e+00 
+  3.22222222e+00  -3.73907156e+00   0.00000000e+00 
+  3.27272727e+00  -3.70790742e+00   0.00000000e+00 
+  3.32323232e+00  -3.67368476e+00   0.00000000e+00 
+  3.37373737e+00  -3.63663556e+00   0.00000000e+00 
+  3.42424242e+00  -3.59698354e+00   0.00000000e+00 
+  3.47474747e+00  -3.55494399e+00   0.00000000e+00 
+  3.52525253e+00  -3.51072376e+00   0.00000000e+00 
+  3.57575758e+00  -3.46452127e+00   0.00000000e+00 
+  3.62626263e+00  -3.41652649e+00   0.00000000e+00 
+  3.67676768e+00  -3.36692105e+00   0.00000000e+00 
+  3.72727273e+00  -3.31587828e+00   0.00000000e+00 
+  3.77777778e+00  -3.26356338e+00   0.00000000e+00 
+  3.82828283e+00  -3.21013351e+00   0.00000000e+00 
+  3.87878788e+00  -3.15573798e+00   0.00000000e+00 
+  3.92929293e+00  -3.10051837e+00   0.00000000e+00 
+  3.97979798e+00  -3.04460880e+00   0.00000000e+00 
+  4.03030303e+00  -2.98813603e+00   0.00000000e+00 
+  4.08080808e+00  -2.93121971e+00   0.00000000e+00 
+  4.13131313e+00  -2.87397262e+00   0.00000000e+00 
+  4.18181818e+00  -2.81650082e+00   0.00000000e+00 
+  4.23232323e+00  -2.75890392e+00   0.00000000e+00 
+  4.28282828e+00  -2.70127528e+00   0.00000000e+00 
+  4.33333333e+00  -2.64370224e+00   0.00000000e+00 
+  4.38383838e+00  -2.58626637e+00   0.00000000e+00 
+  4.43434343e+00  -2.52904363e+00   0.00000000e+00 
+  4.48484848e+00  -2.47210466e+00   0.00000000e+00 
+  4.53535354e+00  -2.41551498e+00   0.00000000e+00 
+  4.58585859e+00  -2.35933519e+00   0.00000000e+00 
+  4.63636364e+00  -2.30362118e+00   0.00000000e+00 
+  4.68686869e+00  -2.24842440e+00   0.00000000e+00 
+  4.73737374e+00  -2.19379198e+00   0.00000000e+00 
+  4.78787879e+00  -2.13976700e+00   0.00000000e+00 
+  4.83838384e+00  -2.08638866e+00   0.00000000e+00 
+  4.88888889e+00  -2.03369247e+00   0.00000000e+00 
+  4.93939394e+00  -1.98171045e+00   0.00000000e+00 
+  4.98989899e+00  -1.93047128e+00   0.00000000e+00 
+  5.04040404e+00  -1.88000053e+00   0.00000000e+00 
+  5.09090909e+00  -1.83032079e+00   0.00000000e+00 
+  5.14141414e+00  -1.78145181e+00   0.00000000e+00 
+  5.19191919e+00  -1.73341074e+00   0.00000000e+00 
+  5.24242424e+00  -1.68621221e+00   0.00000000e+00 
+  5.29292929e+00  -1.63986850e+00   0.00000000e+00 
+  5.34343434e+00  -1.59438968e+00   0.00000000e+00 
+  5.39393939e+00  -1.54978376e+00   0.00000000e+00 
+  5.44444444e+00  -1.50605682e+00   0.00000000e+00 
+  5.49494949e+00  -1.46321309e+00   0.00000000e+00 
+  5.54545455e+00  -1.42125513e+00   0.00000000e+00 
+  5.59595960e+00  -1.38018393e+00   0.00000000e+00 
+  5.64646465e+00  -1.33999897e+00   0.00000000e+00 
+  5.69696970e+00  -1.30069841e+00   0.00000000e+00 
+  5.74747475e+00  -1.26227910e+00   0.00000000e+00 
+  5.79797980e+00  -1.22473675e+00   0.00000000e+00 
+  5.84848485e+00  -1.18806596e+00   0.00000000e+00 
+  5.89898990e+00  -1.15226036e+00   0.00000000e+00 
+  5.94949495e+00  -1.11731265e+00   0.00000000e+00 
+  6.00000000e+00  -1.08321470e+00   0.00000000e+00 
+
+PlotOptions 
+color k
+marker_style .
+line_style -
+line_width 1
+marker_size 5
+draw_line 1
+draw_errors 0
+draw_markers 0
+logx 0
+logy 0
+title 
+xlabel x
+x2label 
+ylabel y
+zlabel z
+legend 
+normalize 0
+ylimits 0 0
+xlimits 0 0
+zorder 0
+
+PlotDataset
+  2.18033989e+00  -3.24702645e+00   0.00000000e+00 
+  2.63118961e+00  -3.78840268e+00   0.00000000e+00 
+  2.80339887e+00  -3.84610352e+00   0.00000000e+00 
+  2.84405197e+00  -3.84986105e+00   0.00000000e+00 
+  2.85958007e+00  -3.85037785e+00   0.00000000e+00 
+  2.86551128e+00  -3.85044424e+00   0.00000000e+00 
+  2.86691144e+00  -3.85044943e+00   0.00000000e+00 
+  2.86744626e+00  -3.85045036e+00   0.00000000e+00 
+  2.86777679e+00  -3.85045064e+00   0.00000000e+00 
+  2.86790305e+00  -3.85045069e+00   0.00000000e+00 
+  2.86798108e+00  -3.85045071e+00   0.00000000e+00 
+  2.86802009e+00  -3.85045071e+00   0.00000000e+00 
+  2.86802930e+00  -3.85045071e+00   0.00000000e+00 
+  2.86805910e+00  -3.85045071e+00   0.00000000e+00 
+  2.86810733e+00  -3.85045070e+00   0.00000000e+00 
+  2.86831161e+00  -3.85045063e+00   0.00000000e+00 
+  2.86917696e+00  -3.85044938e+00   0.00000000e+00 
+  2.87144248e+00  -3.85043892e+00   0.00000000e+00 
+  2.87510817e+00  -3.85039998e+00   0.00000000e+00 
+  2.88470506e+00  -3.85017000e+00   0.00000000e+00 
+  2.90983006e+00  -3.84870266e+00   0.00000000e+00 
+  2.97560814e+00  -3.83915269e+00   0.00000000e+00 
+  3.08203932e+00  -3.80751289e+00   0.00000000e+00 
+  3.36067977e+00  -3.64647260e+00   0.00000000e+00 
+  4.09016994e+00  -2.92062984e+00   0.00000000e+00 
+
+PlotOptions 
+color tab:orange
+marker_style .
+line_style -
+line_width 1
+marker_size 5
+draw_line 0
+draw_errors 0
+draw_markers 1
+logx 0
+logy 0
+title 
+xlabel x
+x2label 
+ylabel y
+zlabel z
+legend 
+normalize 0
+ylimits 0 0
+xlimits 0 0
+zorder 0
+
@@ -6,4 +6,50 @@
     #define API
 #endif
 
-extern "C" API void evaluate_sans_debye(double* _q, double* _x, double* _y, double* _z, double* _w, int _nq, int _nc, int* _return_status, double* _return_Iq);
\ No newline at end of file
+extern "C" API void evaluate_sans_debye(double* _q, double* _x, double* _y, double* _z, double* _w, int _nq, int _nc, int* _return_status, double* _return_Iq);
+
+/**
+ * Handle-based interface for repeated evaluations of the same structures.
+ *
+ * A context refers to the caller's coordinate and weight arrays without copying them, so they must remain valid until the context is destroyed
+ * or given new arrays. After modifying the arrays in place, call sasview_update_coordinates with the same pointers to mark the context as modified.
+ * The distance histogram of a context is only recalculated on the first evaluation after it was modified,
+ * so evaluating the same structure for many q-sets is cheap.
+ * None of these functions modify the global settings or print anything.
+ *
+ * Thread safety: all functions may be called concurrently from different threads. Calls using the same context are serialized by a lock
+ * held by that context, so the caller must only avoid modifying the coordinate arrays of a context while it is being evaluated.
+ * A context destroyed while another call is still using it is only released once that call returns.
+ * The evaluations themselves hold the lock of settings::lock_globals, so they are serialized with each other and with any active settings::ScopedContext,
+ * and each of them can use the entire thread pool.
+ *
+ * Status codes: 0 = success, 1 = invalid handle, 2 = invalid input, 3 = calculation error.
+ */
+
+/**
+ * @brief Create a new context for the structure described by the nc coordinates (x, y, z) with scattering weights w.
+ * @return The handle of the new context, or -1 on failure.
+ */
+extern "C" API int sasview_create_context(double* _x, double* _y, double* _z, double* _w, int _nc, int* _return_status);
+
+/**
+ * @brief Point a context to new coordinate arrays, or mark it as modified after its current arrays were changed in place.
+ */
+extern "C" API void sasview_update_coordinates(int _handle, double* _x, double* _y, double* _z, double* _w, int _nc, int* _return_status);
+
+/**
+ * @brief Evaluate the scattering intensity of a context at the nq values of q, and write them to Iq.
+ */
+extern "C" API void sasview_evaluate(int _handle, double* _q, int _nq, int* _return_status, double* _return_Iq);
+
+/**
+ * @brief Evaluate the scattering intensities of nh contexts at the same nq values of q.
+ *        The histograms of all modified contexts are calculated together in parallel.
+ *        The intensities are written to Iq as nh consecutive rows of nq values.
+ */
+extern "C" API void sasview_evaluate_many(int* _handles, int _nh, double* _q, int _nq, int* _return_status, double* _return_Iq);
+
+/**
+ * @brief Destroy a context. Its coordinate arrays are not accessed by any call started after this one.
+ */
+extern "C" API void sasview_destroy_context(int _handle);
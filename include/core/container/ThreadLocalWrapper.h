@@ -5,88 +5,154 @@
 
 #include <vector>
 #include <functional>
-#include <unordered_map>
+#include <algorithm>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <memory>
 
 namespace ausaxs::container {
     /**
      * @brief A simple wrapper around T to keep track of the thread-local instances of T.
      *        This allows access to all the thread-local data from any single thread.
      *        Note that it is assumed that all threads have a longer lifetime than this class.
-     *        
+     *
+     *        Each worker of the global thread pool is assigned its own cache-line aligned slot through its dense pool index,
+     *        while the thread constructing the wrapper uses the first slot. Any other thread is given its own slot on first access, which is slightly slower
+     *        since the lookup is synchronized. Instances are only created the first time a thread accesses its slot,
+     *        so threads which never run a task do not allocate anything.
+     *
      *        ! Making a static instance of this class will cause Windows DLL to deadlock when the program is closed.
-     *        ? This is probably due to the threads owning the data no longer existing when this class is destroyed, combined with the FreeLibrary locking the system resources necessary for C++ to solve this. 
+     *        ? This is probably due to the threads owning the data no longer existing when this class is destroyed, combined with the FreeLibrary locking the system resources necessary for C++ to solve this.
      */
     template <typename T>
     class ThreadLocalWrapper {
         public:
             /**
-             * @brief Create a wrapper around T, and create a thread-local instance of T for each thread using the given arguments.
-             * 
-             * ! This constructor *must* be called from the main thread, otherwise it will not receive its own thread-local instance.
+             * @brief Create a wrapper around T. The thread-local instances of T will be created from the given arguments on first access.
+             *
+             * The constructing thread owns the first slot.
              */
             template <typename... Args>
-            ThreadLocalWrapper(Args&&... args) {
-                auto ids = utility::multi_threading::get_global_pool()->get_thread_ids();
-                for (auto& id : ids) {
-                    data.emplace(id, T(args...));
-                }
-                data.emplace(std::this_thread::get_id(), T(std::move(args)...));
+            ThreadLocalWrapper(Args&&... args)
+                : pool(utility::multi_threading::get_global_pool()),
+                  slots(utility::multi_threading::get_global_pool()->get_thread_count()+1)
+            {
+                set_factory(std::forward<Args>(args)...);
             }
 
             /**
              * @brief Get the thread-local instance of the wrapped type.
              */
-            T& get() {return data.at(std::this_thread::get_id());}
+            T& get() {return local();}
 
             // @copydoc get()
-            const T& get() const {return data.at(std::this_thread::get_id());}
+            const T& get() const {return local();}
 
             /**
-             * @brief Get the thread-local instances of the wrapped type for all threads.
+             * @brief Get the thread-local instances of the wrapped type for all threads which have accessed their instance.
              */
             std::vector<std::reference_wrapper<T>> get_all() {
-                std::vector<std::reference_wrapper<T>> result; result.reserve(data.size());
-                for (auto& [id, t] : data) {result.emplace_back(t);}
+                std::vector<std::reference_wrapper<T>> result; result.reserve(slots.size());
+                for (auto& slot : slots) {
+                    if (slot.value.has_value()) {result.emplace_back(*slot.value);}
+                }
+                std::lock_guard lock(foreign_mutex);
+                for (auto& [id, slot] : foreign) {
+                    if (slot->value.has_value()) {result.emplace_back(*slot->value);}
+                }
                 return result;
             }
 
             /**
-             * @brief Get the number of thread-local instances of the wrapped type.
+             * @brief Get the number of thread-local slots, i.e. the maximum number of instances of the wrapped type.
+             *        This is one more than the number of workers in the global pool, plus one for each other thread which has accessed its instance.
              */
-            std::size_t size() const {return data.size();}
+            std::size_t size() const {
+                std::lock_guard lock(foreign_mutex);
+                return slots.size() + foreign.size();
+            }
 
             /**
              * @brief Reinitialize all thread-local instances of the wrapped type using the given arguments.
              */
             template <typename... Args>
             void reinitialize_all(Args&&... args) {
-                for (auto& e : data) {
-                    e.second = T(args...);
-                }
+                set_factory(std::forward<Args>(args)...);
+                for (auto& slot : slots) {slot.value.reset();}
+                std::lock_guard lock(foreign_mutex);
+                foreign.clear();
             }
 
             /**
              * @brief Merge all thread-local instances of the wrapped type into a single instance.
+             *        Instances which were never accessed are skipped, so the initial value is expected to be the identity of the addition.
              */
             T merge() const {
                 T result = get();
-                auto this_id = std::this_thread::get_id();
-                if constexpr (std::ranges::range<T>) {
-                    for (const auto& [id, t] : data) {
-                        if (id == this_id) {continue;}
+                const Slot* own = &slot();
+                auto add = [&result, own] (const Slot& s) {
+                    if (&s == own || !s.value.has_value()) {return;}
+                    const T& t = *s.value;
+                    if constexpr (std::ranges::range<T>) {
                         std::transform(t.begin(), t.end(), result.begin(), result.begin(), std::plus<>());
-                    }
-                    return result;
-                } else {
-                    for (const auto& [id, t] : data) {
-                        if (id == this_id) {continue;}
+                    } else {
                         result += t;
                     }
-                    return result;
-                }
+                };
+                for (const auto& s : slots) {add(s);}
+                std::lock_guard lock(foreign_mutex);
+                for (const auto& [id, s] : foreign) {add(*s);}
+                return result;
             }
 
         private:
-            std::unordered_map<std::thread::id, T> data;
+            // aligned to a full cache line to avoid false sharing between the threads
+            struct alignas(64) Slot {
+                std::optional<T> value;
+            };
+
+            void* pool;
+            mutable std::vector<Slot> slots; // mutable since the instances are created lazily
+            std::function<T()> factory;
+            std::thread::id owner = std::this_thread::get_id();
+
+            // slots of threads which are neither the owner nor workers of the global pool
+            mutable std::mutex foreign_mutex;
+            mutable std::vector<std::pair<std::thread::id, std::unique_ptr<Slot>>> foreign;
+
+            template <typename... Args>
+            void set_factory(Args&&... args) {
+                factory = [...args = std::forward<Args>(args)] () {return T(args...);};
+            }
+
+            /**
+             * @brief Get the instance of the calling thread, creating it if necessary.
+             */
+            T& local() const {
+                auto& value = slot().value;
+                if (!value.has_value()) [[unlikely]] {value.emplace(factory());}
+                return *value;
+            }
+
+            /**
+             * @brief Get the slot of the calling thread. The workers of the global pool use the slots 1 to N, while the owning thread uses slot 0.
+             *        Other threads are given a separate slot on their first access.
+             *        Pool workers without a dense slot are treated the same way, so the lookup can never go out of bounds.
+             */
+            Slot& slot() const {
+                if (BS::this_thread::get_pool() == pool) {
+                    std::size_t index = *BS::this_thread::get_index()+1;
+                    if (index < slots.size()) [[likely]] {return slots[index];}
+                } else if (std::this_thread::get_id() == owner) {
+                    return slots[0];
+                }
+
+                std::lock_guard lock(foreign_mutex);
+                auto id = std::this_thread::get_id();
+                auto it = std::find_if(foreign.begin(), foreign.end(), [id] (const auto& f) {return f.first == id;});
+                if (it == foreign.end()) {it = foreign.insert(foreign.end(), {id, std::make_unique<Slot>()});}
+                return *it->second;
+            }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <data/DataFwd.h>
+#include <dataset/DatasetFwd.h>
+#include <hist/HistFwd.h>
+#include <utility/BoundedQueue.h>
+
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace ausaxs::fitter {
+    /**
+     * @brief A single structure/measurement pair from a batch manifest. 
+     *        If the files could not be loaded, only the error message is set.
+     */
+    struct BatchJob {
+        BatchJob();
+        BatchJob(BatchJob&&) noexcept;
+        BatchJob& operator=(BatchJob&&) noexcept;
+        ~BatchJob();
+
+        unsigned int line = 0;                      // the line number in the manifest
+        std::string structure, measurement;         // the paths to the files
+        std::unique_ptr<data::Molecule> protein;
+        std::unique_ptr<SimpleDataset> data;
+        std::unique_ptr<hist::ICompositeDistanceHistogram> histogram; // the histogram of the hydrated structure, once the job has been prepared for its fit
+        std::string error;
+    };
+
+    /**
+     * @brief Load the jobs listed in @a manifest and add them to @a queue, which is closed afterwards. 
+     *        Each line of the manifest contains the path to a structure file followed by the path to its measurement. 
+     *        Empty lines and lines starting with '#' are ignored. 
+     *
+     *        Jobs which could not be loaded are still added with their error message, such that they can be reported in order. 
+     *        Only the files are read, and the structures are not hydrated. Nothing here uses the global thread pool, 
+     *        so this can safely run on a separate thread while the previous jobs are being fitted. 
+     */
+    void load_batch_jobs(std::istream& manifest, utility::BoundedQueue<BatchJob>& queue);
+}
\ No newline at end of file
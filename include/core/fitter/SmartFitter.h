@@ -3,9 +3,12 @@
 #include <fitter/LinearFitter.h>
 #include <dataset/SimpleDataset.h>
 #include <mini/detail/Parameter.h>
+#include <math/CubicSplineResampler.h>
 #include <hist/HistFwd.h>
 
 namespace ausaxs::fitter {
+    namespace detail {class BasisChi2;}
+
     /**
      * @brief A smart fitter automatically fitting the parameters enabled in the settings. 
      *
@@ -28,6 +31,16 @@ namespace ausaxs::fitter {
             SmartFitter(const SimpleDataset& data, std::unique_ptr<hist::DistanceHistogram> h);
 
             [[nodiscard]] virtual std::unique_ptr<FitResult> fit() override;
+
+            /**
+             * @brief Fit the model to each of the given datasets instead of the one given at construction. 
+             *        The histogram of the model and its Debye transform are only calculated once and are shared between all fits. 
+             *        If the model supports an intensity basis, the fits are performed in parallel without modifying the model. 
+             *        Otherwise they are performed sequentially, and the model is left with the optimal parameters of the last dataset. 
+             *
+             * @return The fit results in the same order as the datasets.
+             */
+            [[nodiscard]] std::vector<std::unique_ptr<FitResult>> fit(const std::vector<SimpleDataset>& datasets);
             [[nodiscard]] unsigned int dof() const override;
             [[nodiscard]] unsigned int size() const override;
 
@@ -58,6 +71,18 @@ namespace ausaxs::fitter {
 
             [[nodiscard]] std::vector<double> get_residuals(const std::vector<double>& params) override;
 
+            /**
+             * @brief Evaluate the chi2 for the given parameters.
+             *        This is the objective of the minimizer, and is calculated without constructing a linear fitter.
+             */
+            [[nodiscard]] double chi2(const std::vector<double>& params) override;
+
+            /**
+             * @brief Evaluate the gradient of the chi2 for the given parameters. 
+             *        This is only available during a fit using the intensity basis of the model, and is passed on to gradient-based minimizers.
+             */
+            [[nodiscard]] std::vector<double> chi2_gradient(const std::vector<double>& params) const;
+
             /**
              * @brief Perform a fit and return the optimal parameters.
              */
@@ -67,6 +92,9 @@ namespace ausaxs::fitter {
             SimpleDataset data;
             std::unique_ptr<hist::DistanceHistogram> model;
             std::vector<mini::Parameter> guess;
+            math::CubicSplineResampler resampler;               // resamples the model q-axis to the data q-values, see prepare_data()
+            std::vector<double> inv_sigma;                      // the inverse errors of the data, see prepare_data()
+            std::unique_ptr<detail::BasisChi2> basis;           // the intensity basis of the model, only available during a fit
 
 			/**
 			 * @brief Splice values from the model to match the data.
@@ -75,11 +103,41 @@ namespace ausaxs::fitter {
 			 */
 			[[nodiscard]] std::vector<double> splice(const std::vector<double>& ym) const;
 
+            /**
+             * @brief Prepare the resampling operator and the inverse errors for the current data and model. 
+             *        This must be called whenever either of them changes, since the evaluations only read the prepared values. 
+             */
+            void prepare_data();
+
             /**
              * @brief Get the default guess parameters.
              */
             [[nodiscard]] std::vector<mini::Parameter> get_default_guess() const;
 
+            /**
+             * @brief Apply the given parameters to the model.
+             */
+            void apply_params(const std::vector<double>& params);
+
+            /**
+             * @brief Prepare the intensity basis of the model, such that the chi2 and its gradient can be evaluated without modifying the model. 
+             *        Nothing is done if this is disabled in the settings, or if the model does not support it. 
+             */
+            void prepare_basis();
+
+            /**
+             * @brief Check if chi2 can be evaluated concurrently, such that the minimizer may evaluate independent points in parallel on the global pool. 
+             *        This is the case during a fit using the intensity basis, since it is fully calculated before the minimization starts. 
+             *        Subclasses which add terms to chi2 must override this unless those terms are also thread-safe. 
+             */
+            [[nodiscard]] virtual bool is_chi2_thread_safe() const;
+
+            /**
+             * @brief Fit the model to @a data using only the given chi2 of its intensity basis. 
+             *        Neither this fitter nor the model are modified, so this is safe to call concurrently. 
+             */
+            [[nodiscard]] std::unique_ptr<FitResult> fit_basis(const detail::BasisChi2& chi2, const SimpleDataset& data) const;
+
             /**
              * @brief Prepare a linear fitter for the given parameters.
              */
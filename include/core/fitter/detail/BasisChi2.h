@@ -0,0 +1,63 @@
+#pragma once
+
+#include <hist/intensity_calculator/ICompositeDistanceHistogramExv.h>
+#include <dataset/DatasetFwd.h>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace ausaxs::fitter::detail {
+    /**
+     * @brief The chi2 of fitting a model intensity to a dataset, evaluated directly from the intensity basis of the model.
+     *        The basis curves are resampled to the data q-values once during construction, after which each evaluation of the chi2 and its gradient
+     *        is a single O(n) pass over the data without any allocations. The linear parameters I = a*I_model + b are fitted analytically as in LinearLeastSquares.
+     *
+     *        All evaluations are thread-safe.
+     */
+    class BasisChi2 {
+        using FreeParameters = hist::ICompositeDistanceHistogramExv::FreeParameters;
+        public:
+            BasisChi2() = default;
+
+            /**
+             * @brief Prepare the chi2 evaluation of fitting the intensity described by @a basis to @a data.
+             */
+            BasisChi2(const hist::ICompositeDistanceHistogramExv::IntensityBasis& basis, const SimpleDataset& data);
+
+            /**
+             * @brief Evaluate the chi2 for the given parameters.
+             */
+            [[nodiscard]] double chi2(const FreeParameters& params) const;
+
+            /**
+             * @brief Evaluate the chi2 and its gradient for the given parameters.
+             *        Each member of @a gradient is set to the derivative of the chi2 with respect to the corresponding parameter.
+             */
+            [[nodiscard]] double chi2(const FreeParameters& params, FreeParameters& gradient) const;
+
+            /**
+             * @brief Evaluate the model intensity at the data q-values for the given parameters, before the linear fit.
+             */
+            [[nodiscard]] std::vector<double> intensity(const FreeParameters& params) const;
+
+            /**
+             * @brief Check if the excluded volume scaling factor is a free parameter of the basis.
+             */
+            [[nodiscard]] bool has_exv_factor() const noexcept;
+
+        private:
+            struct Point {double q, y, w, aa, aw, ww, ax0, ax1, xx0, xx1, xx2, wx0, wx1;};
+            std::vector<Point> points;
+            std::function<double(double, double)> exv_factor;
+
+            /**
+             * @brief Evaluate the model intensity at a single point, and optionally its derivatives with respect to each parameter.
+             */
+            template<bool derivatives>
+            double intensity(const Point& pt, const FreeParameters& params, std::array<double, 5>& dI) const;
+
+            template<bool gradient>
+            double evaluate(const FreeParameters& params, FreeParameters* grad) const;
+    };
+}
@@ -48,6 +48,20 @@ namespace ausaxs::fitter::detail {
              */
             [[nodiscard]] std::vector<double> get_model_curve();
 
+            /**
+             * @brief Calculate the parameters of the optimal fit directly from the given vectors, without constructing a fitter. 
+             *        The arguments have the same meaning as in the constructor, except that the inverse errors are expected.
+             *
+             * @return The fitted parameters (a, b, a_err^2, b_err^2) for the equation y = ax+b.
+             */
+            [[nodiscard]] static std::vector<double> optimal_params(const std::vector<double>& data, const std::vector<double>& model, const std::vector<double>& inv_sigma);
+
+            /**
+             * @brief Calculate the chi2 of the optimal fit directly from the given vectors, without constructing a fitter. 
+             *        The arguments have the same meaning as in the constructor, except that the inverse errors are expected.
+             */
+            [[nodiscard]] static double optimal_chi2(const std::vector<double>& data, const std::vector<double>& model, const std::vector<double>& inv_sigma);
+
         protected:
             std::vector<double> data, model, inv_sigma;
 
@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <span>
+#include <memory>
 
 namespace ausaxs::grid {
 	class Grid {
@@ -233,6 +234,26 @@ namespace ausaxs::grid {
 			 */
 			void add_volume(double value);
 
+			/**
+			 * @brief Start a transaction. All subsequent changes to the grid can then be reverted with rollback() or accepted with commit(). 
+			 *        Only the modified bins are recorded, which is much cheaper than keeping a copy of the entire grid. 
+			 *        Only a single transaction can be active at a time.
+			 * 		  Complexity: O(n) in the number of member atoms.
+			 */
+			void begin_transaction();
+
+			/**
+			 * @brief Accept all changes made since the last call to begin_transaction(). 
+			 * 		  Complexity: O(1).
+			 */
+			void commit();
+
+			/**
+			 * @brief Revert all changes made since the last call to begin_transaction(). 
+			 * 		  Complexity: O(n) in the number of modified bins and member atoms.
+			 */
+			void rollback();
+
 			detail::GridObj grid; // The actual grid.
 			std::vector<GridMember<data::AtomFF>> a_members; // The member atoms and where they are located.
 			std::vector<GridMember<data::Water>>  w_members; // The member water molecules and where they are located. 
@@ -280,6 +301,37 @@ namespace ausaxs::grid {
 		private:
 			Axis3D axes;
 
+			struct Transaction;
+			std::unique_ptr<Transaction> transaction; // the member state at the start of the current transaction, if any
+
+			struct Stencils;
+			std::unique_ptr<Stencils> stencils; // cached sphere stencils of the member radii, generated on demand
+
+			/**
+			 * @brief Get the sphere stencil of an atom type, generating it if it is not cached for the current radii.
+			 */
+			const detail::SphereStencil& get_stencil(form_factor::form_factor_t type);
+
+			/**
+			 * @brief Get the sphere stencil of a water molecule, generating it if it is not cached for the current radius.
+			 */
+			const detail::SphereStencil& get_water_stencil();
+
+			/**
+			 * @brief Expand all unexpanded members of the given list. 
+			 * 		  Large lists are expanded in parallel by splitting the grid into slabs along the x-axis, 
+			 * 		  each of which is filled by a single thread such that no bin is written concurrently.
+			 * 		  Complexity: O(n) in the number of unexpanded members.
+			 */
+			template<typename T>
+			void expand_members(std::vector<GridMember<T>>& members);
+
+			/**
+			 * @brief Save the water members if a transaction is active and they have not been saved already. 
+			 *        This must be called before any modification of the water members.
+			 */
+			void save_waters();
+
 			/** 
 			 * @brief Expand a single member atom into an actual sphere.
 			 * 		  All empty bins within the radius of the atom will be set to either GridObj::A_AREA or GridObj::H_AREA, 
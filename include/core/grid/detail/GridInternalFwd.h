@@ -10,4 +10,8 @@ namespace ausaxs::grid {
 	template<grid_member_t T> class GridMember;
 	class PlacementStrategy;
 	class CullingStrategy;
+
+	namespace detail {
+		class SphereStencil;
+	}
 }
\ No newline at end of file
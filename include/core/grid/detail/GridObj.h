@@ -2,9 +2,11 @@
 
 #include <utility/Concepts.h>
 #include <math/MathFwd.h>
-#include <container/Container3D.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
+#include <utility>
 
 namespace ausaxs::grid::detail {
     /**
@@ -25,12 +27,52 @@ namespace ausaxs::grid::detail {
     /**
         * @brief A simple class that represents a 3D grid.
         *        Designed to make access more consistent.
+        * 
+        *        The bins are either stored densely, or in sparse cubic blocks which are only allocated once they are written to. 
+        *        Bins of unallocated blocks are EMPTY. The sparse storage is intended for large grids which are mostly empty. 
         */
-    class GridObj : public container::Container3D<detail::State> {
+    class GridObj {
         public: 
             GridObj() = default;
 
-            GridObj(unsigned int x, unsigned int y, unsigned int z);
+            /**
+                * @brief Constructor.
+                * 
+                * @param x The number of bins along the x-axis.
+                * @param y The number of bins along the y-axis.
+                * @param z The number of bins along the z-axis.
+                * @param sparse Whether to use the sparse block storage.
+                */
+            GridObj(unsigned int x, unsigned int y, unsigned int z, bool sparse = false);
+
+            /**
+                * @brief Get the number of bins along each axis.
+                */
+            std::size_t size_x() const {return N;}
+            std::size_t size_y() const {return M;} // @copydoc size_x() const
+            std::size_t size_z() const {return L;} // @copydoc size_x() const
+
+            /**
+                * @brief Check if the sparse block storage is used.
+                */
+            bool is_sparse() const {return sparse;}
+
+            /**
+                * @brief Get the number of bins which are currently allocated.
+                */
+            std::size_t allocated_size() const;
+
+            /**
+                * @brief Get the width of the storage blocks along each axis. This is 1 for the dense storage.
+                *        Concurrent writers must split the grid along the block boundaries, since blocks are allocated on their first write. 
+                */
+            unsigned int get_block_width() const {return sparse ? block_width : 1;}
+
+            /**
+                * @brief Check if the contents of this grid are equal to another, regardless of how they are stored.
+                *        Complexity: O(n) in the number of bins.
+                */
+            bool operator==(const GridObj& rhs) const;
 
             /**
                 * @brief Branchless function to check if a given bin is part of a volume. This means the bin is VOLUME.
@@ -114,9 +156,114 @@ namespace ausaxs::grid::detail {
             // @copydoc is_water_center(State) const;
             bool is_water_center(unsigned int x, unsigned int y, unsigned int z) const;
 
-            using container::Container3D<State>::index;
+            /**
+                * @brief Get a mutable reference to a given bin. 
+                *        During a transaction, the current state of the bin is recorded such that it can later be restored by rollback().
+                */
+            State& index(unsigned int x, unsigned int y, unsigned int z) {
+                State& s = bin(x, y, z);
+                if (journaling) [[unlikely]] {journal.emplace_back(linear_index(x, y, z), s);}
+                return s;
+            }
+
+            /**
+                * @brief Get the value of a given bin. 
+                */
+            const State& index(unsigned int x, unsigned int y, unsigned int z) const {
+                if (sparse) [[unlikely]] {
+                    const auto& block = blocks[block_index(x, y, z)];
+                    return block.empty() ? empty : block[block_offset(x, y, z)];
+                }
+                return data[linear_index(x, y, z)];
+            }
+
             State& index(const Vector3<int>& v);
             const State& index(const Vector3<int>& v) const;
+
+            /**
+                * @brief The previous states of modified bins, identified by their linear_index().
+                */
+            using Journal = std::vector<std::pair<std::size_t, State>>;
+
+            /**
+                * @brief Get a pointer to the bin (x, y, z), together with the number of bins following it along the z-axis which are stored contiguously with it. 
+                *        Modifications through this pointer are not recorded, and must be passed to record() during a transaction. 
+                */
+            std::pair<State*, unsigned int> segment(unsigned int x, unsigned int y, unsigned int z) {
+                unsigned int length = L - z;
+                if (sparse) {length = std::min(length, block_width - (z & block_mask));}
+                return {&bin(x, y, z), length};
+            }
+
+            /**
+                * @brief Get the position of a bin in row-major order, independent of how the bins are stored.
+                */
+            std::size_t linear_index(unsigned int x, unsigned int y, unsigned int z) const {return z + L*(y + M*x);}
+
+            /**
+                * @brief Record the previous states of bins modified through segment(), such that they can be restored by rollback().
+                *        Does nothing if no transaction is active.
+                *        Complexity: O(n) in the number of entries.
+                */
+            void record(const Journal& entries);
+
+            /**
+                * @brief Start recording the previous state of every bin accessed for modification. 
+                *        Complexity: O(1).
+                */
+            void begin_transaction();
+
+            /**
+                * @brief Accept all changes made since begin_transaction() and stop recording.
+                *        Complexity: O(1).
+                */
+            void commit();
+
+            /**
+                * @brief Revert all changes made since begin_transaction() and stop recording.
+                *        Complexity: O(n) in the number of modified bins.
+                */
+            void rollback();
+
+            /**
+                * @brief Check if a transaction is currently active.
+                */
+            bool in_transaction() const;
+
+        private:
+            static constexpr unsigned int block_bits = 4;
+            static constexpr unsigned int block_width = 1 << block_bits;
+            static constexpr unsigned int block_mask = block_width - 1;
+            static constexpr State empty = EMPTY;
+
+            std::size_t N = 0, M = 0, L = 0;            // the number of bins along each axis
+            bool sparse = false;
+            std::vector<State> data;                    // the dense storage
+            std::size_t BN = 0, BM = 0, BL = 0;         // the number of blocks along each axis
+            std::vector<std::vector<State>> blocks;     // the sparse storage. Unallocated blocks are empty.
+
+            Journal journal;    // the previous states of the modified bins, in the order they were modified
+            bool journaling = false;
+
+            std::size_t block_index(unsigned int x, unsigned int y, unsigned int z) const {
+                return (z >> block_bits) + BL*((y >> block_bits) + BM*(x >> block_bits));
+            }
+
+            static std::size_t block_offset(unsigned int x, unsigned int y, unsigned int z) {
+                return (z & block_mask) + block_width*((y & block_mask) + block_width*(x & block_mask));
+            }
+
+            /**
+                * @brief Get a mutable reference to a bin without recording it, allocating its block if necessary.
+                */
+            State& bin(unsigned int x, unsigned int y, unsigned int z) {
+                if (sparse) [[unlikely]] {
+                    auto& block = blocks[block_index(x, y, z)];
+                    if (block.empty()) {block.assign(block_width*block_width*block_width, EMPTY);}
+                    return block[block_offset(x, y, z)];
+                }
+                return data[linear_index(x, y, z)];
+            }
     };
 
     constexpr grid::detail::State operator|(grid::detail::State lhs, grid::detail::State rhs) {
@@ -19,8 +19,6 @@ namespace ausaxs::grid::detail {
             template<bool detect, bool unity_width>
             GridExcludedVolume helper() const;
 
-            bool collision_check(const Vector3<int>& loc) const;
-
             bool vacuum_collision_check(const Vector3<int>& loc) const;
 
             /**
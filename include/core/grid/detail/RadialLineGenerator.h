@@ -27,6 +27,17 @@ namespace ausaxs::grid::detail {
             static std::vector<Vector3<int>> rot_bins_4;
             static std::vector<Vector3<double>> rot_locs_abs;
 
+            /**
+             * @brief Get the largest offset along any axis of the line bins at the first three radii.
+             */
+            static int line_reach();
+
+            /**
+             * @brief Get the offsets of the line bins at the first three radii in a dense row-major array with the given strides. 
+             *        This allows the lines to be followed without converting to grid coordinates.
+             */
+            static std::vector<std::array<long, 3>> line_offsets(long stride_x, long stride_y);
+
         private:
             inline static double width = 0;
     };
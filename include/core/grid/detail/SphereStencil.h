@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+namespace ausaxs::grid::detail {
+    /**
+     * @brief The rows of a sphere and the shell surrounding it on the grid, such that it can be filled one contiguous z-row at a time.
+     *        All radii are in units of the grid width.
+     */
+    class SphereStencil {
+        public:
+            SphereStencil() = default;
+
+            /**
+             * @brief Constructor.
+             *
+             * @param r_inner The radius of the inner sphere.
+             * @param r_outer The outer radius of the shell. No shell is present if this is not larger than @a r_inner.
+             */
+            SphereStencil(double r_inner, double r_outer);
+
+            /**
+             * @brief Get the half-widths of the inner sphere and the outer shell along the z-row at the offset (dx, dy) from the center.
+             *        The inner sphere covers |dz| <= first, and the shell covers first < |dz| <= second. A half-width of -1 means the row is not covered.
+             *        Both offsets must be within the reach of the stencil.
+             */
+            const std::array<int, 2>& span(int dx, int dy) const {return spans[(dx + reach)*(2*reach + 1) + dy + reach];}
+
+            /**
+             * @brief Get the maximum offset from the center covered along any axis.
+             */
+            int get_reach() const {return reach;}
+
+            /**
+             * @brief Check if this stencil was generated for the given radii.
+             */
+            bool matches(double r_inner, double r_outer) const {return this->r_inner == r_inner && this->r_outer == r_outer;}
+
+        private:
+            double r_inner = -1, r_outer = -1;
+            int reach = 0;
+            std::vector<std::array<int, 2>> spans;
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <table/DebyeTable.h>
+#include <utility/observer_ptr.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ausaxs::hist::detail {
+    /**
+     * @brief Evaluates the Debye transforms of many distance profiles against the same sinc table.
+     *        Instead of a separate dot product for every combination of profile and q-value, all queued profiles are transformed together as
+     *        one matrix product [profiles x d] * [d x q]. This is split into cache-sized tiles, such that every loaded block of the table is
+     *        reused by several profiles, and every block of a profile by several q-values.
+     *
+     *        Most distance bins are typically empty, especially for the rarer form factor pairs. When a profile is queued, its non-zero bin ranges
+     *        are recorded, and only these are included in the transform. Profiles which are mostly empty are transformed span by span instead of
+     *        in the blocked product.
+     */
+    class BatchedDebyeTransform {
+        public:
+            /**
+             * @brief Prepare a batch of transforms.
+             *
+             * @param table The sinc table to use. Must be valid until run is called.
+             * @param q0 The index of the first q-value of the table to evaluate.
+             * @param q_bins The number of q-values to evaluate.
+             */
+            BatchedDebyeTransform(observer_ptr<const table::DebyeTable> table, unsigned int q0, unsigned int q_bins);
+
+            /**
+             * @brief Queue the transform of the distance profile [begin, end).
+             *        The result for the q-value q0+i is written to out[i] when run is called.
+             *        The profile and output ranges must be valid until run is called, and the profile cannot be longer than the table.
+             */
+            template<typename InputIt, typename OutputIt>
+            void enqueue(InputIt begin, InputIt end, OutputIt out);
+
+            /**
+             * @brief Evaluate all queued transforms using the global thread pool.
+             *        This will block until all results have been written.
+             */
+            void run();
+
+        private:
+            struct Profile {
+                const double* data;
+                double* out;
+                unsigned int begin, end;            // the range [begin, end) containing all non-zero bins
+                unsigned int span_begin, span_end;  // the indices of the non-zero spans of this profile in the spans vector
+            };
+
+            observer_ptr<const table::DebyeTable> table;
+            unsigned int q0, q_bins;
+            std::vector<Profile> dense, sparse;
+            std::vector<std::pair<unsigned int, unsigned int>> spans;
+
+            /**
+             * @brief Find the non-zero spans of the profile and queue it as either dense or sparse.
+             */
+            void add_profile(const double* data, unsigned int size, double* out);
+
+            /**
+             * @brief Evaluate the tile of the dense profiles [p_begin, p_end) and q-values [q_begin, q_end).
+             */
+            void evaluate_dense_tile(unsigned int p_begin, unsigned int p_end, unsigned int q_begin, unsigned int q_end) const;
+
+            /**
+             * @brief Evaluate the tile of the sparse profiles [p_begin, p_end) and q-values [q_begin, q_end).
+             */
+            void evaluate_sparse_tile(unsigned int p_begin, unsigned int p_end, unsigned int q_begin, unsigned int q_end) const;
+    };
+}
+
+//#########################################//
+//############ IMPLEMENTATION #############//
+//#########################################//
+
+template<typename InputIt, typename OutputIt>
+inline void ausaxs::hist::detail::BatchedDebyeTransform::enqueue(InputIt begin, InputIt end, OutputIt out) {
+    add_profile(std::to_address(begin), static_cast<unsigned int>(end - begin), std::to_address(out));
+}
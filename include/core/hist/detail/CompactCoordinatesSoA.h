@@ -0,0 +1,86 @@
+#pragma once
+
+#include <hist/detail/CompactCoordinates.h>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ausaxs::hist::detail {
+    /**
+     * @brief Minimal allocator returning memory aligned to a full cache line.
+     *        This guarantees that aligned SIMD loads of up to 512 bits are valid for every 16th element.
+     */
+    template<typename T>
+    struct CacheAlignedAllocator {
+        using value_type = T;
+        static constexpr std::align_val_t alignment{64};
+
+        CacheAlignedAllocator() = default;
+        template<typename U> CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {return static_cast<T*>(::operator new(n*sizeof(T), alignment));}
+        void deallocate(T* p, std::size_t) noexcept {::operator delete(p, alignment);}
+
+        template<typename U> bool operator==(const CacheAlignedAllocator<U>&) const noexcept {return true;}
+        template<typename U> bool operator!=(const CacheAlignedAllocator<U>&) const noexcept {return false;}
+    };
+
+    /**
+     * @brief A structure-of-arrays variant of CompactCoordinates, storing the x, y, z coordinates and weights in separate arrays.
+     *        This layout allows wide SIMD kernels to load 8 or 16 consecutive atoms directly into registers without any transposing shuffles.
+     *
+     *        Each array is padded with zero-weight dummy atoms such that any SIMD kernel may safely read up to lanes-1 elements past the last atom.
+     *        The results of these padded lanes must be discarded by the caller.
+     */
+    class CompactCoordinatesSoA {
+        public:
+            static constexpr unsigned int lanes = 16; // The widest supported SIMD register in floats.
+
+            CompactCoordinatesSoA() = default;
+
+            /**
+             * @brief Transpose the given coordinates into the structure-of-arrays layout.
+             */
+            explicit CompactCoordinatesSoA(const CompactCoordinates& data);
+
+            /**
+             * @brief Get the number of atoms, excluding the padding.
+             */
+            std::size_t size() const;
+
+            const float* x() const; //< Get the x-coordinates.
+            const float* y() const; //< Get the y-coordinates.
+            const float* z() const; //< Get the z-coordinates.
+            const float* w() const; //< Get the weights.
+
+        private:
+            std::size_t n = 0;
+            std::vector<float, CacheAlignedAllocator<float>> xs, ys, zs, ws;
+    };
+    static_assert(supports_nothrow_move_v<CompactCoordinatesSoA>, "CompactCoordinatesSoA should support nothrow move semantics.");
+}
+
+//#########################################//
+//############ IMPLEMENTATION #############//
+//#########################################//
+
+// implementation defined in header to support efficient inlining
+
+inline ausaxs::hist::detail::CompactCoordinatesSoA::CompactCoordinatesSoA(const CompactCoordinates& data) : n(data.size()) {
+    // round up to a multiple of the lane count, and then add a full extra register for unaligned loads starting at an arbitrary index
+    std::size_t padded = (n + lanes - 1)/lanes*lanes + lanes;
+    xs.assign(padded, 0); ys.assign(padded, 0); zs.assign(padded, 0); ws.assign(padded, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        xs[i] = data[i].value.pos.x();
+        ys[i] = data[i].value.pos.y();
+        zs[i] = data[i].value.pos.z();
+        ws[i] = data[i].value.w;
+    }
+}
+
+inline std::size_t ausaxs::hist::detail::CompactCoordinatesSoA::size() const {return n;}
+inline const float* ausaxs::hist::detail::CompactCoordinatesSoA::x() const {return xs.data();}
+inline const float* ausaxs::hist::detail::CompactCoordinatesSoA::y() const {return ys.data();}
+inline const float* ausaxs::hist::detail::CompactCoordinatesSoA::z() const {return zs.data();}
+inline const float* ausaxs::hist::detail::CompactCoordinatesSoA::w() const {return ws.data();}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/distribution/WeightedDistribution1D.h>
+#include <utility/observer_ptr.h>
+
+#include <array>
+#include <complex>
+#include <optional>
+#include <vector>
+
+namespace ausaxs::hist::detail {
+    /**
+     * @brief Pair-distance histograms of point sets on a common regular lattice, such as the dummy atoms of the grid-based excluded volume.
+     *
+     *        The distance between two lattice points only depends on the lattice vector between them, so the histograms can be found from the
+     *        correlations of the occupancy grids of the sets, binned by the lengths of the lattice vectors. The correlations are evaluated with FFTs,
+     *        which scales as O(V log V) in the volume V of the bounding box instead of O(N^2) in the number of points.
+     *        All correlations are evaluated in a single working buffer owned by the instance, so an instance must not be used from multiple threads at once.
+     */
+    class LatticeCorrelation {
+        public:
+            /**
+             * @brief Map the point sets onto a common lattice.
+             *        If all points are on a multiple of the spacing along some axis, the coarser lattice is used instead.
+             *
+             * @param sets The point sets. All points of a set must have the same weight.
+             * @param spacing The spacing of the lattice the points are expected to be on.
+             *
+             * @return The mapped sets, or nothing if any point is not on the lattice, if the pairwise evaluation is expected to be faster,
+             *         or if the working buffer of the transforms would be larger than max_memory.
+             */
+            static std::optional<LatticeCorrelation> create(const std::vector<observer_ptr<const CompactCoordinates>>& sets, double spacing);
+
+            /**
+             * @brief Calculate the histogram of all pairs of distinct points within a set.
+             *        Similar to the pairwise evaluation, each pair is counted twice and the self-correlation terms are not included.
+             *
+             * @param set The index of the set.
+             * @param bins The number of bins of the histogram. Must be large enough to hold all distances.
+             */
+            WeightedDistribution1D self(unsigned int set, unsigned int bins);
+
+            /**
+             * @brief Calculate the histogram of all pairs of points between two different sets.
+             *        This is found from the autocorrelation of the combined sets, reusing the autocorrelations of the individual sets if they were already calculated.
+             *
+             * @param set1 The index of the first set.
+             * @param set2 The index of the second set.
+             * @param bins The number of bins of the histogram. Must be large enough to hold all distances.
+             * @param factor The number of times each pair is counted.
+             */
+            WeightedDistribution1D cross(unsigned int set1, unsigned int set2, unsigned int bins, int factor);
+
+            /**
+             * @brief The maximum size in bytes of the working buffer of the transforms. Larger lattices are left to the pairwise evaluation.
+             */
+            static constexpr std::size_t max_memory = std::size_t(1) << 29;
+
+        private:
+            struct Set {
+                std::vector<std::size_t> cells; // The flat index of the cell of each point in the real layout of the buffer.
+                double weight;                  // The common weight of all points.
+            };
+
+            struct Binned {
+                std::vector<long> counts;       // The number of lattice vectors in each bin.
+                std::vector<double> distances;  // The summed lengths of the lattice vectors in each bin.
+            };
+
+            std::vector<Set> sets;
+            std::vector<Binned> autocorrelations; // The binned autocorrelation of each set, empty until it is needed.
+            std::array<double, 3> step;         // The lattice spacing along each axis.
+            std::array<int, 3> extent;          // The number of lattice points along each axis of the bounding box.
+            std::array<std::size_t, 3> padded;  // The size of the FFTs along each axis, large enough to avoid wrap-around.
+
+            // The working buffer. It holds the half-spectrum of the real transform along the last axis, and is reused in place for the real occupancies
+            // and correlations, with each row padded to 2*(padded[2]/2+1) values.
+            std::vector<std::complex<double>> buffer;
+
+            LatticeCorrelation() = default;
+
+            /**
+             * @brief Calculate the binned autocorrelation C(d) = sum_x A(x) A(x+d) of the combined occupancy A of the given sets.
+             */
+            Binned autocorrelate(const std::vector<unsigned int>& members, unsigned int bins);
+
+            /**
+             * @brief Get the binned autocorrelation of a single set, calculating it if it is not already available.
+             */
+            const Binned& autocorrelation(unsigned int set, unsigned int bins);
+
+            /**
+             * @brief Convert the binned counts to a histogram.
+             *
+             * @param factor The number of times each lattice vector is counted, relative to the counts.
+             */
+            static WeightedDistribution1D distribution(const Binned& binned, double weight, double factor);
+    };
+}
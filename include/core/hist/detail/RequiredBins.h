@@ -0,0 +1,54 @@
+#pragma once
+
+#include <hist/detail/CompactCoordinates.h>
+#include <constants/ConstantsAxes.h>
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace ausaxs::hist::detail {
+    /**
+     * @brief Get the number of distance bins required to hold all pairwise distances within and between the given sets of coordinates.
+     *        The maximum distance is bounded by the diameter of the sphere centered on the common centroid which encloses all coordinates.
+     *        This is at most twice the true maximum distance, but can be evaluated in linear time before any distances are calculated.
+     *
+     * @return The number of bins, capped at the size of the default distance axis.
+     */
+    template<typename... T> requires (std::is_base_of_v<CompactCoordinates, T> && ...)
+    unsigned int required_bins(const T&... data);
+}
+
+//#########################################//
+//############ IMPLEMENTATION #############//
+//#########################################//
+
+template<typename... T> requires (std::is_base_of_v<ausaxs::hist::detail::CompactCoordinates, T> && ...)
+inline unsigned int ausaxs::hist::detail::required_bins(const T&... data) {
+    double cx = 0, cy = 0, cz = 0;
+    std::size_t count = 0;
+    auto accumulate_centroid = [&] (const CompactCoordinates& coords) {
+        for (const auto& c : coords.get_data()) {
+            cx += c.value.pos.x(); cy += c.value.pos.y(); cz += c.value.pos.z();
+        }
+        count += coords.size();
+    };
+    (accumulate_centroid(data), ...);
+    if (count == 0) {return 1;}
+    cx /= count; cy /= count; cz /= count;
+
+    double r2 = 0;
+    auto accumulate_radius = [&] (const CompactCoordinates& coords) {
+        for (const auto& c : coords.get_data()) {
+            double dx = c.value.pos.x() - cx, dy = c.value.pos.y() - cy, dz = c.value.pos.z() - cz;
+            r2 = std::max(r2, dx*dx + dy*dy + dz*dz);
+        }
+    };
+    (accumulate_radius(data), ...);
+
+    // distances are rounded to the nearest bin, so the largest possible bin is round(2R/width).
+    // the extra bin is a safety margin for the single-precision distance calculations
+    double dmax = 2*std::sqrt(r2);
+    auto bins = static_cast<unsigned int>(std::ceil(dmax*constants::axes::d_inv_width)) + 2;
+    return std::min<unsigned int>(bins, constants::axes::d_axis.bins);
+}
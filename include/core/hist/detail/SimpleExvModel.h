@@ -20,6 +20,17 @@ namespace ausaxs::hist::detail {
              */
             static void disable();
 
+            /**
+             * @brief Enable or disable the effective charge excluded volume model without logging the change. 
+             *        This is used when restoring a previous state, which is not a change of configuration by the user.
+             */
+            static void set_enabled(bool enabled);
+
+            /**
+             * @brief Check if the effective charge excluded volume model is enabled.
+             */
+            [[nodiscard]] static bool is_enabled();
+
             /**
              * @brief Account for the excluded volume in the data.
              *		  Note: this should not be done for models with explicit excluded volume terms.
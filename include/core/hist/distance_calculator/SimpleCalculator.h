@@ -3,8 +3,11 @@
 #include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
 #include <hist/distribution/GenericDistribution1D.h>
 #include <hist/detail/CompactCoordinates.h>
+#include <hist/detail/CompactCoordinatesSoA.h>
 #include <hist/distance_calculator/detail/TemplateHelpers.h>
+#include <hist/distance_calculator/detail/SpatialTiling.h>
 #include <container/ThreadLocalWrapper.h>
+#include <settings/HistogramSettings.h>
 #include <utility/MultiThreading.h>
 
 #include <vector>
@@ -14,6 +17,12 @@ namespace ausaxs::hist::distance_calculator {
      * @brief Simple interface to queue histogram calculations. 
      *        Submit the data and then call calculate to get the result.
      *        The caller must guarantee the lifetime of all submitted data.
+     *
+     *        If settings::hist::detail::spatial_tiling is enabled, the submitted data is first copied and sorted into spatially compact blocks, 
+     *        after which the pairs are evaluated in cache-sized tiles. The result is identical to the untiled calculation. 
+     *        If settings::hist::detail::soa_kernels is enabled, the submitted data is copied into a structure-of-arrays layout and evaluated
+     *        with the widest SIMD kernels supported by the processor. This can be combined with the spatial tiling. 
+     *        In all cases, each task bins its distances into a detail::LanePrivateHistogram before merging them into the result.
      */
     template<bool weighted_bins>
     class SimpleCalculator {
@@ -25,6 +34,13 @@ namespace ausaxs::hist::distance_calculator {
         };
 
         public:
+            /**
+             * @brief Create a new calculator. 
+             *
+             * @param bins The number of distance bins of the resulting histograms. This must be large enough to hold the largest distance of all submitted data.
+             */
+            SimpleCalculator(unsigned int bins = constants::axes::d_axis.bins);
+
             /**
              * @brief Queue a self-correlation calculation. 
              *        This is faster than calling the cross-correlation method with the same data, as some optimizations can be made. 
@@ -63,7 +79,26 @@ namespace ausaxs::hist::distance_calculator {
             run_result run();
 
         private:
+            unsigned int bins;
             std::vector<std::unique_ptr<container::ThreadLocalWrapper<GenericDistribution1D_t>>> self_results, cross_results;
+            std::vector<std::unique_ptr<hist::detail::CompactCoordinates>> sorted_data; // spatially sorted copies of the submitted data, only used with spatial tiling
+            std::vector<std::unique_ptr<hist::detail::CompactCoordinatesSoA>> soa_data; // structure-of-arrays copies of the submitted data, only used with the SoA kernels
+
+            /**
+             * @brief Get a spatially sorted copy of the given data. The copy is owned by this object and is valid until run is called.
+             */
+            const hist::detail::CompactCoordinates& spatially_sorted(const hist::detail::CompactCoordinates& data);
+
+            /**
+             * @brief Get a structure-of-arrays copy of the given data, which is also spatially sorted if tiling is enabled. 
+             *        The copy is owned by this object and is valid until run is called.
+             */
+            const hist::detail::CompactCoordinatesSoA& structure_of_arrays(const hist::detail::CompactCoordinates& data);
+
+            /**
+             * @brief Get the tile size to use for the given data size. 
+             */
+            static int get_tile_size(int data_size);
 
             template<int scaling>
             int enqueue_calculate_self(const hist::detail::CompactCoordinates& data, int merge_id);
@@ -73,6 +108,9 @@ namespace ausaxs::hist::distance_calculator {
     };
 }
 
+template<bool weighted_bins>
+inline ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::SimpleCalculator(unsigned int bins) : bins(bins) {}
+
 template<bool weighted_bins> template<int scaling>
 inline int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::enqueue_calculate_self(
     const hist::detail::CompactCoordinates& data, 
@@ -83,7 +121,7 @@ inline int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::e
     int res_idx;
     if (merge_id == -1 || merge_id == static_cast<int>(self_results.size())) {
         // second condition is to enable using size_self_result() to get the next merge_id
-        self_results.emplace_back(std::make_unique<container::ThreadLocalWrapper<GenericDistribution1D_t>>(constants::axes::d_axis.bins));
+        self_results.emplace_back(std::make_unique<container::ThreadLocalWrapper<GenericDistribution1D_t>>(bins));
         res_idx = self_results.size()-1;
     } else {
         assert(merge_id < static_cast<int>(self_results.size()));
@@ -95,26 +133,27 @@ inline int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::e
     int job_size = settings::general::detail::job_size;
 
     // calculate upper triangle
-    for (int i = 0; i < data_size; i+=job_size) {
-        pool->detach_task(
-            [&data, res_ptr, data_size, imin = i, imax = std::min(i+job_size, data_size)] () {
-                auto& p_aa = res_ptr->get();
-                for (int i = imin; i < imax; ++i) { // atom
-                    int j = i+1;                    // atom
-                    for (; j+7 < data_size; j+=8) {
-                        evaluate8<weighted_bins, 2*scaling>(p_aa, data, data, i, j);
-                    }
-
-                    for (; j+3 < data_size; j+=4) {
-                        evaluate4<weighted_bins, 2*scaling>(p_aa, data, data, i, j);
-                    }
-
-                    for (; j < data_size; ++j) {
-                        evaluate1<weighted_bins, 2*scaling>(p_aa, data, data, i, j);
-                    }
+    if (settings::hist::detail::soa_kernels) {
+        const auto& soa = structure_of_arrays(data);
+        int tile_size = get_tile_size(data_size);
+        for (int i = 0; i < data_size; i+=job_size) {
+            pool->detach_task(
+                [&soa, res_ptr, tile_size, imin = i, imax = std::min(i+job_size, data_size)] () {
+                    detail::evaluate_tiled_self<weighted_bins, 2*scaling>(res_ptr->get(), soa, imin, imax, tile_size);
                 }
-            }
-        );
+            );
+        }
+    } else {
+        // without tiling, get_tile_size makes the entire j-axis a single tile
+        const auto& coords = settings::hist::detail::spatial_tiling ? spatially_sorted(data) : data;
+        int tile_size = get_tile_size(data_size);
+        for (int i = 0; i < data_size; i+=job_size) {
+            pool->detach_task(
+                [&coords, res_ptr, tile_size, imin = i, imax = std::min(i+job_size, data_size)] () {
+                    detail::evaluate_tiled_self<weighted_bins, 2*scaling>(res_ptr->get(), coords, imin, imax, tile_size);
+                }
+            );
+        }
     }
 
     // calculate skipped diagonal
@@ -142,7 +181,7 @@ int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::enqueue_
     auto pool = utility::multi_threading::get_global_pool();
     int res_idx;
     if (merge_id == -1) {
-        cross_results.emplace_back(std::make_unique<container::ThreadLocalWrapper<GenericDistribution1D_t>>(constants::axes::d_axis.bins));
+        cross_results.emplace_back(std::make_unique<container::ThreadLocalWrapper<GenericDistribution1D_t>>(bins));
         res_idx = cross_results.size()-1;
     } else {
         res_idx = merge_id;
@@ -153,31 +192,57 @@ int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::enqueue_
     int data_2_size = static_cast<int>(data_2.size());
     int job_size = settings::general::detail::job_size;
 
+    if (settings::hist::detail::soa_kernels) {
+        const auto& soa_1 = structure_of_arrays(data_1);
+        const auto& soa_2 = structure_of_arrays(data_2);
+        int tile_size = get_tile_size(data_1_size);
+        for (int i = 0; i < data_2_size; i+=job_size) {
+            pool->detach_task(
+                [&soa_1, &soa_2, res_ptr, tile_size, imin = i, imax = std::min(i+job_size, data_2_size)] () {
+                    detail::evaluate_tiled_cross<weighted_bins, 2*scaling>(res_ptr->get(), soa_2, soa_1, imin, imax, tile_size);
+                }
+            );
+        }
+        return res_idx;
+    }
+
+    const auto& coords_1 = settings::hist::detail::spatial_tiling ? spatially_sorted(data_1) : data_1;
+    const auto& coords_2 = settings::hist::detail::spatial_tiling ? spatially_sorted(data_2) : data_2;
+    int tile_size = get_tile_size(data_1_size);
     for (int i = 0; i < data_2_size; i+=job_size) {
         pool->detach_task(
-            [&data_1, &data_2, res_ptr, data_1_size, imin = i, imax = std::min(i+job_size, data_2_size)] () {
-                auto& p_ab = res_ptr->get();
-                for (int i = imin; i < imax; ++i) { // b
-                    int j = 0;                      // a
-                    for (; j+7 < data_1_size; j+=8) {
-                        evaluate8<weighted_bins, 2*scaling>(p_ab, data_2, data_1, i, j);
-                    }
-
-                    for (; j+3 < data_1_size; j+=4) {
-                        evaluate4<weighted_bins, 2*scaling>(p_ab, data_2, data_1, i, j);
-                    }
-
-                    for (; j < data_1_size; ++j) {
-                        evaluate1<weighted_bins, 2*scaling>(p_ab, data_2, data_1, i, j);
-                    }
-                }
+            [&coords_1, &coords_2, res_ptr, tile_size, imin = i, imax = std::min(i+job_size, data_2_size)] () {
+                detail::evaluate_tiled_cross<weighted_bins, 2*scaling>(res_ptr->get(), coords_2, coords_1, imin, imax, tile_size);
             }
         );
     }
-
     return res_idx;
 }
 
+template<bool weighted_bins>
+inline const ausaxs::hist::detail::CompactCoordinates& ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::spatially_sorted(
+    const hist::detail::CompactCoordinates& data
+) {
+    return *sorted_data.emplace_back(std::make_unique<hist::detail::CompactCoordinates>(detail::spatial_sort(data)));
+}
+
+template<bool weighted_bins>
+inline const ausaxs::hist::detail::CompactCoordinatesSoA& ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::structure_of_arrays(
+    const hist::detail::CompactCoordinates& data
+) {
+    if (settings::hist::detail::spatial_tiling) {
+        return *soa_data.emplace_back(std::make_unique<hist::detail::CompactCoordinatesSoA>(detail::spatial_sort(data)));
+    }
+    return *soa_data.emplace_back(std::make_unique<hist::detail::CompactCoordinatesSoA>(data));
+}
+
+template<bool weighted_bins>
+inline int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::get_tile_size(int data_size) {
+    // without tiling, the entire j-axis is a single tile
+    if (!settings::hist::detail::spatial_tiling) {return std::max(data_size, 1);}
+    return std::max(static_cast<int>(settings::hist::detail::tile_size), 1);
+}
+
 template<bool weighted_bins>
 inline int ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bins>::size_self_result() const {
     return self_results.size();
@@ -206,6 +271,8 @@ inline typename ausaxs::hist::distance_calculator::SimpleCalculator<weighted_bin
     // cleanup
     self_results.clear();
     cross_results.clear();
+    sorted_data.clear();
+    soa_data.clear();
 
     return result;
 }
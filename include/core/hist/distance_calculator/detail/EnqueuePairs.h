@@ -0,0 +1,60 @@
+#pragma once
+
+#include <hist/distance_calculator/detail/TemplateHelpersFFAvg.h>
+#include <hist/distance_calculator/detail/TemplateHelpersFFExplicit.h>
+#include <hist/detail/CompactCoordinatesFF.h>
+#include <container/ThreadLocalWrapper.h>
+#include <settings/GeneralSettings.h>
+#include <utility/MultiThreading.h>
+
+#include <algorithm>
+
+namespace ausaxs::hist::distance_calculator::detail {
+    /**
+     * @brief Queue the evaluation of all pairs of atoms (i, j) with i in data_i and j in data_j on the global pool.
+     *        The work is split into jobs of settings::general::detail::job_size atoms of data_i.
+     *        The results are added to the thread-local histograms p_all, which are passed on to the matching evaluate overload.
+     *        Nothing is waited for, so the coordinates and histograms must be kept alive until the pool has finished.
+     *
+     * @tparam factor A multiplicative factor for the atomic weights.
+     * @tparam self Whether data_i and data_j are the same coordinates. If so, each pair is only evaluated once.
+     */
+    template<bool use_weighted_distribution, int factor, bool self, typename... T>
+    void enqueue_pairs(const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, container::ThreadLocalWrapper<T>&... p_all);
+}
+
+//#########################################//
+//############ IMPLEMENTATION #############//
+//#########################################//
+
+template<bool use_weighted_distribution, int factor, bool self, typename... T>
+inline void ausaxs::hist::distance_calculator::detail::enqueue_pairs(
+    const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, container::ThreadLocalWrapper<T>&... p_all
+) {
+    auto pool = utility::multi_threading::get_global_pool();
+    int data_i_size = (int) data_i.size();
+    int data_j_size = (int) data_j.size();
+    int job_size = settings::general::detail::job_size;
+    for (int imin = 0; imin < data_i_size; imin += job_size) {
+        pool->detach_task([&data_i, &data_j, &p_all..., imin, imax = std::min(imin+job_size, data_i_size), data_j_size] () {
+            auto evaluate = [&data_i, &data_j] (int i, int imax, int data_j_size, T&... p) {
+                const auto& ev = ausaxs::detail::evaluators();
+                for (; i < imax; ++i) {
+                    int j = self ? i+1 : 0;
+                    for (; j+7 < data_j_size; j+=8) {
+                        evaluate8<use_weighted_distribution, factor>(ev, p..., data_i, data_j, i, j);
+                    }
+
+                    for (; j+3 < data_j_size; j+=4) {
+                        evaluate4<use_weighted_distribution, factor>(ev, p..., data_i, data_j, i, j);
+                    }
+
+                    for (; j < data_j_size; ++j) {
+                        evaluate1<use_weighted_distribution, factor>(ev, p..., data_i, data_j, i, j);
+                    }
+                }
+            };
+            evaluate(imin, imax, data_j_size, p_all.get()...);
+        });
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <hist/detail/CompactCoordinatesData.h>
+#include <utility/CPUFeatures.h>
+
+namespace ausaxs::hist::distance_calculator::detail::dispatch {
+    /**
+     * @brief Evaluators calculating the distances and combined weights between a single atom and 1, 4, or 8 consecutive atoms.
+     *        These mirror the CompactCoordinatesData::evaluate overloads, but are compiled for a specific instruction set and selected at runtime.
+     *
+     * @param atom The single atom.
+     * @param others Pointer to the first of the consecutive atoms.
+     */
+    using evaluate1_t = hist::detail::EvaluatedResult(*)(const hist::detail::CompactCoordinatesData& atom, const hist::detail::CompactCoordinatesData* others);
+    using evaluate1_rounded_t = hist::detail::EvaluatedResultRounded(*)(const hist::detail::CompactCoordinatesData& atom, const hist::detail::CompactCoordinatesData* others);
+    using evaluate4_t = hist::detail::QuadEvaluatedResult(*)(const hist::detail::CompactCoordinatesData& atom, const hist::detail::CompactCoordinatesData* others);
+    using evaluate4_rounded_t = hist::detail::QuadEvaluatedResultRounded(*)(const hist::detail::CompactCoordinatesData& atom, const hist::detail::CompactCoordinatesData* others);
+    using evaluate8_t = hist::detail::OctoEvaluatedResult(*)(const hist::detail::CompactCoordinatesData& atom, const hist::detail::CompactCoordinatesData* others);
+    using evaluate8_rounded_t = hist::detail::OctoEvaluatedResultRounded(*)(const hist::detail::CompactCoordinatesData& atom, const hist::detail::CompactCoordinatesData* others);
+
+    /**
+     * @brief The set of evaluators selected for the current machine.
+     */
+    struct Evaluators {
+        evaluate1_t evaluate1;
+        evaluate1_rounded_t evaluate1_rounded;
+        evaluate4_t evaluate4;
+        evaluate4_rounded_t evaluate4_rounded;
+        evaluate8_t evaluate8;
+        evaluate8_rounded_t evaluate8_rounded;
+        utility::cpu::InstructionSet instruction_set;
+    };
+
+    /**
+     * @brief Get the widest evaluators supported by the processor.
+     *        The selection is made on the first call based on the detected CPU features.
+     */
+    const Evaluators& get_evaluators();
+
+    /**
+     * @brief Get the evaluators for a specific instruction set.
+     *        The instruction set must be supported by the processor. Falls back to the widest available narrower set if no dedicated evaluators exist.
+     */
+    Evaluators get_evaluators(utility::cpu::InstructionSet set);
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <hist/distribution/GenericDistribution1D.h>
+#include <hist/distribution/detail/WeightedEntry.h>
+#include <constants/ConstantsAxes.h>
+#include <utility/Exceptions.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ausaxs::hist::distance_calculator::detail {
+    namespace lane_private {
+        /**
+         * @brief Kernel adding factor*weights[k] to the interleaved bin data[min(bins[k], overflow)*lanes + k%lanes] for all k < n.
+         *        Since consecutive elements always go to different lanes, a vector of lanes elements never contains conflicting addresses.
+         */
+        using scatter_add_t = void(*)(double* data, const int32_t* bins, const float* weights, int n, int32_t overflow, double factor);
+
+        /**
+         * @brief Get the widest scatter_add kernel supported by the processor.
+         *        The selection is made on the first call based on the detected CPU features.
+         */
+        scatter_add_t get_scatter_add();
+    }
+
+    /**
+     * @brief A one-dimensional histogram split into several interleaved lane-private copies.
+     *        Consecutive distances are added to different copies, such that repeated increments of the same bin do not form a chain of dependent loads and stores.
+     *        The copies of a single bin share a cache line. The storage is allocated once for the given number of bins, plus one overflow bin
+     *        which collects all larger distances, such that adding distances never has to check or grow the storage. 
+     *        The copies must be merged into a regular histogram with merge_into when all distances have been added.
+     *
+     * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. If so, raw distances must be added instead of bin indices.
+     */
+    template<bool use_weighted_distribution>
+    class LanePrivateHistogram {
+        public:
+            static constexpr int lanes = 8;
+            using entry_t = std::conditional_t<use_weighted_distribution, hist::detail::WeightedEntry, constants::axes::d_type>;
+            using distance_t = std::conditional_t<use_weighted_distribution, float, int32_t>;
+
+            /**
+             * @param bins The number of bins of the histogram this will be merged into.
+             */
+            explicit LanePrivateHistogram(unsigned int bins);
+
+            /**
+             * @brief Add n distances with their combined weights.
+             *
+             * @param distances The bin indices if use_weighted_distribution is false, otherwise the raw distances.
+             * @param weights The combined weights.
+             * @param n The number of distances.
+             *
+             * @tparam factor A multiplicative factor for the weights.
+             */
+            template<int factor>
+            void add(const distance_t* distances, const float* weights, int n);
+
+            /**
+             * @brief Add the sum of all lanes to the given histogram.
+             *
+             * @throws except::out_of_bounds if any distance was added to a bin outside the histogram.
+             */
+            void merge_into(typename hist::GenericDistribution1D<use_weighted_distribution>::type& p) const;
+
+        private:
+            std::vector<entry_t> data; // layout [bin][lane]
+            int32_t overflow;          // the index of the overflow bin
+    };
+}
+
+//#########################################//
+//############ IMPLEMENTATION #############//
+//#########################################//
+
+// implementation defined in header to support efficient inlining
+
+template<bool use_weighted_distribution>
+inline ausaxs::hist::distance_calculator::detail::LanePrivateHistogram<use_weighted_distribution>::LanePrivateHistogram(unsigned int bins) 
+    : data((bins+1)*lanes), overflow(static_cast<int32_t>(bins)) 
+{}
+
+template<bool use_weighted_distribution> template<int factor>
+inline void ausaxs::hist::distance_calculator::detail::LanePrivateHistogram<use_weighted_distribution>::add(const distance_t* distances, const float* weights, int n) {
+    if constexpr (use_weighted_distribution) {
+        for (int k = 0; k < n; ++k) {
+            // distances are non-negative, so adding one half before truncating is equivalent to std::round
+            int32_t bin = std::min(static_cast<int32_t>(distances[k]*constants::axes::d_inv_width + 0.5), overflow);
+            data[bin*lanes + (k & (lanes-1))].template add<factor>(distances[k], weights[k]);
+        }
+    } else {
+        // the vector kernels only pay off for longer sequences
+        if (32 <= n) {
+            static lane_private::scatter_add_t scatter_add = lane_private::get_scatter_add();
+            scatter_add(data.data(), distances, weights, n, overflow, factor);
+            return;
+        }
+        for (int k = 0; k < n; ++k) {
+            data[std::min(distances[k], overflow)*lanes + (k & (lanes-1))] += factor*static_cast<double>(weights[k]);
+        }
+    }
+}
+
+template<bool use_weighted_distribution>
+inline void ausaxs::hist::distance_calculator::detail::LanePrivateHistogram<use_weighted_distribution>::merge_into(typename hist::GenericDistribution1D<use_weighted_distribution>::type& p) const {
+    int bins = std::min<int>(overflow, p.size());
+    for (int bin = 0; bin < bins; ++bin) {
+        entry_t sum = data[bin*lanes];
+        for (int lane = 1; lane < lanes; ++lane) {
+            sum += data[bin*lanes + lane];
+        }
+        p.add_index(bin, sum);
+    }
+
+    // the remaining bins, including the overflow bin, must be empty
+    for (std::size_t i = static_cast<std::size_t>(bins)*lanes; i < data.size(); ++i) {
+        bool used;
+        if constexpr (use_weighted_distribution) {used = data[i].count != 0;}
+        else {used = data[i] != 0;}
+        if (used) [[unlikely]] {
+            std::string bin = static_cast<int32_t>(i/lanes) == overflow ? "beyond " + std::to_string(overflow) : std::to_string(i/lanes);
+            throw except::out_of_bounds("LanePrivateHistogram::merge_into: Distance bin " + bin + " is outside the histogram with " + std::to_string(p.size()) + " bins.");
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <utility/CPUFeatures.h>
+
+#include <cstdint>
+
+namespace ausaxs::hist::distance_calculator::detail::soa {
+    /**
+     * @brief Kernel calculating the @a binned distances and combined weights between a single atom and n consecutive atoms stored in structure-of-arrays layout.
+     *        Kernels may process n rounded up to a multiple of their register width, so both the input and output arrays must be padded accordingly.
+     *
+     * @param atom The x, y, z coordinates and weight of the single atom.
+     * @param x, y, z, w The coordinates and weights of the other atoms.
+     * @param n The number of atoms to evaluate.
+     * @param inv_width The inverse width of the distance bins.
+     * @param bins Output array of distance bins.
+     * @param weights Output array of combined weights.
+     */
+    using rounded_kernel_t = void(*)(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float inv_width, int32_t* bins, float* weights);
+
+    /**
+     * @brief Kernel calculating the distances and combined weights between a single atom and n consecutive atoms stored in structure-of-arrays layout.
+     *        Kernels may process n rounded up to a multiple of their register width, so both the input and output arrays must be padded accordingly.
+     */
+    using exact_kernel_t = void(*)(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float* distances, float* weights);
+
+    /**
+     * @brief The set of kernels selected for the current machine.
+     */
+    struct Kernels {
+        rounded_kernel_t evaluate_rounded;
+        exact_kernel_t evaluate;
+        utility::cpu::InstructionSet instruction_set;
+    };
+
+    /**
+     * @brief Get the widest kernels supported by the processor. 
+     *        The selection is made on the first call based on the detected CPU features. 
+     */
+    const Kernels& get_kernels();
+
+    /**
+     * @brief Get the kernels for a specific instruction set. 
+     *        The instruction set must be supported by the processor. Falls back to the widest available narrower set if no dedicated kernels exist.
+     */
+    Kernels get_kernels(utility::cpu::InstructionSet set);
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <hist/distance_calculator/detail/TemplateHelpers.h>
+#include <hist/distribution/GenericDistribution1D.h>
+#include <hist/distance_calculator/detail/SoAKernels.h>
+#include <hist/distance_calculator/detail/LanePrivateHistogram.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/detail/CompactCoordinatesSoA.h>
+#include <constants/ConstantsAxes.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace ausaxs::hist::distance_calculator::detail {
+    /**
+     * @brief Spread the lower 10 bits of a value such that there are two zero bits between each of them.
+     *        This is the standard building block of a 30-bit three-dimensional Morton code.
+     */
+    inline uint32_t spread_bits(uint32_t v) {
+        v &= 0x000003ff;
+        v = (v | (v << 16)) & 0x030000ff;
+        v = (v | (v <<  8)) & 0x0300f00f;
+        v = (v | (v <<  4)) & 0x030c30c3;
+        v = (v | (v <<  2)) & 0x09249249;
+        return v;
+    }
+
+    /**
+     * @brief Create a copy of the given coordinates reordered along a Morton (Z-order) curve of their bounding box.
+     *        Atoms which are close in space will be close in memory, such that a contiguous block of atoms occupies a compact spatial region.
+     *        The histogram is independent of the order of the atoms, so this does not change the result of a distance calculation.
+     */
+    inline hist::detail::CompactCoordinates spatial_sort(const hist::detail::CompactCoordinates& data) {
+        if (data.size() < 2) {return data;}
+
+        std::array<float, 3> min, max;
+        min.fill(std::numeric_limits<float>::max());
+        max.fill(std::numeric_limits<float>::lowest());
+        for (const auto& d : data.get_data()) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                min[k] = std::min(min[k], d.data[k]);
+                max[k] = std::max(max[k], d.data[k]);
+            }
+        }
+
+        // quantize each axis of the bounding box to 10 bits
+        float extent = std::max({max[0]-min[0], max[1]-min[1], max[2]-min[2], 1e-3f});
+        float scale = 1023.f/extent;
+        std::vector<std::pair<uint32_t, uint32_t>> codes(data.size());
+        for (unsigned int i = 0; i < data.size(); ++i) {
+            uint32_t code = 0;
+            for (unsigned int k = 0; k < 3; ++k) {
+                code |= spread_bits(static_cast<uint32_t>((data[i].data[k]-min[k])*scale)) << k;
+            }
+            codes[i] = {code, i};
+        }
+        std::sort(codes.begin(), codes.end());
+
+        hist::detail::CompactCoordinates sorted(data.size());
+        for (unsigned int i = 0; i < data.size(); ++i) {
+            sorted[i] = data[codes[i].second];
+        }
+        return sorted;
+    }
+
+    /**
+     * @brief Calculate all distances between the atoms [imin, imax) of data_i and [jmin, jmax) of data_j and add them to the histogram.
+     *
+     * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
+     * @tparam factor A multiplicative factor for the atomic weights.
+     */
+    template<bool use_weighted_distribution, int factor>
+    inline void evaluate_tile(
+        LanePrivateHistogram<use_weighted_distribution>& p,
+        const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j,
+        int imin, int imax, int jmin, int jmax
+    ) {
+        const auto& ev = ausaxs::detail::evaluators();
+        for (int i = imin; i < imax; ++i) {
+            int j = jmin;
+            for (; j+7 < jmax; j+=8) {
+                auto res = ausaxs::detail::add8::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
+                p.template add<factor>(res.distances.data(), res.weights.data(), 8);
+            }
+
+            for (; j+3 < jmax; j+=4) {
+                auto res = ausaxs::detail::add4::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
+                p.template add<factor>(res.distances.data(), res.weights.data(), 4);
+            }
+
+            for (; j < jmax; ++j) {
+                auto res = ausaxs::detail::add1::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
+                p.template add<factor>(&res.distance, &res.weight, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Calculate all distances between the atoms [imin, imax) of data_i and [jmin, jmax) of data_j and add them to the histogram.
+     *        The distances are evaluated in chunks by the widest SIMD kernel supported by the processor, after which they are binned. 
+     *
+     * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
+     * @tparam factor A multiplicative factor for the atomic weights.
+     */
+    template<bool use_weighted_distribution, int factor>
+    inline void evaluate_tile(
+        LanePrivateHistogram<use_weighted_distribution>& p,
+        const hist::detail::CompactCoordinatesSoA& data_i, const hist::detail::CompactCoordinatesSoA& data_j,
+        int imin, int imax, int jmin, int jmax
+    ) {
+        // the kernel buffers must have room for the padded lanes
+        constexpr int chunk = 256;
+        constexpr int buffer_size = chunk + hist::detail::CompactCoordinatesSoA::lanes;
+        alignas(64) std::array<typename LanePrivateHistogram<use_weighted_distribution>::distance_t, buffer_size> distances;
+        alignas(64) std::array<float, buffer_size> weights;
+        const auto& kernels = soa::get_kernels();
+
+        for (int i = imin; i < imax; ++i) {
+            std::array<float, 4> atom{data_i.x()[i], data_i.y()[i], data_i.z()[i], data_i.w()[i]};
+            for (int j = jmin; j < jmax; j += chunk) {
+                int n = std::min(chunk, jmax-j);
+                if constexpr (use_weighted_distribution) {
+                    kernels.evaluate(atom.data(), data_j.x()+j, data_j.y()+j, data_j.z()+j, data_j.w()+j, n, distances.data(), weights.data());
+                } else {
+                    kernels.evaluate_rounded(atom.data(), data_j.x()+j, data_j.y()+j, data_j.z()+j, data_j.w()+j, n, constants::axes::d_inv_width, distances.data(), weights.data());
+                }
+                p.template add<factor>(distances.data(), weights.data(), n);
+            }
+        }
+    }
+
+    /**
+     * @brief Calculate the upper triangle of distances between the atoms [imin, imax) and all atoms with a larger index.
+     *        The j-axis is traversed in tiles of tile_size atoms, such that each tile stays in cache while all i-atoms are evaluated against it.
+     *        The distances are binned into a LanePrivateHistogram which is merged into p at the end. 
+     *
+     * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
+     * @tparam factor A multiplicative factor for the atomic weights.
+     * @tparam coordinates_t Either CompactCoordinates or CompactCoordinatesSoA.
+     */
+    template<bool use_weighted_distribution, int factor, typename coordinates_t>
+    inline void evaluate_tiled_self(
+        typename hist::GenericDistribution1D<use_weighted_distribution>::type& p,
+        const coordinates_t& data, int imin, int imax, int tile_size
+    ) {
+        int size = static_cast<int>(data.size());
+        LanePrivateHistogram<use_weighted_distribution> bins(p.size());
+
+        // the diagonal tile is a triangle
+        for (int i = imin; i < imax; ++i) {
+            evaluate_tile<use_weighted_distribution, factor>(bins, data, data, i, i+1, i+1, imax);
+        }
+
+        // the remaining tiles are rectangular
+        for (int jmin = imax; jmin < size; jmin += tile_size) {
+            evaluate_tile<use_weighted_distribution, factor>(bins, data, data, imin, imax, jmin, std::min(jmin+tile_size, size));
+        }
+        bins.merge_into(p);
+    }
+
+    /**
+     * @brief Calculate all distances between the atoms [imin, imax) of data_i and all atoms of data_j.
+     *        The j-axis is traversed in tiles of tile_size atoms, such that each tile stays in cache while all i-atoms are evaluated against it.
+     *        The distances are binned into a LanePrivateHistogram which is merged into p at the end. 
+     *
+     * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
+     * @tparam factor A multiplicative factor for the atomic weights.
+     * @tparam coordinates_t Either CompactCoordinates or CompactCoordinatesSoA.
+     */
+    template<bool use_weighted_distribution, int factor, typename coordinates_t>
+    inline void evaluate_tiled_cross(
+        typename hist::GenericDistribution1D<use_weighted_distribution>::type& p,
+        const coordinates_t& data_i, const coordinates_t& data_j, int imin, int imax, int tile_size
+    ) {
+        int size = static_cast<int>(data_j.size());
+        LanePrivateHistogram<use_weighted_distribution> bins(p.size());
+        for (int jmin = 0; jmin < size; jmin += tile_size) {
+            evaluate_tile<use_weighted_distribution, factor>(bins, data_i, data_j, imin, imax, jmin, std::min(jmin+tile_size, size));
+        }
+        bins.merge_into(p);
+    }
+}
@@ -2,49 +2,99 @@
 
 #include <hist/distribution/GenericDistribution1D.h>
 #include <hist/detail/CompactCoordinates.h>
+#include <hist/distance_calculator/detail/EvaluatorDispatch.h>
+
+// With AUSAXS_RUNTIME_DISPATCH, the evaluators are selected at runtime from the CPU features instead of the compile-time architecture flags.
+// This is used for portable builds, which must run on any x86-64 machine while still using the widest registers available. 
+
+namespace ausaxs::detail {
+    #if defined AUSAXS_RUNTIME_DISPATCH
+        using Evaluators = hist::distance_calculator::detail::dispatch::Evaluators;
+    #else
+        // the evaluators are selected at compile time, so there is nothing to look up
+        struct Evaluators {};
+    #endif
+
+    /**
+     * @brief Get the evaluators used by the helpers below.
+     *        With runtime dispatch the lookup is not free, so it should be done once per block of pairs and passed to the helpers.
+     */
+    inline const Evaluators& evaluators() {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return hist::distance_calculator::detail::dispatch::get_evaluators();
+        #else
+            static constexpr Evaluators none;
+            return none;
+        #endif
+    }
+}
 
 namespace ausaxs::detail::add8 {
     template<int use_weighted_distribution>
-    inline auto evaluate(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j);
+    inline auto evaluate([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j);
 
     template<>
-    inline auto evaluate<false>(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        return data_i[i].evaluate_rounded(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3], data_j[j+4], data_j[j+5], data_j[j+6], data_j[j+7]);
+    inline auto evaluate<false>([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return ev.evaluate8_rounded(data_i[i], &data_j[j]);
+        #else
+            return data_i[i].evaluate_rounded(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3], data_j[j+4], data_j[j+5], data_j[j+6], data_j[j+7]);
+        #endif
     }
 
     template<>
-    inline auto evaluate<true>(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        return data_i[i].evaluate(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3], data_j[j+4], data_j[j+5], data_j[j+6], data_j[j+7]);
+    inline auto evaluate<true>([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return ev.evaluate8(data_i[i], &data_j[j]);
+        #else
+            return data_i[i].evaluate(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3], data_j[j+4], data_j[j+5], data_j[j+6], data_j[j+7]);
+        #endif
     }
 }
 
 namespace ausaxs::detail::add4 {
     template<int use_weighted_distribution>
-    inline auto evaluate(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j);
+    inline auto evaluate([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j);
 
     template<>
-    inline auto evaluate<false>(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        return data_i[i].evaluate_rounded(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3]);
+    inline auto evaluate<false>([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return ev.evaluate4_rounded(data_i[i], &data_j[j]);
+        #else
+            return data_i[i].evaluate_rounded(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3]);
+        #endif
     }
 
     template<>
-    inline auto evaluate<true>(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        return data_i[i].evaluate(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3]);
+    inline auto evaluate<true>([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return ev.evaluate4(data_i[i], &data_j[j]);
+        #else
+            return data_i[i].evaluate(data_j[j], data_j[j+1], data_j[j+2], data_j[j+3]);
+        #endif
     }
 }
 
 namespace ausaxs::detail::add1 {
     template<int use_weighted_distribution>
-    inline auto evaluate(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j);
+    inline auto evaluate([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j);
 
     template<>
-    inline auto evaluate<false>(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        return data_i[i].evaluate_rounded(data_j[j]);
+    inline auto evaluate<false>([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return ev.evaluate1_rounded(data_i[i], &data_j[j]);
+        #else
+            return data_i[i].evaluate_rounded(data_j[j]);
+        #endif
     }
 
     template<>
-    inline auto evaluate<true>(const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        return data_i[i].evaluate(data_j[j]);
+    inline auto evaluate<true>([[maybe_unused]] const Evaluators& ev, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        #if defined AUSAXS_RUNTIME_DISPATCH
+            return ev.evaluate1(data_i[i], &data_j[j]);
+        #else
+            return data_i[i].evaluate(data_j[j]);
+        #endif
     }
 }
 
@@ -54,6 +104,7 @@ namespace ausaxs {
      * 
      * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
      * @tparam factor A multiplicative factor for the atomic weights. 
+     * @param ev The distance evaluators, see detail::evaluators().
      * @param p The histogram to add the distances to.
      * @param data_i The first atom.
      * @param data_j The second atom.
@@ -61,10 +112,14 @@ namespace ausaxs {
      * @param j The index of the second atom.
      */
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate8(typename hist::GenericDistribution1D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = detail::add8::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate8(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution1D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = detail::add8::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 8; ++k) {
-            p.template add<factor>(res.distances[k], res.weights[k]);
+            if constexpr (use_weighted_distribution) {
+                p.template add<factor>(res.distances[k], res.weights[k]);
+            } else {
+                p.template add_index<factor>(res.distances[k], res.weights[k]); // the distances are already binned
+            }
         }
     }
 
@@ -73,6 +128,7 @@ namespace ausaxs {
      * 
      * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
      * @tparam factor A multiplicative factor for the atomic weights. 
+     * @param ev The distance evaluators, see detail::evaluators().
      * @param p The histogram to add the distances to.
      * @param data_i The first atom.
      * @param data_j The second atom.
@@ -80,10 +136,14 @@ namespace ausaxs {
      * @param j The index of the second atom.
      */
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate4(typename hist::GenericDistribution1D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = detail::add4::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate4(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution1D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = detail::add4::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 4; ++k) {
-            p.template add<factor>(res.distances[k], res.weights[k]);
+            if constexpr (use_weighted_distribution) {
+                p.template add<factor>(res.distances[k], res.weights[k]);
+            } else {
+                p.template add_index<factor>(res.distances[k], res.weights[k]); // the distances are already binned
+            }
         }
     }
 
@@ -92,6 +152,7 @@ namespace ausaxs {
      * 
      * @tparam use_weighted_distribution Whether to keep track of the distances added to the bins. This is useful for weighting the bins later.
      * @tparam factor A multiplicative factor for the atomic weights. 
+     * @param ev The distance evaluators, see detail::evaluators().
      * @param p The histogram to add the distances to.
      * @param data_i The first atom.
      * @param data_j The second atom.
@@ -99,8 +160,12 @@ namespace ausaxs {
      * @param j The index of the second atom.
      */
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate1(typename hist::GenericDistribution1D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = detail::add1::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
-        p.template add<factor>(res.distance, res.weight);
+    inline void evaluate1(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution1D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinates& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = detail::add1::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
+        if constexpr (use_weighted_distribution) {
+            p.template add<factor>(res.distance, res.weight);
+        } else {
+            p.template add_index<factor>(res.distance, res.weight); // the distance is already binned
+        }
     }
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ namespace ausaxs {
      * 
      * @tparam use_weighted_distribution Whether to keep track of the distances template added to the bins. This is useful for weighting the bins later.
      * @tparam factor A multiplicative factor for the atomic weights. 
+     * @param ev The distance evaluators, see detail::evaluators().
      * @param p The histogram to template add the distances to.
      * @param data_i The first atom. The form factor index of this will be used for the first axis of the histogram.
      * @param data_j The second atom. This is assumed to be water.
@@ -18,8 +19,8 @@ namespace ausaxs {
      * @param j The index of the second atom.
      */
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate8(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, int i, int j) {
-        auto res = detail::add8::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate8(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, int i, int j) {
+        auto res = detail::add8::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 8; ++k) {
             if constexpr (factor == 1) {
                 p.template add<1>(data_i.get_ff_type(i), res.distances[k], res.weights[k]);
@@ -36,6 +37,7 @@ namespace ausaxs {
      * 
      * @tparam use_weighted_distribution Whether to keep track of the distances template added to the bins. This is useful for weighting the bins later.
      * @tparam factor A multiplicative factor for the atomic weights. 
+     * @param ev The distance evaluators, see detail::evaluators().
      * @param p The histogram to template add the distances to.
      * @param data_i The first atom. The form factor index of this will be used for the first axis of the histogram.
      * @param data_j The second atom. This is assumed to be water.
@@ -43,8 +45,8 @@ namespace ausaxs {
      * @param j The index of the second atom.
      */
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate4(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, int i, int j) {
-        auto res = detail::add4::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate4(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, int i, int j) {
+        auto res = detail::add4::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 4; ++k) {
             if constexpr (factor == 1) {
                 p.template add<1>(data_i.get_ff_type(i), res.distances[k], res.weights[k]);
@@ -61,6 +63,7 @@ namespace ausaxs {
      * 
      * @tparam use_weighted_distribution Whether to keep track of the distances template added to the bins. This is useful for weighting the bins later.
      * @tparam factor A multiplicative factor for the atomic weights. 
+     * @param ev The distance evaluators, see detail::evaluators().
      * @param p The histogram to template add the distances to.
      * @param data_i The first atom. The form factor index of this will be used for the first axis of the histogram.
      * @param data_j The second atom. This is assumed to be water.
@@ -68,8 +71,8 @@ namespace ausaxs {
      * @param j The index of the second atom.
      */
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate1(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, int i, int j) {
-        auto res = detail::add1::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate1(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinatesFF& data_j, int i, int j) {
+        auto res = detail::add1::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         if constexpr (factor == 1) {
             p.template add<1>(data_i.get_ff_type(i), res.distance, res.weight);
             p.template add<1>(static_cast<unsigned int>(form_factor::form_factor_t::EXCLUDED_VOLUME), res.distance, data_j[j].value.w);
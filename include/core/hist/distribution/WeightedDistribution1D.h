@@ -62,7 +62,8 @@ namespace ausaxs::hist {
              */
             template<int N = 1>
             void add(float distance, constants::axes::d_type value) {
-                int i = std::round(distance*constants::axes::d_inv_width);
+                // distances are non-negative, so adding one half before truncating is equivalent to std::round but much cheaper
+                int i = static_cast<int>(distance*constants::axes::d_inv_width + 0.5);
                 index(i).add<N>(distance, value);
             }
 
@@ -22,5 +22,19 @@ namespace ausaxs::hist {
              * @brief Calculate all contributions to the scattering histogram. 
              */
             std::unique_ptr<ICompositeDistanceHistogram> calculate_all() override;
+
+            /**
+             * @brief Replace the average excluded volume contributions of a weighted FFAvg histogram with those of the excluded volume grid of the molecule.
+             *        This is shared with PartialHistogramManagerMTFFGrid. 
+             *
+             * @param base_res The result of a weighted FFAvg histogram manager. 
+             * @param protein The molecule the histogram was calculated for. 
+             * @param data_a The compact representation of all atoms of the molecule, in body order. 
+             * @param data_w The compact representation of the hydration layer of the molecule. 
+             */
+            static std::unique_ptr<ICompositeDistanceHistogram> add_grid_excluded_volume(
+                std::unique_ptr<ICompositeDistanceHistogram> base_res, observer_ptr<const data::Molecule> protein, 
+                const hist::detail::CompactCoordinatesFF& data_a, const hist::detail::CompactCoordinatesFF& data_w
+            );
     };
 }
\ No newline at end of file
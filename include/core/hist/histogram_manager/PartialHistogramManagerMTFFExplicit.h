@@ -0,0 +1,61 @@
+#pragma once
+
+#include <hist/histogram_manager/IPartialHistogramManager.h>
+#include <hist/detail/CompactCoordinatesFF.h>
+#include <hist/distribution/GenericDistribution1D.h>
+#include <hist/distribution/GenericDistribution2D.h>
+#include <hist/distribution/GenericDistribution3D.h>
+#include <container/Container1D.h>
+#include <container/Container2D.h>
+
+#include <vector>
+
+namespace ausaxs::hist {
+	/**
+	 * @brief A multi-threaded smart histogram manager which uses precalculated form factor products for both the atoms and the excluded volume.
+	 *        This is the partial equivalent of HistogramManagerMTFFExplicit.
+	 *
+	 *        The form factor resolved histograms of each pair of bodies and of each body with the hydration layer are stored separately,
+	 *        such that only the histograms involving a modified body must be recalculated. See PartialHistogramManager for more details.
+	 *        Each partial histogram is only as large as required by the bodies it covers, and they are summed whenever a result is requested.
+	 */
+	template<bool use_weighted_distribution>
+	class PartialHistogramManagerMTFFExplicit : public IPartialHistogramManager {
+	    using GenericDistribution1D_t = typename hist::GenericDistribution1D<use_weighted_distribution>::type;
+	    using GenericDistribution2D_t = typename hist::GenericDistribution2D<use_weighted_distribution>::type;
+	    using GenericDistribution3D_t = typename hist::GenericDistribution3D<use_weighted_distribution>::type;
+		public:
+			PartialHistogramManagerMTFFExplicit(observer_ptr<const data::Molecule> protein);
+			virtual ~PartialHistogramManagerMTFFExplicit() override;
+
+			/**
+			 * @brief Calculate only the total scattering histogram.
+			 */
+			std::unique_ptr<DistanceHistogram> calculate() override;
+
+			/**
+			 * @brief Calculate all contributions to the scattering histogram.
+			 */
+			std::unique_ptr<ICompositeDistanceHistogram> calculate_all() override;
+
+		protected:
+			observer_ptr<const data::Molecule> protein;						// the molecule we are calculating the histogram for
+			std::vector<detail::CompactCoordinatesFF> coords_a;				// a compact representation of the atoms of each body
+			detail::CompactCoordinatesFF coords_w;							// a compact representation of the hydration layer
+			container::Container2D<GenericDistribution3D_t> partials_aa;	// the atom-atom partial histograms (n, m) for m <= n, indexed as (ff1, ff2, distance)
+			container::Container2D<GenericDistribution3D_t> partials_ax;	// the atom-exv partial histograms (n, m) for m <= n, indexed as (ff1, ff2, distance)
+			container::Container2D<GenericDistribution3D_t> partials_xx;	// the exv-exv partial histograms (n, m) for m <= n, indexed as (ff1, ff2, distance)
+			container::Container1D<GenericDistribution2D_t> partials_aw;	// the atom-water partial histograms of each body, indexed as (ff, distance)
+			container::Container1D<GenericDistribution2D_t> partials_wx;	// the water-exv partial histograms of each body, indexed as (ff, distance)
+			GenericDistribution1D_t partials_ww;							// the water-water partial histogram
+
+			/**
+			 * @brief Recalculate all partial histograms affected by the changes since the last call.
+			 *        On the first call, all partial histograms are calculated.
+			 */
+			void update_partials();
+
+		private:
+			bool initialized = false;
+	};
+}
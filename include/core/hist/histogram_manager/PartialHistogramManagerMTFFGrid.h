@@ -0,0 +1,29 @@
+#pragma once
+
+#include <hist/histogram_manager/PartialHistogramManagerMTFFAvg.h>
+
+namespace ausaxs::hist {
+	/**
+	 * @brief A multi-threaded smart histogram manager which uses a grid-based approximation of the excluded volume.
+	 *        This is the partial equivalent of HistogramManagerMTFFGrid, and weighted bins are likewise required.
+	 *
+	 *        Only the atomic and hydration contributions are updated incrementally. The excluded volume grid is generated for the molecule as a whole,
+	 *        so its contributions are recalculated on every call.
+	 */
+	class PartialHistogramManagerMTFFGrid : public PartialHistogramManagerMTFFAvg<true> {
+		public:
+			using PartialHistogramManagerMTFFAvg::PartialHistogramManagerMTFFAvg;
+
+			virtual ~PartialHistogramManagerMTFFGrid() override;
+
+			/**
+			 * @brief Calculate only the total scattering histogram.
+			 */
+			std::unique_ptr<DistanceHistogram> calculate() override;
+
+			/**
+			 * @brief Calculate all contributions to the scattering histogram.
+			 */
+			std::unique_ptr<ICompositeDistanceHistogram> calculate_all() override;
+	};
+}
@@ -62,6 +62,9 @@ namespace ausaxs::hist {
 
             virtual ScatteringProfile debye_transform() const override;
             virtual SimpleDataset debye_transform(const std::vector<double>& q) const override;
+            std::vector<double> evaluate(const FreeParameters& params) const override;
+            IntensityBasis get_intensity_basis() const override;
+            FreeParameters get_free_parameters() const override;
 
             void apply_water_scaling_factor(double k) override;
             void apply_excluded_volume_scaling_factor(double k) override;
@@ -127,19 +130,27 @@ namespace ausaxs::hist {
             static double get_exv_debye_waller_factor(double q, double sigma);
 
         protected:
-            struct {
-                double cw = 1;               // water density scaling factor
-                double cx = 1;               // excluded volume scaling factor, method-dependent
-                double crho = 1;             // solvent density scaling factor
-                double DW_sigma_atomic = 0;  // atomic form factor debye-waller factor, zero for disabled
-                double DW_sigma_exv = 0;     // excluded volume form factor debye-waller factor, zero for disabled
-            } free_params;
+            FreeParameters free_params;
             struct {Distribution3D aa; Distribution2D aw; Distribution1D ww;} distance_profiles;
 
             /**
              * @brief Get the q-dependent multiplicative factor for the excluded volume form factor.
              */
-            virtual double exv_factor(double q) const;
+            virtual double exv_factor(double q, const FreeParameters& params) const;
+
+            enum class Profile {aa, ax, aw, xx, wx, ww};
+
+            /**
+             * @brief Add a partial intensity profile evaluated with the given parameters to @a out, without any Debye-Waller factors.
+             *        Only the sinqd cache is read, which must be valid. This is thread-safe. 
+             */
+            void evaluate_profile(Profile profile, const FreeParameters& params, std::vector<double>& out) const;
+
+            /**
+             * @brief Add a partial intensity profile to @a out as above, but with the excluded volume factor at each q-value given by @a cx.
+             *        The profiles are polynomials in this factor, which is used to decompose them in get_intensity_basis. 
+             */
+            virtual void evaluate_profile(Profile profile, const FreeParameters& params, const std::vector<double>& cx, std::vector<double>& out) const;
 
         private:
             /**
@@ -211,7 +222,7 @@ namespace ausaxs::hist {
                 const std::vector<double>&, const std::vector<double>&, const std::vector<double>&,
                 const std::vector<double>&, const std::vector<double>&, const std::vector<double>& 
             >) const;
-            virtual void cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const;
+            void cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const;
             virtual void cache_refresh_distance_profiles() const;
             virtual void cache_refresh_sinqd() const;
     };
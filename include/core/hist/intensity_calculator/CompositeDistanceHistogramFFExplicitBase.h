@@ -14,6 +14,8 @@ namespace ausaxs::hist {
     template<typename AAFormFactorTableType, typename AXFormFactorTableType, typename XXFormFactorTableType>
     class CompositeDistanceHistogramFFExplicitBase : public CompositeDistanceHistogramFFAvgBase<AAFormFactorTableType> {
         public: 
+            using typename CompositeDistanceHistogramFFAvgBase<AAFormFactorTableType>::FreeParameters;
+
             CompositeDistanceHistogramFFExplicitBase();
             CompositeDistanceHistogramFFExplicitBase(const CompositeDistanceHistogramFFExplicitBase&);
             CompositeDistanceHistogramFFExplicitBase(CompositeDistanceHistogramFFExplicitBase&&) noexcept;
@@ -76,8 +78,13 @@ namespace ausaxs::hist {
             static double exv_factor(double q, double cx);
 
         protected:
-            // @copydoc CompositeDistanceHistogramFFAvgBase::exv_factor(double) const
-            double exv_factor(double q) const override;
+            using typename CompositeDistanceHistogramFFAvgBase<AAFormFactorTableType>::Profile;
+
+            // @copydoc CompositeDistanceHistogramFFAvgBase::exv_factor(double, const FreeParameters&) const
+            double exv_factor(double q, const FreeParameters& params) const override;
+
+            // @copydoc CompositeDistanceHistogramFFAvgBase::evaluate_profile
+            void evaluate_profile(Profile profile, const FreeParameters& params, const std::vector<double>& cx, std::vector<double>& out) const override;
 
             struct {hist::Distribution3D xx, ax; hist::Distribution2D wx;} exv_distance_profiles;
 
@@ -97,7 +104,6 @@ namespace ausaxs::hist {
             } exv_cache;
 
         private:
-            void cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const override;
             void cache_refresh_sinqd() const override;
     };
 }
\ No newline at end of file
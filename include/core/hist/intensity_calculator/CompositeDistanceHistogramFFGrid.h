@@ -81,7 +81,7 @@ namespace ausaxs::hist {
              */
             observer_ptr<const table::DebyeTable> get_sinc_table_ax() const;
 
-            double exv_factor(double q) const override;
+            double exv_factor(double q, const FreeParameters& params) const override;
 
         private: 
             inline static form_factor::storage::atomic::table_t ff_table;
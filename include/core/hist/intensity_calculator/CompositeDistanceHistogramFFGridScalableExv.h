@@ -10,10 +10,24 @@ namespace ausaxs::hist {
         public:
             CompositeDistanceHistogramFFGridScalableExv(CompositeDistanceHistogramFFGrid&& cdh, std::function<std::unique_ptr<CompositeDistanceHistogramFFGrid>(double)> eval_scaled_exv);
             void apply_excluded_volume_scaling_factor(double k) override;
-            virtual double exv_factor(double) const override {return 1;}
+            virtual double exv_factor(double, const FreeParameters&) const override {return 1;}
+
+            /**
+             * @brief Evaluate the scattering intensity for the given parameters without modifying this object. 
+             *        The excluded volume can only be scaled by recalculating the histogram, so the excluded volume scaling factor must match the one last applied.
+             */
+            std::vector<double> evaluate(const FreeParameters& params) const override;
+
+            /**
+             * @brief Get the decomposition of the scattering intensity into parameter-independent curves. 
+             *        The excluded volume can only be scaled by recalculating the histogram, so the exv_factor of the basis is left empty.
+             */
+            IntensityBasis get_intensity_basis() const override;
+            FreeParameters get_free_parameters() const override;
 
         private:
             std::function<std::unique_ptr<CompositeDistanceHistogramFFGrid>(double)> eval_scaled_exv;
+            double cx = 1; // the currently applied excluded volume scaling factor
     };
     static_assert(supports_nothrow_move_v<CompositeDistanceHistogramFFGridScalableExv>, "CompositeDistanceHistogramFFGridScalableExv should support nothrow move semantics.");
 }
\ No newline at end of file
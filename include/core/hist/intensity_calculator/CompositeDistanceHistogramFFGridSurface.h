@@ -99,7 +99,8 @@ namespace ausaxs::hist {
             hist::Distribution1D evaluate_wx_distance_profile(double cx) const;
             hist::Distribution2D evaluate_ax_distance_profile(double cx) const;
 
-            double exv_factor(double q) const override;
+            double exv_factor(double q, const FreeParameters& params) const override;
+            void evaluate_profile(Profile profile, const FreeParameters& params, const std::vector<double>& cx, std::vector<double>& out) const override;
 
         private: 
             struct {std::unique_ptr<table::VectorDebyeTable> xx, ax;} sinc_tables;
@@ -111,7 +112,15 @@ namespace ausaxs::hist {
             //#################################//
             //###           CACHE           ###//
             //#################################//
-            void cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const override;
+            mutable struct {
+                // cached sinqd vals of the interior, surface, and cross exv distance profiles
+                // the exv profiles are linear in the surface scaling, so they can be combined after the transform
+                mutable struct {
+                    container::Container2D<double> ax_i, ax_s;
+                    container::Container1D<double> xx_i, xx_s, xx_c, wx_i, wx_s;
+                } sinqd;
+            } exv_cache;
+
             void cache_refresh_sinqd() const override;
     };
     static_assert(supports_nothrow_move_v<CompositeDistanceHistogramFFGridSurface>, "CompositeDistanceHistogramFFGridSurface should support nothrow move semantics.");
@@ -5,6 +5,9 @@
 #include <container/Container2D.h>
 #include <container/Container3D.h>
 
+#include <functional>
+#include <vector>
+
 namespace ausaxs::hist {
     class ICompositeDistanceHistogramExv : public ICompositeDistanceHistogram {
         public:
@@ -16,6 +19,55 @@ namespace ausaxs::hist {
             ICompositeDistanceHistogramExv& operator=(ICompositeDistanceHistogramExv&&) noexcept = default;
             virtual ~ICompositeDistanceHistogramExv() = default;
 
+            /**
+             * @brief The free parameters of the model. The default values correspond to an unmodified model.
+             */
+            struct FreeParameters {
+                double cw = 1;               // water density scaling factor
+                double cx = 1;               // excluded volume scaling factor, method-dependent
+                double crho = 1;             // solvent density scaling factor
+                double DW_sigma_atomic = 0;  // atomic form factor debye-waller factor, zero for disabled
+                double DW_sigma_exv = 0;     // excluded volume form factor debye-waller factor, zero for disabled
+            };
+
+            /**
+             * @brief Evaluate the scattering intensity for the given parameters without modifying this object. 
+             *        The intensity is defined on the same axis as debye_transform(), and is identical to calling it after applying the parameters. 
+             *
+             *        The first call may initialize internal caches and is not thread-safe. All subsequent calls are thread-safe,
+             *        as long as the object is not modified in the meantime. 
+             */
+            virtual std::vector<double> evaluate(const FreeParameters& params) const;
+
+            /**
+             * @brief The scattering intensity decomposed into curves which do not depend on the free parameters. 
+             *        With X the excluded volume factor, and Ba and Bx the atomic and excluded volume Debye-Waller factors, the intensity is
+             *
+             *            I = Ba^2*aa + Ba*cw*aw + cw^2*ww
+             *              - Ba*Bx*crho*(ax0 + X*ax1)
+             *              + Bx^2*crho^2*(xx0 + X*xx1 + X^2*xx2)
+             *              - Bx*crho*cw*(wx0 + X*wx1)
+             *
+             *        at each q-value, which reproduces evaluate for all parameters. 
+             */
+            struct IntensityBasis {
+                std::vector<double> q;                                      // the q-values of the curves
+                std::vector<double> aa, aw, ww, ax0, ax1, xx0, xx1, xx2, wx0, wx1;
+                std::function<double(double q, double cx)> exv_factor;      // X as a function of q and cx. If empty, X = 1 regardless of cx.
+            };
+
+            /**
+             * @brief Get the decomposition of the scattering intensity into parameter-independent curves. 
+             *        The curves are defined on the same axis as debye_transform(). 
+             *        The exv_factor of the basis refers to this object, which must outlive it. 
+             */
+            virtual IntensityBasis get_intensity_basis() const;
+
+            /**
+             * @brief Get the free parameters currently applied to this object. 
+             */
+            virtual FreeParameters get_free_parameters() const;
+
             /**
              * @brief Apply a scaling factor to the excluded volume partial distance histogram.
              */
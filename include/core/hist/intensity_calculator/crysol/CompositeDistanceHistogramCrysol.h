@@ -78,7 +78,7 @@ namespace ausaxs::hist {
             double average_displaced_V = 0;
 
         protected:
-            double exv_factor(double q) const override;
+            double exv_factor(double q, const FreeParameters& params) const override;
             void initialize();
 
             inline static form_factor::storage::atomic::table_t ffaa_table;
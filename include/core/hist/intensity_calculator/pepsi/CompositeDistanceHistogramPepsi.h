@@ -29,6 +29,6 @@ namespace ausaxs::hist {
             static double exv_factor(double q, double cx);
 
         protected:
-            double exv_factor(double q) const override;
+            double exv_factor(double q, const FreeParameters& params) const override;
     };
 }
\ No newline at end of file
@@ -15,6 +15,9 @@ namespace ausaxs::hydrate {
      * Although more calculations are involved for each location than the AxesPlacement strategy, the complexity is the same.
      * 
      * The radius r is defined as the sum of @a ra and @a rh.
+     * 
+     * If settings::hydrate::parallel is enabled, the candidate locations are first proposed in parallel, discarding those whose center bins are already occupied.
+     * The collision checks are then made sequentially in the order of the atoms, so the result is the same as without the parallel proposals. 
      */
     class RadialHydration : public GridBasedHydration {
         public:
@@ -24,8 +27,18 @@ namespace ausaxs::hydrate {
 
             std::span<grid::GridMember<data::Water>> generate_explicit_hydration(std::span<grid::GridMember<data::AtomFF>> atoms) override;
 
+            /**
+             * @brief Replace the random noise added to the water locations. 
+             *        The function is called sequentially in the order of the atoms and radial lines, even if the hydration is generated in parallel. 
+             *        Set it to nullptr to restore the default Gaussian noise.
+             */
             static void set_noise_generator(std::function<Vector3<double>()>&& noise_function);
 
+            /**
+             * @brief Seed the default noise. The following hydrations are then reproducible, independent of the number of threads.
+             */
+            static void set_noise_seed(unsigned int seed);
+
             bool global() const override {return false;}
 
         private:
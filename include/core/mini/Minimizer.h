@@ -28,6 +28,12 @@ namespace ausaxs::mini {
              */
             virtual void set_function(std::function<double(std::vector<double>)>&& function);
 
+            /**
+             * @brief Set the gradient of the function to be minimized. 
+             *        Gradient-based minimizers use this instead of approximating the derivatives numerically, while all others ignore it.
+             */
+            void set_gradient(std::function<std::vector<double>(std::vector<double>)>&& gradient);
+
             /**
              * @brief Perform the minimization.
              */
@@ -70,10 +76,34 @@ namespace ausaxs::mini {
              */
             virtual void set_max_evals(unsigned int evals);
 
+            /**
+             * @brief Change whether independent points may be evaluated in parallel on the global thread pool. 
+             *        This is only used where a minimizer knows multiple points in advance, e.g. for the landscape scans. 
+             *
+             *        The function must be thread-safe, and any state it initializes lazily should be prepared before the minimization starts. 
+             *        As a safeguard, the first point of each batch is always evaluated on the calling thread before the remaining points are evaluated concurrently. 
+             *
+             *        The points are evaluated as tasks on the global pool, so a function which itself waits on the global pool will deadlock. 
+             *        This includes anything calling BatchedDebyeTransform::run, and the first evaluation of a CompositeDistanceHistogramFFAvgBase, which fills its sinqd cache on the pool. 
+             *        Use set_evaluation_threads for such functions instead. 
+             */
+            void set_parallel_evaluation(bool setting) noexcept;
+
+            /**
+             * @brief Evaluate independent points concurrently on the given number of dedicated threads instead of the global thread pool. 
+             *        This is meant for expensive functions which are themselves parallelized on the global pool, and thus cannot be evaluated as tasks on it. 
+             *        Each thread waiting on the pool only delays the others, so this is only worthwhile if a single evaluation cannot saturate the pool. 
+             *        A value of 0 or 1 disables this. When enabled, it takes precedence over set_parallel_evaluation. 
+             *
+             *        The same restrictions as for set_parallel_evaluation apply, except that the function may wait on the global pool. 
+             */
+            void set_evaluation_threads(unsigned int threads) noexcept;
+
             double tol = 1e-4;
         protected:
             std::vector<Parameter> parameters;
             std::function<double(std::vector<double>)> function = [] (std::vector<double>) -> double {throw std::runtime_error("Minimizer::function: Function was not initialized.");};
+            std::function<std::vector<double>(std::vector<double>)> gradient;
             mini::Landscape evaluations;
             unsigned int fevals = 0;
             unsigned int max_evals = 100;
@@ -83,19 +113,47 @@ namespace ausaxs::mini {
              */
             void clear_evaluated_points() noexcept;
 
+            /**
+             * @brief Evaluate the function at each of the given points, in parallel if enabled. 
+             *
+             * @param points The points to evaluate. 
+             * @param record Whether to record the evaluations. If false, they can be recorded selectively with record_evaluation.
+             * @return The function values in the same order as the points.
+             */
+            std::vector<double> evaluate_batch(const std::vector<std::vector<double>>& points, bool record = true);
+
+            /**
+             * @brief Record an evaluation performed by evaluate_batch. Nothing is done if evaluations are not being recorded.
+             */
+            void record_evaluation(const std::vector<double>& point, double fval);
+
             /**
              * @brief Check if the function is set.
              */
             [[nodiscard]] bool is_function_set() const noexcept;
 
+            /**
+             * @brief Check if the gradient is set.
+             */
+            [[nodiscard]] bool is_gradient_set() const noexcept;
+
             /**
              * @brief Check if at least one parameter has been provided.
              */
             [[nodiscard]] bool is_parameter_set() const noexcept;
 
+            /**
+             * @brief Get the number of points evaluated in each batch when the points are not known in advance. 
+             *        This is 1 unless parallel evaluation or dedicated evaluation threads are enabled.
+             */
+            [[nodiscard]] unsigned int get_batch_size() const noexcept;
+
         private:
             std::function<double(std::vector<double>)> wrapper;
             std::function<double(std::vector<double>)> raw;
+            bool recording = true;
+            bool parallel = false;
+            unsigned int threads = 0;
 
             /**
              * @brief The minimization function to be defined by subclasses. 
@@ -10,5 +10,6 @@
 #include <settings/PlotSettings.h>
 #include <settings/MoleculeSettings.h>
 #include <settings/RigidBodySettings.h>
+#include <settings/SettingsContext.h>
 #include <settings/SettingsIO.h>
 #include <settings/SettingsValidation.h>
\ No newline at end of file
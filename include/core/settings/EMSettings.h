@@ -14,6 +14,8 @@ namespace ausaxs::settings::em {
     extern Limit alpha_levels;            // The range of alpha-levels to search.
 
     extern bool fixed_weights;            // Whether to use fixed or dynamic weights for the EM algorithm. Fixed weights means that all atoms will have the same weight of 1.
+    extern bool incremental_histogram;    // Whether to update the atomic histogram incrementally when the cutoff changes. Only used with the simple histogram managers without form factors.
+    extern unsigned int scan_threads;     // The number of cutoff values evaluated concurrently when scanning the chi2 landscape. Each keeps its own copy of the generated structure, so the memory use grows accordingly.
     extern bool plot_landscapes;          // Whether to plot the evaluated chi2 points. Produces 2 plots; one of the full landscape and another of the area near the minimum. The number of points is roughly determined by setting::em::evals
 
     namespace simulation {
@@ -9,4 +9,5 @@ namespace ausaxs::settings::fit {
     extern bool fit_hydration;           // Enable fitting of the hydration shell.
     extern bool fit_atomic_debye_waller; // Enable fitting of the atomic form factor debye-waller factor.
     extern bool fit_exv_debye_waller;    // Enable fitting of the excluded volume form factor debye-waller factor.
+    extern bool use_intensity_basis;     // Evaluate the chi2 and its gradient from a precomputed basis of the model intensity whenever the model supports it.
 }
\ No newline at end of file
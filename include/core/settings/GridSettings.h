@@ -22,6 +22,10 @@ namespace ausaxs::settings::grid {
     // This is primarily intended for rigid body optimization, to ensure there's enough space for all possible conformations. A value of 0 means disabled. 
     extern unsigned int min_bins;
 
+    // Whether to store the grid in sparse blocks which are only allocated once they are written to. 
+    // This greatly reduces the memory usage of large grids which are mostly empty, such as for elongated structures or fine cell widths, at a small cost in access time. 
+    extern bool sparse;
+
     // Grid-based excluded volume settings.
     namespace exv {
         // Whether to save the excluded volume grid when using the grid-based excluded volume calculations. This is primarily useful for debugging.
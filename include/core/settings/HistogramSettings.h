@@ -27,4 +27,11 @@ namespace ausaxs::settings::hist {
     };
     extern bool weighted_bins;          // Whether to use weighted p(r) bins or not.
     extern HistogramManagerChoice histogram_manager;
+
+    namespace detail {
+        extern bool spatial_tiling;     // Whether to sort the atoms into spatially compact blocks and evaluate the distances in cache-sized tiles.
+        extern unsigned int tile_size;  // The number of atoms in each tile when spatial tiling is enabled.
+        extern bool soa_kernels;        // Whether to evaluate the distances with runtime-dispatched SIMD kernels on a structure-of-arrays copy of the atoms.
+        extern bool lattice_exv;        // Whether to evaluate the self-correlations of the grid-based excluded volume from FFTs of the occupancy lattice, when this is expected to be faster.
+    }
 }
\ No newline at end of file
@@ -64,5 +64,8 @@ namespace ausaxs::settings {
         // Correction added to the sum of van der Waals radii when calculating the distance to the placed water molecules.
         // By default this is tuned to roughly match MD density profiles. 
         extern double shell_correction;
+
+        // Propose the water locations of the radial hydration in parallel before adding them to the grid. Otherwise each location is checked and added one at a time.
+        extern bool parallel;
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <utility/Type.h>
 #include <utility/UtilityFwd.h>
 
+#include <any>
 #include <vector>
 #include <string>
 #include <memory>
@@ -27,6 +28,26 @@ namespace ausaxs::settings::io::detail {
          */
         virtual std::string get() const = 0;
 
+        /**
+         * @brief Get a copy of the setting value.
+         */
+        virtual std::any value() const = 0;
+
+        /**
+         * @brief Set the setting value from a copy previously obtained with value().
+         */
+        virtual void assign(const std::any& value) = 0;
+
+        /**
+         * @brief Parse a setting value in the same way as set, but return it as a copy instead of modifying the setting.
+         */
+        virtual std::any parse(const std::vector<std::string>& str) const = 0;
+
+        /**
+         * @brief Convert a copy previously obtained with value() or parse() to a string in the same way as get.
+         */
+        virtual std::string to_string(const std::any& value) const = 0;
+
         std::vector<std::string> names; // The name of the setting.
 
         /**
@@ -58,6 +79,11 @@ namespace ausaxs::settings::io::detail {
             throw std::runtime_error("settings::io::detail::SettingRef::get: missing implementation for type \"" + type(settingref) + "\".");
         }
 
+        std::any value() const override {return settingref;}
+        void assign(const std::any& value) override {settingref = std::any_cast<const T&>(value);}
+        std::any parse(const std::vector<std::string>& str) const override {T value{}; SettingRef<T>(value, names).set(str); return value;}
+        std::string to_string(const std::any& value) const override {T copy = std::any_cast<const T&>(value); return SettingRef<T>(copy, names).get();}
+
         T& settingref; // A reference to the setting.
     };
 }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <settings/SettingRef.h>
+#include <utility/Exceptions.h>
+
+#include <any>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ausaxs::settings {
+    /**
+     * @brief Lock the global settings. Contexts are only captured and applied while holding this lock. 
+     *        Code which reads or writes the global settings from another thread than the one running a ScopedContext must also hold it, 
+     *        such that it runs either before or after the scope instead of seeing a mix of configurations. 
+     *        The lock is recursive, so it can also be taken by the thread holding a ScopedContext.
+     */
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> lock_globals();
+
+    /**
+     * @brief A complete configuration, holding a value for every setting registered in the settings file sections.
+     *        A context is a plain value independent of the global settings, so any number of them can be prepared and modified concurrently.
+     *        The global settings act as the default context, and are only changed when a context is applied.
+     *
+     *        Besides the settings, a context also holds the global state of the simple excluded volume model, see hist::detail::SimpleExvModel.
+     */
+    class Context {
+        public:
+            /**
+             * @brief Capture the current values of the global settings.
+             */
+            [[nodiscard]] static Context current();
+
+            /**
+             * @brief Set a setting of this context, using the same names and value format as in the settings file.
+             *        The global settings are not modified.
+             */
+            void set(std::string_view name, const std::vector<std::string>& value);
+
+            /**
+             * @brief Set a setting of this context to the given value. 
+             *        The global settings are not modified.
+             *
+             * @throw except::invalid_argument If the type of @a value does not match the type of the setting.
+             */
+            template<typename T>
+            void set(std::string_view name, T value);
+
+            /**
+             * @brief Get the value of a setting of this context as a string.
+             */
+            [[nodiscard]] std::string get(std::string_view name) const;
+
+            /**
+             * @brief Enable or disable the simple excluded volume model in this context. 
+             *        The global state of hist::detail::SimpleExvModel is not modified.
+             */
+            void set_simple_exv_model(bool enabled);
+
+            /**
+             * @brief Overwrite the global settings with the values of this context.
+             *        Prefer ScopedContext, which also restores the previous values and keeps the global settings locked in the meantime.
+             */
+            void apply() const;
+
+        private:
+            using Value = std::pair<std::shared_ptr<io::detail::ISettingRef>, std::any>;
+            std::vector<Value> values;
+            bool simple_exv_model = false;
+
+            /**
+             * @brief Find the stored value of a setting.
+             *
+             * @throw except::invalid_argument If there is no setting with the given name.
+             */
+            Value& find(std::string_view name);
+            const Value& find(std::string_view name) const; //< @copydoc find
+    };
+
+    /**
+     * @brief Apply a context to the global settings for the lifetime of this object, after which the previous values are restored.
+     *
+     *        All computational code reads the global settings, including the tasks running on the global thread pool, so only one context can be active at a time.
+     *        The lock of lock_globals is therefore held while a context is active. This serializes jobs with different configurations started from different threads: 
+     *        they run one after the other instead of silently reading each other's settings, but never concurrently. Each job can still use the entire thread pool.
+     *        The lock is recursive, so a thread can activate nested contexts.
+     */
+    class ScopedContext {
+        public:
+            ScopedContext(const Context& context);
+            ~ScopedContext();
+
+            ScopedContext(const ScopedContext&) = delete;
+            ScopedContext& operator=(const ScopedContext&) = delete;
+
+        private:
+            std::unique_lock<std::recursive_mutex> lock;
+            Context previous;
+    };
+}
+
+//#########################################//
+//############ IMPLEMENTATION #############//
+//#########################################//
+
+template<typename T>
+inline void ausaxs::settings::Context::set(std::string_view name, T value) {
+    auto& [setting, stored] = find(name);
+    if (stored.type() != typeid(T)) {
+        throw except::invalid_argument("settings::Context::set: Invalid type for setting \"" + std::string(name) + "\".");
+    }
+    stored = std::move(value);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <utility/Exceptions.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <queue>
+
+namespace ausaxs::utility {
+    /**
+     * @brief A thread-safe queue with a maximum size, handing items from producer threads to consumer threads in order.
+     *        Producers block while the queue is full, which keeps them at most a few items ahead of the consumers.
+     */
+    template<typename T>
+    class BoundedQueue {
+        public:
+            /**
+             * @brief Create a new queue holding at most @a capacity items.
+             *
+             * @throws except::invalid_argument if the capacity is zero.
+             */
+            BoundedQueue(unsigned int capacity) : capacity(capacity) {
+                if (capacity == 0) {throw except::invalid_argument("BoundedQueue::BoundedQueue: The capacity must be positive.");}
+            }
+
+            /**
+             * @brief Add an item to the end of the queue, waiting until there is room for it.
+             *
+             * @throws except::bad_order if the queue was closed.
+             */
+            void push(T&& item) {
+                std::unique_lock lock(mutex);
+                not_full.wait(lock, [this] () {return items.size() < capacity || finished;});
+                if (finished) {throw except::bad_order("BoundedQueue::push: Cannot add items to a closed queue.");}
+                items.push(std::move(item));
+                not_empty.notify_one();
+            }
+
+            /**
+             * @brief Get the next item, waiting until one is available.
+             *
+             * @return The next item, or std::nullopt if the queue is closed and all items were consumed.
+             */
+            std::optional<T> pop() {
+                std::unique_lock lock(mutex);
+                not_empty.wait(lock, [this] () {return !items.empty() || finished;});
+                if (items.empty()) {return std::nullopt;}
+                T item = std::move(items.front());
+                items.pop();
+                not_full.notify_one();
+                return item;
+            }
+
+            /**
+             * @brief Signal that no more items will be added. The remaining items can still be consumed.
+             */
+            void close() {
+                std::lock_guard lock(mutex);
+                finished = true;
+                not_empty.notify_all();
+                not_full.notify_all();
+            }
+
+        private:
+            unsigned int capacity;
+            bool finished = false;
+            std::queue<T> items;
+            std::mutex mutex;
+            std::condition_variable not_empty, not_full;
+    };
+}
\ No newline at end of file
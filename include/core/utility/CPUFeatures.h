@@ -0,0 +1,46 @@
+#pragma once
+
+// Functions compiled for a specific instruction set through these attributes may only be called after checking utility::cpu::supports. 
+// This allows the rest of the library to target a baseline architecture while the hot kernels still use the widest registers available.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define AUSAXS_CPU_X86
+    #if defined(__GNUC__)
+        #define AUSAXS_TARGET_SSE41 __attribute__((target("sse4.1")))
+        #define AUSAXS_TARGET_AVX __attribute__((target("avx")))
+        #define AUSAXS_TARGET_AVX512 __attribute__((target("avx512f")))
+    #else
+        #define AUSAXS_TARGET_SSE41
+        #define AUSAXS_TARGET_AVX
+        #define AUSAXS_TARGET_AVX512
+    #endif
+#endif
+
+namespace ausaxs::utility::cpu {
+    /**
+     * @brief The SIMD instruction sets which can be selected at runtime. 
+     *        The values are ordered such that a larger value implies support for all smaller ones. 
+     */
+    enum class InstructionSet {
+        Scalar,     // No SIMD instructions are available.
+        SSE41,      // 128-bit SSE4.1 instructions.
+        AVX,        // 256-bit AVX instructions.
+        AVX2,       // 256-bit AVX2 and FMA instructions.
+        AVX512,     // 512-bit AVX-512F instructions.
+    };
+
+    /**
+     * @brief Get the widest instruction set supported by both the processor and the operating system. 
+     *        The processor is only queried on the first call, after which the result is cached. 
+     */
+    InstructionSet get_instruction_set();
+
+    /**
+     * @brief Check if the given instruction set is supported on this machine. 
+     */
+    bool supports(InstructionSet set);
+
+    /**
+     * @brief Get a human-readable name of the instruction set. 
+     */
+    const char* to_string(InstructionSet set);
+}
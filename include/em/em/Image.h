@@ -9,6 +9,7 @@
 #include <utility/observer_ptr.h>
 
 #include <list>
+#include <vector>
 
 namespace ausaxs::em {
     /**
@@ -34,6 +35,11 @@ namespace ausaxs::em {
 
             std::list<data::EMAtom> generate_atoms(double cutoff) const;
 
+            /**
+             * @brief Append the atoms generated from all pixels within the current bounds with a density of at least @a cutoff to @a atoms. 
+             */
+            void generate_atoms(std::vector<data::EMAtom>& atoms, double cutoff) const;
+
             /**
              * @brief Count the number of voxels larger than a given cutoff value.
              */
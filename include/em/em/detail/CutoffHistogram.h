@@ -0,0 +1,54 @@
+#pragma once
+
+#include <em/detail/EMInternalFwd.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/distribution/GenericDistribution1D.h>
+
+#include <memory>
+
+namespace ausaxs::em::detail {
+    /**
+     * @brief The atomic self-correlation histogram of the atoms of a VoxelIndex above a moving cutoff.
+     *
+     * Since the index is sorted by density, changing the cutoff only adds or removes the contiguous slice of atoms between the old and the new cutoff.
+     * Instead of recalculating the histogram from scratch, only the contributions of this slice are added or subtracted, i.e. its self-correlation and
+     * its cross-correlation with the atoms which are included by both cutoffs. A scan over closely spaced cutoffs is thus much cheaper than a full calculation for each of them.
+     */
+    template<bool weighted_bins>
+    class CutoffHistogram {
+        using GenericDistribution1D_t = typename hist::GenericDistribution1D<weighted_bins>::type;
+        public:
+            /**
+             * @brief Prepare the histogram of the given index. No atoms are included until the first cutoff is set.
+             */
+            CutoffHistogram(std::shared_ptr<const VoxelIndex> index);
+
+            /**
+             * @brief Get the histogram of all atoms with a density of at least @a cutoff.
+             *        The size of the histogram is fixed by the extent of all atoms in the index.
+             */
+            const GenericDistribution1D_t& get_histogram(double cutoff);
+
+            /**
+             * @brief Get the coordinates of the atoms included by the last cutoff.
+             */
+            hist::detail::CompactCoordinates get_coordinates() const;
+
+            /**
+             * @brief Get the index backing this histogram.
+             */
+            const std::shared_ptr<const VoxelIndex>& get_index() const;
+
+        private:
+            std::shared_ptr<const VoxelIndex> index;
+            hist::detail::CompactCoordinates coords;    // The coordinates of all atoms of the index, in the same order.
+            GenericDistribution1D_t p_aa;               // The histogram of the atoms in the range [begin, end).
+            std::size_t begin;                          // The position of the first included atom.
+            unsigned int bins;                          // The number of bins required by all atoms of the index.
+
+            /**
+             * @brief Copy the coordinates in the range [start, end).
+             */
+            hist::detail::CompactCoordinates slice(std::size_t start, std::size_t end) const;
+    };
+}
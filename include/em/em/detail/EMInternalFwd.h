@@ -5,6 +5,8 @@ namespace ausaxs::em {
 
 	namespace detail {
 		struct ExtendedLandscape;
+		class VoxelIndex;
+		template<bool> class CutoffHistogram;
 	}
 }
 
@@ -13,6 +13,8 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace ausaxs::em {
     /**
@@ -142,12 +144,22 @@ namespace ausaxs::em {
              */
             void set_minimum_bounds(double min_val);
 
+            /**
+             * @brief Get the density-sorted index of the voxels, which can be used to look up the atoms of the given cutoff.
+             *        The index is built on first use, and is reused for all larger cutoffs until the bounds, header, or EM settings are changed.
+             *        It is safe to call this concurrently, and the returned index remains valid even if it is replaced in the meantime.
+             */
+            std::shared_ptr<const detail::VoxelIndex> get_voxel_index(double cutoff) const;
+
         private:
             std::unique_ptr<detail::header::IMapHeader> header; // The header of the input file.
             std::unique_ptr<em::managers::ProteinManager> phm;  // The histogram manager. Manages both the backing protein & its scattering curve. 
             std::vector<Image> data;                            // The actual image data. 
             unsigned int size_x, size_y, size_z;                // The number of pixels in each dimension.
             mutable double _rms = 0;                            // The root-mean-square of the map.
+            std::optional<double> minimum_bound;                // The smallest cutoff of interest, as set by set_minimum_bounds.
+            mutable std::shared_ptr<const detail::VoxelIndex> voxel_index; // The density-sorted voxels, built on first use.
+            mutable std::mutex voxel_index_mutex;               // Guards the voxel index.
             
             void read(std::ifstream& istream);
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <em/detail/EMAtom.h>
+
+#include <vector>
+#include <span>
+
+namespace ausaxs::em {
+    class Image;
+
+    namespace detail {
+        /**
+         * @brief A density-sorted index of the voxels of an ImageStack.
+         *
+         * The index contains the atoms generated from all voxels with a density of at least some minimum cutoff, sampled in the same way as for the atom generation.
+         * Since the atoms are sorted by increasing density, the atoms of any larger cutoff form a contiguous slice at the end of the index, which is found by a binary search.
+         */
+        class VoxelIndex {
+            public:
+                /**
+                 * @brief Build the index for the current bounds of the given images.
+                 *
+                 * @param images The images of the stack. Only every settings::em::sample_frequency image is used.
+                 * @param min_cutoff The smallest cutoff which can be looked up in this index.
+                 */
+                VoxelIndex(const std::vector<Image>& images, double min_cutoff);
+
+                /**
+                 * @brief Get the atoms with a density of at least @a cutoff, sorted by increasing density.
+                 */
+                [[nodiscard]] std::span<const data::EMAtom> get_atoms(double cutoff) const;
+
+                /**
+                 * @brief Get the atoms with a density in the range [min, max), sorted by increasing density.
+                 */
+                [[nodiscard]] std::span<const data::EMAtom> get_atoms(double min, double max) const;
+
+                /**
+                 * @brief Get the position of the first atom with a density of at least @a cutoff.
+                 */
+                [[nodiscard]] std::size_t lower_bound(double cutoff) const;
+
+                /**
+                 * @brief Get the smallest cutoff which can be looked up in this index.
+                 */
+                [[nodiscard]] double get_min_cutoff() const noexcept;
+
+                /**
+                 * @brief Check if this index was built with the current sampling and weight settings.
+                 */
+                [[nodiscard]] bool is_current() const noexcept;
+
+                /**
+                 * @brief Get the number of atoms in this index.
+                 */
+                [[nodiscard]] std::size_t size() const noexcept;
+
+            private:
+                std::vector<data::EMAtom> atoms;    // The generated atoms, sorted by increasing density.
+                std::vector<float> densities;       // The densities of the atoms, stored separately to keep the binary searches cache friendly.
+                double min_cutoff;                  // The smallest cutoff which can be looked up.
+                unsigned int sample_frequency;      // The value of settings::em::sample_frequency when the index was built.
+                bool fixed_weights;                 // The value of settings::em::fixed_weights when the index was built.
+        };
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <hist/histogram_manager/IHistogramManager.h>
+#include <em/detail/EMInternalFwd.h>
+#include <data/DataFwd.h>
+#include <utility/observer_ptr.h>
+
+#include <memory>
+
+namespace ausaxs::em::managers {
+    /**
+     * @brief A histogram manager for molecules generated from an ImageStack at some cutoff.
+     *        The cutoff must be updated whenever the atoms of the molecule are regenerated.
+     */
+    class ICutoffHistogramManager : public hist::IHistogramManager {
+        public:
+            virtual ~ICutoffHistogramManager() override = default;
+
+            /**
+             * @brief Set the cutoff the atoms of the molecule were generated from.
+             */
+            virtual void set_cutoff(double cutoff) = 0;
+    };
+
+    /**
+     * @brief A histogram manager which maintains the atomic histogram across cutoff changes.
+     *
+     * Only the contributions of the voxels crossing the threshold are added or subtracted when the cutoff changes.
+     * The hydration shell is regenerated for every cutoff, so its contributions are always calculated from scratch.
+     *
+     * This class does not account for the excluded volume in any way, similar to HistogramManagerMT.
+     */
+    template<bool use_weighted_distribution>
+    class CutoffHistogramManager : public ICutoffHistogramManager {
+        public:
+            CutoffHistogramManager(observer_ptr<const data::Molecule> protein, observer_ptr<const em::ImageStackBase> images);
+            virtual ~CutoffHistogramManager() override;
+
+            void set_cutoff(double cutoff) override;
+
+            /**
+             * @brief Calculate only the total scattering histogram.
+             */
+            std::unique_ptr<hist::DistanceHistogram> calculate() override;
+
+            /**
+             * @brief Calculate all contributions to the scattering histogram.
+             */
+            std::unique_ptr<hist::ICompositeDistanceHistogram> calculate_all() override;
+
+        private:
+            observer_ptr<const data::Molecule> protein;
+            observer_ptr<const em::ImageStackBase> images;
+            std::unique_ptr<detail::CutoffHistogram<use_weighted_distribution>> histogram;
+            double cutoff = 0;
+    };
+}
@@ -4,6 +4,7 @@
 #include <data/DataFwd.h>
 #include <hist/HistFwd.h>
 #include <utility/observer_ptr.h>
+#include <settings/HistogramSettings.h>
 
 #include <memory>
 #include <vector>
@@ -45,9 +46,21 @@ namespace ausaxs::em {
                  */
                 std::vector<double> get_charge_levels() const noexcept;
 
+                /**
+                 * @brief Set the histogram manager used for the generated proteins. 
+                 *        This defaults to the global setting at the time of construction, and is independent of it afterwards.
+                 */
+                void set_histogram_manager(settings::hist::HistogramManagerChoice choice) noexcept;
+
+                /**
+                 * @brief Get the histogram manager used for the generated proteins.
+                 */
+                settings::hist::HistogramManagerChoice get_histogram_manager() const noexcept;
+
             protected:
                 observer_ptr<const em::ImageStackBase> images; 
                 std::vector<double> charge_levels;
+                settings::hist::HistogramManagerChoice histogram_manager;
         };
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <data/DataFwd.h>
 #include <hist/HistFwd.h>
 #include <em/manager/ProteinManager.h>
+#include <em/manager/CutoffHistogramManager.h>
 #include <em/detail/EMAtom.h>
 #include <utility/observer_ptr.h>
 
@@ -14,6 +15,8 @@ namespace ausaxs::em::managers {
      * 
      * This class generates and updates histograms in a smart way. This is done by splitting the 
      * generated atoms into multiple bodies, and then utilizing the smart histogram manager from the Protein. 
+     * If settings::em::incremental_histogram is enabled and a simple histogram manager is selected, the body split is replaced by
+     * a CutoffHistogramManager, which only accounts for the voxels crossing the threshold when the cutoff changes. 
      */
     class SmartProteinManager : public ProteinManager {
         public:
@@ -44,7 +47,7 @@ namespace ausaxs::em::managers {
             std::unique_ptr<data::Molecule> protein;
 
             /**
-             * @brief Generate the atmos for a given cutoff.
+             * @brief Generate the atoms for a given cutoff, sorted by increasing density.
              */
             std::vector<data::EMAtom> generate_atoms(double cutoff) const;
 
@@ -53,17 +56,18 @@ namespace ausaxs::em::managers {
              */
             virtual void update_protein(double cutoff);
 
-            /**
-             * @brief Enable or disable the histogram manager initialization for generated proteins.
-             */
-            void toggle_histogram_manager_init(bool state);
-
         private:
             double previous_cutoff = 0;
+            observer_ptr<ICutoffHistogramManager> cutoff_manager; // The histogram manager of the protein if it is updated incrementally, otherwise nullptr.
 
             /**
              * @brief Generate a new Protein for a given cutoff. 
              */
             std::unique_ptr<data::Molecule> generate_protein(double cutoff) const;
+
+            /**
+             * @brief Generate the body of a single charge level for a given cutoff. 
+             */
+            data::Body generate_body(const em::detail::VoxelIndex& index, double cutoff, unsigned int charge_index) const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+namespace ausaxs::math {
+    /**
+     * @brief Resample values on a fixed grid to a fixed set of new points using a cubic spline. 
+     *        This is equivalent to constructing a CubicSpline for each new set of values and evaluating it at every point, 
+     *        but everything which only depends on the two grids is calculated once during construction. 
+     *
+     *        The spline is linear in the values, and each resampled point is a combination of only the two surrounding values and their spline slopes:
+     *            S(z) = w0*y[i] + w1*y[i+1] + v0*b[i] + v1*b[i+1]
+     *        The slopes b are found from a tridiagonal system whose matrix only depends on the grid, so its factorization is also precomputed.
+     *        Each resampling is thus O(n + m) for n grid points and m new points. 
+     */
+    class CubicSplineResampler {
+        public:
+            CubicSplineResampler() = default;
+
+            /**
+             * @brief Prepare resampling from the grid @a x to the points @a z.
+             *
+             * @param x The grid of the values to be resampled. Must be strictly increasing and contain at least four elements.
+             * @param z The points to resample to. Points outside the grid are extrapolated from the nearest interval.
+             */
+            CubicSplineResampler(const std::vector<double>& x, const std::vector<double>& z);
+
+            /**
+             * @brief Resample the values @a y defined on the grid into @a out. 
+             *        This is thread-safe. 
+             */
+            void resample(const std::vector<double>& y, std::vector<double>& out) const;
+
+            /**
+             * @brief Resample the values @a y defined on the grid. 
+             */
+            [[nodiscard]] std::vector<double> resample(const std::vector<double>& y) const;
+
+            /**
+             * @brief Get the number of grid points.
+             */
+            [[nodiscard]] unsigned int size_grid() const;
+
+            /**
+             * @brief Get the number of resampled points.
+             */
+            [[nodiscard]] unsigned int size() const;
+
+            /**
+             * @brief Get the points this resampler resamples to.
+             */
+            [[nodiscard]] const std::vector<double>& get_points() const;
+
+        private:
+            struct Weights {unsigned int i; double w0, w1, v0, v1;};
+            std::vector<double> points;     // the resampled points
+            std::vector<Weights> weights;   // the interpolation weights of each resampled point
+            std::vector<double> inv_h;      // inverse grid spacings
+            std::vector<double> r;          // ratios of adjacent grid spacings h[i]/h[i+1]
+            std::vector<double> Q;          // upper diagonal of the slope system
+            std::vector<double> inv_D;      // inverse of the eliminated diagonal of the slope system
+    };
+}
@@ -34,6 +34,13 @@ namespace ausaxs::fitter {
 
             observer_ptr<rigidbody::constraints::ConstraintManager> get_constraint_manager(); 
 
+        protected:
+            /**
+             * @brief The constraints are evaluated on the shared molecule, so the chi2 is never evaluated concurrently. 
+             *        The hook is declared by SmartFitter, which is the only fitter extended with constraints. 
+             */
+            [[nodiscard]] bool is_chi2_thread_safe() const override {return false;}
+
         private: 
             std::shared_ptr<rigidbody::constraints::ConstraintManager> constraints = nullptr;
     };
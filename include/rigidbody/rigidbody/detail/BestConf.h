@@ -1,20 +1,15 @@
 #pragma once
 
-#include <data/DataFwd.h>
-#include <grid/GridFwd.h>
-#include <data/atoms/Water.h>
-
-#include <memory>
-#include <vector>
-
 namespace ausaxs::rigidbody::detail {
+    /**
+     * @brief The best configuration found so far. 
+     *        The grid and hydration layer of rejected steps are restored through a grid transaction, so only the score is stored here.
+     */
     struct BestConf {
         BestConf();
-        BestConf(std::shared_ptr<grid::Grid> grid, std::vector<data::Water> waters, double chi2) noexcept;
+        BestConf(double chi2) noexcept;
         ~BestConf();
 
-        std::shared_ptr<grid::Grid> grid;
-        std::vector<data::Water> waters;
         double chi2;	
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,347 @@
+PlotDataset
+  1.00000000e-04   1.29599993e+05   0.00000000e+00 
+  5.09950000e-03   1.29582460e+05   0.00000000e+00 
+  1.00990000e-02   1.29531221e+05   0.00000000e+00 
+  1.50985000e-02   1.29446311e+05   0.00000000e+00 
+  2.00980000e-02   1.29327788e+05   0.00000000e+00 
+  2.50975000e-02   1.29175732e+05   0.00000000e+00 
+  3.00970000e-02   1.28990245e+05   0.00000000e+00 
+  3.50965000e-02   1.28771455e+05   0.00000000e+00 
+  4.00960000e-02   1.28519508e+05   0.00000000e+00 
+  4.50955000e-02   1.28234575e+05   0.00000000e+00 
+  5.00950000e-02   1.27916850e+05   0.00000000e+00 
+  5.50945000e-02   1.27566546e+05   0.00000000e+00 
+  6.00940000e-02   1.27183899e+05   0.00000000e+00 
+  6.50935000e-02   1.26769168e+05   0.00000000e+00 
+  7.00930000e-02   1.26322632e+05   0.00000000e+00 
+  7.50925000e-02   1.25844590e+05   0.00000000e+00 
+  8.00920000e-02   1.25335363e+05   0.00000000e+00 
+  8.50915000e-02   1.24795293e+05   0.00000000e+00 
+  9.00910000e-02   1.24224740e+05   0.00000000e+00 
+  9.50905000e-02   1.23624085e+05   0.00000000e+00 
+  1.00090000e-01   1.22993728e+05   0.00000000e+00 
+  1.05089500e-01   1.22334088e+05   0.00000000e+00 
+  1.10089000e-01   1.21645603e+05   0.00000000e+00 
+  1.15088500e-01   1.20928728e+05   0.00000000e+00 
+  1.20088000e-01   1.20183935e+05   0.00000000e+00 
+  1.25087500e-01   1.19411716e+05   0.00000000e+00 
+  1.30087000e-01   1.18612577e+05   0.00000000e+00 
+  1.35086500e-01   1.17787041e+05   0.00000000e+00 
+  1.40086000e-01   1.16935647e+05   0.00000000e+00 
+  1.45085500e-01   1.16058949e+05   0.00000000e+00 
+  1.50085000e-01   1.15157515e+05   0.00000000e+00 
+  1.55084500e-01   1.14231928e+05   0.00000000e+00 
+  1.60084000e-01   1.13282783e+05   0.00000000e+00 
+  1.65083500e-01   1.12310690e+05   0.00000000e+00 
+  1.70083000e-01   1.11316271e+05   0.00000000e+00 
+  1.75082500e-01   1.10300157e+05   0.00000000e+00 
+  1.80082000e-01   1.09262994e+05   0.00000000e+00 
+  1.85081500e-01   1.08205436e+05   0.00000000e+00 
+  1.90081000e-01   1.07128148e+05   0.00000000e+00 
+  1.95080500e-01   1.06031805e+05   0.00000000e+00 
+  2.00080000e-01   1.04917088e+05   0.00000000e+00 
+  2.05079500e-01   1.03784688e+05   0.00000000e+00 
+  2.10079000e-01   1.02635305e+05   0.00000000e+00 
+  2.15078500e-01   1.01469643e+05   0.00000000e+00 
+  2.20078000e-01   1.00288412e+05   0.00000000e+00 
+  2.25077500e-01   9.90923300e+04   0.00000000e+00 
+  2.30077000e-01   9.78821181e+04   0.00000000e+00 
+  2.35076500e-01   9.66585017e+04   0.00000000e+00 
+  2.40076000e-01   9.54222100e+04   0.00000000e+00 
+  2.45075500e-01   9.41739750e+04   0.00000000e+00 
+  2.50075000e-01   9.29145310e+04   0.00000000e+00 
+  2.55074500e-01   9.16446136e+04   0.00000000e+00 
+  2.60074000e-01   9.03649598e+04   0.00000000e+00 
+  2.65073500e-01   8.90763063e+04   0.00000000e+00 
+  2.70073000e-01   8.77793900e+04   0.00000000e+00 
+  2.75072500e-01   8.64749466e+04   0.00000000e+00 
+  2.80072000e-01   8.51637101e+04   0.00000000e+00 
+  2.85071500e-01   8.38464123e+04   0.00000000e+00 
+  2.90071000e-01   8.25237825e+04   0.00000000e+00 
+  2.95070500e-01   8.11965460e+04   0.00000000e+00 
+  3.00070000e-01   7.98654246e+04   0.00000000e+00 
+  3.05069500e-01   7.85311351e+04   0.00000000e+00 
+  3.10069000e-01   7.71943893e+04   0.00000000e+00 
+  3.15068500e-01   7.58558931e+04   0.00000000e+00 
+  3.20068000e-01   7.45163462e+04   0.00000000e+00 
+  3.25067500e-01   7.31764414e+04   0.00000000e+00 
+  3.30067000e-01   7.18368639e+04   0.00000000e+00 
+  3.35066500e-01   7.04982912e+04   0.00000000e+00 
+  3.40066000e-01   6.91613923e+04   0.00000000e+00 
+  3.45065500e-01   6.78268272e+04   0.00000000e+00 
+  3.50065000e-01   6.64952466e+04   0.00000000e+00 
+  3.55064500e-01   6.51672910e+04   0.00000000e+00 
+  3.60064000e-01   6.38435911e+04   0.00000000e+00 
+  3.65063500e-01   6.25247662e+04   0.00000000e+00 
+  3.70063000e-01   6.12114249e+04   0.00000000e+00 
+  3.75062500e-01   5.99041640e+04   0.00000000e+00 
+  3.80062000e-01   5.86035681e+04   0.00000000e+00 
+  3.85061500e-01   5.73102098e+04   0.00000000e+00 
+  3.90061000e-01   5.60246486e+04   0.00000000e+00 
+  3.95060500e-01   5.47474311e+04   0.00000000e+00 
+  4.00060000e-01   5.34790906e+04   0.00000000e+00 
+  4.05059500e-01   5.22201466e+04   0.00000000e+00 
+  4.10059000e-01   5.09711043e+04   0.00000000e+00 
+  4.15058500e-01   4.97324552e+04   0.00000000e+00 
+  4.20058000e-01   4.85046757e+04   0.00000000e+00 
+  4.25057500e-01   4.72882279e+04   0.00000000e+00 
+  4.30057000e-01   4.60835586e+04   0.00000000e+00 
+  4.35056500e-01   4.48910996e+04   0.00000000e+00 
+  4.40056000e-01   4.37112672e+04   0.00000000e+00 
+  4.45055500e-01   4.25444622e+04   0.00000000e+00 
+  4.50055000e-01   4.13910698e+04   0.00000000e+00 
+  4.55054500e-01   4.02514594e+04   0.00000000e+00 
+  4.60054000e-01   3.91259844e+04   0.00000000e+00 
+  4.65053500e-01   3.80149822e+04   0.00000000e+00 
+  4.70053000e-01   3.69187741e+04   0.00000000e+00 
+  4.75052500e-01   3.58376654e+04   0.00000000e+00 
+  4.80052000e-01   3.47719450e+04   0.00000000e+00 
+  4.85051500e-01   3.37218858e+04   0.00000000e+00 
+  4.90051000e-01   3.26877444e+04   0.00000000e+00 
+
+PlotOptions 
+color k
+marker_style .
+line_style -
+line_width 1
+marker_size 5
+draw_line 1
+draw_errors 0
+draw_markers 0
+logx 1
+logy 1
+title 
+xlabel x
+x2label 
+ylabel y
+zlabel z
+legend 
+normalize 0
+ylimits 0 0
+xlimits 0 0
+zorder 0
+
+PlotDataset
+  1.00000000e-04   1.29599993e+05   0.00000000e+00 
+  5.09950000e-03   1.29582460e+05   0.00000000e+00 
+  1.00990000e-02   1.29531220e+05   0.00000000e+00 
+  1.50985000e-02   1.29446308e+05   0.00000000e+00 
+  2.00980000e-02   1.29327783e+05   0.00000000e+00 
+  2.50975000e-02   1.29175723e+05   0.00000000e+00 
+  3.00970000e-02   1.28990233e+05   0.00000000e+00 
+  3.50965000e-02   1.28771439e+05   0.00000000e+00 
+  4.00960000e-02   1.28519487e+05   0.00000000e+00 
+  4.50955000e-02   1.28234549e+05   0.00000000e+00 
+  5.00950000e-02   1.27916818e+05   0.00000000e+00 
+  5.50945000e-02   1.27566507e+05   0.00000000e+00 
+  6.00940000e-02   1.27183853e+05   0.00000000e+00 
+  6.50935000e-02   1.26769115e+05   0.00000000e+00 
+  7.00930000e-02   1.26322570e+05   0.00000000e+00 
+  7.50925000e-02   1.25844520e+05   0.00000000e+00 
+  8.00920000e-02   1.25335284e+05   0.00000000e+00 
+  8.50915000e-02   1.24795204e+05   0.00000000e+00 
+  9.00910000e-02   1.24224642e+05   0.00000000e+00 
+  9.50905000e-02   1.23623977e+05   0.00000000e+00 
+  1.00090000e-01   1.22993609e+05   0.00000000e+00 
+  1.05089500e-01   1.22333959e+05   0.00000000e+00 
+  1.10089000e-01   1.21645463e+05   0.00000000e+00 
+  1.15088500e-01   1.20928577e+05   0.00000000e+00 
+  1.20088000e-01   1.20183773e+05   0.00000000e+00 
+  1.25087500e-01   1.19411543e+05   0.00000000e+00 
+  1.30087000e-01   1.18612393e+05   0.00000000e+00 
+  1.35086500e-01   1.17786845e+05   0.00000000e+00 
+  1.40086000e-01   1.16935440e+05   0.00000000e+00 
+  1.45085500e-01   1.16058731e+05   0.00000000e+00 
+  1.50085000e-01   1.15157285e+05   0.00000000e+00 
+  1.55084500e-01   1.14231687e+05   0.00000000e+00 
+  1.60084000e-01   1.13282531e+05   0.00000000e+00 
+  1.65083500e-01   1.12310428e+05   0.00000000e+00 
+  1.70083000e-01   1.11315998e+05   0.00000000e+00 
+  1.75082500e-01   1.10299875e+05   0.00000000e+00 
+  1.80082000e-01   1.09262702e+05   0.00000000e+00 
+  1.85081500e-01   1.08205135e+05   0.00000000e+00 
+  1.90081000e-01   1.07127838e+05   0.00000000e+00 
+  1.95080500e-01   1.06031486e+05   0.00000000e+00 
+  2.00080000e-01   1.04916762e+05   0.00000000e+00 
+  2.05079500e-01   1.03784355e+05   0.00000000e+00 
+  2.10079000e-01   1.02634965e+05   0.00000000e+00 
+  2.15078500e-01   1.01469297e+05   0.00000000e+00 
+  2.20078000e-01   1.00288061e+05   0.00000000e+00 
+  2.25077500e-01   9.90919750e+04   0.00000000e+00 
+  2.30077000e-01   9.78817593e+04   0.00000000e+00 
+  2.35076500e-01   9.66581401e+04   0.00000000e+00 
+  2.40076000e-01   9.54218464e+04   0.00000000e+00 
+  2.45075500e-01   9.41736103e+04   0.00000000e+00 
+  2.50075000e-01   9.29141660e+04   0.00000000e+00 
+  2.55074500e-01   9.16442493e+04   0.00000000e+00 
+  2.60074000e-01   9.03645970e+04   0.00000000e+00 
+  2.65073500e-01   8.90759462e+04   0.00000000e+00 
+  2.70073000e-01   8.77790335e+04   0.00000000e+00 
+  2.75072500e-01   8.64745946e+04   0.00000000e+00 
+  2.80072000e-01   8.51633637e+04   0.00000000e+00 
+  2.85071500e-01   8.38460726e+04   0.00000000e+00 
+  2.90071000e-01   8.25234505e+04   0.00000000e+00 
+  2.95070500e-01   8.11962229e+04   0.00000000e+00 
+  3.00070000e-01   7.98651114e+04   0.00000000e+00 
+  3.05069500e-01   7.85308329e+04   0.00000000e+00 
+  3.10069000e-01   7.71940991e+04   0.00000000e+00 
+  3.15068500e-01   7.58556162e+04   0.00000000e+00 
+  3.20068000e-01   7.45160836e+04   0.00000000e+00 
+  3.25067500e-01   7.31761941e+04   0.00000000e+00 
+  3.30067000e-01   7.18366331e+04   0.00000000e+00 
+  3.35066500e-01   7.04980780e+04   0.00000000e+00 
+  3.40066000e-01   6.91611978e+04   0.00000000e+00 
+  3.45065500e-01   6.78266524e+04   0.00000000e+00 
+  3.50065000e-01   6.64950926e+04   0.00000000e+00 
+  3.55064500e-01   6.51671589e+04   0.00000000e+00 
+  3.60064000e-01   6.38434818e+04   0.00000000e+00 
+  3.65063500e-01   6.25246808e+04   0.00000000e+00 
+  3.70063000e-01   6.12113643e+04   0.00000000e+00 
+  3.75062500e-01   5.99041292e+04   0.00000000e+00 
+  3.80062000e-01   5.86035600e+04   0.00000000e+00 
+  3.85061500e-01   5.73102293e+04   0.00000000e+00 
+  3.90061000e-01   5.60246966e+04   0.00000000e+00 
+  3.95060500e-01   5.47475085e+04   0.00000000e+00 
+  4.00060000e-01   5.34791982e+04   0.00000000e+00 
+  4.05059500e-01   5.22202850e+04   0.00000000e+00 
+  4.10059000e-01   5.09712744e+04   0.00000000e+00 
+  4.15058500e-01   4.97326575e+04   0.00000000e+00 
+  4.20058000e-01   4.85049110e+04   0.00000000e+00 
+  4.25057500e-01   4.72884968e+04   0.00000000e+00 
+  4.30057000e-01   4.60838616e+04   0.00000000e+00 
+  4.35056500e-01   4.48914372e+04   0.00000000e+00 
+  4.40056000e-01   4.37116398e+04   0.00000000e+00 
+  4.45055500e-01   4.25448704e+04   0.00000000e+00 
+  4.50055000e-01   4.13915138e+04   0.00000000e+00 
+  4.55054500e-01   4.02519396e+04   0.00000000e+00 
+  4.60054000e-01   3.91265010e+04   0.00000000e+00 
+  4.65053500e-01   3.80155354e+04   0.00000000e+00 
+  4.70053000e-01   3.69193641e+04   0.00000000e+00 
+  4.75052500e-01   3.58382922e+04   0.00000000e+00 
+  4.80052000e-01   3.47726087e+04   0.00000000e+00 
+  4.85051500e-01   3.37225864e+04   0.00000000e+00 
+  4.90051000e-01   3.26884818e+04   0.00000000e+00 
+  4.95050500e-01   3.16705353e+04   0.00000000e+00 
+  5.00050000e-01   3.06689711e+04   0.00000000e+00 
+  5.05049500e-01   2.96839972e+04   0.00000000e+00 
+  5.10049000e-01   2.87158058e+04   0.00000000e+00 
+  5.15048500e-01   2.77645728e+04   0.00000000e+00 
+  5.20048000e-01   2.68304583e+04   0.00000000e+00 
+  5.25047500e-01   2.59136069e+04   0.00000000e+00 
+  5.30047000e-01   2.50141472e+04   0.00000000e+00 
+  5.35046500e-01   2.41321924e+04   0.00000000e+00 
+  5.40046000e-01   2.32678404e+04   0.00000000e+00 
+  5.45045500e-01   2.24211739e+04   0.00000000e+00 
+  5.50045000e-01   2.15922605e+04   0.00000000e+00 
+  5.55044500e-01   2.07811530e+04   0.00000000e+00 
+  5.60044000e-01   1.99878897e+04   0.00000000e+00 
+  5.65043500e-01   1.92124944e+04   0.00000000e+00 
+  5.70043000e-01   1.84549768e+04   0.00000000e+00 
+  5.75042500e-01   1.77153326e+04   0.00000000e+00 
+  5.80042000e-01   1.69935439e+04   0.00000000e+00 
+  5.85041500e-01   1.62895793e+04   0.00000000e+00 
+  5.90041000e-01   1.56033944e+04   0.00000000e+00 
+  5.95040500e-01   1.49349319e+04   0.00000000e+00 
+  6.00040000e-01   1.42841220e+04   0.00000000e+00 
+  6.05039500e-01   1.36508824e+04   0.00000000e+00 
+  6.10039000e-01   1.30351192e+04   0.00000000e+00 
+  6.15038500e-01   1.24367267e+04   0.00000000e+00 
+  6.20038000e-01   1.18555878e+04   0.00000000e+00 
+  6.25037500e-01   1.12915745e+04   0.00000000e+00 
+  6.30037000e-01   1.07445484e+04   0.00000000e+00 
+  6.35036500e-01   1.02143604e+04   0.00000000e+00 
+  6.40036000e-01   9.70085166e+03   0.00000000e+00 
+  6.45035500e-01   9.20385377e+03   0.00000000e+00 
+  6.50035000e-01   8.72318901e+03   0.00000000e+00 
+  6.55034500e-01   8.25867078e+03   0.00000000e+00 
+  6.60034000e-01   7.81010398e+03   0.00000000e+00 
+  6.65033500e-01   7.37728535e+03   0.00000000e+00 
+  6.70033000e-01   6.96000382e+03   0.00000000e+00 
+  6.75032500e-01   6.55804092e+03   0.00000000e+00 
+  6.80032000e-01   6.17117112e+03   0.00000000e+00 
+  6.85031500e-01   5.79916221e+03   0.00000000e+00 
+  6.90031000e-01   5.44177568e+03   0.00000000e+00 
+  6.95030500e-01   5.09876707e+03   0.00000000e+00 
+  7.00030000e-01   4.76988634e+03   0.00000000e+00 
+  7.05029500e-01   4.45487828e+03   0.00000000e+00 
+  7.10029000e-01   4.15348283e+03   0.00000000e+00 
+  7.15028500e-01   3.86543544e+03   0.00000000e+00 
+  7.20028000e-01   3.59046750e+03   0.00000000e+00 
+  7.25027500e-01   3.32830661e+03   0.00000000e+00 
+  7.30027000e-01   3.07867700e+03   0.00000000e+00 
+  7.35026500e-01   2.84129987e+03   0.00000000e+00 
+  7.40026000e-01   2.61589372e+03   0.00000000e+00 
+  7.45025500e-01   2.40217473e+03   0.00000000e+00 
+  7.50025000e-01   2.19985704e+03   0.00000000e+00 
+  7.55024500e-01   2.00865317e+03   0.00000000e+00 
+  7.60024000e-01   1.82827426e+03   0.00000000e+00 
+  7.65023500e-01   1.65843047e+03   0.00000000e+00 
+  7.70023000e-01   1.49883126e+03   0.00000000e+00 
+  7.75022500e-01   1.34918569e+03   0.00000000e+00 
+  7.80022000e-01   1.20920277e+03   0.00000000e+00 
+  7.85021500e-01   1.07859172e+03   0.00000000e+00 
+  7.90021000e-01   9.57062276e+02   0.00000000e+00 
+  7.95020500e-01   8.44324979e+02   0.00000000e+00 
+  8.00020000e-01   7.40091447e+02   0.00000000e+00 
+  8.05019500e-01   6.44074648e+02   0.00000000e+00 
+  8.10019000e-01   5.55989160e+02   0.00000000e+00 
+  8.15018500e-01   4.75551428e+02   0.00000000e+00 
+  8.20018000e-01   4.02480006e+02   0.00000000e+00 
+  8.25017500e-01   3.36495800e+02   0.00000000e+00 
+  8.30017000e-01   2.77322295e+02   0.00000000e+00 
+  8.35016500e-01   2.24685777e+02   0.00000000e+00 
+  8.40016000e-01   1.78315546e+02   0.00000000e+00 
+  8.45015500e-01   1.37944118e+02   0.00000000e+00 
+  8.50015000e-01   1.03307422e+02   0.00000000e+00 
+  8.55014500e-01   7.41449888e+01   0.00000000e+00 
+  8.60014000e-01   5.02001231e+01   0.00000000e+00 
+  8.65013500e-01   3.12200774e+01   0.00000000e+00 
+  8.70013000e-01   1.69562096e+01   0.00000000e+00 
+  8.75012500e-01   7.16413451e+00   0.00000000e+00 
+  8.80012000e-01   1.60386629e+00   0.00000000e+00 
+  8.85011500e-01   3.99516334e-02   0.00000000e+00 
+  8.90011000e-01   2.24159439e+00   0.00000000e+00 
+  8.95010500e-01   7.98277128e+00   0.00000000e+00 
+  9.00010000e-01   1.70423390e+01   0.00000000e+00 
+  9.05009500e-01   2.92041325e+01   0.00000000e+00 
+  9.10009000e-01   4.42570550e+01   0.00000000e+00 
+  9.15008500e-01   6.19951590e+01   0.00000000e+00 
+  9.20008000e-01   8.22177192e+01   0.00000000e+00 
+  9.25007500e-01   1.04729297e+02   0.00000000e+00 
+  9.30007000e-01   1.29339798e+02   0.00000000e+00 
+  9.35006500e-01   1.55864519e+02   0.00000000e+00 
+  9.40006000e-01   1.84124188e+02   0.00000000e+00 
+  9.45005500e-01   2.13944999e+02   0.00000000e+00 
+  9.50005000e-01   2.45158634e+02   0.00000000e+00 
+  9.55004500e-01   2.77602285e+02   0.00000000e+00 
+  9.60004000e-01   3.11118658e+02   0.00000000e+00 
+  9.65003500e-01   3.45555983e+02   0.00000000e+00 
+  9.70003000e-01   3.80768003e+02   0.00000000e+00 
+  9.75002500e-01   4.16613971e+02   0.00000000e+00 
+  9.80002000e-01   4.52958624e+02   0.00000000e+00 
+  9.85001500e-01   4.89672168e+02   0.00000000e+00 
+  9.90001000e-01   5.26630241e+02   0.00000000e+00 
+  9.95000500e-01   5.63713882e+02   0.00000000e+00 
+
+PlotOptions 
+color tab:red
+marker_style .
+line_style -
+line_width 1
+marker_size 5
+draw_line 1
+draw_errors 0
+draw_markers 0
+logx 0
+logy 0
+title 
+xlabel x
+x2label 
+ylabel y
+zlabel z
+legend 
+normalize 0
+ylimits 0 0
+xlimits 0 0
+zorder 0
+
@@ -10,32 +10,46 @@ For more information, please refer to the LICENSE file in the project root.
 #include <data/atoms/Atom.h>
 #include <data/Molecule.h>
 #include <data/Body.h>
-#include <hist/detail/SimpleExvModel.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogram.h>
+#include <hist/distance_calculator/SimpleCalculator.h>
+#include <hist/detail/BatchedDebyeTransform.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/detail/RequiredBins.h>
+#include <table/VectorDebyeTable.h>
+#include <math/Vector3.h>
 #include <utility/Utility.h>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 using namespace ausaxs;
 using namespace ausaxs::data;
 
 void evaluate_sans_debye(double* _q, double* _x, double* _y, double* _z, double* _w, int _nq, int _nc, int* _return_status, double* _return_Iq) {
-    std::cout << "AUSAXS: Started evaluating Debye equation." << std::endl;
     // default state is error since we don't trust the input enough to assume success
     *_return_status = 1;
 
+    // the settings of the caller are only replaced for the duration of this call
+    auto context = settings::Context::current();
+
     // use the multithreaded version of the simple histogram manager
-    settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::HistogramManagerMT;
+    context.set("histogram_manager", settings::hist::HistogramManagerChoice::HistogramManagerMT);
 
     // do not subtract the solvent charge from the atoms
-    hist::detail::SimpleExvModel::disable();
+    context.set_simple_exv_model(false);
 
     // do not subtract the charge of bound hydrogens
-    settings::molecule::implicit_hydrogens = false;
+    context.set("implicit_hydrogens", false);
 
     // use weighted bins for the histogram approach - this dramatically improves the accuracy
-    settings::hist::weighted_bins = true;
+    context.set("weighted_bins", true);
 
     // set qmax as high as it can go. Values beyond this are suppoted, but will recalculate the sinc(x) lookup table at runtime
-    settings::axes::qmax = 1;
+    context.set("qmax", 1.);
+    settings::ScopedContext scope(context);
 
     // convert C input to C++
     std::vector<double> q(_q, _q+_nq);
@@ -73,4 +87,159 @@ void evaluate_sans_debye(double* _q, double* _x, double* _y, double* _z, double*
         _return_Iq[i] =  Iq.y(i) / std::exp(-std::pow(Iq.x(i), 2));
     }
     *_return_status = 0;
+}
+
+namespace {
+    /**
+     * @brief A structure registered through the handle-based interface. 
+     *        The coordinate arrays are owned by the caller, and are only read when the histogram is recalculated.
+     */
+    struct Context {
+        std::mutex mutex;                           // guards all members, and is held for the duration of every call using this context
+        double *x, *y, *z, *w;
+        int n;
+        bool modified = true;
+        hist::detail::CompactCoordinates coords;    // reused between recalculations to avoid reallocations
+        std::vector<double> p;                      // the weighted distance histogram, trimmed to the last non-zero bin
+        std::vector<double> d;                      // the weighted distance axis of p
+    };
+
+    std::mutex registry_mutex;
+    std::unordered_map<int, std::shared_ptr<Context>> registry;
+    int next_handle = 0;
+
+    /**
+     * @brief Get the context of a handle, or nullptr if there is none. 
+     *        The context is shared with the registry, so it remains valid even if the handle is destroyed concurrently.
+     */
+    std::shared_ptr<Context> find_context(int handle) {
+        std::lock_guard lock(registry_mutex);
+        auto it = registry.find(handle);
+        return it == registry.end() ? nullptr : it->second;
+    }
+
+    bool valid_coordinates(double* x, double* y, double* z, double* w, int n) {
+        return x != nullptr && y != nullptr && z != nullptr && w != nullptr && 0 < n;
+    }
+
+    /**
+     * @brief Recalculate the distance histograms of all modified contexts. 
+     *        They are all queued in the same calculator, such that small structures are processed in parallel with each other.
+     */
+    void update_histograms(const std::vector<Context*>& contexts) {
+        std::vector<Context*> modified;
+        std::copy_if(contexts.begin(), contexts.end(), std::back_inserter(modified), [] (Context* c) {return c->modified;});
+        if (modified.empty()) {return;}
+
+        unsigned int bins = 1;
+        for (auto c : modified) {
+            auto& data = c->coords.get_data();
+            data.resize(c->n);
+            for (int i = 0; i < c->n; ++i) {
+                data[i] = hist::detail::CompactCoordinatesData(Vector3<double>(c->x[i], c->y[i], c->z[i]), c->w[i]);
+            }
+            bins = std::max(bins, hist::detail::required_bins(c->coords));
+        }
+
+        // always use weighted bins since they dramatically improve the accuracy at high q
+        hist::distance_calculator::SimpleCalculator<true> calculator(bins);
+        std::vector<int> ids(modified.size());
+        for (unsigned int i = 0; i < modified.size(); ++i) {
+            ids[i] = calculator.enqueue_calculate_self(modified[i]->coords);
+        }
+        auto res = calculator.run();
+
+        for (unsigned int i = 0; i < modified.size(); ++i) {
+            auto c = modified[i];
+            const auto& dist = res.self[ids[i]];
+            c->p = dist.get_content();
+            c->d = dist.get_weighted_axis();
+
+            unsigned int size = c->p.size();
+            while (1 < size && c->p[size-1] == 0) {--size;}
+            c->p.resize(size);
+            c->d.resize(size);
+            c->modified = false;
+        }
+    }
+
+    /**
+     * @brief Evaluate the Debye transform of the histogram of a context at the given q-values.
+     */
+    void transform(const Context& c, const std::vector<double>& q, double* out) {
+        std::fill(out, out+q.size(), 0);
+        table::VectorDebyeTable table(c.d, q);
+        hist::detail::BatchedDebyeTransform transform(&table, 0, q.size());
+        transform.enqueue(c.p.begin(), c.p.end(), out);
+        transform.run();
+    }
+}
+
+int sasview_create_context(double* _x, double* _y, double* _z, double* _w, int _nc, int* _return_status) {
+    if (!valid_coordinates(_x, _y, _z, _w, _nc)) {
+        *_return_status = 2;
+        return -1;
+    }
+
+    auto context = std::make_shared<Context>();
+    context->x = _x; context->y = _y; context->z = _z; context->w = _w; context->n = _nc;
+
+    std::lock_guard lock(registry_mutex);
+    int handle = next_handle++;
+    registry.emplace(handle, std::move(context));
+    *_return_status = 0;
+    return handle;
+}
+
+void sasview_update_coordinates(int _handle, double* _x, double* _y, double* _z, double* _w, int _nc, int* _return_status) {
+    auto context = find_context(_handle);
+    if (context == nullptr) {*_return_status = 1; return;}
+    if (!valid_coordinates(_x, _y, _z, _w, _nc)) {*_return_status = 2; return;}
+
+    std::lock_guard lock(context->mutex);
+    context->x = _x; context->y = _y; context->z = _z; context->w = _w; context->n = _nc;
+    context->modified = true;
+    *_return_status = 0;
+}
+
+void sasview_evaluate(int _handle, double* _q, int _nq, int* _return_status, double* _return_Iq) {
+    sasview_evaluate_many(&_handle, 1, _q, _nq, _return_status, _return_Iq);
+}
+
+void sasview_evaluate_many(int* _handles, int _nh, double* _q, int _nq, int* _return_status, double* _return_Iq) {
+    if (_handles == nullptr || _q == nullptr || _return_Iq == nullptr || _nh <= 0 || _nq <= 0) {*_return_status = 2; return;}
+
+    std::vector<std::shared_ptr<Context>> contexts(_nh);
+    for (int i = 0; i < _nh; ++i) {
+        contexts[i] = find_context(_handles[i]);
+        if (contexts[i] == nullptr) {*_return_status = 1; return;}
+    }
+
+    // lock each distinct context once, always in the same order such that overlapping calls cannot deadlock
+    std::vector<Context*> unique(_nh);
+    std::transform(contexts.begin(), contexts.end(), unique.begin(), [] (const auto& c) {return c.get();});
+    std::sort(unique.begin(), unique.end(), std::less<Context*>());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(unique.size());
+    for (auto c : unique) {locks.emplace_back(c->mutex);}
+
+    try {
+        // the calculations run on the global pool and read the global settings, so they must not overlap with a settings::ScopedContext
+        auto settings_lock = settings::lock_globals();
+        update_histograms(unique);
+        std::vector<double> q(_q, _q+_nq);
+        for (int i = 0; i < _nh; ++i) {
+            transform(*contexts[i], q, _return_Iq + static_cast<std::size_t>(i)*_nq);
+        }
+    } catch (const std::exception&) {
+        *_return_status = 3;
+        return;
+    }
+    *_return_status = 0;
+}
+
+void sasview_destroy_context(int _handle) {
+    std::lock_guard lock(registry_mutex);
+    registry.erase(_handle);
 }
\ No newline at end of file
@@ -192,7 +192,8 @@ double Molecule::get_volume_exv(double d) const {
             return fraser_helper()*CompositeDistanceHistogramFoXS::exv_factor(0, d);
         }
 
-        case settings::hist::HistogramManagerChoice::HistogramManagerMTFFGrid: {
+        case settings::hist::HistogramManagerChoice::HistogramManagerMTFFGrid:
+        case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFGrid: {
             // note: not equivalent to grid volume! 
             // the grid can be finer than the resolution of the excluded volume, in which case every Nth bin is used
             unsigned int exv_atoms = get_grid()->generate_excluded_volume(false).interior.size();
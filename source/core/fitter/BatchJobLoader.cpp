@@ -0,0 +1,61 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0. 
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <fitter/BatchJobLoader.h>
+#include <data/Molecule.h>
+#include <dataset/SimpleDataset.h>
+#include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
+#include <settings/Flags.h>
+#include <constants/Constants.h>
+#include <io/ExistingFile.h>
+#include <utility/Exceptions.h>
+
+#include <sstream>
+
+using namespace ausaxs;
+using namespace ausaxs::fitter;
+
+BatchJob::BatchJob() = default;
+BatchJob::BatchJob(BatchJob&&) noexcept = default;
+BatchJob& BatchJob::operator=(BatchJob&&) noexcept = default;
+BatchJob::~BatchJob() = default;
+
+void fitter::load_batch_jobs(std::istream& manifest, utility::BoundedQueue<BatchJob>& queue) {
+    // the consumers must always be released, even if reading the manifest itself fails
+    try {
+        std::string line;
+        unsigned int line_number = 0;
+        while (std::getline(manifest, line)) {
+            ++line_number;
+            std::istringstream tokens(line);
+            std::string structure, measurement;
+            if (!(tokens >> structure) || structure.starts_with('#')) {continue;}
+
+            BatchJob job;
+            job.line = line_number;
+            job.structure = structure;
+            try {
+                if (!(tokens >> measurement)) {throw except::invalid_argument("Expected both a structure and a measurement file.");}
+                job.measurement = measurement;
+                io::ExistingFile structure_file(structure), measurement_file(measurement);
+                if (!constants::filetypes::structure.check(structure_file)) {throw except::invalid_argument("Unknown structure extension: " + structure);}
+                if (!constants::filetypes::saxs_data.check(measurement_file)) {throw except::invalid_argument("Unknown SAXS data extension: " + measurement);}
+
+                job.protein = std::make_unique<data::Molecule>(structure_file);
+                job.data = std::make_unique<SimpleDataset>(measurement_file);
+                if (settings::flags::data_rebin) {job.data->rebin();}
+            } catch (const std::exception& e) {
+                job.protein = nullptr;
+                job.data = nullptr;
+                job.error = e.what();
+            }
+            queue.push(std::move(job));
+        }
+    } catch (...) {
+        queue.close();
+        throw;
+    }
+    queue.close();
+}
\ No newline at end of file
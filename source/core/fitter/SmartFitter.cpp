@@ -5,14 +5,18 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <fitter/SmartFitter.h>
 #include <fitter/FitResult.h>
+#include <fitter/detail/BasisChi2.h>
 #include <hist/intensity_calculator/ICompositeDistanceHistogramExv.h>
 #include <dataset/SimpleDataset.h>
-#include <math/CubicSpline.h>
 #include <mini/All.h>
 #include <settings/FitSettings.h>
 #include <constants/ConstantsFitParameters.h>
+#include <utility/Exceptions.h>
+#include <utility/MultiThreading.h>
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
 
 using namespace ausaxs;
 using namespace ausaxs::fitter;
@@ -30,7 +34,9 @@ SmartFitter::~SmartFitter() = default;
 SmartFitter::SmartFitter(SmartFitter&&) noexcept = default;
 SmartFitter& SmartFitter::operator=(SmartFitter&&) noexcept = default;
 
-SmartFitter::SmartFitter(const SimpleDataset& data) : data(data) {}
+SmartFitter::SmartFitter(const SimpleDataset& data) : data(data) {
+    prepare_data();
+}
 
 SmartFitter::SmartFitter(const SimpleDataset& saxs, std::unique_ptr<hist::DistanceHistogram> h) : SmartFitter(saxs) {
     set_model(std::move(h));
@@ -57,6 +63,75 @@ observer_ptr<hist::ICompositeDistanceHistogram> cast_h(observer_ptr<hist::Distan
     return static_cast<hist::ICompositeDistanceHistogram*>(hist);
 }
 
+hist::ICompositeDistanceHistogramExv::FreeParameters to_free_parameters(observer_ptr<hist::DistanceHistogram> hist, const std::vector<double>& params) {
+    assert(
+        params.size() == get_number_of_enabled_pars()
+        && "SmartFitter::to_free_parameters: Invalid number of parameters."
+    );
+
+    // parameters which are not fitted keep the values currently applied to the model
+    auto p = cast_exv(hist)->get_free_parameters();
+    int index = 0;
+    if (settings::fit::fit_hydration)           {p.cw = params[index++];}
+    if (settings::fit::fit_excluded_volume)     {p.cx = params[index++];}
+    if (settings::fit::fit_solvent_density)     {p.crho = params[index++];}
+    if (settings::fit::fit_atomic_debye_waller) {p.DW_sigma_atomic = params[index++];}
+    if (settings::fit::fit_exv_debye_waller)    {p.DW_sigma_exv = params[index++];}
+    return p;
+}
+
+std::vector<double> from_free_parameters(const hist::ICompositeDistanceHistogramExv::FreeParameters& p) {
+    std::vector<double> params;
+    if (settings::fit::fit_hydration)           {params.push_back(p.cw);}
+    if (settings::fit::fit_excluded_volume)     {params.push_back(p.cx);}
+    if (settings::fit::fit_solvent_density)     {params.push_back(p.crho);}
+    if (settings::fit::fit_atomic_debye_waller) {params.push_back(p.DW_sigma_atomic);}
+    if (settings::fit::fit_exv_debye_waller)    {params.push_back(p.DW_sigma_exv);}
+    return params;
+}
+
+/**
+ * @brief Get the intensity basis of a model, or nullptr if this is disabled in the settings or not supported by the model. 
+ */
+std::unique_ptr<hist::ICompositeDistanceHistogramExv::IntensityBasis> get_intensity_basis(observer_ptr<hist::DistanceHistogram> model) {
+    if (!settings::fit::use_intensity_basis) {return nullptr;}
+
+    auto h = dynamic_cast<hist::ICompositeDistanceHistogramExv*>(model);
+    if (h == nullptr) {return nullptr;}
+
+    std::unique_ptr<hist::ICompositeDistanceHistogramExv::IntensityBasis> basis;
+    try {
+        basis = std::make_unique<hist::ICompositeDistanceHistogramExv::IntensityBasis>(h->get_intensity_basis());
+    } catch (const except::not_implemented&) {
+        return nullptr;
+    }
+
+    // the excluded volume of some models can only be scaled by recalculating their histograms
+    if (settings::fit::fit_excluded_volume && !basis->exv_factor) {return nullptr;}
+    return basis;
+}
+
+/**
+ * @brief Collect the result of a fit, with the data curves described by the linear fit of the optimal model intensity. 
+ */
+std::unique_ptr<FitResult> make_fit_result(const mini::Result& res, fitter::detail::LinearLeastSquares& linear_fitter, const SimpleDataset& data, mini::Landscape&& evaluated_points) {
+    auto linear_fit = linear_fitter.fit();
+
+    // the intensity basis is resampled before it is combined, so the two only agree to within the rounding errors
+    assert(std::abs(linear_fit->fval - res.fval) < 1e-6*std::max(1., res.fval) && "SmartFitter::fit: Linear fit and minimizer results do not match.");
+    auto fit_result = std::make_unique<FitResult>(res, res.fval, data.size() - get_number_of_enabled_pars()); // start with the fit performed here
+    fit_result->add_fit(linear_fit.get(), true);                               // add the a,b inner fit
+    fit_result->set_data_curves(
+        data.x(),                                                              // q
+        data.y(),                                                              // I
+        data.yerr(),                                                           // I_err
+        linear_fitter.get_model_curve(linear_fit->get_parameter_values()),     // I_fit
+        linear_fitter.get_residuals(linear_fit->get_parameter_values())        // residuals
+    );
+    fit_result->evaluated_points = std::move(evaluated_points);                // add the evaluated points
+    return fit_result;
+}
+
 std::vector<mini::Parameter> SmartFitter::get_default_guess() const {
     std::vector<mini::Parameter> guess;
     if (settings::fit::fit_hydration) {
@@ -81,10 +156,10 @@ std::vector<mini::Parameter> SmartFitter::get_default_guess() const {
     return guess;
 }
 
-fitter::detail::LinearLeastSquares SmartFitter::prepare_linear_fitter(const std::vector<double>& params) {
+void SmartFitter::apply_params(const std::vector<double>& params) {
     assert(
         params.size() == get_number_of_enabled_pars()
-        && "SmartFitter::get_model_curve: Invalid number of parameters."
+        && "SmartFitter::apply_params: Invalid number of parameters."
     );
 
     int index = 0;
@@ -93,49 +168,149 @@ fitter::detail::LinearLeastSquares SmartFitter::prepare_linear_fitter(const std:
     if (settings::fit::fit_solvent_density)     {cast_exv(model.get())->apply_solvent_density_scaling_factor(params[index++]);}
     if (settings::fit::fit_atomic_debye_waller) {cast_exv(model.get())->apply_atomic_debye_waller_factor(params[index++]);}
     if (settings::fit::fit_exv_debye_waller)    {cast_exv(model.get())->apply_exv_debye_waller_factor(params[index++]);}
+}
+
+fitter::detail::LinearLeastSquares SmartFitter::prepare_linear_fitter(const std::vector<double>& params) {
+    apply_params(params);
     return detail::LinearLeastSquares(splice(model->debye_transform().get_counts()), data.y(), data.yerr());
 }
 
+void SmartFitter::prepare_basis() {
+    auto intensity_basis = get_intensity_basis(model.get());
+    basis = intensity_basis ? std::make_unique<detail::BasisChi2>(*intensity_basis, data) : nullptr;
+}
+
+double SmartFitter::chi2(const std::vector<double>& params) {
+    if (basis) {return basis->chi2(to_free_parameters(model.get(), params));}
+
+    apply_params(params);
+    return detail::LinearLeastSquares::optimal_chi2(splice(model->debye_transform().get_counts()), data.y(), inv_sigma);
+}
+
+std::vector<double> SmartFitter::chi2_gradient(const std::vector<double>& params) const {
+    if (!basis) {throw except::bad_order("SmartFitter::chi2_gradient: The gradient is only available during a fit using the intensity basis.");}
+
+    hist::ICompositeDistanceHistogramExv::FreeParameters g;
+    [[maybe_unused]] double chi2 = basis->chi2(to_free_parameters(model.get(), params), g);
+    return from_free_parameters(g);
+}
+
 std::unique_ptr<FitResult> SmartFitter::fit() {
     validate_model(model.get());
     if (guess.empty()) {guess = get_default_guess();}
+    prepare_data();
+    // the basis is only valid during this fit, so it is released when leaving this scope, also if the minimization throws
+    struct ReleaseBasis {
+        SmartFitter& fitter;
+        ~ReleaseBasis() {fitter.basis = nullptr;}
+    } release{*this};
+    prepare_basis();
 
     auto f = std::bind(&SmartFitter::chi2, this, std::placeholders::_1);
     auto mini = mini::create_minimizer(algorithm, std::move(f), guess);
+    if (basis) {mini->set_gradient(std::bind(&SmartFitter::chi2_gradient, this, std::placeholders::_1));}
+    mini->set_parallel_evaluation(is_chi2_thread_safe());
     auto res = mini->minimize();
 
     auto linear_fitter = prepare_linear_fitter(res.get_parameter_values());
-    auto linear_fit = linear_fitter.fit();
+    return make_fit_result(res, linear_fitter, data, mini->get_evaluated_points());
+}
 
-    assert(std::abs(linear_fit->fval - res.fval) < 1e-6 && "SmartFitter::fit: Linear fit and minimizer results do not match.");
-    auto fit_result = std::make_unique<FitResult>(res, res.fval, dof()+2);     // start with the fit performed here
-    fit_result->add_fit(linear_fit.get(), true);                               // add the a,b inner fit
-    fit_result->set_data_curves(
-        data.x(),                                                              // q
-        data.y(),                                                              // I
-        data.yerr(),                                                           // I_err
-        linear_fitter.get_model_curve(linear_fit->get_parameter_values()),     // I_fit
-        linear_fitter.get_residuals(linear_fit->get_parameter_values())        // residuals
+bool SmartFitter::is_chi2_thread_safe() const {
+    return basis != nullptr;
+}
+
+std::unique_ptr<FitResult> SmartFitter::fit_basis(const detail::BasisChi2& chi2, const SimpleDataset& data) const {
+    // this runs as a task on the global pool, so the evaluations must not be parallelized on it as well
+    auto mini = mini::create_minimizer(
+        algorithm, 
+        [this, &chi2] (std::vector<double> params) {return chi2.chi2(to_free_parameters(model.get(), params));}, 
+        guess.empty() ? get_default_guess() : guess
     );
-    fit_result->evaluated_points = mini->get_evaluated_points();               // add the evaluated points
-    return fit_result;
+    mini->set_gradient([this, &chi2] (std::vector<double> params) {
+        hist::ICompositeDistanceHistogramExv::FreeParameters g;
+        [[maybe_unused]] double val = chi2.chi2(to_free_parameters(model.get(), params), g);
+        return from_free_parameters(g);
+    });
+    auto res = mini->minimize();
+
+    detail::LinearLeastSquares linear_fitter(chi2.intensity(to_free_parameters(model.get(), res.get_parameter_values())), data.y(), data.yerr());
+    return make_fit_result(res, linear_fitter, data, mini->get_evaluated_points());
+}
+
+std::vector<std::unique_ptr<FitResult>> SmartFitter::fit(const std::vector<SimpleDataset>& datasets) {
+    validate_model(model.get());
+    if (guess.empty()) {guess = get_default_guess();}
+    std::vector<std::unique_ptr<FitResult>> results(datasets.size());
+
+    auto intensity_basis = get_intensity_basis(model.get());
+    if (!intensity_basis) {
+        // every evaluation modifies the model, so the datasets must be fitted one at a time
+        // the histogram and its cached sinc tables are still shared between all of them
+        // the original data is restored when leaving this scope, also if one of the fits throws
+        struct RestoreData {
+            SmartFitter& fitter;
+            SimpleDataset original;
+            ~RestoreData() {
+                fitter.data = std::move(original);
+                fitter.prepare_data();
+            }
+        } restore{*this, std::move(data)};
+
+        for (unsigned int i = 0; i < datasets.size(); ++i) {
+            data = datasets[i];
+            results[i] = fit();
+        }
+        return results;
+    }
+
+    // the fits only read the shared basis, so they are independent of each other
+    // exceptions cannot propagate out of the pool tasks, so they are collected and rethrown after all fits are done
+    auto pool = utility::multi_threading::get_global_pool();
+    std::vector<std::exception_ptr> errors(datasets.size());
+    for (unsigned int i = 0; i < datasets.size(); ++i) {
+        pool->detach_task([this, &datasets, &intensity_basis, &results, &errors, i] () {
+            try {
+                results[i] = fit_basis(detail::BasisChi2(*intensity_basis, datasets[i]), datasets[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    pool->wait();
+    for (auto& error : errors) {
+        if (error) {std::rethrow_exception(error);}
+    }
+    return results;
 }
 
 std::vector<double> SmartFitter::fit_params_only() {
     validate_model(model.get());
     if (guess.empty()) {guess = get_default_guess();}
 
+    prepare_data();
+    // the basis is only valid during this fit, so it is released when leaving this scope, also if the minimization throws
+    struct ReleaseBasis {
+        SmartFitter& fitter;
+        ~ReleaseBasis() {fitter.basis = nullptr;}
+    } release{*this};
+    prepare_basis();
+
     std::function<double(std::vector<double>)> f = std::bind(&SmartFitter::chi2, this, std::placeholders::_1);
     auto mini = mini::create_minimizer(algorithm, std::move(f), guess);
+    if (basis) {mini->set_gradient(std::bind(&SmartFitter::chi2_gradient, this, std::placeholders::_1));}
+    mini->set_parallel_evaluation(is_chi2_thread_safe());
     return mini->minimize().get_parameter_values();
 }
 
 std::vector<double> SmartFitter::get_residuals(const std::vector<double>& params) {
+    prepare_data();
     auto fitter = prepare_linear_fitter(params);
     return fitter.get_residuals();
 }
 
 std::vector<double> SmartFitter::get_model_curve(const std::vector<double>& params) {
+    prepare_data();
     auto fitter = prepare_linear_fitter(params);
     return fitter.get_model_curve();
 }
@@ -189,13 +364,23 @@ void SmartFitter::set_guess(std::vector<mini::Parameter>&& guess) {
 
 void SmartFitter::set_model(std::unique_ptr<hist::DistanceHistogram> h) {
     model = std::move(h);
+    basis = nullptr;
+    prepare_data();
 }
 
-std::vector<double> SmartFitter::splice(const std::vector<double>& ym) const {
-    std::vector<double> Im(data.size()); // spliced model values
-    math::CubicSpline s(model->get_q_axis(), ym);
-    for (unsigned int i = 0; i < data.size(); ++i) {
-        Im[i] = s.spline(data.x(i));
+void SmartFitter::prepare_data() {
+    inv_sigma.resize(data.size());
+    std::transform(data.yerr().begin(), data.yerr().end(), inv_sigma.begin(), [] (double sigma) {return 1./sigma;});
+
+    // the q-axes rarely change, so the resampling operator is only reconstructed if they do
+    if (!model) {return;}
+    const auto& q = model->get_q_axis();
+    if (resampler.size_grid() != q.size() || !std::equal(resampler.get_points().begin(), resampler.get_points().end(), data.x().begin(), data.x().end())) {
+        resampler = math::CubicSplineResampler(q, data.x());
     }
-    return Im;
+}
+
+std::vector<double> SmartFitter::splice(const std::vector<double>& ym) const {
+    assert(resampler.size_grid() == ym.size() && "SmartFitter::splice: The resampler was not prepared for this model.");
+    return resampler.resample(ym);
 }
\ No newline at end of file
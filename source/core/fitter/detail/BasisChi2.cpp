@@ -0,0 +1,124 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <fitter/detail/BasisChi2.h>
+#include <dataset/SimpleDataset.h>
+#include <math/CubicSplineResampler.h>
+
+#include <array>
+#include <cmath>
+#include <cassert>
+
+using namespace ausaxs;
+using namespace ausaxs::fitter::detail;
+
+BasisChi2::BasisChi2(const hist::ICompositeDistanceHistogramExv::IntensityBasis& basis, const SimpleDataset& data) : exv_factor(basis.exv_factor) {
+    math::CubicSplineResampler resampler(basis.q, data.x());
+    auto aa = resampler.resample(basis.aa), aw = resampler.resample(basis.aw), ww = resampler.resample(basis.ww);
+    auto ax0 = resampler.resample(basis.ax0), ax1 = resampler.resample(basis.ax1);
+    auto xx0 = resampler.resample(basis.xx0), xx1 = resampler.resample(basis.xx1), xx2 = resampler.resample(basis.xx2);
+    auto wx0 = resampler.resample(basis.wx0), wx1 = resampler.resample(basis.wx1);
+
+    points.resize(data.size());
+    for (unsigned int i = 0; i < data.size(); ++i) {
+        points[i] = {
+            data.x(i), data.y(i), 1./(data.yerr(i)*data.yerr(i)),
+            aa[i], aw[i], ww[i], ax0[i], ax1[i], xx0[i], xx1[i], xx2[i], wx0[i], wx1[i]
+        };
+    }
+}
+
+double BasisChi2::chi2(const FreeParameters& params) const {
+    return evaluate<false>(params, nullptr);
+}
+
+double BasisChi2::chi2(const FreeParameters& params, FreeParameters& gradient) const {
+    return evaluate<true>(params, &gradient);
+}
+
+bool BasisChi2::has_exv_factor() const noexcept {
+    return static_cast<bool>(exv_factor);
+}
+
+std::vector<double> BasisChi2::intensity(const FreeParameters& params) const {
+    std::vector<double> I(points.size());
+    std::array<double, 5> dI;
+    for (unsigned int i = 0; i < points.size(); ++i) {
+        I[i] = intensity<false>(points[i], params, dI);
+    }
+    return I;
+}
+
+template<bool derivatives>
+double BasisChi2::intensity(const Point& pt, const FreeParameters& p, std::array<double, 5>& dI) const {
+    double q2 = pt.q*pt.q;
+
+    // same Debye-Waller factors as CompositeDistanceHistogramFFAvgBase
+    double Ba = p.DW_sigma_atomic == 0 ? 1 : std::exp(-q2*p.DW_sigma_atomic*p.DW_sigma_atomic*0.5);
+    double Bx = p.DW_sigma_exv == 0 ? 1 : std::exp(-q2*p.DW_sigma_exv*p.DW_sigma_exv*0.5);
+    double X = exv_factor ? exv_factor(pt.q, p.cx) : 1;
+
+    double AX = pt.ax0 + X*pt.ax1;
+    double XX = pt.xx0 + X*(pt.xx1 + X*pt.xx2);
+    double WX = pt.wx0 + X*pt.wx1;
+    double I = Ba*(Ba*pt.aa + p.cw*pt.aw) + p.cw*p.cw*pt.ww - Ba*Bx*p.crho*AX + Bx*Bx*p.crho*p.crho*XX - Bx*p.crho*p.cw*WX;
+
+    if constexpr (derivatives) {
+        // the exv factor is only available as a function, so it is differentiated numerically
+        constexpr double h = 1e-6;
+        double dX = exv_factor ? (exv_factor(pt.q, p.cx+h) - exv_factor(pt.q, p.cx-h))/(2*h) : 0;
+        dI[0] = Ba*pt.aw + 2*p.cw*pt.ww - Bx*p.crho*WX;
+        dI[1] = dX*Bx*p.crho*(-Ba*pt.ax1 + Bx*p.crho*(pt.xx1 + 2*X*pt.xx2) - p.cw*pt.wx1);
+        dI[2] = Bx*(-Ba*AX + 2*Bx*p.crho*XX - p.cw*WX);
+        dI[3] = -q2*p.DW_sigma_atomic*Ba*(2*Ba*pt.aa + p.cw*pt.aw - Bx*p.crho*AX);
+        dI[4] = -q2*p.DW_sigma_exv*Bx*(-Ba*p.crho*AX + 2*Bx*p.crho*p.crho*XX - p.crho*p.cw*WX);
+    }
+    return I;
+}
+
+template<bool gradient>
+double BasisChi2::evaluate(const FreeParameters& p, FreeParameters* grad) const {
+    assert((!gradient || grad != nullptr) && "BasisChi2::evaluate: No gradient output was given.");
+
+    // the sums of the linear fit y = a*I + b, and for each parameter k the sums of w*y*dI_k, w*I*dI_k, and w*dI_k
+    // the parameters are indexed in the order (cw, cx, crho, DW_sigma_atomic, DW_sigma_exv)
+    double S = 0, Sx = 0, Sy = 0, Sxx = 0, Sxy = 0;
+    std::array<double, 5> dI{}, Gy{}, GI{}, G1{};
+    for (const auto& pt : points) {
+        double I = intensity<gradient>(pt, p, dI);
+        S += pt.w;
+        Sx += I*pt.w;
+        Sy += pt.y*pt.w;
+        Sxx += I*I*pt.w;
+        Sxy += I*pt.y*pt.w;
+        if constexpr (gradient) {
+            for (unsigned int k = 0; k < 5; ++k) {
+                Gy[k] += pt.w*pt.y*dI[k];
+                GI[k] += pt.w*I*dI[k];
+                G1[k] += pt.w*dI[k];
+            }
+        }
+    }
+
+    double delta = S*Sxx - Sx*Sx;
+    double a = (S*Sxy - Sx*Sy)/delta;
+    double b = (Sxx*Sy - Sx*Sxy)/delta;
+
+    // the residuals are recalculated instead of using the sums directly to avoid cancellation errors
+    double chi2 = 0;
+    for (const auto& pt : points) {
+        double r = pt.y - (a*intensity<false>(pt, p, dI) + b);
+        chi2 += r*r*pt.w;
+    }
+
+    // since a and b are optimal, the chi2 is stationary with respect to them, and only the explicit dependence on I remains:
+    //   dchi2/dp = -2a*sum(w*(y - a*I - b)*dI/dp)
+    if constexpr (gradient) {
+        std::array<double, 5> g;
+        for (unsigned int k = 0; k < 5; ++k) {g[k] = -2*a*(Gy[k] - a*GI[k] - b*G1[k]);}
+        *grad = {.cw=g[0], .cx=g[1], .crho=g[2], .DW_sigma_atomic=g[3], .DW_sigma_exv=g[4]};
+    }
+    return chi2;
+}
@@ -24,6 +24,11 @@ LinearLeastSquares::LinearLeastSquares(const std::vector<double> data, const std
 }
 
 std::vector<double> LinearLeastSquares::fit_params_only() {
+    return optimal_params(data, model, inv_sigma);
+}
+
+std::vector<double> LinearLeastSquares::optimal_params(const std::vector<double>& data, const std::vector<double>& model, const std::vector<double>& inv_sigma) {
+    assert(data.size() == model.size() && data.size() == inv_sigma.size() && "LinearLeastSquares::optimal_params: Data, model, and errors must have the same size.");
     double S = 0, Sx = 0, Sy = 0, Sxx = 0, Sxy = 0;
     for (unsigned i = 0; i < data.size(); ++i) {
         double inv_sig2 = inv_sigma[i]*inv_sigma[i];
@@ -42,6 +47,16 @@ std::vector<double> LinearLeastSquares::fit_params_only() {
     return {a, b, a_err, b_err};
 }
 
+double LinearLeastSquares::optimal_chi2(const std::vector<double>& data, const std::vector<double>& model, const std::vector<double>& inv_sigma) {
+    auto p = optimal_params(data, model, inv_sigma);
+    double chi2 = 0;
+    for (unsigned int i = 0; i < data.size(); ++i) {
+        double r = (model[i] - (p[0]*data[i] + p[1]))*inv_sigma[i];
+        chi2 += r*r;
+    }
+    return chi2;
+}
+
 std::unique_ptr<ausaxs::fitter::FitResult> LinearLeastSquares::fit() {
     auto p = fit_params_only();
 
@@ -6,18 +6,126 @@ For more information, please refer to the LICENSE file in the project root.
 #include <grid/Grid.h>
 #include <grid/detail/GridMember.h>
 #include <grid/detail/GridSurfaceDetection.h>
+#include <grid/detail/SphereStencil.h>
 #include <data/Molecule.h>
 #include <data/Body.h>
 #include <settings/GridSettings.h>
 #include <settings/GeneralSettings.h>
 #include <utility/Console.h>
+#include <utility/MultiThreading.h>
+#include <utility/observer_ptr.h>
 #include <constants/Constants.h>
 #include <io/ExistingFile.h>
 
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <cassert>
+
 using namespace ausaxs;
 using namespace ausaxs::grid;
 using namespace ausaxs::data;
 
+struct Grid::Transaction {
+    std::vector<GridMember<AtomFF>> a_members;
+    std::optional<std::vector<GridMember<Water>>> w_members; // only saved once they are about to be modified
+    std::unordered_map<int, int> body_start;
+    int volume;
+};
+
+struct Grid::Stencils {
+    std::unordered_map<form_factor::form_factor_t, detail::SphereStencil> atoms;
+    detail::SphereStencil water;
+};
+
+namespace {
+    using grid::detail::State;
+
+    // mark the empty bins and the bins of the outer volume as atomic area. only the previously empty bins are added to the volume
+    int fill_area(State* bins, int n) {
+        int added = 0;
+        for (int k = 0; k < n; ++k) {
+            State s = bins[k];
+            added += s == grid::detail::EMPTY;
+            bins[k] = (s & (grid::detail::EMPTY | grid::detail::VOLUME)) ? grid::detail::A_AREA : s;
+        }
+        return added;
+    }
+
+    // mark the empty bins with the given state
+    int fill_empty(State* bins, int n, State value) {
+        int added = 0;
+        for (int k = 0; k < n; ++k) {
+            State s = bins[k];
+            added += s == grid::detail::EMPTY;
+            bins[k] = s == grid::detail::EMPTY ? value : s;
+        }
+        return added;
+    }
+
+    /**
+     * @brief Apply a fill to the bins [lo, hi] of the z-row at (x, y), one contiguously stored segment at a time.
+     * 
+     * @param journal Where the previous states of the bins matching @a modifiable are recorded, or nullptr if they should not be recorded.
+     * @return The total number of bins added by the fill.
+     */
+    template<typename F>
+    int fill_row(grid::detail::GridObj& grid, int x, int y, int lo, int hi, grid::detail::GridObj::Journal* journal, State modifiable, F&& fill) {
+        int added = 0;
+        while (lo <= hi) {
+            auto [bins, length] = grid.segment(x, y, lo);
+            int n = std::min<int>(hi - lo + 1, length);
+            if (journal) {
+                for (int k = 0; k < n; ++k) {
+                    if (bins[k] & modifiable) {journal->emplace_back(grid.linear_index(x, y, lo + k), bins[k]);}
+                }
+            }
+            added += fill(bins, n);
+            lo += n;
+        }
+        return added;
+    }
+
+    /**
+     * @brief Fill the sphere of a member within the x-slab [xmin, xmax) of the grid, one z-row at a time. 
+     *        Atoms fill their inner sphere with A_AREA and their outer shell with VOLUME, while waters fill their sphere with W_AREA. 
+     * 
+     * @param journal Where the previous states of the modified bins are recorded, or nullptr if they should not be recorded.
+     * @return The number of bins added to the volume.
+     */
+    int fill_sphere(grid::detail::GridObj& grid, const Vector3<int>& loc, const grid::detail::SphereStencil& stencil, int xmin, int xmax, bool water, grid::detail::GridObj::Journal* journal) {
+        int x = loc.x(), y = loc.y(), z = loc.z();
+        int reach = stencil.get_reach(), ny = grid.size_y(), nz = grid.size_z();
+        int added = 0;
+
+        // i, j *must* be ints to avoid unsigned underflow
+        for (int i = std::max(x - reach, xmin); i < std::min(x + reach + 1, xmax); ++i) {
+            for (int j = std::max(y - reach, 0); j < std::min(y + reach + 1, ny); ++j) {
+                auto [inner, outer] = stencil.span(i - x, j - y);
+                int lo = std::max(z - inner, 0), hi = std::min(z + inner, nz-1);
+                if (water) {
+                    fill_row(grid, i, j, lo, hi, journal, grid::detail::EMPTY, [] (State* bins, int n) {return fill_empty(bins, n, grid::detail::W_AREA);});
+                    continue;
+                }
+                added += fill_row(grid, i, j, lo, hi, journal, grid::detail::EMPTY | grid::detail::VOLUME, fill_area);
+
+                // the outer shell consists of the parts of the row on either side of the inner sphere
+                if (outer <= inner) {continue;}
+                std::array<std::pair<int, int>, 2> shell = {{
+                    {std::max(z - outer, 0), std::min(z - inner - 1, nz-1)}, 
+                    {std::max(z + std::max(inner, 0) + 1, 0), std::min(z + outer, nz-1)}
+                }};
+                for (auto [lo, hi] : shell) {
+                    added += fill_row(grid, i, j, lo, hi, journal, grid::detail::EMPTY, [] (State* bins, int n) {return fill_empty(bins, n, grid::detail::VOLUME);});
+                }
+            }
+        }
+        return added;
+    }
+}
+
 Grid::Grid(const Limit3D& axes) : axes(Axis3D(axes, settings::grid::cell_width)) {
     setup();
 }
@@ -111,15 +219,15 @@ void Grid::setup() {
         }
     }
 
-    // check if the grid is abnormally large
-    long long int total_bins = (long long) axes.x.bins*axes.y.bins*axes.z.bins;
+    // check if the grid is abnormally large. the sparse storage only allocates the parts which are written to, so it is exempt
+    long long int total_bins = settings::grid::sparse ? 0 : (long long) axes.x.bins*axes.y.bins*axes.z.bins;
     if (total_bins > 32e9) {
         throw except::size_error("Grid::setup: Attempting to allocate a grid of size > 16GB. Try reducing the number of bins.");
     } else if (total_bins > 4e9) {
         console::print_warning("Warning in Grid::setup: Attempting to allocate a grid of size > 2GB. Consider lowering the number of bins.");
     }
 
-    this->grid = detail::GridObj(axes.x.bins, axes.y.bins, axes.z.bins);
+    this->grid = detail::GridObj(axes.x.bins, axes.y.bins, axes.z.bins, settings::grid::sparse);
 }
 
 double Grid::get_atomic_radius(form_factor::form_factor_t atom) const {
@@ -165,103 +273,117 @@ void Grid::add_volume(double value) {
 }
 
 void Grid::force_expand_volume() {
-    for (auto& atom : a_members) {
-        atom.set_expanded(false);
-        expand_volume(atom);
-    }
-
-    for (auto& water : w_members) {
-        water.set_expanded(false);
-        expand_volume(water);
-    }
+    for (auto& atom : a_members) {atom.set_expanded(false);}
+    save_waters();
+    for (auto& water : w_members) {water.set_expanded(false);}
+    expand_volume();
 }
 
 void Grid::expand_volume() {
-    // iterate through each member location
-    for (auto& atom : a_members) {
-        expand_volume(atom);
-    }
+    save_waters();
 
-    for (auto& water : w_members) {
-        expand_volume(water);
-    }
+    // the waters are expanded after the atoms since they cannot overwrite the atomic volume
+    expand_members(a_members);
+    expand_members(w_members);
 }
 
-void Grid::expand_volume(GridMember<AtomFF>& atom) {
-    if (atom.is_expanded()) {return;} // check if this location has already been expanded
-    atom.set_expanded(true); // mark this location as expanded
-
-    // create a box of size [x-r, x+r][y-r, y+r][z-r, z+r] within the bounds
-    int x = atom.get_bin_loc().x(), y = atom.get_bin_loc().y(), z = atom.get_bin_loc().z(); 
-    double rvdw = get_atomic_radius(atom.get_atom_type())/settings::grid::cell_width;
+const grid::detail::SphereStencil& Grid::get_stencil(form_factor::form_factor_t type) {
+    if (stencils == nullptr) {stencils = std::make_unique<Stencils>();}
+    double rvdw = get_atomic_radius(type)/settings::grid::cell_width;
     double rvol = settings::grid::min_exv_radius/settings::grid::cell_width;
-    double rvdw2 = std::pow(rvdw, 2), rvol2 = std::pow(rvol, 2);
+    auto& stencil = stencils->atoms[type];
+    if (!stencil.matches(rvdw, rvol)) {stencil = detail::SphereStencil(rvdw, rvol);}
+    return stencil;
+}
 
-    double r = std::max(rvdw, rvol);
-    int xm = std::max<int>(x - std::ceil(r), 0), xp = std::min<int>(x + std::ceil(r) + 1, axes.x.bins); // xminus and xplus
-    int ym = std::max<int>(y - std::ceil(r), 0), yp = std::min<int>(y + std::ceil(r) + 1, axes.y.bins); // yminus and yplus
-    int zm = std::max<int>(z - std::ceil(r), 0), zp = std::min<int>(z + std::ceil(r) + 1, axes.z.bins); // zminus and zplus
+const grid::detail::SphereStencil& Grid::get_water_stencil() {
+    if (stencils == nullptr) {stencils = std::make_unique<Stencils>();}
+    double rvdw = get_hydration_radius()/settings::grid::cell_width;
+    if (!stencils->water.matches(rvdw, 0)) {stencils->water = detail::SphereStencil(rvdw, 0);}
+    return stencils->water;
+}
 
-    // loop over each bin in the box
-    int added_volume = 0;
+template<typename T>
+void Grid::expand_members(std::vector<GridMember<T>>& members) {
+    constexpr bool water = std::is_same_v<T, Water>;
 
-    // i, j, k *must* be ints to avoid unsigned underflow
-    for (int i = xm; i < xp; ++i) {
-        double x2 = std::pow(x - i, 2);
-        for (int j = ym; j < yp; ++j) {
-            double x2y2 = x2 + std::pow(y - j, 2);
-            for (int k = zm; k < zp; ++k) {
-                // fill a sphere of radius [0, vdw] around the atom
-                double dist = x2y2 + std::pow(z - k, 2);
-                auto& bin = grid.index(i, j, k);
-                if (dist <= rvdw2) {
-                    if (!grid.is_empty_or_volume(bin)) {continue;}
-                    added_volume += !grid.is_volume(bin); // only add to the volume if the bin is not already part of the volume
-                    bin = detail::A_AREA;
-                }
+    // the stencils are generated up front so the workers only have to read them
+    std::vector<std::pair<observer_ptr<const GridMember<T>>, observer_ptr<const detail::SphereStencil>>> pending;
+    for (auto& member : members) {
+        if (member.is_expanded()) {continue;}
+        member.set_expanded(true);
+        if constexpr (water) {pending.emplace_back(&member, &get_water_stencil());}
+        else {pending.emplace_back(&member, &get_stencil(member.get_atom_type()));}
+    }
+    if (pending.empty()) {return;}
+
+    // small expansions are not worth distributing
+    auto pool = utility::multi_threading::get_global_pool();
+    int bins = axes.x.bins;
+    int width = grid.get_block_width(), units = (bins + width - 1)/width;
+    int slabs = pending.size() < 1000 ? 1 : std::min<int>(4*pool->get_thread_count(), units);
+    if (slabs == 1) {
+        detail::GridObj::Journal journal;
+        for (auto [member, stencil] : pending) {
+            volume += fill_sphere(grid, member->get_bin_loc(), *stencil, 0, bins, water, grid.in_transaction() ? &journal : nullptr);
+        }
+        grid.record(journal);
+        return;
+    }
 
-                // fill an outer shell of radius [vdw, rvol] to make sure the volume is space-filling
-                else if (dist <= rvol2) {
-                    if (!grid.is_empty(i, j, k)) {continue;}
-                    bin = detail::VOLUME;
-                    added_volume++;
-                }
+    // the slab boundaries are aligned with the storage blocks since the blocks are allocated on their first write
+    auto slab_start = [bins, width, units, slabs] (int s) {return std::min(s*units/slabs*width, bins);};
+    auto slab_of = [bins, width, units, slabs] (int x) {return ((std::clamp(x, 0, bins-1)/width + 1)*slabs - 1)/units;};
+
+    // assign each member to all slabs overlapped by its sphere
+    std::vector<std::vector<unsigned int>> assigned(slabs);
+    for (unsigned int m = 0; m < pending.size(); ++m) {
+        int x = pending[m].first->get_bin_loc().x(), reach = pending[m].second->get_reach();
+        for (int s = slab_of(x - reach); s <= slab_of(x + reach); ++s) {assigned[s].push_back(m);}
+    }
+
+    // each slab is only written by its own task, so the bins can be modified without synchronization
+    std::vector<int> added(slabs, 0);
+    std::vector<detail::GridObj::Journal> journals(slabs);
+    bool journaling = grid.in_transaction();
+    for (int s = 0; s < slabs; ++s) {
+        pool->detach_task([&, s] () {
+            int xmin = slab_start(s), xmax = slab_start(s+1);
+            for (unsigned int m : assigned[s]) {
+                auto [member, stencil] = pending[m];
+                added[s] += fill_sphere(grid, member->get_bin_loc(), *stencil, xmin, xmax, water, journaling ? &journals[s] : nullptr);
             }
-        }
+        });
+    }
+    pool->wait();
+
+    // the slabs are disjoint, so the journals can be recorded in any order
+    for (int s = 0; s < slabs; ++s) {
+        volume += added[s];
+        grid.record(journals[s]);
     }
-    volume += added_volume;
+}
+
+void Grid::expand_volume(GridMember<AtomFF>& atom) {
+    if (atom.is_expanded()) {return;} // check if this location has already been expanded
+    atom.set_expanded(true); // mark this location as expanded
+
+    detail::GridObj::Journal journal;
+    volume += fill_sphere(grid, atom.get_bin_loc(), get_stencil(atom.get_atom_type()), 0, axes.x.bins, false, grid.in_transaction() ? &journal : nullptr);
+    grid.record(journal);
 }
 
 void Grid::expand_volume(GridMember<Water>& water) {
     if (water.is_expanded()) {return;} // check if this location has already been expanded
     water.set_expanded(true); // mark this location as expanded
 
-    // create a box of size [x-r, x+r][y-r, y+r][z-r, z+r] within the bounds
-    int x = water.get_bin_loc().x(), y = water.get_bin_loc().y(), z = water.get_bin_loc().z();
-    double rvdw = get_hydration_radius()/settings::grid::cell_width;
-    double rvdw2 = std::pow(rvdw, 2);
-    int xm = std::max<int>(x - std::ceil(rvdw), 0), xp = std::min<int>(x + std::ceil(rvdw) + 1, axes.x.bins); // xminus and xplus
-    int ym = std::max<int>(y - std::ceil(rvdw), 0), yp = std::min<int>(y + std::ceil(rvdw) + 1, axes.y.bins); // yminus and yplus
-    int zm = std::max<int>(z - std::ceil(rvdw), 0), zp = std::min<int>(z + std::ceil(rvdw) + 1, axes.z.bins); // zminus and zplus
-
-    // i, j, k *must* be ints to avoid unsigned underflow
-    for (int i = xm; i < xp; ++i) {
-        double x2 = std::pow(x - i, 2);
-        for (int j = ym; j < yp; ++j) {
-            double x2y2 = x2 + std::pow(y - j, 2);
-            for (int k = zm; k < zp; ++k) {
-                // determine if the bin is within a sphere centered on the atom
-                double dist = x2y2 + std::pow(z - k, 2);
-                if (dist <= rvdw2) {
-                    if (!grid.is_empty(i, j, k)) {continue;}
-                    grid.index(i, j, k) = detail::W_AREA;
-                }
-            }
-        }
-    }
+    detail::GridObj::Journal journal;
+    fill_sphere(grid, water.get_bin_loc(), get_water_stencil(), 0, axes.x.bins, true, grid.in_transaction() ? &journal : nullptr);
+    grid.record(journal);
 }
 
 void Grid::deflate_volume() {
+    save_waters();
     // iterate through each member location
     for (auto& atom : a_members) {
         deflate_volume(atom);
@@ -295,10 +417,9 @@ void Grid::deflate_volume(GridMember<AtomFF>& atom) {
                 double dist = x2y2 + std::pow(z - k, 2);
 
                 // determine if the bin is within a sphere centered on the atom
-                auto& bin = grid.index(i, j, k);
                 if (dist <= rvol2) {
-                    if (!grid.is_atom_area_or_volume(bin)) {continue;}
-                    bin = detail::EMPTY;
+                    if (!grid.is_atom_area_or_volume(i, j, k)) {continue;}
+                    grid.index(i, j, k) = detail::EMPTY;
                     ++removed_volume;
                 }
             }
@@ -339,6 +460,7 @@ void Grid::deflate_volume(GridMember<Water>& water) {
 
 void Grid::remove_waters(const std::vector<bool>& to_remove) {
     assert(to_remove.size() == w_members.size() && "Grid::remove_waters: The size of the removal vector does not match the number of waters!");
+    save_waters();
 
     std::vector<GridMember<Water>> new_waters;
     new_waters.reserve(w_members.size());
@@ -411,6 +533,7 @@ auto add_single_water = [] (grid::Grid& g, const data::Water& w) {
 };
 
 std::span<grid::GridMember<data::Water>> Grid::add(const std::vector<data::Water>& waters, bool expand) {
+    save_waters();
     size_t start = w_members.size();
     w_members.reserve(w_members.size() + waters.size());
     for (int i = 0; i < static_cast<int>(waters.size()); ++i) {
@@ -423,6 +546,7 @@ std::span<grid::GridMember<data::Water>> Grid::add(const std::vector<data::Water
 }
 
 grid::GridMember<data::Water>& Grid::add(const data::Water& water, bool expand) {
+    save_waters();
     w_members.emplace_back(add_single_water(*this, water));
     if (expand) {expand_volume(w_members.back());}
     return w_members.back();
@@ -458,6 +582,17 @@ void Grid::remove(const Body& body) {
 }
 
 void Grid::clear_waters() {
+    // during a transaction the members are moved to the saved state instead of being copied, so we deflate copies of them
+    if (transaction != nullptr && !transaction->w_members.has_value()) {
+        transaction->w_members = std::move(w_members);
+        for (auto water : *transaction->w_members) {
+            deflate_volume(water);
+            grid.index(water.get_bin_loc()) = detail::EMPTY;
+        }
+        w_members.clear();
+        return;
+    }
+
     for (auto& water : w_members) {
         deflate_volume(water);
         grid.index(water.get_bin_loc()) = detail::EMPTY;
@@ -465,6 +600,35 @@ void Grid::clear_waters() {
     w_members.clear();
 }
 
+void Grid::save_waters() {
+    if (transaction == nullptr || transaction->w_members.has_value()) {return;}
+    transaction->w_members = w_members;
+}
+
+void Grid::begin_transaction() {
+    assert(transaction == nullptr && "Grid::begin_transaction: A transaction is already active.");
+    transaction = std::make_unique<Transaction>(a_members, std::nullopt, body_start, volume);
+    grid.begin_transaction();
+}
+
+void Grid::commit() {
+    assert(transaction != nullptr && "Grid::commit: No transaction is active.");
+    grid.commit();
+    transaction.reset();
+}
+
+void Grid::rollback() {
+    assert(transaction != nullptr && "Grid::rollback: No transaction is active.");
+    grid.rollback();
+    a_members = std::move(transaction->a_members);
+    body_start = std::move(transaction->body_start);
+    volume = transaction->volume;
+    if (transaction->w_members.has_value()) {
+        w_members = std::move(*transaction->w_members);
+    }
+    transaction.reset();
+}
+
 Vector3<int> Grid::get_bins() const {
     return Vector3<int>(axes.x.bins, axes.y.bins, axes.z.bins);
 }
@@ -496,6 +660,7 @@ Grid& Grid::operator=(const Grid& rhs) {
     volume = rhs.volume;
     axes = rhs.axes;
     body_start = rhs.body_start;
+    if (grid.in_transaction()) {grid.commit();} // the copy only represents the current state
     // culler & placer cannot be modified after program is run, so they'll automatically be equal always
     return *this;
 }
@@ -507,6 +672,7 @@ Grid& Grid::operator=(Grid&& rhs) noexcept {
     volume = rhs.volume;
     axes = std::move(rhs.axes);
     body_start = std::move(rhs.body_start);
+    transaction = std::move(rhs.transaction);
     return *this;
 }
 
@@ -6,14 +6,75 @@ For more information, please refer to the LICENSE file in the project root.
 #include <grid/detail/GridObj.h>
 #include <math/Vector3.h>
 
+#include <algorithm>
+#include <cassert>
+
 using namespace ausaxs;
 using namespace ausaxs::grid::detail;
 
-GridObj::GridObj(unsigned int x, unsigned int y, unsigned int z) : container::Container3D<State>(x, y, z, EMPTY) {}
+GridObj::GridObj(unsigned int x, unsigned int y, unsigned int z, bool sparse) : N(x), M(y), L(z), sparse(sparse) {
+    if (!sparse) {
+        data.assign(N*M*L, EMPTY);
+        return;
+    }
+    BN = (N + block_mask) >> block_bits;
+    BM = (M + block_mask) >> block_bits;
+    BL = (L + block_mask) >> block_bits;
+    blocks.resize(BN*BM*BL);
+}
+
+std::size_t GridObj::allocated_size() const {
+    if (!sparse) {return data.size();}
+    return block_width*block_width*block_width*std::count_if(blocks.begin(), blocks.end(), [] (const std::vector<State>& block) {return !block.empty();});
+}
+
+bool GridObj::operator==(const GridObj& rhs) const {
+    if (N != rhs.N || M != rhs.M || L != rhs.L) {return false;}
+    if (!sparse && !rhs.sparse) {return data == rhs.data;}
+    for (unsigned int i = 0; i < N; ++i) {
+        for (unsigned int j = 0; j < M; ++j) {
+            for (unsigned int k = 0; k < L; ++k) {
+                if (index(i, j, k) != rhs.index(i, j, k)) {return false;}
+            }
+        }
+    }
+    return true;
+}
 
 State& GridObj::index(const Vector3<int>& v) {return index(v.x(), v.y(), v.z());}
 const State& GridObj::index(const Vector3<int>& v) const {return index(v.x(), v.y(), v.z());}
 
+void GridObj::begin_transaction() {
+    assert(!journaling && "GridObj::begin_transaction: A transaction is already active.");
+    journaling = true;
+}
+
+void GridObj::commit() {
+    journal.clear();
+    journaling = false;
+}
+
+void GridObj::rollback() {
+    // replay in reverse order since the same bin may have been recorded multiple times
+    for (auto it = journal.rbegin(); it != journal.rend(); ++it) {
+        if (!sparse) {
+            data[it->first] = it->second;
+            continue;
+        }
+        std::size_t x = it->first/(L*M), y = it->first/L % M, z = it->first % L;
+        bin(x, y, z) = it->second;
+    }
+    journal.clear();
+    journaling = false;
+}
+
+bool GridObj::in_transaction() const {return journaling;}
+
+void GridObj::record(const Journal& entries) {
+    if (!journaling) {return;}
+    journal.insert(journal.end(), entries.begin(), entries.end());
+}
+
 bool GridObj::is_empty_or_volume(unsigned int x, unsigned int y, unsigned int z) const {return is_empty_or_volume(index(x, y, z));}
 bool GridObj::is_empty_or_volume(State s) const {return s & (EMPTY | VOLUME);}
 
@@ -7,8 +7,13 @@ For more information, please refer to the LICENSE file in the project root.
 #include <grid/detail/GridMember.h>
 #include <grid/Grid.h>
 #include <settings/GridSettings.h>
+#include <utility/MultiThreading.h>
 
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
 
 using namespace ausaxs;
 using namespace ausaxs::grid::detail;
@@ -17,67 +22,66 @@ GridSurfaceDetection::GridSurfaceDetection(observer_ptr<grid::Grid> grid) : Radi
 
 GridSurfaceDetection::~GridSurfaceDetection() = default;
 
-bool GridSurfaceDetection::collision_check(const Vector3<int>& loc) const {
-    grid::detail::GridObj& gref = grid->grid;
-    auto bins = grid->get_bins();
-    int score = 0;
-
-    // check if a location is out-of-bounds
-    auto is_out_of_bounds = [&bins] (Vector3<int> v) {
-        if (v.x() < 0 || (int) bins.x() <= v.x()) {return true;}
-        if (v.y() < 0 || (int) bins.y() <= v.y()) {return true;}
-        if (v.z() < 0 || (int) bins.z() <= v.z()) {return true;}
-        return false;
-    };
-
-    for (unsigned int i = 0; i < rot_locs_abs.size(); i++) {
-        {   // check for collisions at 1r
-            auto xr = loc.x() + rot_bins_1[i].x();
-            auto yr = loc.y() + rot_bins_1[i].y();
-            auto zr = loc.z() + rot_bins_1[i].z();
-            if (is_out_of_bounds({xr, yr, zr})) [[unlikely]] {
-                score += 7;
-                continue;
-            }
-
-            if (!gref.is_empty_or_water(xr, yr, zr)) {
-                continue;
+namespace {
+    // the states of the padded copy of the grid used by the collision checks
+    enum : std::uint8_t {OPEN = 0, BLOCKED = 1, OUTSIDE = 2};
+
+    // the score of a single radial line, indexed by the states of its bins at the three radii
+    // the line is blocked at the first bin which is not open, and stops with the full score if it leaves the grid
+    constexpr std::array<std::uint8_t, 27> line_scores = [] () {
+        std::array<std::uint8_t, 27> scores{};
+        for (int s1 = 0; s1 < 3; ++s1) {
+            for (int s2 = 0; s2 < 3; ++s2) {
+                for (int s3 = 0; s3 < 3; ++s3) {
+                    int score = 7;
+                    if (s1 == BLOCKED) {score = 0;}
+                    else if (s1 == OPEN && s2 == BLOCKED) {score = 3;}
+                    else if (s1 == OPEN && s2 == OPEN && s3 == BLOCKED) {score = 5;}
+                    scores[9*s1 + 3*s2 + s3] = score;
+                }
             }
         }
-
-        {   // check for collisions at 2r
-            auto xr = loc.x() + rot_bins_2[i].x();
-            auto yr = loc.y() + rot_bins_2[i].y();
-            auto zr = loc.z() + rot_bins_2[i].z();
-            if (is_out_of_bounds({xr, yr, zr})) [[unlikely]] {
-                score += 7;
-                continue;
-            }
-
-            if (!gref.is_empty_or_water(xr, yr, zr)) {
-                score += 3;
-                continue;
+        return scores;
+    }();
+
+    /**
+     * @brief A copy of a region of the grid, padded by the reach of the radial lines such that they can be followed without bounds checks.
+     */
+    struct PaddedGrid {
+        PaddedGrid(const GridObj& gobj, const Vector3<int>& min, const Vector3<int>& max, int pad) 
+            : origin(min - Vector3<int>(pad, pad, pad)), size(max - min + Vector3<int>(2*pad, 2*pad, 2*pad)), cells(static_cast<std::size_t>(size.x())*size.y()*size.z())
+        {
+            for (int x = 0; x < size.x(); ++x) {
+                int gx = origin.x() + x;
+                for (int y = 0; y < size.y(); ++y) {
+                    int gy = origin.y() + y;
+                    std::uint8_t* row = cells.data() + index(gx, gy, origin.z());
+                    for (int z = 0; z < size.z(); ++z) {
+                        int gz = origin.z() + z;
+                        bool outside = gx < 0 || gy < 0 || gz < 0 || (int) gobj.size_x() <= gx || (int) gobj.size_y() <= gy || (int) gobj.size_z() <= gz;
+                        row[z] = outside ? OUTSIDE : gobj.is_empty_or_water(gx, gy, gz) ? OPEN : BLOCKED;
+                    }
+                }
             }
         }
 
-        {   // check for collisions at 3r
-            auto xr = loc.x() + rot_bins_3[i].x();
-            auto yr = loc.y() + rot_bins_3[i].y();
-            auto zr = loc.z() + rot_bins_3[i].z();
-            if (is_out_of_bounds({xr, yr, zr})) [[unlikely]] {
-                score += 7;
-                continue;
-            }
+        long index(int x, int y, int z) const {
+            return (static_cast<long>(x - origin.x())*size.y() + (y - origin.y()))*size.z() + (z - origin.z());
+        }
 
-            if (!gref.is_empty_or_water(xr, yr, zr)) {
-                score += 5;
-                continue;
+        // check if the voxel at the given flat index is buried sufficiently deep to be part of the interior
+        bool collision_check(long center, const std::vector<std::array<long, 3>>& offsets) const {
+            const std::uint8_t* c = cells.data() + center;
+            int score = 0;
+            for (const auto& o : offsets) {
+                score += line_scores[9*c[o[0]] + 3*c[o[1]] + c[o[2]]];
             }
+            return score < 42;
         }
 
-        score += 7;
-    }
-    return score < 42;
+        Vector3<int> origin, size;
+        std::vector<std::uint8_t> cells;
+    };
 }
 
 std::vector<Vector3<double>> GridSurfaceDetection::determine_vacuum_holes() const {
@@ -137,36 +141,78 @@ GridExcludedVolume GridSurfaceDetection::helper() const {
     const auto& axes = grid->get_axes();
     auto& gobj = grid->grid;
     auto[vmin, vmax] = grid->bounding_box_index();
-    for (int i = std::max<int>(vmin.x()-buffer, 0); i < std::min<int>(vmax.x()+buffer+1, axes.x.bins); i+=stride) {
-        for (int j = std::max<int>(vmin.y()-buffer, 0); j < std::min<int>(vmax.y()+buffer+1, axes.y.bins); j+=stride) {
-            for (int k = std::max<int>(vmin.z()-buffer, 0); k < std::min<int>(vmax.z()+buffer+1, axes.z.bins); k+=stride) {
-                auto& val = gobj.index(i, j, k);
-                switch (val) {
-                    case grid::detail::State::VOLUME:
-                    case grid::detail::State::A_AREA:
-                    case grid::detail::State::A_CENTER: {
-                        // if we're not detecting the surface, everything is interior
-                        if constexpr (!detect_surface) {
-                            vol.interior.push_back(grid->to_xyz(i, j, k));
-                            continue;
-                        }
+    Vector3<int> lo(std::max<int>(vmin.x()-buffer, 0), std::max<int>(vmin.y()-buffer, 0), std::max<int>(vmin.z()-buffer, 0));
+    Vector3<int> hi(std::min<int>(vmax.x()+buffer+1, axes.x.bins), std::min<int>(vmax.y()+buffer+1, axes.y.bins), std::min<int>(vmax.z()+buffer+1, axes.z.bins));
+
+    // the radial lines of the voxels are followed in a padded copy of the i-slabs of each task, which extends by the reach of the lines on all sides
+    // all copies have the same size along y and z, so the bins of the lines have the same offsets in each of them
+    int reach = line_reach();
+    std::vector<std::array<long, 3>> offsets;
+    if constexpr (detect_surface) {
+        long size_z = hi.z() - lo.z() + 2*reach;
+        offsets = line_offsets((hi.y() - lo.y() + 2*reach)*size_z, size_z);
+    }
+
+    // the grid is only read while classifying the voxels, so the i-slabs are classified in parallel
+    // each task handles a contiguous run of slabs, such that only one padded copy is made per task and the padding is only copied once per thread
+    // each slab keeps its own results, which are merged in order afterwards such that the output does not depend on the number of threads
+    struct Slab {
+        std::vector<Vector3<double>> interior, surface;
+        std::vector<Vector3<int>> marked;
+    };
+    auto pool = utility::multi_threading::get_global_pool();
+    std::vector<Slab> slabs(lo.x() < hi.x() ? (hi.x() - lo.x() - 1)/stride + 1 : 0);
+    int tasks = std::min<int>(slabs.size(), pool->get_thread_count());
+    for (int t = 0; t < tasks; ++t) {
+        pool->detach_task([&, t] () {
+            int first = t*static_cast<int>(slabs.size())/tasks, last = (t+1)*static_cast<int>(slabs.size())/tasks;
+            std::optional<PaddedGrid> padded;
+            if constexpr (detect_surface) {
+                int imin = lo.x() + first*stride, imax = lo.x() + (last-1)*stride + 1;
+                padded.emplace(std::as_const(gobj), Vector3<int>(imin, lo.y(), lo.z()), Vector3<int>(imax, hi.y(), hi.z()), reach);
+            }
 
-                        // with non-unity widths we don't need the actual vectors yet since we have more work to do later
-                        auto collision = collision_check({i, j, k});
-                        if constexpr (!unity_width) {
-                            if (!collision) {val |= grid::detail::RESERVED_1;}
-                        } else { // with unity widths our work is already done here
-                            if (collision) {vol.interior.push_back(grid->to_xyz(i, j, k));}
-                            else           {vol.surface.push_back( grid->to_xyz(i, j, k));}
+            for (int s = first; s < last; ++s) {
+                int i = lo.x() + s*stride;
+                auto& slab = slabs[s];
+                for (int j = lo.y(); j < hi.y(); j+=stride) {
+                    for (int k = lo.z(); k < hi.z(); k+=stride) {
+                        auto val = std::as_const(gobj).index(i, j, k); // avoid journaling bins which are only read
+                        switch (val) {
+                            case grid::detail::State::VOLUME:
+                            case grid::detail::State::A_AREA:
+                            case grid::detail::State::A_CENTER: {
+                                // if we're not detecting the surface, everything is interior
+                                if constexpr (!detect_surface) {
+                                    slab.interior.push_back(grid->to_xyz(i, j, k));
+                                    continue;
+                                } else {
+                                    // with non-unity widths we don't need the actual vectors yet since we have more work to do later
+                                    auto collision = padded->collision_check(padded->index(i, j, k), offsets);
+                                    if constexpr (!unity_width) {
+                                        if (!collision) {slab.marked.emplace_back(i, j, k);}
+                                    } else { // with unity widths our work is already done here
+                                        if (collision) {slab.interior.push_back(grid->to_xyz(i, j, k));}
+                                        else           {slab.surface.push_back( grid->to_xyz(i, j, k));}
+                                    }
+                                }
+                                break;
+                            }
+
+                            default:
+                                break;
                         }
-                        break;
                     }
-
-                    default:
-                        break;
                 }
             }
-        }
+        });
+    }
+    pool->wait();
+
+    for (const auto& slab : slabs) {
+        vol.interior.insert(vol.interior.end(), slab.interior.begin(), slab.interior.end());
+        vol.surface.insert(vol.surface.end(), slab.surface.begin(), slab.surface.end());
+        for (const auto& v : slab.marked) {gobj.index(v.x(), v.y(), v.z()) |= grid::detail::RESERVED_1;}
     }
 
     if constexpr (!unity_width) {
@@ -187,10 +233,10 @@ GridExcludedVolume GridSurfaceDetection::helper() const {
         };
 
         // expand the area around each surface voxel
-        for (int i = std::max<int>(vmin.x()-buffer, 0); i < std::min<int>(vmax.x()+buffer+1, axes.x.bins); i+=stride) {
-            for (int j = std::max<int>(vmin.y()-buffer, 0); j < std::min<int>(vmax.y()+buffer+1, axes.y.bins); j+=stride) {
-                for (int k = std::max<int>(vmin.z()-buffer, 0); k < std::min<int>(vmax.z()+buffer+1, axes.z.bins); k+=stride) {
-                    if (gobj.index(i, j, k) & grid::detail::RESERVED_1) {
+        for (int i = lo.x(); i < hi.x(); i+=stride) {
+            for (int j = lo.y(); j < hi.y(); j+=stride) {
+                for (int k = lo.z(); k < hi.z(); k+=stride) {
+                    if (std::as_const(gobj).index(i, j, k) & grid::detail::RESERVED_1) {
                         mark_adjacent(i, j, k);
                     }
                 }
@@ -198,17 +244,17 @@ GridExcludedVolume GridSurfaceDetection::helper() const {
         }
 
         // collect the surface voxels
-        for (int i = std::max<int>(vmin.x()-buffer, 0); i < std::min<int>(vmax.x()+buffer+1, axes.x.bins); i+=stride) {
-            for (int j = std::max<int>(vmin.y()-buffer, 0); j < std::min<int>(vmax.y()+buffer+1, axes.y.bins); j+=stride) {
-                for (int k = std::max<int>(vmin.z()-buffer, 0); k < std::min<int>(vmax.z()+buffer+1, axes.z.bins); k+=stride) {
-                    auto& val = gobj.index(i, j, k);
+        for (int i = lo.x(); i < hi.x(); i+=stride) {
+            for (int j = lo.y(); j < hi.y(); j+=stride) {
+                for (int k = lo.z(); k < hi.z(); k+=stride) {
+                    auto val = std::as_const(gobj).index(i, j, k);
                     if (val & (grid::detail::RESERVED_1 | grid::detail::VACUUM)) {
                         vol.surface.push_back(grid->to_xyz(i, j, k));
-                        val &= ~(grid::detail::RESERVED_1 | grid::detail::VACUUM);
+                        gobj.index(i, j, k) &= ~(grid::detail::RESERVED_1 | grid::detail::VACUUM);
                         continue;
                     }
 
-                    switch (gobj.index(i, j, k)) {
+                    switch (val) {
                         case grid::detail::State::VOLUME:
                         case grid::detail::State::A_AREA:
                         case grid::detail::State::A_CENTER: 
@@ -8,6 +8,9 @@ For more information, please refer to the LICENSE file in the project root.
 #include <constants/vdwTable.h>
 #include <math/Vector3.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace ausaxs;
 using namespace ausaxs::grid::detail;
 
@@ -85,4 +88,23 @@ void RadialLineGenerator::generate(std::array<double, 4> r, int divisions) {
     rot_bins_3 = std::move(bins_3);
     rot_bins_4 = std::move(bins_4);
     rot_locs_abs = std::move(locs);
+}
+
+int RadialLineGenerator::line_reach() {
+    int reach = 0;
+    for (const auto& bins : {&rot_bins_1, &rot_bins_2, &rot_bins_3}) {
+        for (const auto& b : *bins) {
+            reach = std::max({reach, std::abs(b.x()), std::abs(b.y()), std::abs(b.z())});
+        }
+    }
+    return reach;
+}
+
+std::vector<std::array<long, 3>> RadialLineGenerator::line_offsets(long stride_x, long stride_y) {
+    auto offset = [stride_x, stride_y] (const Vector3<int>& b) {return b.x()*stride_x + b.y()*stride_y + b.z();};
+    std::vector<std::array<long, 3>> offsets(rot_locs_abs.size());
+    for (unsigned int i = 0; i < offsets.size(); ++i) {
+        offsets[i] = {offset(rot_bins_1[i]), offset(rot_bins_2[i]), offset(rot_bins_3[i])};
+    }
+    return offsets;
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <grid/detail/SphereStencil.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ausaxs;
+using namespace ausaxs::grid::detail;
+
+SphereStencil::SphereStencil(double r_inner, double r_outer) : r_inner(r_inner), r_outer(r_outer), reach(std::ceil(std::max(r_inner, r_outer))) {
+    double r2_inner = r_inner*r_inner, r2_outer = r_outer*r_outer;
+    spans.resize((2*reach + 1)*(2*reach + 1));
+    for (int dx = -reach; dx <= reach; ++dx) {
+        for (int dy = -reach; dy <= reach; ++dy) {
+            // the same comparisons as a bin-by-bin check, such that the boundary bins are treated identically
+            double d2 = dx*dx + dy*dy;
+            auto half_width = [d2] (double r2) {
+                int h = -1;
+                while (d2 + (h+1)*(h+1) <= r2) {++h;}
+                return h;
+            };
+            spans[(dx + reach)*(2*reach + 1) + dy + reach] = {half_width(r2_inner), half_width(r2_outer)};
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/detail/BatchedDebyeTransform.h>
+#include <utility/MultiThreading.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace ausaxs;
+using namespace ausaxs::hist::detail;
+
+namespace {
+    constexpr unsigned int profile_tile = 16;   // number of profiles per task
+    constexpr unsigned int q_tile = 32;         // number of q-values per task
+    constexpr unsigned int d_tile = 512;        // number of distance bins kept in cache at a time, 4 kB per row
+    constexpr unsigned int min_gap = 32;        // minimum number of consecutive empty bins before a profile is split into separate spans
+
+    // register block sizes. 4x2 accumulators leaves enough registers for the loaded values without spilling.
+    constexpr unsigned int block_p = 4;
+    constexpr unsigned int block_q = 2;
+
+    /**
+     * @brief Add the P x Q dot products of the profiles a and table rows t over the distances [d_begin, d_end) to out[p][q].
+     *        The reduction is kept in registers, and is vectorized along the distance axis by the compiler.
+     */
+    template<unsigned int P, unsigned int Q>
+    inline void kernel(const double* const* a, const double* const* t, unsigned int d_begin, unsigned int d_end, double* const* out, unsigned int q) {
+        double acc[P][Q] = {};
+        for (unsigned int d = d_begin; d < d_end; ++d) {
+            for (unsigned int i = 0; i < P; ++i) {
+                for (unsigned int j = 0; j < Q; ++j) {
+                    acc[i][j] += a[i][d]*t[j][d];
+                }
+            }
+        }
+        for (unsigned int i = 0; i < P; ++i) {
+            for (unsigned int j = 0; j < Q; ++j) {
+                out[i][q+j] += acc[i][j];
+            }
+        }
+    }
+}
+
+BatchedDebyeTransform::BatchedDebyeTransform(observer_ptr<const table::DebyeTable> table, unsigned int q0, unsigned int q_bins)
+    : table(table), q0(q0), q_bins(q_bins)
+{
+    assert(q0 + q_bins <= table->size_q() && "BatchedDebyeTransform::BatchedDebyeTransform: The q-range exceeds the table.");
+}
+
+void BatchedDebyeTransform::add_profile(const double* data, unsigned int size, double* out) {
+    assert(size <= table->size_d() && "BatchedDebyeTransform::add_profile: The distance profile is longer than the table.");
+
+    // split the profile into spans of non-zero bins. short gaps are not worth a separate span, so they are included in the surrounding ones
+    unsigned int span_begin = spans.size();
+    unsigned int occupied = 0;
+    for (unsigned int d = 0; d < size;) {
+        if (data[d] == 0) {++d; continue;}
+        unsigned int start = d, last = d;
+        for (; d < size; ++d) {
+            if (data[d] != 0) {last = d;}
+            else if (d - last >= min_gap) {break;}
+        }
+        spans.emplace_back(start, last+1);
+        occupied += last+1-start;
+    }
+    unsigned int span_end = spans.size();
+
+    if (span_begin == span_end) {
+        sparse.push_back({data, out, 0, 0, span_begin, span_end});
+        return;
+    }
+
+    unsigned int begin = spans[span_begin].first, end = spans[span_end-1].second;
+    if (2*occupied < end - begin) {
+        sparse.push_back({data, out, begin, end, span_begin, span_end});
+    } else {
+        spans.resize(span_begin);
+        dense.push_back({data, out, begin, end, span_begin, span_begin});
+    }
+}
+
+void BatchedDebyeTransform::run() {
+    auto pool = utility::multi_threading::get_global_pool();
+    unsigned int n_dense = dense.size(), n_sparse = sparse.size();
+    for (unsigned int q = 0; q < q_bins; q += q_tile) {
+        unsigned int q_end = std::min(q+q_tile, q_bins);
+        for (unsigned int p = 0; p < n_dense; p += profile_tile) {
+            pool->detach_task([this, p, q, q_end, p_end = std::min(p+profile_tile, n_dense)] () {
+                evaluate_dense_tile(p, p_end, q, q_end);
+            });
+        }
+        for (unsigned int p = 0; p < n_sparse; p += profile_tile) {
+            pool->detach_task([this, p, q, q_end, p_end = std::min(p+profile_tile, n_sparse)] () {
+                evaluate_sparse_tile(p, p_end, q, q_end);
+            });
+        }
+    }
+    pool->wait();
+    dense.clear();
+    sparse.clear();
+    spans.clear();
+}
+
+void BatchedDebyeTransform::evaluate_dense_tile(unsigned int p_begin, unsigned int p_end, unsigned int q_begin, unsigned int q_end) const {
+    for (unsigned int p = p_begin; p < p_end; ++p) {
+        std::fill(dense[p].out + q_begin, dense[p].out + q_end, 0.0);
+    }
+
+    // the profiles do not necessarily occupy the same range, so each register block only runs over the intersection of its profiles
+    // the remaining bins are added separately at the end
+    std::vector<std::pair<unsigned int, unsigned int>> common;
+    unsigned int d_min = std::numeric_limits<unsigned int>::max(), d_max = 0;
+    for (unsigned int p = p_begin; p < p_end; p += block_p) {
+        unsigned int lo = dense[p].begin, hi = dense[p].end;
+        for (unsigned int i = p+1; i < std::min(p+block_p, p_end); ++i) {
+            lo = std::max(lo, dense[i].begin);
+            hi = std::min(hi, dense[i].end);
+        }
+        hi = std::max(lo, hi);
+        common.emplace_back(lo, hi);
+        d_min = std::min(d_min, lo);
+        d_max = std::max(d_max, hi);
+    }
+
+    const double* a[block_p];
+    const double* t[block_q];
+    double* out[block_p];
+    for (unsigned int d0 = d_min; d0 < d_max; d0 += d_tile) {
+        for (unsigned int q = q_begin; q < q_end; q += block_q) {
+            unsigned int nq = std::min(block_q, q_end-q);
+            for (unsigned int j = 0; j < nq; ++j) {t[j] = table->begin(q0+q+j);}
+
+            for (unsigned int p = p_begin, b = 0; p < p_end; p += block_p, ++b) {
+                unsigned int d_lo = std::max(d0, common[b].first);
+                unsigned int d_hi = std::min(d0+d_tile, common[b].second);
+                if (d_hi <= d_lo) {continue;}
+
+                unsigned int np = std::min(block_p, p_end-p);
+                for (unsigned int i = 0; i < np; ++i) {
+                    a[i] = dense[p+i].data;
+                    out[i] = dense[p+i].out;
+                }
+
+                if (np == block_p && nq == block_q) {
+                    kernel<block_p, block_q>(a, t, d_lo, d_hi, out, q);
+                } else {
+                    for (unsigned int i = 0; i < np; ++i) {
+                        for (unsigned int j = 0; j < nq; ++j) {
+                            kernel<1, 1>(a+i, t+j, d_lo, d_hi, out+i, q+j);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // add the bins outside the common range of each register block
+    for (unsigned int p = p_begin, b = 0; p < p_end; p += block_p, ++b) {
+        for (unsigned int i = p; i < std::min(p+block_p, p_end); ++i) {
+            const auto& profile = dense[i];
+            unsigned int head_end = std::min(common[b].first, profile.end);
+            unsigned int tail_begin = std::max(common[b].second, profile.begin);
+            if (profile.begin == head_end && tail_begin >= profile.end) {continue;}
+            for (unsigned int q = q_begin; q < q_end; ++q) {
+                const double* row = table->begin(q0+q);
+                double sum = 0;
+                for (unsigned int d = profile.begin; d < head_end; ++d) {sum += profile.data[d]*row[d];}
+                for (unsigned int d = tail_begin; d < profile.end; ++d) {sum += profile.data[d]*row[d];}
+                profile.out[q] += sum;
+            }
+        }
+    }
+}
+
+void BatchedDebyeTransform::evaluate_sparse_tile(unsigned int p_begin, unsigned int p_end, unsigned int q_begin, unsigned int q_end) const {
+    for (unsigned int p = p_begin; p < p_end; ++p) {
+        const auto& profile = sparse[p];
+        for (unsigned int q = q_begin; q < q_end; ++q) {
+            const double* row = table->begin(q0+q);
+            double sum = 0;
+            for (unsigned int s = profile.span_begin; s < profile.span_end; ++s) {
+                for (unsigned int d = spans[s].first; d < spans[s].second; ++d) {sum += profile.data[d]*row[d];}
+            }
+            profile.out[q] = sum;
+        }
+    }
+}
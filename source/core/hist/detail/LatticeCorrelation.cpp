@@ -0,0 +1,302 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/detail/LatticeCorrelation.h>
+#include <constants/ConstantsAxes.h>
+#include <utility/MultiThreading.h>
+#include <utility/Exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+using namespace ausaxs;
+using namespace ausaxs::hist::detail;
+
+namespace {
+    using complex = std::complex<double>;
+
+    /**
+     * @brief A mixed-radix FFT for sizes with no prime factors larger than 5.
+     */
+    class FFT {
+        public:
+            FFT(std::size_t n) : n(n), twiddles(n) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    twiddles[k] = std::polar(1.0, -2*std::numbers::pi*static_cast<double>(k)/static_cast<double>(n));
+                }
+                for (std::size_t rem = n; 1 < rem;) {
+                    std::size_t p = rem % 4 == 0 ? 4 : rem % 2 == 0 ? 2 : rem % 3 == 0 ? 3 : 5;
+                    factors.push_back(p);
+                    rem /= p;
+                }
+            }
+
+            /**
+             * @brief Transform the contiguous line in place. The inverse transform is not normalized.
+             */
+            void transform(complex* line, std::vector<complex>& scratch, bool inverse) const {
+                scratch.resize(n);
+                transform(line, 1, scratch.data(), n, 0, 1, inverse);
+                std::copy(scratch.begin(), scratch.end(), line);
+            }
+
+        private:
+            std::size_t n;
+            std::vector<complex> twiddles;
+            std::vector<std::size_t> factors;
+
+            complex twiddle(std::size_t k, bool inverse) const {
+                return inverse ? std::conj(twiddles[k]) : twiddles[k];
+            }
+
+            // recursive decimation in time: the sub-transforms of the p interleaved subsequences are combined with radix-p butterflies
+            void transform(const complex* in, std::size_t stride, complex* out, std::size_t size, std::size_t depth, std::size_t step, bool inverse) const {
+                if (size == 1) {
+                    out[0] = in[0];
+                    return;
+                }
+
+                std::size_t p = factors[depth];
+                std::size_t m = size/p;
+                for (std::size_t q = 0; q < p; ++q) {
+                    transform(in + q*stride, stride*p, out + q*m, m, depth+1, step*p, inverse);
+                }
+
+                complex terms[5];
+                for (std::size_t k = 0; k < m; ++k) {
+                    for (std::size_t q = 0; q < p; ++q) {
+                        terms[q] = out[q*m + k]*twiddle(q*k*step, inverse);
+                    }
+                    for (std::size_t s = 0; s < p; ++s) {
+                        complex sum = terms[0];
+                        for (std::size_t q = 1; q < p; ++q) {
+                            sum += terms[q]*twiddle((q*s % p)*(n/p), inverse);
+                        }
+                        out[k + s*m] = sum;
+                    }
+                }
+            }
+    };
+
+    /**
+     * @brief Get the smallest size of at least @a n without prime factors larger than 5.
+     */
+    std::size_t next_fft_size(std::size_t n) {
+        for (std::size_t size = std::max<std::size_t>(n, 1);; ++size) {
+            std::size_t rem = size;
+            for (std::size_t p : {2, 3, 5}) {
+                while (rem % p == 0) {rem /= p;}
+            }
+            if (rem == 1) {return size;}
+        }
+    }
+
+    /**
+     * @brief Transform the lines along one of the two first axes of the half-spectrum in place.
+     */
+    void transform_axis(std::vector<complex>& data, const std::array<std::size_t, 3>& dims, int axis, bool inverse) {
+        auto pool = utility::multi_threading::get_global_pool();
+        std::array<std::size_t, 3> strides = {dims[1]*dims[2], dims[2], 1};
+        FFT fft(dims[axis]);
+        std::size_t lines = data.size()/dims[axis];
+        std::size_t job_size = std::max<std::size_t>(1, lines/(4*pool->get_thread_count()));
+        for (std::size_t start = 0; start < lines; start += job_size) {
+            pool->detach_task([&, start, end = std::min(start+job_size, lines)] () {
+                std::vector<complex> line(dims[axis]), scratch;
+                for (std::size_t l = start; l < end; ++l) {
+                    // the lines along an axis are enumerated by the indices of the two other axes
+                    std::size_t outer = l / strides[axis], inner = l % strides[axis];
+                    std::size_t offset = outer*strides[axis]*dims[axis] + inner;
+                    for (std::size_t i = 0; i < dims[axis]; ++i) {line[i] = data[offset + i*strides[axis]];}
+                    fft.transform(line.data(), scratch, inverse);
+                    for (std::size_t i = 0; i < dims[axis]; ++i) {data[offset + i*strides[axis]] = line[i];}
+                }
+            });
+        }
+        pool->wait();
+    }
+
+    /**
+     * @brief Transform the rows along the last axis between real values and their half-spectra in place.
+     *        Each row holds either n real values or the n/2+1 non-redundant coefficients of their transform, which occupy the same memory.
+     */
+    void transform_rows(std::vector<complex>& data, std::size_t n, bool inverse) {
+        auto pool = utility::multi_threading::get_global_pool();
+        std::size_t half = n/2+1;
+        std::size_t rows = data.size()/half;
+        std::size_t job_size = std::max<std::size_t>(1, rows/(4*pool->get_thread_count()));
+        FFT fft(n);
+        for (std::size_t start = 0; start < rows; start += job_size) {
+            pool->detach_task([&, start, end = std::min(start+job_size, rows)] () {
+                std::vector<complex> line(n), scratch;
+                for (std::size_t r = start; r < end; ++r) {
+                    complex* row = data.data() + r*half;
+                    double* values = reinterpret_cast<double*>(row);
+                    if (!inverse) {
+                        for (std::size_t i = 0; i < n; ++i) {line[i] = values[i];}
+                        fft.transform(line.data(), scratch, false);
+                        std::copy_n(line.begin(), half, row);
+                    } else {
+                        // the remaining coefficients follow from the symmetry of the transforms of real data
+                        std::copy_n(row, half, line.begin());
+                        for (std::size_t i = half; i < n; ++i) {line[i] = std::conj(line[n-i]);}
+                        fft.transform(line.data(), scratch, true);
+                        for (std::size_t i = 0; i < n; ++i) {values[i] = line[i].real();}
+                    }
+                }
+            });
+        }
+        pool->wait();
+    }
+
+    /**
+     * @brief Transform a real 3D array stored in the padded row layout to its half-spectrum in place, or back.
+     */
+    void transform(std::vector<complex>& data, const std::array<std::size_t, 3>& dims, bool inverse) {
+        std::array<std::size_t, 3> half = {dims[0], dims[1], dims[2]/2+1};
+        if (!inverse) {
+            transform_rows(data, dims[2], false);
+            transform_axis(data, half, 1, false);
+            transform_axis(data, half, 0, false);
+        } else {
+            transform_axis(data, half, 0, true);
+            transform_axis(data, half, 1, true);
+            transform_rows(data, dims[2], true);
+        }
+    }
+}
+
+std::optional<LatticeCorrelation> LatticeCorrelation::create(const std::vector<observer_ptr<const CompactCoordinates>>& sets, double spacing) {
+    auto first = std::find_if(sets.begin(), sets.end(), [] (observer_ptr<const CompactCoordinates> set) {return set->size() != 0;});
+    if (first == sets.end()) {return std::nullopt;}
+    const auto& origin = (*first)->get_data().front().value.pos;
+
+    // map all points to integer lattice coordinates
+    std::size_t total = 0;
+    std::vector<std::vector<std::array<long, 3>>> indices(sets.size());
+    std::array<long, 3> min = {0, 0, 0}, max = {0, 0, 0}, divisor = {0, 0, 0};
+    for (unsigned int s = 0; s < sets.size(); ++s) {
+        const auto& data = sets[s]->get_data();
+        indices[s].resize(data.size());
+        for (unsigned int i = 0; i < data.size(); ++i) {
+            if (data[i].value.w != data.front().value.w) {return std::nullopt;}
+            for (unsigned int a = 0; a < 3; ++a) {
+                double r = (static_cast<double>(data[i].value.pos[a]) - origin[a])/spacing;
+                long index = std::lround(r);
+                if (1e-3 < std::abs(r - index)) {return std::nullopt;}
+                indices[s][i][a] = index;
+                min[a] = std::min(min[a], index);
+                max[a] = std::max(max[a], index);
+                divisor[a] = std::gcd(divisor[a], index);
+            }
+        }
+        total += data.size();
+    }
+
+    LatticeCorrelation lattice;
+    for (unsigned int a = 0; a < 3; ++a) {
+        divisor[a] = std::max<long>(divisor[a], 1);
+        lattice.step[a] = spacing*divisor[a];
+        lattice.extent[a] = (max[a] - min[a])/divisor[a] + 1;
+        lattice.padded[a] = next_fft_size(2*lattice.extent[a] - 1);
+    }
+
+    // a pair evaluation is a lot cheaper than an FFT element, so small sets are faster to evaluate directly
+    double volume = static_cast<double>(lattice.padded[0]*lattice.padded[1]*lattice.padded[2]);
+    if (static_cast<double>(total)*total < 20*volume*std::log2(volume)) {return std::nullopt;}
+
+    // the real data is stored in the same buffer as its half-spectrum, so each row is padded to hold both
+    std::size_t row = 2*(lattice.padded[2]/2+1);
+    if (max_memory < lattice.padded[0]*lattice.padded[1]*row*sizeof(double)) {return std::nullopt;}
+
+    lattice.sets.resize(sets.size());
+    for (unsigned int s = 0; s < sets.size(); ++s) {
+        auto& set = lattice.sets[s];
+        set.weight = sets[s]->size() == 0 ? 0 : sets[s]->get_data().front().value.w;
+        set.cells.resize(indices[s].size());
+        std::transform(indices[s].begin(), indices[s].end(), set.cells.begin(), [&] (const std::array<long, 3>& index) {
+            std::size_t x = (index[0] - min[0])/divisor[0], y = (index[1] - min[1])/divisor[1], z = (index[2] - min[2])/divisor[2];
+            return (x*lattice.padded[1] + y)*row + z;
+        });
+    }
+    lattice.autocorrelations.resize(sets.size());
+    return lattice;
+}
+
+hist::WeightedDistribution1D LatticeCorrelation::self(unsigned int set, unsigned int bins) {
+    Binned binned = autocorrelation(set, bins);
+
+    // the self-correlation terms are all at the origin
+    binned.counts[0] -= static_cast<long>(sets[set].cells.size());
+    return distribution(binned, sets[set].weight*sets[set].weight, 1);
+}
+
+hist::WeightedDistribution1D LatticeCorrelation::cross(unsigned int set1, unsigned int set2, unsigned int bins, int factor) {
+    // the autocorrelation of A+B is AA + BB + AB + BA, and AB and BA have the same distances since BA(d) = AB(-d)
+    Binned binned = autocorrelate({set1, set2}, bins);
+    for (auto set : {set1, set2}) {
+        const auto& single = autocorrelation(set, bins);
+        for (unsigned int i = 0; i < bins; ++i) {
+            binned.counts[i] -= single.counts[i];
+            binned.distances[i] -= single.distances[i];
+        }
+    }
+    return distribution(binned, sets[set1].weight*sets[set2].weight, factor/2.);
+}
+
+const LatticeCorrelation::Binned& LatticeCorrelation::autocorrelation(unsigned int set, unsigned int bins) {
+    auto& binned = autocorrelations[set];
+    if (binned.counts.size() != bins) {binned = autocorrelate({set}, bins);}
+    return binned;
+}
+
+LatticeCorrelation::Binned LatticeCorrelation::autocorrelate(const std::vector<unsigned int>& members, unsigned int bins) {
+    std::size_t row = 2*(padded[2]/2+1);
+    buffer.assign(padded[0]*padded[1]*row/2, complex(0));
+    double* values = reinterpret_cast<double*>(buffer.data());
+    for (auto set : members) {
+        for (auto cell : sets[set].cells) {values[cell] += 1;}
+    }
+    transform(buffer, padded, false);
+    for (auto& v : buffer) {v = std::norm(v);}
+    transform(buffer, padded, true);
+
+    // bin the correlation by the lengths of the lattice vectors
+    Binned binned{std::vector<long>(bins, 0), std::vector<double>(bins, 0)};
+    double norm = 1./static_cast<double>(padded[0]*padded[1]*padded[2]);
+    for (int dx = 1-extent[0]; dx < extent[0]; ++dx) {
+        std::size_t ix = (dx + padded[0]) % padded[0];
+        for (int dy = 1-extent[1]; dy < extent[1]; ++dy) {
+            std::size_t iy = (dy + padded[1]) % padded[1];
+            for (int dz = 1-extent[2]; dz < extent[2]; ++dz) {
+                std::size_t iz = (dz + padded[2]) % padded[2];
+                long count = std::lround(values[(ix*padded[1] + iy)*row + iz]*norm);
+                if (count <= 0) {continue;}
+
+                // single precision to match the binning of the pairwise evaluation
+                float distance = std::sqrt(static_cast<float>(dx*step[0]*dx*step[0] + dy*step[1]*dy*step[1] + dz*step[2]*dz*step[2]));
+                int i = static_cast<int>(distance*constants::axes::d_inv_width + 0.5);
+                if (static_cast<int>(bins) <= i) [[unlikely]] {
+                    throw except::out_of_bounds("LatticeCorrelation::autocorrelate: Too few bins to hold the distance " + std::to_string(distance) + ".");
+                }
+                binned.counts[i] += count;
+                binned.distances[i] += count*static_cast<double>(distance);
+            }
+        }
+    }
+    return binned;
+}
+
+hist::WeightedDistribution1D LatticeCorrelation::distribution(const Binned& binned, double weight, double factor) {
+    WeightedDistribution1D p(binned.counts.size());
+    for (unsigned int i = 0; i < binned.counts.size(); ++i) {
+        if (binned.counts[i] <= 0) {continue;}
+        double n = binned.counts[i]*factor;
+        p.index(i) = WeightedEntry(n*weight, static_cast<unsigned int>(std::lround(n)), binned.distances[i]*factor);
+    }
+    return p;
+}
\ No newline at end of file
@@ -21,6 +21,14 @@ void SimpleExvModel::disable() {
     logging::log("SimpleExvModel disabled.");
 }
 
+void SimpleExvModel::set_enabled(bool enabled) {
+    flag_simple_excluded_volume = enabled;
+}
+
+bool SimpleExvModel::is_enabled() {
+    return flag_simple_excluded_volume;
+}
+
 void SimpleExvModel::apply_simple_excluded_volume(hist::detail::CompactCoordinates& data_a, observer_ptr<const data::Molecule> protein) {
     if (flag_simple_excluded_volume) {
         data_a.implicit_excluded_volume(protein->get_volume_grid()/protein->size_atom());
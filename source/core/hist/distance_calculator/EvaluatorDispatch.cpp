@@ -0,0 +1,205 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/distance_calculator/detail/EvaluatorDispatch.h>
+
+#include <cmath>
+
+#if defined AUSAXS_CPU_X86
+    #include <immintrin.h>
+#endif
+
+using namespace ausaxs;
+using namespace ausaxs::hist::distance_calculator::detail;
+using hist::detail::CompactCoordinatesData;
+using utility::cpu::InstructionSet;
+
+// note: the squared distances are summed in the order (dx^2 + dy^2) + dz^2 without fused multiply-adds in all evaluators.
+//       this matches the masked dot products of the compile-time CompactCoordinatesData paths, such that all evaluators produce identical bins.
+namespace scalar {
+    inline float distance(const CompactCoordinatesData& a, const CompactCoordinatesData& b) {
+        float dx = a.data[0] - b.data[0];
+        float dy = a.data[1] - b.data[1];
+        float dz = a.data[2] - b.data[2];
+        return std::sqrt((dx*dx + dy*dy) + dz*dz);
+    }
+
+    hist::detail::EvaluatedResult evaluate1(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        return hist::detail::EvaluatedResult(distance(atom, others[0]), atom.value.w*others[0].value.w);
+    }
+
+    hist::detail::EvaluatedResultRounded evaluate1_rounded(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        return hist::detail::EvaluatedResultRounded(std::round(hist::detail::inv_width*distance(atom, others[0])), atom.value.w*others[0].value.w);
+    }
+
+    template<typename result_t, int N>
+    result_t evaluate(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        result_t result;
+        for (int k = 0; k < N; ++k) {
+            result.distances[k] = distance(atom, others[k]);
+            result.weights[k] = atom.value.w*others[k].value.w;
+        }
+        return result;
+    }
+
+    template<typename result_t, int N>
+    result_t evaluate_rounded(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        result_t result;
+        for (int k = 0; k < N; ++k) {
+            result.distances[k] = std::round(hist::detail::inv_width*distance(atom, others[k]));
+            result.weights[k] = atom.value.w*others[k].value.w;
+        }
+        return result;
+    }
+}
+
+#if defined AUSAXS_CPU_X86
+namespace sse {
+    /**
+     * @brief Transpose four consecutive atoms into |x1|x2|x3|x4|, |y1|y2|y3|y4|, ... registers and calculate their squared distances and combined weights to the given atom.
+     */
+    AUSAXS_TARGET_SSE41 inline void squared_distances(const CompactCoordinatesData& atom, const CompactCoordinatesData* others, __m128& dist2, __m128& weights) {
+        __m128 x = _mm_loadu_ps(others[0].data.data());
+        __m128 y = _mm_loadu_ps(others[1].data.data());
+        __m128 z = _mm_loadu_ps(others[2].data.data());
+        __m128 w = _mm_loadu_ps(others[3].data.data());
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        __m128 dx = _mm_sub_ps(_mm_set1_ps(atom.data[0]), x);
+        __m128 dy = _mm_sub_ps(_mm_set1_ps(atom.data[1]), y);
+        __m128 dz = _mm_sub_ps(_mm_set1_ps(atom.data[2]), z);
+        dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        weights = _mm_mul_ps(_mm_set1_ps(atom.value.w), w);
+    }
+
+    AUSAXS_TARGET_SSE41 hist::detail::QuadEvaluatedResult evaluate4(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        __m128 dist2, weights;
+        squared_distances(atom, others, dist2, weights);
+
+        hist::detail::QuadEvaluatedResult result;
+        _mm_storeu_ps(result.distances.data(), _mm_sqrt_ps(dist2));
+        _mm_storeu_ps(result.weights.data(), weights);
+        return result;
+    }
+
+    AUSAXS_TARGET_SSE41 hist::detail::QuadEvaluatedResultRounded evaluate4_rounded(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        __m128 dist2, weights;
+        squared_distances(atom, others, dist2, weights);
+        __m128i dist_bin = _mm_cvtps_epi32(_mm_mul_ps(_mm_sqrt_ps(dist2), _mm_set1_ps(hist::detail::inv_width)));
+
+        hist::detail::QuadEvaluatedResultRounded result;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result.distances.data()), dist_bin);
+        _mm_storeu_ps(result.weights.data(), weights);
+        return result;
+    }
+
+    AUSAXS_TARGET_SSE41 hist::detail::OctoEvaluatedResult evaluate8(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        hist::detail::OctoEvaluatedResult result;
+        for (int half = 0; half < 8; half += 4) {
+            __m128 dist2, weights;
+            squared_distances(atom, others+half, dist2, weights);
+            _mm_storeu_ps(result.distances.data()+half, _mm_sqrt_ps(dist2));
+            _mm_storeu_ps(result.weights.data()+half, weights);
+        }
+        return result;
+    }
+
+    AUSAXS_TARGET_SSE41 hist::detail::OctoEvaluatedResultRounded evaluate8_rounded(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        hist::detail::OctoEvaluatedResultRounded result;
+        for (int half = 0; half < 8; half += 4) {
+            __m128 dist2, weights;
+            squared_distances(atom, others+half, dist2, weights);
+            __m128i dist_bin = _mm_cvtps_epi32(_mm_mul_ps(_mm_sqrt_ps(dist2), _mm_set1_ps(hist::detail::inv_width)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result.distances.data()+half), dist_bin);
+            _mm_storeu_ps(result.weights.data()+half, weights);
+        }
+        return result;
+    }
+}
+
+namespace avx {
+    /**
+     * @brief Transpose eight consecutive atoms into |x1|...|x8|, |y1|...|y8|, ... registers and calculate their squared distances and combined weights to the given atom.
+     *        Atoms k and k+4 share a register, such that the transpose can be done independently within each 128-bit lane.
+     */
+    AUSAXS_TARGET_AVX inline void squared_distances(const CompactCoordinatesData& atom, const CompactCoordinatesData* others, __m256& dist2, __m256& weights) {
+        __m256 r0 = _mm256_set_m128(_mm_loadu_ps(others[4].data.data()), _mm_loadu_ps(others[0].data.data()));   // |x1|y1|z1|w1|x5|y5|z5|w5|
+        __m256 r1 = _mm256_set_m128(_mm_loadu_ps(others[5].data.data()), _mm_loadu_ps(others[1].data.data()));   // |x2|y2|z2|w2|x6|y6|z6|w6|
+        __m256 r2 = _mm256_set_m128(_mm_loadu_ps(others[6].data.data()), _mm_loadu_ps(others[2].data.data()));   // |x3|y3|z3|w3|x7|y7|z7|w7|
+        __m256 r3 = _mm256_set_m128(_mm_loadu_ps(others[7].data.data()), _mm_loadu_ps(others[3].data.data()));   // |x4|y4|z4|w4|x8|y8|z8|w8|
+
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1);                         // |x1|x2|y1|y2|x5|x6|y5|y6|
+        __m256 t1 = _mm256_unpacklo_ps(r2, r3);                         // |x3|x4|y3|y4|x7|x8|y7|y8|
+        __m256 t2 = _mm256_unpackhi_ps(r0, r1);                         // |z1|z2|w1|w2|z5|z6|w5|w6|
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);                         // |z3|z4|w3|w4|z7|z8|w7|w8|
+        __m256 x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));  // |x1|x2|x3|x4|x5|x6|x7|x8|
+        __m256 y = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));  // |y1|y2|y3|y4|y5|y6|y7|y8|
+        __m256 z = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));  // |z1|z2|z3|z4|z5|z6|z7|z8|
+        __m256 w = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));  // |w1|w2|w3|w4|w5|w6|w7|w8|
+
+        __m256 dx = _mm256_sub_ps(_mm256_set1_ps(atom.data[0]), x);
+        __m256 dy = _mm256_sub_ps(_mm256_set1_ps(atom.data[1]), y);
+        __m256 dz = _mm256_sub_ps(_mm256_set1_ps(atom.data[2]), z);
+        dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+        weights = _mm256_mul_ps(_mm256_set1_ps(atom.value.w), w);
+    }
+
+    AUSAXS_TARGET_AVX hist::detail::OctoEvaluatedResult evaluate8(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        __m256 dist2, weights;
+        squared_distances(atom, others, dist2, weights);
+
+        hist::detail::OctoEvaluatedResult result;
+        _mm256_storeu_ps(result.distances.data(), _mm256_sqrt_ps(dist2));
+        _mm256_storeu_ps(result.weights.data(), weights);
+        return result;
+    }
+
+    AUSAXS_TARGET_AVX hist::detail::OctoEvaluatedResultRounded evaluate8_rounded(const CompactCoordinatesData& atom, const CompactCoordinatesData* others) {
+        __m256 dist2, weights;
+        squared_distances(atom, others, dist2, weights);
+        __m256i dist_bin = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_sqrt_ps(dist2), _mm256_set1_ps(hist::detail::inv_width)));
+
+        hist::detail::OctoEvaluatedResultRounded result;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result.distances.data()), dist_bin);
+        _mm256_storeu_ps(result.weights.data(), weights);
+        return result;
+    }
+}
+#endif
+
+dispatch::Evaluators dispatch::get_evaluators(InstructionSet set) {
+    #if defined AUSAXS_CPU_X86
+        // single evaluations cannot be vectorized, and the 4-wide evaluations gain nothing from the 256-bit registers.
+        // the 8-wide AVX evaluators are also used on AVX2 and AVX-512 machines, since the AoS layout cannot fill wider registers without extra shuffles.
+        if (static_cast<int>(InstructionSet::AVX) <= static_cast<int>(set)) {
+            return {
+                scalar::evaluate1, scalar::evaluate1_rounded,
+                sse::evaluate4, sse::evaluate4_rounded,
+                avx::evaluate8, avx::evaluate8_rounded,
+                InstructionSet::AVX
+            };
+        }
+        if (set == InstructionSet::SSE41) {
+            return {
+                scalar::evaluate1, scalar::evaluate1_rounded,
+                sse::evaluate4, sse::evaluate4_rounded,
+                sse::evaluate8, sse::evaluate8_rounded,
+                InstructionSet::SSE41
+            };
+        }
+    #endif
+    (void) set;
+    return {
+        scalar::evaluate1, scalar::evaluate1_rounded,
+        scalar::evaluate<hist::detail::QuadEvaluatedResult, 4>, scalar::evaluate_rounded<hist::detail::QuadEvaluatedResultRounded, 4>,
+        scalar::evaluate<hist::detail::OctoEvaluatedResult, 8>, scalar::evaluate_rounded<hist::detail::OctoEvaluatedResultRounded, 8>,
+        InstructionSet::Scalar
+    };
+}
+
+const dispatch::Evaluators& dispatch::get_evaluators() {
+    static Evaluators evaluators = get_evaluators(utility::cpu::get_instruction_set());
+    return evaluators;
+}
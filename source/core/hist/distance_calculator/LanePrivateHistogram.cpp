@@ -0,0 +1,56 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/distance_calculator/detail/LanePrivateHistogram.h>
+#include <utility/CPUFeatures.h>
+
+#include <algorithm>
+
+#if defined AUSAXS_CPU_X86
+    #include <immintrin.h>
+#endif
+
+using namespace ausaxs;
+using namespace ausaxs::hist::distance_calculator::detail;
+
+static constexpr int lanes = LanePrivateHistogram<false>::lanes;
+
+namespace scalar {
+    void scatter_add(double* data, const int32_t* bins, const float* weights, int n, int32_t overflow, double factor) {
+        for (int k = 0; k < n; ++k) {
+            data[std::min(bins[k], overflow)*lanes + (k & (lanes-1))] += factor*static_cast<double>(weights[k]);
+        }
+    }
+}
+
+#if defined AUSAXS_CPU_X86
+namespace avx512 {
+    AUSAXS_TARGET_AVX512 void scatter_add(double* data, const int32_t* bins, const float* weights, int n, int32_t overflow, double factor) {
+        static_assert(lanes == 8, "The AVX-512 kernel processes exactly one double per lane.");
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i last = _mm256_set1_epi32(overflow);
+        const __m512d f = _mm512_set1_pd(factor);
+        int k = 0;
+        for (; k+8 <= n; k += 8) {
+            // the lane offset guarantees that all eight addresses are distinct, so the scatter never has to resolve conflicts
+            __m256i bin = _mm256_min_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bins+k)), last);
+            __m256i idx = _mm256_add_epi32(_mm256_slli_epi32(bin, 3), lane);
+
+            // the zero-masked forms are used since the unmasked ones start from an uninitialized register, which GCC warns about
+            __m512d w = _mm512_mul_pd(f, _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(weights+k)));
+            __m512d v = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, data, 8);
+            _mm512_i32scatter_pd(data, idx, _mm512_add_pd(v, w), 8);
+        }
+        scalar::scatter_add(data, bins+k, weights+k, n-k, overflow, factor); // k is a multiple of the lane count, so the lanes of the remainder are unchanged
+    }
+}
+#endif
+
+lane_private::scatter_add_t lane_private::get_scatter_add() {
+    #if defined AUSAXS_CPU_X86
+        if (utility::cpu::supports(utility::cpu::InstructionSet::AVX512)) {return avx512::scatter_add;}
+    #endif
+    return scalar::scatter_add;
+}
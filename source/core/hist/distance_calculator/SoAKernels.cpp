@@ -0,0 +1,126 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0. 
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/distance_calculator/detail/SoAKernels.h>
+
+#include <cmath>
+
+#if defined AUSAXS_CPU_X86
+    #include <immintrin.h>
+#endif
+
+using namespace ausaxs;
+using namespace ausaxs::hist::distance_calculator::detail;
+using utility::cpu::InstructionSet;
+
+// note: the squared distances are summed in the order (dx^2 + dy^2) + dz^2 without fused multiply-adds in all kernels. 
+//       this matches the CompactCoordinatesData evaluations exactly, such that the SoA and AoS paths produce identical bins.
+namespace scalar {
+    void evaluate_rounded(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float inv_width, int32_t* bins, float* weights) {
+        for (int j = 0; j < n; ++j) {
+            float dx = atom[0] - x[j];
+            float dy = atom[1] - y[j];
+            float dz = atom[2] - z[j];
+            bins[j] = static_cast<int32_t>(std::round(inv_width*std::sqrt((dx*dx + dy*dy) + dz*dz)));
+            weights[j] = atom[3]*w[j];
+        }
+    }
+
+    void evaluate(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float* distances, float* weights) {
+        for (int j = 0; j < n; ++j) {
+            float dx = atom[0] - x[j];
+            float dy = atom[1] - y[j];
+            float dz = atom[2] - z[j];
+            distances[j] = std::sqrt((dx*dx + dy*dy) + dz*dz);
+            weights[j] = atom[3]*w[j];
+        }
+    }
+}
+
+#if defined AUSAXS_CPU_X86
+namespace avx {
+    AUSAXS_TARGET_AVX void evaluate_rounded(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float inv_width, int32_t* bins, float* weights) {
+        __m256 xi = _mm256_set1_ps(atom[0]);
+        __m256 yi = _mm256_set1_ps(atom[1]);
+        __m256 zi = _mm256_set1_ps(atom[2]);
+        __m256 wi = _mm256_set1_ps(atom[3]);
+        __m256 inv = _mm256_set1_ps(inv_width);
+        for (int j = 0; j < n; j += 8) {
+            __m256 dx = _mm256_sub_ps(xi, _mm256_loadu_ps(x+j));
+            __m256 dy = _mm256_sub_ps(yi, _mm256_loadu_ps(y+j));
+            __m256 dz = _mm256_sub_ps(zi, _mm256_loadu_ps(z+j));
+            __m256 dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            __m256 dist_binf = _mm256_mul_ps(_mm256_sqrt_ps(dist2), inv);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(bins+j), _mm256_cvtps_epi32(dist_binf));
+            _mm256_storeu_ps(weights+j, _mm256_mul_ps(wi, _mm256_loadu_ps(w+j)));
+        }
+    }
+
+    AUSAXS_TARGET_AVX void evaluate(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float* distances, float* weights) {
+        __m256 xi = _mm256_set1_ps(atom[0]);
+        __m256 yi = _mm256_set1_ps(atom[1]);
+        __m256 zi = _mm256_set1_ps(atom[2]);
+        __m256 wi = _mm256_set1_ps(atom[3]);
+        for (int j = 0; j < n; j += 8) {
+            __m256 dx = _mm256_sub_ps(xi, _mm256_loadu_ps(x+j));
+            __m256 dy = _mm256_sub_ps(yi, _mm256_loadu_ps(y+j));
+            __m256 dz = _mm256_sub_ps(zi, _mm256_loadu_ps(z+j));
+            __m256 dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            _mm256_storeu_ps(distances+j, _mm256_sqrt_ps(dist2));
+            _mm256_storeu_ps(weights+j, _mm256_mul_ps(wi, _mm256_loadu_ps(w+j)));
+        }
+    }
+}
+
+namespace avx512 {
+    AUSAXS_TARGET_AVX512 void evaluate_rounded(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float inv_width, int32_t* bins, float* weights) {
+        __m512 xi = _mm512_set1_ps(atom[0]);
+        __m512 yi = _mm512_set1_ps(atom[1]);
+        __m512 zi = _mm512_set1_ps(atom[2]);
+        __m512 wi = _mm512_set1_ps(atom[3]);
+        __m512 inv = _mm512_set1_ps(inv_width);
+        for (int j = 0; j < n; j += 16) {
+            __m512 dx = _mm512_sub_ps(xi, _mm512_loadu_ps(x+j));
+            __m512 dy = _mm512_sub_ps(yi, _mm512_loadu_ps(y+j));
+            __m512 dz = _mm512_sub_ps(zi, _mm512_loadu_ps(z+j));
+            __m512 dist2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)), _mm512_mul_ps(dz, dz));
+            // the zero-masked forms are used since the unmasked ones start from an uninitialized register, which GCC warns about
+            __m512 dist_binf = _mm512_mul_ps(_mm512_maskz_sqrt_ps(0xFFFF, dist2), inv);
+            _mm512_storeu_si512(bins+j, _mm512_maskz_cvtps_epi32(0xFFFF, dist_binf));
+            _mm512_storeu_ps(weights+j, _mm512_mul_ps(wi, _mm512_loadu_ps(w+j)));
+        }
+    }
+
+    AUSAXS_TARGET_AVX512 void evaluate(const float* atom, const float* x, const float* y, const float* z, const float* w, int n, float* distances, float* weights) {
+        __m512 xi = _mm512_set1_ps(atom[0]);
+        __m512 yi = _mm512_set1_ps(atom[1]);
+        __m512 zi = _mm512_set1_ps(atom[2]);
+        __m512 wi = _mm512_set1_ps(atom[3]);
+        for (int j = 0; j < n; j += 16) {
+            __m512 dx = _mm512_sub_ps(xi, _mm512_loadu_ps(x+j));
+            __m512 dy = _mm512_sub_ps(yi, _mm512_loadu_ps(y+j));
+            __m512 dz = _mm512_sub_ps(zi, _mm512_loadu_ps(z+j));
+            __m512 dist2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)), _mm512_mul_ps(dz, dz));
+            _mm512_storeu_ps(distances+j, _mm512_maskz_sqrt_ps(0xFFFF, dist2));
+            _mm512_storeu_ps(weights+j, _mm512_mul_ps(wi, _mm512_loadu_ps(w+j)));
+        }
+    }
+}
+#endif
+
+soa::Kernels soa::get_kernels(InstructionSet set) {
+    #if defined AUSAXS_CPU_X86
+        // the 256-bit kernels only use AVX instructions, so they are also valid on AVX2 machines
+        if (set == InstructionSet::AVX512) {return {avx512::evaluate_rounded, avx512::evaluate, InstructionSet::AVX512};}
+        if (set == InstructionSet::AVX2 || set == InstructionSet::AVX) {return {avx::evaluate_rounded, avx::evaluate, InstructionSet::AVX};}
+    #endif
+    (void) set;
+    return {scalar::evaluate_rounded, scalar::evaluate, InstructionSet::Scalar};
+}
+
+const soa::Kernels& soa::get_kernels() {
+    static Kernels kernels = get_kernels(utility::cpu::get_instruction_set());
+    return kernels;
+}
@@ -13,6 +13,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <hist/distribution/GenericDistribution1D.h>
 #include <hist/detail/CompactCoordinates.h>
 #include <hist/detail/SimpleExvModel.h>
+#include <hist/detail/RequiredBins.h>
 #include <settings/HistogramSettings.h>
 #include <constants/ConstantsAxes.h>
 
@@ -31,29 +32,32 @@ std::unique_ptr<DistanceHistogram> HistogramManager<use_weighted_distribution>::
 template<bool use_weighted_distribution>
 std::unique_ptr<ICompositeDistanceHistogram> HistogramManager<use_weighted_distribution>::calculate_all() {
     using GenericDistribution1D_t = typename hist::GenericDistribution1D<use_weighted_distribution>::type;
-    GenericDistribution1D_t p_aa(constants::axes::d_axis.bins);
-    GenericDistribution1D_t p_ww(constants::axes::d_axis.bins);
-    GenericDistribution1D_t p_aw(constants::axes::d_axis.bins);
-
     hist::detail::CompactCoordinates data_a(protein->get_bodies());
     hist::detail::CompactCoordinates data_w = hist::detail::CompactCoordinates(protein->get_waters());
+
+    // only allocate as many bins as the size of the molecule requires
+    unsigned int bins = hist::detail::required_bins(data_a, data_w);
+    GenericDistribution1D_t p_aa(bins);
+    GenericDistribution1D_t p_ww(bins);
+    GenericDistribution1D_t p_aw(bins);
     int data_a_size = (int) data_a.size();
     int data_w_size = (int) data_w.size();
     hist::detail::SimpleExvModel::apply_simple_excluded_volume(data_a, protein);
 
     // calculate aa distances
+    const auto& ev = ausaxs::detail::evaluators();
     for (int i = 0; i < data_a_size; ++i) {
         int j = i+1;
         for (; j+7 < data_a_size; j+=8) {
-            evaluate8<use_weighted_distribution, 2>(p_aa, data_a, data_a, i, j);
+            evaluate8<use_weighted_distribution, 2>(ev, p_aa, data_a, data_a, i, j);
         }
 
         for (; j+3 < data_a_size; j+=4) {
-            evaluate4<use_weighted_distribution, 2>(p_aa, data_a, data_a, i, j);
+            evaluate4<use_weighted_distribution, 2>(ev, p_aa, data_a, data_a, i, j);
         }
 
         for (; j < data_a_size; ++j) {
-            evaluate1<use_weighted_distribution, 2>(p_aa, data_a, data_a, i, j);
+            evaluate1<use_weighted_distribution, 2>(ev, p_aa, data_a, data_a, i, j);
         }
     }
 
@@ -62,15 +66,15 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManager<use_weighted_distr
         {
             int j = i+1;
             for (; j+7 < data_w_size; j+=8) {
-                evaluate8<use_weighted_distribution, 2>(p_ww, data_w, data_w, i, j);
+                evaluate8<use_weighted_distribution, 2>(ev, p_ww, data_w, data_w, i, j);
             }
 
             for (; j+3 < data_w_size; j+=4) {
-                evaluate4<use_weighted_distribution, 2>(p_ww, data_w, data_w, i, j);
+                evaluate4<use_weighted_distribution, 2>(ev, p_ww, data_w, data_w, i, j);
             }
 
             for (; j < data_w_size; ++j) {
-                evaluate1<use_weighted_distribution, 2>(p_ww, data_w, data_w, i, j);
+                evaluate1<use_weighted_distribution, 2>(ev, p_ww, data_w, data_w, i, j);
             }
         }
         
@@ -78,15 +82,15 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManager<use_weighted_distr
         {
             int j = 0;
             for (; j+7 < data_a_size; j+=8) {
-                evaluate8<use_weighted_distribution, 2>(p_aw, data_w, data_a, i, j);
+                evaluate8<use_weighted_distribution, 2>(ev, p_aw, data_w, data_a, i, j);
             }
 
             for (; j+3 < data_a_size; j+=4) {
-                evaluate4<use_weighted_distribution, 2>(p_aw, data_w, data_a, i, j);
+                evaluate4<use_weighted_distribution, 2>(ev, p_aw, data_w, data_a, i, j);
             }
 
             for (; j < data_a_size; ++j) {
-                evaluate1<use_weighted_distribution, 2>(p_aw, data_w, data_a, i, j);
+                evaluate1<use_weighted_distribution, 2>(ev, p_aw, data_w, data_a, i, j);
             }
         }
     }
@@ -96,7 +100,7 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManager<use_weighted_distr
     p_ww.add(0, std::accumulate(data_w.get_data().begin(), data_w.get_data().end(), 0.0, [](double sum, const hist::detail::CompactCoordinatesData& val) {return sum + std::pow(val.value.w, 2);}));
 
     // calculate p_tot
-    GenericDistribution1D_t p_tot(constants::axes::d_axis.bins);
+    GenericDistribution1D_t p_tot(bins);
     for (int i = 0; i < (int) p_aa.size(); ++i) {p_tot.index(i) = p_aa.index(i) + p_ww.index(i) + p_aw.index(i);}
 
     // downsize our axes to only the relevant area
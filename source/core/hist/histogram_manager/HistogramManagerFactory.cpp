@@ -13,6 +13,9 @@ For more information, please refer to the LICENSE file in the project root.
 #include <hist/histogram_manager/HistogramManagerMTFFGridScalableExv.h>
 #include <hist/histogram_manager/PartialHistogramManager.h>
 #include <hist/histogram_manager/PartialHistogramManagerMT.h>
+#include <hist/histogram_manager/PartialHistogramManagerMTFFAvg.h>
+#include <hist/histogram_manager/PartialHistogramManagerMTFFExplicit.h>
+#include <hist/histogram_manager/PartialHistogramManagerMTFFGrid.h>
 #include <settings/HistogramSettings.h>
 #include <data/Molecule.h>
 #include <utility/Exceptions.h>
@@ -45,6 +48,12 @@ std::unique_ptr<hist::IHistogramManager> hist::factory::construct_histogram_mana
                 return std::make_unique<PartialHistogramManager<true>>(protein);
             case settings::hist::HistogramManagerChoice::PartialHistogramManagerMT:
                 return std::make_unique<PartialHistogramManagerMT<true>>(protein);
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg:
+                return std::make_unique<PartialHistogramManagerMTFFAvg<true>>(protein);
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit:
+                return std::make_unique<PartialHistogramManagerMTFFExplicit<true>>(protein);
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFGrid:
+                return std::make_unique<PartialHistogramManagerMTFFGrid>(protein);
             // case settings::hist::HistogramManagerChoice::DebugManager:
             //     return std::make_unique<DebugManager<true>>(protein);
             case settings::hist::HistogramManagerChoice::FoXSManager:
@@ -71,6 +80,10 @@ std::unique_ptr<hist::IHistogramManager> hist::factory::construct_histogram_mana
                 return std::make_unique<PartialHistogramManager<false>>(protein);
             case settings::hist::HistogramManagerChoice::PartialHistogramManagerMT:
                 return std::make_unique<PartialHistogramManagerMT<false>>(protein);
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg:
+                return std::make_unique<PartialHistogramManagerMTFFAvg<false>>(protein);
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit:
+                return std::make_unique<PartialHistogramManagerMTFFExplicit<false>>(protein);
             case settings::hist::HistogramManagerChoice::FoXSManager:
             case settings::hist::HistogramManagerChoice::PepsiManager:
             case settings::hist::HistogramManagerChoice::CrysolManager:
@@ -9,6 +9,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <hist/distance_calculator/SimpleCalculator.h>
 #include <hist/detail/CompactCoordinates.h>
 #include <hist/detail/SimpleExvModel.h>
+#include <hist/detail/RequiredBins.h>
 #include <hist/distance_calculator/detail/TemplateHelpers.h>
 #include <data/Molecule.h>
 
@@ -31,7 +32,9 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMT<use_weighted_dis
     hist::detail::CompactCoordinates data_w(this->protein->get_waters());
     hist::detail::SimpleExvModel::apply_simple_excluded_volume(data_a, this->protein);
 
-    hist::distance_calculator::SimpleCalculator<use_weighted_distribution> calculator;
+    // only allocate as many bins as the size of the molecule requires
+    unsigned int bins = hist::detail::required_bins(data_a, data_w);
+    hist::distance_calculator::SimpleCalculator<use_weighted_distribution> calculator(bins);
     calculator.enqueue_calculate_self(data_a);
     calculator.enqueue_calculate_self(data_w);
     calculator.enqueue_calculate_cross(data_a, data_w);
@@ -42,7 +45,7 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMT<use_weighted_dis
     auto p_aw = res.cross[0];
 
     // calculate p_tot
-    GenericDistribution1D_t p_tot(constants::axes::d_axis.bins);
+    GenericDistribution1D_t p_tot(bins);
     for (unsigned int i = 0; i < p_tot.size(); ++i) {p_tot.index(i) = p_aa.index(i) + p_ww.index(i) + p_aw.index(i);}
 
     // downsize our axes to only the relevant area
@@ -9,6 +9,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <hist/distribution/GenericDistribution1D.h>
 #include <hist/distribution/GenericDistribution2D.h>
 #include <hist/distribution/GenericDistribution3D.h>
+#include <hist/detail/RequiredBins.h>
 #include <container/ThreadLocalWrapper.h>
 #include <form_factor/FormFactorType.h>
 #include <data/Molecule.h>
@@ -40,62 +41,68 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFAvg<use_weighte
     int data_a_size = (int) data_a.size();
     int data_w_size = (int) data_w.size();
 
+    // only allocate as many bins as the size of the molecule requires
+    unsigned int bins = hist::detail::required_bins(data_a, data_w);
+
     //########################//
     // PREPARE MULTITHREADING //
     //########################//
-    container::ThreadLocalWrapper<GenericDistribution3D_t> p_aa_all(form_factor::get_count(), form_factor::get_count(), constants::axes::d_axis.bins); // ff_type1, ff_type2, distance
+    container::ThreadLocalWrapper<GenericDistribution3D_t> p_aa_all(form_factor::get_count(), form_factor::get_count(), bins); // ff_type1, ff_type2, distance
     auto calc_aa = [&data_a, &p_aa_all, data_a_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_aa = p_aa_all.get();
         for (int i = imin; i < imax; ++i) { // atom
             int j = i+1;                    // atom
             for (; j+7 < data_a_size; j+=8) {
-                evaluate8<use_weighted_distribution, 2>(p_aa, data_a, data_a, i, j);
+                evaluate8<use_weighted_distribution, 2>(ev, p_aa, data_a, data_a, i, j);
             }
 
             for (; j+3 < data_a_size; j+=4) {
-                evaluate4<use_weighted_distribution, 2>(p_aa, data_a, data_a, i, j);
+                evaluate4<use_weighted_distribution, 2>(ev, p_aa, data_a, data_a, i, j);
             }
 
             for (; j < data_a_size; ++j) {
-                evaluate1<use_weighted_distribution, 2>(p_aa, data_a, data_a, i, j);
+                evaluate1<use_weighted_distribution, 2>(ev, p_aa, data_a, data_a, i, j);
             }
         }
     };
 
-    container::ThreadLocalWrapper<GenericDistribution2D_t> p_aw_all(form_factor::get_count(), constants::axes::d_axis.bins); // ff_type, distance
+    container::ThreadLocalWrapper<GenericDistribution2D_t> p_aw_all(form_factor::get_count(), bins); // ff_type, distance
     auto calc_aw = [&data_w, &data_a, &p_aw_all, data_w_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_aw = p_aw_all.get();
         for (int i = imin; i < imax; ++i) { // atom
             int j = 0;                      // water
             for (; j+7 < data_w_size; j+=8) {
-                evaluate8<use_weighted_distribution, 1>(p_aw, data_a, data_w, i, j);
+                evaluate8<use_weighted_distribution, 1>(ev, p_aw, data_a, data_w, i, j);
             }
 
             for (; j+3 < data_w_size; j+=4) {
-                evaluate4<use_weighted_distribution, 1>(p_aw, data_a, data_w, i, j);
+                evaluate4<use_weighted_distribution, 1>(ev, p_aw, data_a, data_w, i, j);
             }
 
             for (; j < data_w_size; ++j) {
-                evaluate1<use_weighted_distribution, 1>(p_aw, data_a, data_w, i, j);
+                evaluate1<use_weighted_distribution, 1>(ev, p_aw, data_a, data_w, i, j);
             }
         }
     };
 
-    container::ThreadLocalWrapper<GenericDistribution1D_t> p_ww_all(constants::axes::d_axis.bins); // distance
+    container::ThreadLocalWrapper<GenericDistribution1D_t> p_ww_all(bins); // distance
     auto calc_ww = [&data_w, &p_ww_all, data_w_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_ww = p_ww_all.get();
         for (int i = imin; i < imax; ++i) { // water
             int j = i+1;                    // water
             for (; j+7 < data_w_size; j+=8) {
-                evaluate8<use_weighted_distribution, 2>(p_ww, data_w, data_w, i, j);
+                evaluate8<use_weighted_distribution, 2>(ev, p_ww, data_w, data_w, i, j);
             }
 
             for (; j+3 < data_w_size; j+=4) {
-                evaluate4<use_weighted_distribution, 2>(p_ww, data_w, data_w, i, j);
+                evaluate4<use_weighted_distribution, 2>(ev, p_ww, data_w, data_w, i, j);
             }
 
             for (; j < data_w_size; ++j) {
-                evaluate1<use_weighted_distribution, 2>(p_ww, data_w, data_w, i, j);
+                evaluate1<use_weighted_distribution, 2>(ev, p_ww, data_w, data_w, i, j);
             }
         }
     };
@@ -135,7 +142,7 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFAvg<use_weighte
     p_ww.add(0, std::accumulate(data_w.get_data().begin(), data_w.get_data().end(), 0.0, [](double sum, const hist::detail::CompactCoordinatesData& data) {return sum + std::pow(data.value.w, 2);}));
 
     // this is counter-intuitive, but splitting the loop into separate parts is likely faster since it allows both SIMD optimizations and better cache usage
-    GenericDistribution1D_t p_tot(constants::axes::d_axis.bins);
+    GenericDistribution1D_t p_tot(bins);
     {   // sum all elements to the total
         for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
             for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
@@ -5,6 +5,8 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <hist/histogram_manager/HistogramManagerMTFFGridScalableExv.h>
 #include <hist/detail/CompactCoordinatesFF.h>
+#include <hist/detail/RequiredBins.h>
+#include <hist/detail/LatticeCorrelation.h>
 #include <hist/intensity_calculator/DistanceHistogram.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFAvg.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFGridScalableExv.h>
@@ -24,20 +26,20 @@ using namespace ausaxs::hist;
 // custom evaluates for the grid since we don't want to account for the excluded volume
 namespace ausaxs::grid {
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate8(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = ausaxs::detail::add8::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate8(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = ausaxs::detail::add8::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 8; ++k) {p.add(data_i.get_ff_type(i), res.distances[k], factor*res.weights[k]);}
     }
 
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate4(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = ausaxs::detail::add4::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate4(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = ausaxs::detail::add4::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 4; ++k) {p.add(data_i.get_ff_type(i), res.distances[k], factor*res.weights[k]);}
     }
 
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate1(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = ausaxs::detail::add1::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate1(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = ausaxs::detail::add1::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         p.add(data_i.get_ff_type(i), res.distance, factor*res.weight);
     }
 }
@@ -67,6 +69,7 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridScalableExv
         data_a = *this->data_a_ptr, 
         data_w = *this->data_w_ptr, 
         data_x = hist::detail::CompactCoordinates(this->protein->get_grid()->generate_excluded_volume(false).interior, 1),
+        width = this->protein->get_grid()->get_width(),
         pool] 
         (double scale) 
     {
@@ -82,64 +85,74 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridScalableExv
             coord.value.pos.z() *= scale;
         }
 
+        // the scaled excluded volume cells may extend beyond the atoms, and we must be able to hold all bins of the base histograms
+        unsigned int bins = std::max<unsigned int>(hist::detail::required_bins(data_a, data_w, scaled_data_x), p_tot.size());
+
+        // the scaled cells are still on a regular lattice, so their self-correlation can be found from the autocorrelation of the occupancy grid
+        std::optional<hist::detail::LatticeCorrelation> lattice;
+        if (settings::hist::detail::lattice_exv) {lattice = hist::detail::LatticeCorrelation::create({&scaled_data_x}, width*scale);}
+
         //########################//
         // PREPARE MULTITHREADING //
         //########################//
-        container::ThreadLocalWrapper<WeightedDistribution1D> p_xx_all(constants::axes::d_axis.bins);
+        container::ThreadLocalWrapper<WeightedDistribution1D> p_xx_all(bins);
         auto calc_xx = [&scaled_data_x, &p_xx_all, data_x_size] (int imin, int imax) {
+            const auto& ev = ausaxs::detail::evaluators();
             auto& p_xx = p_xx_all.get();
             for (int i = imin; i < imax; ++i) { // exv
                 int j = i+1;                    // exv
                 for (; j+7 < data_x_size; j+=8) {
-                    evaluate8<true, 2>(p_xx, scaled_data_x, scaled_data_x, i, j);
+                    evaluate8<true, 2>(ev, p_xx, scaled_data_x, scaled_data_x, i, j);
                 }
 
                 for (; j+3 < data_x_size; j+=4) {
-                    evaluate4<true, 2>(p_xx, scaled_data_x, scaled_data_x, i, j);
+                    evaluate4<true, 2>(ev, p_xx, scaled_data_x, scaled_data_x, i, j);
                 }
 
                 for (; j < data_x_size; ++j) {
-                    evaluate1<true, 2>(p_xx, scaled_data_x, scaled_data_x, i, j);
+                    evaluate1<true, 2>(ev, p_xx, scaled_data_x, scaled_data_x, i, j);
                 }
             }
             return p_xx;
         };
 
-        container::ThreadLocalWrapper<WeightedDistribution2D> p_ax_all(form_factor::get_count(), constants::axes::d_axis.bins);
+        container::ThreadLocalWrapper<WeightedDistribution2D> p_ax_all(form_factor::get_count(), bins);
         auto calc_ax = [&data_a, &scaled_data_x, &p_ax_all, data_x_size] (int imin, int imax) {
+            const auto& ev = ausaxs::detail::evaluators();
             auto& p_ax = p_ax_all.get();
             for (int i = imin; i < imax; ++i) { // atoms
                 int j = 0;                      // exv
                 for (; j+7 < data_x_size; j+=8) {
-                    grid::evaluate8<true, 1>(p_ax, data_a, scaled_data_x, i, j);
+                    grid::evaluate8<true, 1>(ev, p_ax, data_a, scaled_data_x, i, j);
                 }
 
                 for (; j+3 < data_x_size; j+=4) {
-                    grid::evaluate4<true, 1>(p_ax, data_a, scaled_data_x, i, j);
+                    grid::evaluate4<true, 1>(ev, p_ax, data_a, scaled_data_x, i, j);
                 }
 
                 for (; j < data_x_size; ++j) {
-                    grid::evaluate1<true, 1>(p_ax, data_a, scaled_data_x, i, j);
+                    grid::evaluate1<true, 1>(ev, p_ax, data_a, scaled_data_x, i, j);
                 }
             }
             return p_ax;
         };
 
-        container::ThreadLocalWrapper<WeightedDistribution1D> p_wx_all(constants::axes::d_axis.bins);
+        container::ThreadLocalWrapper<WeightedDistribution1D> p_wx_all(bins);
         auto calc_wx = [&data_w, &scaled_data_x, &p_wx_all, data_x_size] (int imin, int imax) {
+            const auto& ev = ausaxs::detail::evaluators();
             auto& p_wx = p_wx_all.get();
             for (int i = imin; i < imax; ++i) { // waters
                 int j = 0;                      // exv
                 for (; j+7 < data_x_size; j+=8) {
-                    evaluate8<true, 1>(p_wx, data_w, scaled_data_x, i, j);
+                    evaluate8<true, 1>(ev, p_wx, data_w, scaled_data_x, i, j);
                 }
 
                 for (; j+3 < data_x_size; j+=4) {
-                    evaluate4<true, 1>(p_wx, data_w, scaled_data_x, i, j);
+                    evaluate4<true, 1>(ev, p_wx, data_w, scaled_data_x, i, j);
                 }
 
                 for (; j < data_x_size; ++j) {
-                    evaluate1<true, 1>(p_wx, data_w, scaled_data_x, i, j);
+                    evaluate1<true, 1>(ev, p_wx, data_w, scaled_data_x, i, j);
                 }
             }
             return p_wx;
@@ -149,7 +162,7 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridScalableExv
         // SUBMIT TASKS //
         //##############//
         int job_size = settings::general::detail::job_size;
-        for (int i = 0; i < (int) data_x_size; i+=job_size) {
+        for (int i = 0; i < (int) data_x_size && !lattice; i+=job_size) {
             pool->detach_task(
                 [&calc_xx, i, job_size, data_x_size] () {return calc_xx(i, std::min(i+job_size, data_x_size));}
             );
@@ -166,7 +179,7 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridScalableExv
         }
 
         pool->wait();
-        WeightedDistribution1D p_xx_generic = p_xx_all.merge();
+        WeightedDistribution1D p_xx_generic = lattice ? lattice->self(0, bins) : p_xx_all.merge();
         WeightedDistribution2D p_ax_generic = p_ax_all.merge();
         WeightedDistribution1D p_wx_generic = p_wx_all.merge();
 
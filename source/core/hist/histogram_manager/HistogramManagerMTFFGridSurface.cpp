@@ -5,6 +5,8 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <hist/histogram_manager/HistogramManagerMTFFGridSurface.h>
 #include <hist/detail/CompactCoordinatesFF.h>
+#include <hist/detail/RequiredBins.h>
+#include <hist/detail/LatticeCorrelation.h>
 #include <hist/intensity_calculator/DistanceHistogram.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFAvg.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFGridSurface.h>
@@ -24,20 +26,20 @@ using namespace ausaxs::hist;
 // custom evaluates for the grid since we don't want to account for the excluded volume
 namespace ausaxs::grid {
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate8(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = ausaxs::detail::add8::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate8(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = ausaxs::detail::add8::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 8; ++k) {p.add(data_i.get_ff_type(i), res.distances[k], factor*res.weights[k]);}
     }
 
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate4(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = ausaxs::detail::add4::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate4(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = ausaxs::detail::add4::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         for (unsigned int k = 0; k < 4; ++k) {p.add(data_i.get_ff_type(i), res.distances[k], factor*res.weights[k]);}
     }
 
     template<bool use_weighted_distribution, int factor>
-    inline void evaluate1(typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
-        auto res = ausaxs::detail::add1::evaluate<use_weighted_distribution>(data_i, data_j, i, j);
+    inline void evaluate1(const ausaxs::detail::Evaluators& ev, typename hist::GenericDistribution2D<use_weighted_distribution>::type& p, const hist::detail::CompactCoordinatesFF& data_i, const hist::detail::CompactCoordinates& data_j, int i, int j) {
+        auto res = ausaxs::detail::add1::evaluate<use_weighted_distribution>(ev, data_i, data_j, i, j);
         p.add(data_i.get_ff_type(i), res.distance, factor*res.weight);
     }
 }
@@ -70,128 +72,140 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridSurface::ca
     int data_x_i_size = (int) data_x_i.size();
     int data_x_s_size = (int) data_x_s.size();
 
+    // the excluded volume cells may extend beyond the atoms, and we must be able to hold all bins of the base histograms
+    unsigned int bins = std::max<unsigned int>(hist::detail::required_bins(data_a, data_w, data_x_i, data_x_s), base_res->get_d_axis().size());
+
+    // the excluded volume cells are on a regular lattice, so their correlations can be found from the occupancy grids
+    std::optional<hist::detail::LatticeCorrelation> lattice;
+    if (settings::hist::detail::lattice_exv) {lattice = hist::detail::LatticeCorrelation::create({&data_x_i, &data_x_s}, this->protein->get_grid()->get_width());}
+
     //########################//
     // PREPARE MULTITHREADING //
     //########################//
-    container::ThreadLocalWrapper<XXContainer> p_xx_all(constants::axes::d_axis.bins);
+    container::ThreadLocalWrapper<XXContainer> p_xx_all(bins);
     auto calc_xx_ii = [&data_x_i, &p_xx_all, data_x_i_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_xx = p_xx_all.get();
         for (int i = imin; i < imax; ++i) { // exv interior
             int j = i+1;                    // exv interior
             for (; j+7 < data_x_i_size; j+=8) {
-                evaluate8<true, 2>(p_xx.interior, data_x_i, data_x_i, i, j);
+                evaluate8<true, 2>(ev, p_xx.interior, data_x_i, data_x_i, i, j);
             }
 
             for (; j+3 < data_x_i_size; j+=4) {
-                evaluate4<true, 2>(p_xx.interior, data_x_i, data_x_i, i, j);
+                evaluate4<true, 2>(ev, p_xx.interior, data_x_i, data_x_i, i, j);
             }
 
             for (; j < data_x_i_size; ++j) {
-                evaluate1<true, 2>(p_xx.interior, data_x_i, data_x_i, i, j);
+                evaluate1<true, 2>(ev, p_xx.interior, data_x_i, data_x_i, i, j);
             }
         }
         return p_xx;
     };
 
     auto calc_xx_ss = [&data_x_s, &p_xx_all, data_x_s_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_xx = p_xx_all.get();
         for (int i = imin; i < imax; ++i) { // exv surface
             int j = i+1;                    // exv surface
             for (; j+7 < data_x_s_size; j+=8) {
-                evaluate8<true, 2>(p_xx.surface, data_x_s, data_x_s, i, j);
+                evaluate8<true, 2>(ev, p_xx.surface, data_x_s, data_x_s, i, j);
             }
 
             for (; j+3 < data_x_s_size; j+=4) {
-                evaluate4<true, 2>(p_xx.surface, data_x_s, data_x_s, i, j);
+                evaluate4<true, 2>(ev, p_xx.surface, data_x_s, data_x_s, i, j);
             }
 
             for (; j < data_x_s_size; ++j) {
-                evaluate1<true, 2>(p_xx.surface, data_x_s, data_x_s, i, j);
+                evaluate1<true, 2>(ev, p_xx.surface, data_x_s, data_x_s, i, j);
             }
         }
         return p_xx;
     };
 
     auto calc_xx_si = [&data_x_i, &data_x_s, &p_xx_all, data_x_s_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_xx = p_xx_all.get();
         for (int i = imin; i < imax; ++i) { // exv interior
             int j = 0;                      // exv surface
             for (; j+7 < data_x_s_size; j+=8) {
-                evaluate8<true, 2>(p_xx.cross, data_x_i, data_x_s, i, j);
+                evaluate8<true, 2>(ev, p_xx.cross, data_x_i, data_x_s, i, j);
             }
 
             for (; j+3 < data_x_s_size; j+=4) {
-                evaluate4<true, 2>(p_xx.cross, data_x_i, data_x_s, i, j);
+                evaluate4<true, 2>(ev, p_xx.cross, data_x_i, data_x_s, i, j);
             }
 
             for (; j < data_x_s_size; ++j) {
-                evaluate1<true, 2>(p_xx.cross, data_x_i, data_x_s, i, j);
+                evaluate1<true, 2>(ev, p_xx.cross, data_x_i, data_x_s, i, j);
             }
         }
         return p_xx;
     };
 
-    container::ThreadLocalWrapper<AXContainer> p_ax_all(form_factor::get_count(), constants::axes::d_axis.bins);
+    container::ThreadLocalWrapper<AXContainer> p_ax_all(form_factor::get_count(), bins);
     auto calc_ax = [&data_a, &data_x_i, &data_x_s, &p_ax_all, data_x_i_size, data_x_s_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_ax = p_ax_all.get();
         for (int i = imin; i < imax; ++i) { // atoms
             int j = 0;                      // exv interior
             for (; j+7 < data_x_i_size; j+=8) {
-                grid::evaluate8<true, 1>(p_ax.interior, data_a, data_x_i, i, j);
+                grid::evaluate8<true, 1>(ev, p_ax.interior, data_a, data_x_i, i, j);
             }
 
             for (; j+3 < data_x_i_size; j+=4) {
-                grid::evaluate4<true, 1>(p_ax.interior, data_a, data_x_i, i, j);
+                grid::evaluate4<true, 1>(ev, p_ax.interior, data_a, data_x_i, i, j);
             }
 
             for (; j < data_x_i_size; ++j) {
-                grid::evaluate1<true, 1>(p_ax.interior, data_a, data_x_i, i, j);
+                grid::evaluate1<true, 1>(ev, p_ax.interior, data_a, data_x_i, i, j);
             }
 
             j = 0;                          // exv surface
             for (; j+7 < data_x_s_size; j+=8) {
-                grid::evaluate8<true, 1>(p_ax.surface, data_a, data_x_s, i, j);
+                grid::evaluate8<true, 1>(ev, p_ax.surface, data_a, data_x_s, i, j);
             }
 
             for (; j+3 < data_x_s_size; j+=4) {
-                grid::evaluate4<true, 1>(p_ax.surface, data_a, data_x_s, i, j);
+                grid::evaluate4<true, 1>(ev, p_ax.surface, data_a, data_x_s, i, j);
             }
 
             for (; j < data_x_s_size; ++j) {
-                grid::evaluate1<true, 1>(p_ax.surface, data_a, data_x_s, i, j);
+                grid::evaluate1<true, 1>(ev, p_ax.surface, data_a, data_x_s, i, j);
             }
         }
         return p_ax;
     };
 
-    container::ThreadLocalWrapper<WXContainer> p_wx_all(constants::axes::d_axis.bins);
+    container::ThreadLocalWrapper<WXContainer> p_wx_all(bins);
     auto calc_wx = [&data_w, &data_x_i, &data_x_s, &p_wx_all, data_x_i_size, data_x_s_size] (int imin, int imax) {
+        const auto& ev = ausaxs::detail::evaluators();
         auto& p_wx = p_wx_all.get();
         for (int i = imin; i < imax; ++i) { // waters
             int j = 0;                      // exv interior
             for (; j+7 < data_x_i_size; j+=8) {
-                evaluate8<true, 1>(p_wx.interior, data_w, data_x_i, i, j);
+                evaluate8<true, 1>(ev, p_wx.interior, data_w, data_x_i, i, j);
             }
 
             for (; j+3 < data_x_i_size; j+=4) {
-                evaluate4<true, 1>(p_wx.interior, data_w, data_x_i, i, j);
+                evaluate4<true, 1>(ev, p_wx.interior, data_w, data_x_i, i, j);
             }
 
             for (; j < data_x_i_size; ++j) {
-                evaluate1<true, 1>(p_wx.interior, data_w, data_x_i, i, j);
+                evaluate1<true, 1>(ev, p_wx.interior, data_w, data_x_i, i, j);
             }
 
             j = 0;                          // exv surface
             for (; j+7 < data_x_s_size; j+=8) {
-                evaluate8<true, 1>(p_wx.surface, data_w, data_x_s, i, j);
+                evaluate8<true, 1>(ev, p_wx.surface, data_w, data_x_s, i, j);
             }
 
             for (; j+3 < data_x_s_size; j+=4) {
-                evaluate4<true, 1>(p_wx.surface, data_w, data_x_s, i, j);
+                evaluate4<true, 1>(ev, p_wx.surface, data_w, data_x_s, i, j);
             }
 
             for (; j < data_x_s_size; ++j) {
-                evaluate1<true, 1>(p_wx.surface, data_w, data_x_s, i, j);
+                evaluate1<true, 1>(ev, p_wx.surface, data_w, data_x_s, i, j);
             }
         }
         return p_wx;
@@ -201,19 +215,19 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridSurface::ca
     // SUBMIT TASKS //
     //##############//
     int job_size = settings::general::detail::job_size;
-    for (int i = 0; i < (int) data_x_i_size; i+=job_size) {
+    for (int i = 0; i < (int) data_x_i_size && !lattice; i+=job_size) {
         pool->detach_task(
             [&calc_xx_ii, i, job_size, data_x_i_size] () {return calc_xx_ii(i, std::min(i+job_size, data_x_i_size));}
         );
     }
 
-    for (int i = 0; i < (int) data_x_s_size; i+=job_size) {
+    for (int i = 0; i < (int) data_x_s_size && !lattice; i+=job_size) {
         pool->detach_task(
             [&calc_xx_ss, i, job_size, data_x_s_size] () {return calc_xx_ss(i, std::min(i+job_size, data_x_s_size));}
         );
     }
 
-    for (int i = 0; i < (int) data_x_i_size; i+=job_size) {
+    for (int i = 0; i < (int) data_x_i_size && !lattice; i+=job_size) {
         pool->detach_task(
             [&calc_xx_si, i, job_size, data_x_i_size] () {return calc_xx_si(i, std::min(i+job_size, data_x_i_size));}
         );
@@ -232,7 +246,12 @@ std::unique_ptr<ICompositeDistanceHistogram> HistogramManagerMTFFGridSurface::ca
     }
 
     pool->wait();
-    XXContainer p_xx = p_xx_all.merge();
+    XXContainer p_xx = lattice ? XXContainer(0) : p_xx_all.merge();
+    if (lattice) {
+        p_xx.interior = lattice->self(0, bins);
+        p_xx.surface = lattice->self(1, bins);
+        p_xx.cross = lattice->cross(0, 1, bins, 2);
+    }
     AXContainer p_ax = p_ax_all.merge();
     WXContainer p_wx = p_wx_all.merge();
 
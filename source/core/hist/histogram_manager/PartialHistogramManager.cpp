@@ -154,18 +154,19 @@ void PartialHistogramManager<use_weighted_distribution>::calc_self_correlation(u
 
     // calculate internal distances between atoms
     GenericDistribution1D_t p_aa(this->master.axis.bins);
+    const auto& ev = ausaxs::detail::evaluators();
     for (unsigned int i = 0; i < current.size(); i++) {
         unsigned int j = i+1;
         for (; j+7 < current.size(); j+=8) {
-            evaluate8<use_weighted_distribution, 2>(p_aa, current, current, i, j);
+            evaluate8<use_weighted_distribution, 2>(ev, p_aa, current, current, i, j);
         }
 
         for (; j+3 < current.size(); j+=4) {
-            evaluate4<use_weighted_distribution, 2>(p_aa, current, current, i, j);
+            evaluate4<use_weighted_distribution, 2>(ev, p_aa, current, current, i, j);
         }
 
         for (; j < current.size(); ++j) {
-            evaluate1<use_weighted_distribution, 2>(p_aa, current, current, i, j);
+            evaluate1<use_weighted_distribution, 2>(ev, p_aa, current, current, i, j);
         }
     }
 
@@ -188,18 +189,19 @@ void PartialHistogramManager<use_weighted_distribution>::calc_aa(unsigned int n,
     auto& coords_m = this->coords_a[m];
 
     GenericDistribution1D_t p_aa(this->master.axis.bins);
+    const auto& ev = ausaxs::detail::evaluators();
     for (unsigned int i = 0; i < coords_n.size(); i++) {
         unsigned int j = 0;
         for (; j+7 < coords_m.size(); j+=8) {
-            evaluate8<use_weighted_distribution, 2>(p_aa, coords_n, coords_m, i, j);
+            evaluate8<use_weighted_distribution, 2>(ev, p_aa, coords_n, coords_m, i, j);
         }
 
         for (; j+3 < coords_m.size(); j+=4) {
-            evaluate4<use_weighted_distribution, 2>(p_aa, coords_n, coords_m, i, j);
+            evaluate4<use_weighted_distribution, 2>(ev, p_aa, coords_n, coords_m, i, j);
         }
 
         for (; j < coords_m.size(); ++j) {
-            evaluate1<use_weighted_distribution, 2>(p_aa, coords_n, coords_m, i, j);
+            evaluate1<use_weighted_distribution, 2>(ev, p_aa, coords_n, coords_m, i, j);
         }
     }
 
@@ -231,18 +233,19 @@ void PartialHistogramManager<use_weighted_distribution>::calc_aw(unsigned int in
     auto& coords = this->coords_a[index];
 
     GenericDistribution1D_t p_aw(this->master.axis.bins);
+    const auto& ev = ausaxs::detail::evaluators();
     for (unsigned int i = 0; i < coords.size(); i++) {
         unsigned int j = 0;
         for (; j+7 < this->coords_w.size(); j+=8) {
-            evaluate8<use_weighted_distribution, 2>(p_aw, coords, this->coords_w, i, j);
+            evaluate8<use_weighted_distribution, 2>(ev, p_aw, coords, this->coords_w, i, j);
         }
 
         for (; j+3 < this->coords_w.size(); j+=4) {
-            evaluate4<use_weighted_distribution, 2>(p_aw, coords, this->coords_w, i, j);
+            evaluate4<use_weighted_distribution, 2>(ev, p_aw, coords, this->coords_w, i, j);
         }
 
         for (; j < this->coords_w.size(); ++j) {
-            evaluate1<use_weighted_distribution, 2>(p_aw, coords, this->coords_w, i, j);
+            evaluate1<use_weighted_distribution, 2>(ev, p_aw, coords, this->coords_w, i, j);
         }
     }
 
@@ -256,18 +259,19 @@ void PartialHistogramManager<use_weighted_distribution>::calc_ww() {
     GenericDistribution1D_t p_ww(this->master.axis.bins);
 
     // calculate internal distances for the hydration layer
+    const auto& ev = ausaxs::detail::evaluators();
     for (unsigned int i = 0; i < this->coords_w.size(); i++) {
         unsigned int j = i+1;
         for (; j+7 < this->coords_w.size(); j+=8) {
-            evaluate8<use_weighted_distribution, 2>(p_ww, this->coords_w, this->coords_w, i, j);
+            evaluate8<use_weighted_distribution, 2>(ev, p_ww, this->coords_w, this->coords_w, i, j);
         }
 
         for (; j+3 < this->coords_w.size(); j+=4) {
-            evaluate4<use_weighted_distribution, 2>(p_ww, this->coords_w, this->coords_w, i, j);
+            evaluate4<use_weighted_distribution, 2>(ev, p_ww, this->coords_w, this->coords_w, i, j);
         }
 
         for (; j < this->coords_w.size(); ++j) {
-            evaluate1<use_weighted_distribution, 2>(p_ww, this->coords_w, this->coords_w, i, j);
+            evaluate1<use_weighted_distribution, 2>(ev, p_ww, this->coords_w, this->coords_w, i, j);
         }
     }
 
@@ -0,0 +1,204 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/histogram_manager/PartialHistogramManagerMTFFAvg.h>
+#include <hist/distance_calculator/detail/EnqueuePairs.h>
+#include <hist/intensity_calculator/CompositeDistanceHistogramFFAvg.h>
+#include <hist/detail/RequiredBins.h>
+#include <container/ThreadLocalWrapper.h>
+#include <form_factor/FormFactorType.h>
+#include <data/state/StateManager.h>
+#include <data/Molecule.h>
+#include <data/Body.h>
+#include <constants/Constants.h>
+#include <utility/MultiThreading.h>
+
+#include <memory>
+#include <numeric>
+
+using namespace ausaxs;
+using namespace ausaxs::hist;
+using distance_calculator::detail::enqueue_pairs;
+
+template<bool use_weighted_distribution>
+PartialHistogramManagerMTFFAvg<use_weighted_distribution>::PartialHistogramManagerMTFFAvg(observer_ptr<const data::Molecule> protein)
+    : IPartialHistogramManager(protein),
+      protein(protein),
+      coords_a(this->body_size),
+      partials_aa(this->body_size, this->body_size),
+      partials_aw(this->body_size)
+{}
+
+template<bool use_weighted_distribution>
+PartialHistogramManagerMTFFAvg<use_weighted_distribution>::~PartialHistogramManagerMTFFAvg() = default;
+
+template<bool use_weighted_distribution>
+void PartialHistogramManagerMTFFAvg<use_weighted_distribution>::update_partials() {
+    std::vector<bool> externally_modified = this->statemanager->get_externally_modified_bodies();
+    std::vector<bool> internally_modified = this->statemanager->get_internally_modified_bodies();
+    bool hydration_modified = this->statemanager->is_modified_hydration();
+    auto pool = utility::multi_threading::get_global_pool();
+
+    if (!initialized) [[unlikely]] {
+        externally_modified = std::vector<bool>(this->body_size, true);
+        internally_modified = std::vector<bool>(this->body_size, true);
+        hydration_modified = true;
+        initialized = true;
+    }
+
+    // update the compact representations of everything that was modified
+    for (unsigned int i = 0; i < this->body_size; ++i) {
+        if (externally_modified[i] || internally_modified[i]) {
+            pool->detach_task([this, i] () {coords_a[i] = detail::CompactCoordinatesFF(protein->get_body(i));});
+        }
+    }
+    if (hydration_modified) {
+        pool->detach_task([this] () {coords_w = detail::CompactCoordinatesFF(protein->get_waters());});
+    }
+    pool->wait();
+
+    // queue the recalculation of all affected partial histograms
+    // each is sized to only the distances possible between its two sets of coordinates
+    struct Job3D {unsigned int n, m; std::unique_ptr<container::ThreadLocalWrapper<GenericDistribution3D_t>> p;};
+    struct Job2D {unsigned int n; std::unique_ptr<container::ThreadLocalWrapper<GenericDistribution2D_t>> p;};
+    std::vector<Job3D> jobs_aa;
+    std::vector<Job2D> jobs_aw;
+    std::unique_ptr<container::ThreadLocalWrapper<GenericDistribution1D_t>> job_ww;
+    for (unsigned int n = 0; n < this->body_size; ++n) {
+        if (internally_modified[n]) {
+            auto& job = jobs_aa.emplace_back(n, n, std::make_unique<container::ThreadLocalWrapper<GenericDistribution3D_t>>(
+                form_factor::get_count(), form_factor::get_count(), detail::required_bins(coords_a[n])
+            ));
+            enqueue_pairs<use_weighted_distribution, 2, true>(coords_a[n], coords_a[n], *job.p);
+        }
+
+        // the bodies are concatenated in order in the full manager, so the body with the lowest index must be the first argument to get identical results
+        for (unsigned int m = 0; m < n; ++m) {
+            if (externally_modified[n] || externally_modified[m]) {
+                auto& job = jobs_aa.emplace_back(n, m, std::make_unique<container::ThreadLocalWrapper<GenericDistribution3D_t>>(
+                    form_factor::get_count(), form_factor::get_count(), detail::required_bins(coords_a[n], coords_a[m])
+                ));
+                enqueue_pairs<use_weighted_distribution, 2, false>(coords_a[m], coords_a[n], *job.p);
+            }
+        }
+
+        if (externally_modified[n] || hydration_modified) {
+            auto& job = jobs_aw.emplace_back(n, std::make_unique<container::ThreadLocalWrapper<GenericDistribution2D_t>>(
+                form_factor::get_count(), detail::required_bins(coords_a[n], coords_w)
+            ));
+            enqueue_pairs<use_weighted_distribution, 1, false>(coords_a[n], coords_w, *job.p);
+        }
+    }
+    if (hydration_modified) {
+        job_ww = std::make_unique<container::ThreadLocalWrapper<GenericDistribution1D_t>>(detail::required_bins(coords_w));
+        enqueue_pairs<use_weighted_distribution, 2, true>(coords_w, coords_w, *job_ww);
+    }
+    pool->wait();
+
+    // collect the results
+    for (auto& job : jobs_aa) {
+        auto& p = partials_aa.index(job.n, job.m);
+        p = job.p->merge();
+
+        // the self-correlations are only included in the diagonal partials
+        if (job.n == job.m) {
+            const auto& coords = coords_a[job.n];
+            for (unsigned int i = 0; i < coords.size(); ++i) {
+                p.add(coords.get_ff_type(i), coords.get_ff_type(i), 0, std::pow(coords[i].value.w, 2));
+            }
+            p.add(form_factor::exv_bin, form_factor::exv_bin, 0, coords.size());
+        }
+    }
+    for (auto& job : jobs_aw) {
+        partials_aw.index(job.n) = job.p->merge();
+    }
+    if (hydration_modified) {
+        partials_ww = job_ww->merge();
+        partials_ww.add(0, std::accumulate(coords_w.get_data().begin(), coords_w.get_data().end(), 0.0, [](double sum, const hist::detail::CompactCoordinatesData& data) {return sum + std::pow(data.value.w, 2);}));
+    }
+
+    this->statemanager->reset_to_false();
+}
+
+template<bool use_weighted_distribution>
+std::unique_ptr<DistanceHistogram> PartialHistogramManagerMTFFAvg<use_weighted_distribution>::calculate() {return calculate_all();}
+
+template<bool use_weighted_distribution>
+std::unique_ptr<ICompositeDistanceHistogram> PartialHistogramManagerMTFFAvg<use_weighted_distribution>::calculate_all() {
+    update_partials();
+
+    // sum all partial histograms
+    unsigned int bins = partials_ww.size();
+    for (unsigned int n = 0; n < this->body_size; ++n) {
+        for (unsigned int m = 0; m <= n; ++m) {
+            bins = std::max<unsigned int>(bins, partials_aa.index(n, m).size_z());
+        }
+        bins = std::max<unsigned int>(bins, partials_aw.index(n).size_y());
+    }
+
+    GenericDistribution3D_t p_aa(form_factor::get_count(), form_factor::get_count(), bins);
+    GenericDistribution2D_t p_aw(form_factor::get_count(), bins);
+    GenericDistribution1D_t p_ww(bins);
+    for (unsigned int n = 0; n < this->body_size; ++n) {
+        for (unsigned int m = 0; m <= n; ++m) {
+            const auto& partial = partials_aa.index(n, m);
+            for (unsigned int ff1 = 0; ff1 < form_factor::get_count(); ++ff1) {
+                for (unsigned int ff2 = 0; ff2 < form_factor::get_count(); ++ff2) {
+                    std::transform(partial.begin(ff1, ff2), partial.end(ff1, ff2), p_aa.begin(ff1, ff2), p_aa.begin(ff1, ff2), std::plus<>());
+                }
+            }
+        }
+
+        const auto& partial = partials_aw.index(n);
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count(); ++ff1) {
+            std::transform(partial.begin(ff1), partial.end(ff1), p_aw.begin(ff1), p_aw.begin(ff1), std::plus<>());
+        }
+    }
+    std::transform(partials_ww.begin(), partials_ww.end(), p_ww.begin(), p_ww.begin(), std::plus<>());
+
+    GenericDistribution1D_t p_tot(bins);
+    {   // sum all elements to the total
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+            for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
+                std::transform(p_tot.begin(), p_tot.end(), p_aa.begin(ff1, ff2), p_tot.begin(), std::plus<>());
+            }
+        }
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+            std::transform(p_tot.begin(), p_tot.end(), p_aw.begin(ff1), p_tot.begin(), std::plus<>());
+        }
+        std::transform(p_tot.begin(), p_tot.end(), p_ww.begin(), p_tot.begin(), std::plus<>());
+    }
+
+    // downsize our axes to only the relevant area
+    unsigned int max_bin = 10; // minimum size is 10
+    for (unsigned int i = p_tot.size()-1; i >= 10; --i) {
+        if (p_tot.index(i) != 0) {
+            max_bin = i+1; // +1 since we usually use this for looping (i.e. i < max_bin)
+            break;
+        }
+    }
+    p_aa.resize(max_bin);
+    p_aw.resize(max_bin);
+    p_ww.resize(max_bin);
+    p_tot.resize(max_bin);
+
+    // multiply the excluded volume charge onto the excluded volume bins
+    double Z_exv_avg = this->protein->get_volume_grid()*constants::charge::density::water/this->protein->size_atom();
+    for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+        std::transform(p_aa.begin(ff1, form_factor::exv_bin), p_aa.end(ff1, form_factor::exv_bin), p_aa.begin(ff1, form_factor::exv_bin), [Z_exv_avg] (auto val) {return val*Z_exv_avg;});
+    }
+    std::transform(p_aa.begin(form_factor::exv_bin, form_factor::exv_bin), p_aa.end(form_factor::exv_bin, form_factor::exv_bin), p_aa.begin(form_factor::exv_bin, form_factor::exv_bin), [Z_exv_avg] (auto val) {return val*Z_exv_avg*Z_exv_avg;});
+    std::transform(p_aw.begin(form_factor::exv_bin), p_aw.end(form_factor::exv_bin), p_aw.begin(form_factor::exv_bin), [Z_exv_avg] (auto val) {return val*Z_exv_avg;});
+
+    return std::make_unique<CompositeDistanceHistogramFFAvg>(
+        std::move(Distribution3D(std::move(p_aa))),
+        std::move(Distribution2D(std::move(p_aw))),
+        std::move(Distribution1D(std::move(p_ww))),
+        std::move(p_tot)
+    );
+}
+
+template class hist::PartialHistogramManagerMTFFAvg<false>;
+template class hist::PartialHistogramManagerMTFFAvg<true>;
@@ -0,0 +1,223 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/histogram_manager/PartialHistogramManagerMTFFExplicit.h>
+#include <hist/distance_calculator/detail/EnqueuePairs.h>
+#include <hist/intensity_calculator/CompositeDistanceHistogramFFExplicit.h>
+#include <hist/detail/RequiredBins.h>
+#include <container/ThreadLocalWrapper.h>
+#include <form_factor/FormFactorType.h>
+#include <data/state/StateManager.h>
+#include <data/Molecule.h>
+#include <data/Body.h>
+#include <utility/MultiThreading.h>
+
+#include <memory>
+#include <numeric>
+
+using namespace ausaxs;
+using namespace ausaxs::hist;
+using distance_calculator::detail::enqueue_pairs;
+
+template<bool use_weighted_distribution>
+PartialHistogramManagerMTFFExplicit<use_weighted_distribution>::PartialHistogramManagerMTFFExplicit(observer_ptr<const data::Molecule> protein)
+    : IPartialHistogramManager(protein),
+      protein(protein),
+      coords_a(this->body_size),
+      partials_aa(this->body_size, this->body_size),
+      partials_ax(this->body_size, this->body_size),
+      partials_xx(this->body_size, this->body_size),
+      partials_aw(this->body_size),
+      partials_wx(this->body_size)
+{}
+
+template<bool use_weighted_distribution>
+PartialHistogramManagerMTFFExplicit<use_weighted_distribution>::~PartialHistogramManagerMTFFExplicit() = default;
+
+template<bool use_weighted_distribution>
+void PartialHistogramManagerMTFFExplicit<use_weighted_distribution>::update_partials() {
+    std::vector<bool> externally_modified = this->statemanager->get_externally_modified_bodies();
+    std::vector<bool> internally_modified = this->statemanager->get_internally_modified_bodies();
+    bool hydration_modified = this->statemanager->is_modified_hydration();
+    auto pool = utility::multi_threading::get_global_pool();
+
+    if (!initialized) [[unlikely]] {
+        externally_modified = std::vector<bool>(this->body_size, true);
+        internally_modified = std::vector<bool>(this->body_size, true);
+        hydration_modified = true;
+        initialized = true;
+    }
+
+    // update the compact representations of everything that was modified
+    for (unsigned int i = 0; i < this->body_size; ++i) {
+        if (externally_modified[i] || internally_modified[i]) {
+            pool->detach_task([this, i] () {coords_a[i] = detail::CompactCoordinatesFF(protein->get_body(i));});
+        }
+    }
+    if (hydration_modified) {
+        pool->detach_task([this] () {coords_w = detail::CompactCoordinatesFF(protein->get_waters());});
+    }
+    pool->wait();
+
+    // queue the recalculation of all affected partial histograms
+    // each is sized to only the distances possible between its two sets of coordinates
+    using Wrapper3D = container::ThreadLocalWrapper<GenericDistribution3D_t>;
+    using Wrapper2D = container::ThreadLocalWrapper<GenericDistribution2D_t>;
+    struct Job3D {unsigned int n, m; std::unique_ptr<Wrapper3D> aa, ax, xx;};
+    struct Job2D {unsigned int n; std::unique_ptr<Wrapper2D> aw, wx;};
+    std::vector<Job3D> jobs_aa;
+    std::vector<Job2D> jobs_aw;
+    std::unique_ptr<container::ThreadLocalWrapper<GenericDistribution1D_t>> job_ww;
+    auto make_3D = [] (unsigned int bins) {
+        return std::make_unique<Wrapper3D>(form_factor::get_count_without_excluded_volume(), form_factor::get_count_without_excluded_volume(), bins);
+    };
+    auto make_2D = [] (unsigned int bins) {
+        return std::make_unique<Wrapper2D>(form_factor::get_count_without_excluded_volume(), bins);
+    };
+    for (unsigned int n = 0; n < this->body_size; ++n) {
+        if (internally_modified[n]) {
+            unsigned int bins = detail::required_bins(coords_a[n]);
+            auto& job = jobs_aa.emplace_back(n, n, make_3D(bins), make_3D(bins), make_3D(bins));
+            enqueue_pairs<use_weighted_distribution, 2, true>(coords_a[n], coords_a[n], *job.aa, *job.ax, *job.xx);
+        }
+
+        // the bodies are concatenated in order in the full manager, so the body with the lowest index must be the first argument to get identical results
+        for (unsigned int m = 0; m < n; ++m) {
+            if (externally_modified[n] || externally_modified[m]) {
+                unsigned int bins = detail::required_bins(coords_a[n], coords_a[m]);
+                auto& job = jobs_aa.emplace_back(n, m, make_3D(bins), make_3D(bins), make_3D(bins));
+                enqueue_pairs<use_weighted_distribution, 2, false>(coords_a[m], coords_a[n], *job.aa, *job.ax, *job.xx);
+            }
+        }
+
+        if (externally_modified[n] || hydration_modified) {
+            unsigned int bins = detail::required_bins(coords_a[n], coords_w);
+            auto& job = jobs_aw.emplace_back(n, make_2D(bins), make_2D(bins));
+            enqueue_pairs<use_weighted_distribution, 1, false>(coords_a[n], coords_w, *job.aw, *job.wx);
+        }
+    }
+    if (hydration_modified) {
+        job_ww = std::make_unique<container::ThreadLocalWrapper<GenericDistribution1D_t>>(detail::required_bins(coords_w));
+        enqueue_pairs<use_weighted_distribution, 2, true>(coords_w, coords_w, *job_ww);
+    }
+    pool->wait();
+
+    // collect the results
+    for (auto& job : jobs_aa) {
+        auto& p_aa = partials_aa.index(job.n, job.m);
+        auto& p_xx = partials_xx.index(job.n, job.m);
+        p_aa = job.aa->merge();
+        p_xx = job.xx->merge();
+        partials_ax.index(job.n, job.m) = job.ax->merge();
+
+        // the self-correlations are only included in the diagonal partials
+        if (job.n == job.m) {
+            const auto& coords = coords_a[job.n];
+            for (unsigned int i = 0; i < coords.size(); ++i) {
+                p_aa.add(coords.get_ff_type(i), coords.get_ff_type(i), 0, std::pow(coords[i].value.w, 2));
+                p_xx.add(coords.get_ff_type(i), coords.get_ff_type(i), 0, 1);
+            }
+        }
+    }
+    for (auto& job : jobs_aw) {
+        partials_aw.index(job.n) = job.aw->merge();
+        partials_wx.index(job.n) = job.wx->merge();
+    }
+    if (hydration_modified) {
+        partials_ww = job_ww->merge();
+        partials_ww.add(0, std::accumulate(coords_w.get_data().begin(), coords_w.get_data().end(), 0.0, [](double sum, const hist::detail::CompactCoordinatesData& data) {return sum + std::pow(data.value.w, 2);}));
+    }
+
+    this->statemanager->reset_to_false();
+}
+
+template<bool use_weighted_distribution>
+std::unique_ptr<DistanceHistogram> PartialHistogramManagerMTFFExplicit<use_weighted_distribution>::calculate() {return calculate_all();}
+
+template<bool use_weighted_distribution>
+std::unique_ptr<ICompositeDistanceHistogram> PartialHistogramManagerMTFFExplicit<use_weighted_distribution>::calculate_all() {
+    update_partials();
+
+    // sum all partial histograms
+    unsigned int bins = partials_ww.size();
+    for (unsigned int n = 0; n < this->body_size; ++n) {
+        for (unsigned int m = 0; m <= n; ++m) {
+            bins = std::max<unsigned int>(bins, partials_aa.index(n, m).size_z());
+        }
+        bins = std::max<unsigned int>(bins, partials_aw.index(n).size_y());
+    }
+
+    auto add_3D = [] (GenericDistribution3D_t& dest, const GenericDistribution3D_t& partial) {
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+            for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
+                std::transform(partial.begin(ff1, ff2), partial.end(ff1, ff2), dest.begin(ff1, ff2), dest.begin(ff1, ff2), std::plus<>());
+            }
+        }
+    };
+    auto add_2D = [] (GenericDistribution2D_t& dest, const GenericDistribution2D_t& partial) {
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+            std::transform(partial.begin(ff1), partial.end(ff1), dest.begin(ff1), dest.begin(ff1), std::plus<>());
+        }
+    };
+
+    GenericDistribution3D_t p_aa(form_factor::get_count_without_excluded_volume(), form_factor::get_count_without_excluded_volume(), bins);
+    GenericDistribution3D_t p_ax(form_factor::get_count_without_excluded_volume(), form_factor::get_count_without_excluded_volume(), bins);
+    GenericDistribution3D_t p_xx(form_factor::get_count_without_excluded_volume(), form_factor::get_count_without_excluded_volume(), bins);
+    GenericDistribution2D_t p_wa(form_factor::get_count_without_excluded_volume(), bins);
+    GenericDistribution2D_t p_wx(form_factor::get_count_without_excluded_volume(), bins);
+    GenericDistribution1D_t p_ww(bins);
+    for (unsigned int n = 0; n < this->body_size; ++n) {
+        for (unsigned int m = 0; m <= n; ++m) {
+            add_3D(p_aa, partials_aa.index(n, m));
+            add_3D(p_ax, partials_ax.index(n, m));
+            add_3D(p_xx, partials_xx.index(n, m));
+        }
+        add_2D(p_wa, partials_aw.index(n));
+        add_2D(p_wx, partials_wx.index(n));
+    }
+    std::transform(partials_ww.begin(), partials_ww.end(), p_ww.begin(), p_ww.begin(), std::plus<>());
+
+    GenericDistribution1D_t p_tot(bins);
+    {   // sum all elements to the total
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+            for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
+                std::transform(p_tot.begin(), p_tot.end(), p_aa.begin(ff1, ff2), p_tot.begin(), std::plus<>());
+            }
+        }
+        for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+            std::transform(p_tot.begin(), p_tot.end(), p_wa.begin(ff1), p_tot.begin(), std::plus<>());
+        }
+        std::transform(p_tot.begin(), p_tot.end(), p_ww.begin(), p_tot.begin(), std::plus<>());
+    }
+
+    // downsize our axes to only the relevant area
+    unsigned int max_bin = 10; // minimum size is 10
+    for (unsigned int i = p_tot.size()-1; i >= 10; --i) {
+        if (p_tot.index(i) != 0) {
+            max_bin = i+1; // +1 since we usually use this for looping (i.e. i < max_bin)
+            break;
+        }
+    }
+    p_aa.resize(max_bin);
+    p_ax.resize(max_bin);
+    p_xx.resize(max_bin);
+    p_wa.resize(max_bin);
+    p_wx.resize(max_bin);
+    p_ww.resize(max_bin);
+    p_tot.resize(max_bin);
+
+    return std::make_unique<CompositeDistanceHistogramFFExplicit>(
+        std::move(Distribution3D(std::move(p_aa))),
+        std::move(Distribution3D(std::move(p_ax))),
+        std::move(Distribution3D(std::move(p_xx))),
+        std::move(Distribution2D(std::move(p_wa))),
+        std::move(Distribution2D(std::move(p_wx))),
+        std::move(Distribution1D(std::move(p_ww))),
+        std::move(p_tot)
+    );
+}
+
+template class hist::PartialHistogramManagerMTFFExplicit<false>;
+template class hist::PartialHistogramManagerMTFFExplicit<true>;
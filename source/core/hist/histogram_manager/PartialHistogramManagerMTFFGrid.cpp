@@ -0,0 +1,23 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <hist/histogram_manager/PartialHistogramManagerMTFFGrid.h>
+#include <hist/histogram_manager/HistogramManagerMTFFGrid.h>
+#include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
+#include <data/Molecule.h>
+
+using namespace ausaxs;
+using namespace ausaxs::hist;
+
+PartialHistogramManagerMTFFGrid::~PartialHistogramManagerMTFFGrid() = default;
+
+std::unique_ptr<DistanceHistogram> PartialHistogramManagerMTFFGrid::calculate() {return calculate_all();}
+
+std::unique_ptr<ICompositeDistanceHistogram> PartialHistogramManagerMTFFGrid::calculate_all() {
+    auto base_res = PartialHistogramManagerMTFFAvg<true>::calculate_all();
+    return HistogramManagerMTFFGrid::add_grid_excluded_volume(
+        std::move(base_res), this->protein, detail::CompactCoordinatesFF(this->protein->get_bodies()), this->coords_w
+    );
+}
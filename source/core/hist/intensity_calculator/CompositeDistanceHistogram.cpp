@@ -5,6 +5,7 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <hist/intensity_calculator/CompositeDistanceHistogram.h>
 #include <hist/Histogram.h>
+#include <hist/detail/BatchedDebyeTransform.h>
 #include <table/ArrayDebyeTable.h>
 #include <constants/Constants.h>
 #include <settings/HistogramSettings.h>
@@ -65,8 +66,10 @@ auto partial_profile = [] (const Distribution1D& p, observer_ptr<const table::De
     const auto& q_axis = constants::axes::q_vals;
 
     std::vector<double> Iq(debye_axis.bins, 0);
+    hist::detail::BatchedDebyeTransform transform(sinqd_table, q0, debye_axis.bins);
+    transform.enqueue(p.begin(), p.end(), Iq.begin());
+    transform.run();
     for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-        Iq[q-q0] = std::inner_product(p.begin(), p.end(), sinqd_table->begin(q), 0.0);
         Iq[q-q0] *= std::exp(-q_axis[q]*q_axis[q]);
     }
     return ScatteringProfile(std::move(Iq), debye_axis);
@@ -5,6 +5,7 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFAvgBase.h>
 #include <hist/Histogram.h>
+#include <hist/detail/BatchedDebyeTransform.h>
 #include <dataset/SimpleDataset.h>
 #include <table/ArrayDebyeTable.h>
 #include <form_factor/FormFactor.h>
@@ -52,8 +53,8 @@ template<typename FormFactorTableType>
 CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::~CompositeDistanceHistogramFFAvgBase() = default;
 
 template<typename FormFactorTableType>
-double CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::exv_factor(double) const {
-    return free_params.cx;
+double CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::exv_factor(double, const FreeParameters& params) const {
+    return params.cx;
 }
 
 template<typename FormFactorTableType>
@@ -76,6 +77,82 @@ ScatteringProfile CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::deby
     return ScatteringProfile(Iq, debye_axis);
 }
 
+template<typename FormFactorTableType>
+std::vector<double> CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::evaluate(const FreeParameters& params) const {
+    // the sinqd cache is shared with the stateful methods, and is initialized on first use
+    if (!cache.sinqd.valid) {cache_get_intensity_profiles();}
+
+    Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
+    unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin);
+
+    std::vector<double> B_atomic(debye_axis.bins, 1), B_exv(debye_axis.bins, 1);
+    if (params.DW_sigma_atomic != 0) {
+        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {B_atomic[q-q0] = get_atomic_debye_waller_factor(constants::axes::q_vals[q], params.DW_sigma_atomic);}
+    }
+    if (params.DW_sigma_exv != 0) {
+        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {B_exv[q-q0] = get_exv_debye_waller_factor(constants::axes::q_vals[q], params.DW_sigma_exv);}
+    }
+
+    // same sum as in debye_transform, with the debye-waller factors of apply_debye_waller_factors
+    std::vector<double> Iq(debye_axis.bins, 0), I(debye_axis.bins);
+    auto add = [&] (Profile profile, auto&& weight) {
+        std::fill(I.begin(), I.end(), 0);
+        evaluate_profile(profile, params, I);
+        for (unsigned int i = 0; i < Iq.size(); ++i) {Iq[i] += weight(i)*I[i];}
+    };
+    add(Profile::aa, [&] (unsigned int i) {return B_atomic[i]*B_atomic[i];});
+    add(Profile::ax, [&] (unsigned int i) {return -B_atomic[i]*B_exv[i];});
+    add(Profile::aw, [&] (unsigned int i) {return B_atomic[i];});
+    add(Profile::xx, [&] (unsigned int i) {return B_exv[i]*B_exv[i];});
+    add(Profile::wx, [&] (unsigned int i) {return -B_exv[i];});
+    add(Profile::ww, [] (unsigned int) {return 1.;});
+    return Iq;
+}
+
+template<typename FormFactorTableType>
+ICompositeDistanceHistogramExv::IntensityBasis CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::get_intensity_basis() const {
+    if (!cache.sinqd.valid) {cache_get_intensity_profiles();}
+
+    Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
+
+    // the profiles are linear in cw and crho (quadratic for ww and xx), and polynomials of at most second degree in the exv factor,
+    // so the coefficients of each power of the exv factor can be extracted by evaluating them at X = -1, 0, 1 with unit parameters
+    FreeParameters unit;
+    std::vector<double> zero(debye_axis.bins, 0), one(debye_axis.bins, 1), minus_one(debye_axis.bins, -1);
+    auto profile = [&] (Profile p, const std::vector<double>& X) {
+        std::vector<double> out(debye_axis.bins, 0);
+        evaluate_profile(p, unit, X, out);
+        return out;
+    };
+
+    IntensityBasis basis;
+    basis.q = debye_axis.as_vector();
+    basis.aa = profile(Profile::aa, one);
+    basis.aw = profile(Profile::aw, one);
+    basis.ww = profile(Profile::ww, one);
+    basis.ax0 = profile(Profile::ax, zero);
+    basis.ax1 = profile(Profile::ax, one);
+    basis.xx0 = profile(Profile::xx, zero);
+    basis.xx1 = profile(Profile::xx, one);
+    basis.xx2 = profile(Profile::xx, minus_one);
+    basis.wx0 = profile(Profile::wx, zero);
+    basis.wx1 = profile(Profile::wx, one);
+    for (unsigned int i = 0; i < debye_axis.bins; ++i) {
+        basis.ax1[i] -= basis.ax0[i];
+        basis.wx1[i] -= basis.wx0[i];
+        double xx_p = basis.xx1[i], xx_m = basis.xx2[i];
+        basis.xx1[i] = (xx_p - xx_m)/2;
+        basis.xx2[i] = (xx_p + xx_m)/2 - basis.xx0[i];
+    }
+    basis.exv_factor = [this] (double q, double cx) {return exv_factor(q, FreeParameters{.cx=cx});};
+    return basis;
+}
+
+template<typename FormFactorTableType>
+ICompositeDistanceHistogramExv::FreeParameters CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::get_free_parameters() const {
+    return free_params;
+}
+
 template<typename FormFactorTableType>
 SimpleDataset CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::debye_transform(const std::vector<double>&) const {
     throw except::not_implemented("CompositeDistanceHistogramFFGrid::debye_transform(const std::vector<double>& q) const");
@@ -350,7 +427,6 @@ void CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::cache_refresh_dis
 
 template<typename FormFactorTableType>
 void CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::cache_refresh_sinqd() const {
-    auto pool = utility::multi_threading::get_global_pool();
     auto sinqd_table = get_sinc_table();
 
     Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
@@ -365,120 +441,120 @@ void CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::cache_refresh_sin
         cache.sinqd.ww = container::Container1D<double>(debye_axis.bins);
     }
 
+    // all profiles are transformed with the same table, so they are evaluated as a single batch
+    hist::detail::BatchedDebyeTransform transform(sinqd_table, q0, debye_axis.bins);
     for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
         for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
-            pool->detach_task([this, q0, bins=debye_axis.bins, ff1, ff2, sinqd_table] () {
-                for (unsigned int q = q0; q < q0+bins; ++q) {
-                    cache.sinqd.aa.index(ff1, ff2, q-q0) = std::inner_product(distance_profiles.aa.begin(ff1, ff2), distance_profiles.aa.end(ff1, ff2), sinqd_table->begin(q), 0.0);
-                }
-            });
+            transform.enqueue(distance_profiles.aa.begin(ff1, ff2), distance_profiles.aa.end(ff1, ff2), cache.sinqd.aa.begin(ff1, ff2));
         }
-        pool->detach_task([this, q0, bins=debye_axis.bins, ff1, sinqd_table] () {
-            for (unsigned int q = q0; q < q0+bins; ++q) {
-                cache.sinqd.ax.index(ff1, q-q0) = std::inner_product(distance_profiles.aa.begin(ff1, form_factor::exv_bin), distance_profiles.aa.end(ff1, form_factor::exv_bin), sinqd_table->begin(q), 0.0);
-                cache.sinqd.aw.index(ff1, q-q0) = std::inner_product(distance_profiles.aw.begin(ff1), distance_profiles.aw.end(ff1), sinqd_table->begin(q), 0.0);
-            }
-        });
+        transform.enqueue(distance_profiles.aa.begin(ff1, form_factor::exv_bin), distance_profiles.aa.end(ff1, form_factor::exv_bin), cache.sinqd.ax.begin(ff1));
+        transform.enqueue(distance_profiles.aw.begin(ff1), distance_profiles.aw.end(ff1), cache.sinqd.aw.begin(ff1));
     }
-    pool->detach_task([&] () {
-        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            cache.sinqd.xx.index(q-q0) = std::inner_product(distance_profiles.aa.begin(form_factor::exv_bin, form_factor::exv_bin), distance_profiles.aa.end(form_factor::exv_bin, form_factor::exv_bin), sinqd_table->begin(q), 0.0);
-            cache.sinqd.wx.index(q-q0) = std::inner_product(distance_profiles.aw.begin(form_factor::exv_bin), distance_profiles.aw.end(form_factor::exv_bin), sinqd_table->begin(q), 0.0);
-            cache.sinqd.ww.index(q-q0) = std::inner_product(distance_profiles.ww.begin(), distance_profiles.ww.end(), sinqd_table->begin(q), 0.0);
-        }
-    });
+    transform.enqueue(distance_profiles.aa.begin(form_factor::exv_bin, form_factor::exv_bin), distance_profiles.aa.end(form_factor::exv_bin, form_factor::exv_bin), cache.sinqd.xx.begin());
+    transform.enqueue(distance_profiles.aw.begin(form_factor::exv_bin), distance_profiles.aw.end(form_factor::exv_bin), cache.sinqd.wx.begin());
+    transform.enqueue(distance_profiles.ww.begin(), distance_profiles.ww.end(), cache.sinqd.ww.begin());
+    transform.run();
     cache.sinqd.valid = true;
-    pool->wait();
 }
 
 template<typename FormFactorTableType>
 void CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const {
     auto pool = utility::multi_threading::get_global_pool();
-    const auto& ff_table = get_ff_table(); 
-
-    Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
-    unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin);
+    unsigned int bins = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax).bins;
 
+    // the profiles are independent, so each is evaluated as a separate task
+    auto refresh = [&] (Profile profile, std::vector<double>& out) {
+        out.assign(bins, 0);
+        pool->detach_task([this, profile, &out] () {evaluate_profile(profile, free_params, out);});
+    };
     if (sinqd_changed) {
-        cache.intensity_profiles.aa = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cw_changed) {
-        cache.intensity_profiles.aw = std::vector<double>(debye_axis.bins, 0);
-        cache.intensity_profiles.ww = std::vector<double>(debye_axis.bins, 0);
+        refresh(Profile::aa, cache.intensity_profiles.aa);
     }
     if (cx_changed) {
-        cache.intensity_profiles.ax = std::vector<double>(debye_axis.bins, 0);
-        cache.intensity_profiles.xx = std::vector<double>(debye_axis.bins, 0);
+        refresh(Profile::ax, cache.intensity_profiles.ax);
+        refresh(Profile::xx, cache.intensity_profiles.xx);
+    }
+    if (cw_changed) {
+        refresh(Profile::aw, cache.intensity_profiles.aw);
+        refresh(Profile::ww, cache.intensity_profiles.ww);
     }
     if (cw_changed || cx_changed) {
-        cache.intensity_profiles.wx = std::vector<double>(debye_axis.bins, 0);
+        refresh(Profile::wx, cache.intensity_profiles.wx);
     }
 
+    cache.intensity_profiles.cached_cx = free_params.cx;
+    cache.intensity_profiles.cached_crho = free_params.crho;
+    cache.intensity_profiles.cached_cw = free_params.cw;
+    pool->wait();
+}
+
+template<typename FormFactorTableType>
+void CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::evaluate_profile(Profile profile, const FreeParameters& params, std::vector<double>& out) const {
+    Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
+    unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin);
+
     // calculate exv factor
     std::vector<double> cx(debye_axis.bins, 0);
-    for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {cx[q-q0] = exv_factor(constants::axes::q_vals[q]);}
+    if (profile == Profile::ax || profile == Profile::xx || profile == Profile::wx) {
+        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {cx[q-q0] = exv_factor(constants::axes::q_vals[q], params);}
+    }
+    evaluate_profile(profile, params, cx, out);
+}
 
-    if (sinqd_changed) {
-        // aa
-        pool->detach_task([&] () {
+template<typename FormFactorTableType>
+void CompositeDistanceHistogramFFAvgBase<FormFactorTableType>::evaluate_profile(Profile profile, const FreeParameters& params, const std::vector<double>& cx, std::vector<double>& out) const {
+    const auto& ff_table = get_ff_table(); 
+
+    Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
+    unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin);
+    assert(out.size() == debye_axis.bins && "CompositeDistanceHistogramFFAvgBase::evaluate_profile: out.size() != debye_axis.bins");
+    assert(cx.size() == debye_axis.bins && "CompositeDistanceHistogramFFAvgBase::evaluate_profile: cx.size() != debye_axis.bins");
+
+    switch (profile) {
+        case Profile::aa:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                        cache.intensity_profiles.aa[q-q0] += cache.sinqd.aa.index(ff1, ff2, q-q0)*ff_table.index(ff1, ff2).evaluate(q);
+                        out[q-q0] += cache.sinqd.aa.index(ff1, ff2, q-q0)*ff_table.index(ff1, ff2).evaluate(q);
                     }
                 }
             }
-        });
-    }
+            break;
 
-    if (cx_changed) {
-        // ax
-        pool->detach_task([&] () {
+        case Profile::ax:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                    cache.intensity_profiles.ax[q-q0] += 2*free_params.crho*cx[q-q0]*cache.sinqd.ax.index(ff1, q-q0)*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
+                    out[q-q0] += 2*params.crho*cx[q-q0]*cache.sinqd.ax.index(ff1, q-q0)*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
                 }
             }
-        });
+            break;
 
-        // xx
-        pool->detach_task([&] () {
+        case Profile::xx:
             for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                cache.intensity_profiles.xx[q-q0] += std::pow(cx[q-q0]*free_params.crho, 2)*cache.sinqd.xx.index(q-q0)*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
+                out[q-q0] += std::pow(cx[q-q0]*params.crho, 2)*cache.sinqd.xx.index(q-q0)*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
             }
-        });
-    }
+            break;
 
-    if (cw_changed) {
-        // aw
-        pool->detach_task([&] () {
+        case Profile::aw:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                    cache.intensity_profiles.aw[q-q0] += 2*free_params.cw*cache.sinqd.aw.index(ff1, q-q0)*ff_table.index(ff1, form_factor::water_bin).evaluate(q);
+                    out[q-q0] += 2*params.cw*cache.sinqd.aw.index(ff1, q-q0)*ff_table.index(ff1, form_factor::water_bin).evaluate(q);
                 }
             }
-        });
+            break;
 
-        // ww
-        pool->detach_task([&] () {
+        case Profile::ww:
             for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                cache.intensity_profiles.ww[q-q0] += free_params.cw*free_params.cw*cache.sinqd.ww.index(q-q0)*ff_table.index(form_factor::water_bin, form_factor::water_bin).evaluate(q);
+                out[q-q0] += params.cw*params.cw*cache.sinqd.ww.index(q-q0)*ff_table.index(form_factor::water_bin, form_factor::water_bin).evaluate(q);
             }
-        });
-    }
+            break;
 
-    if (cw_changed || cx_changed) {
-        // wx
-        pool->detach_task([&] () {
+        case Profile::wx:
             for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                cache.intensity_profiles.wx[q-q0] += 2*free_params.crho*cx[q-q0]*free_params.cw*cache.sinqd.wx.index(q-q0)*ff_table.index(form_factor::exv_bin, form_factor::water_bin).evaluate(q);
+                out[q-q0] += 2*params.crho*cx[q-q0]*params.cw*cache.sinqd.wx.index(q-q0)*ff_table.index(form_factor::exv_bin, form_factor::water_bin).evaluate(q);
             }
-        });
+            break;
     }
-
-    cache.intensity_profiles.cached_cx = free_params.cx;
-    cache.intensity_profiles.cached_crho = free_params.crho;
-    cache.intensity_profiles.cached_cw = free_params.cw;
-    pool->wait();
 }
+
 template class hist::CompositeDistanceHistogramFFAvgBase<form_factor::storage::atomic::table_t>;
\ No newline at end of file
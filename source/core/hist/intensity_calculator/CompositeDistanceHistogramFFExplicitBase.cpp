@@ -5,12 +5,14 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFExplicitBase.h>
 #include <hist/Histogram.h>
+#include <hist/detail/BatchedDebyeTransform.h>
 #include <table/ArrayDebyeTable.h>
 #include <form_factor/FormFactor.h>
 #include <form_factor/PrecalculatedFormFactorProduct.h>
 #include <form_factor/PrecalculatedExvFormFactorProduct.h>
 #include <settings/HistogramSettings.h>
-#include <utility/MultiThreading.h>
+
+#include <cassert>
 
 using namespace ausaxs;
 using namespace ausaxs::hist;
@@ -67,13 +69,12 @@ double CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::
 }
 
 template<typename AA, typename AXFormFactorTableType, typename XX>
-double CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::exv_factor(double q) const {
-    return exv_factor(q, this->free_params.cx);
+double CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::exv_factor(double q, const FreeParameters& params) const {
+    return exv_factor(q, params.cx);
 }
 
 template<typename AA, typename AXFormFactorTableType, typename XX>
 void CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::cache_refresh_sinqd() const {
-    auto pool = utility::multi_threading::get_global_pool();
     auto sinqd_table = this->get_sinc_table();
 
     Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
@@ -88,130 +89,95 @@ void CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::ca
         exv_cache.sinqd.ww = container::Container1D<double>(debye_axis.bins);
     }
 
+    // all profiles are transformed with the same table, so they are evaluated as a single batch
+    hist::detail::BatchedDebyeTransform transform(sinqd_table, q0, debye_axis.bins);
     for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
         for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
-            pool->detach_task([this, q0, bins=debye_axis.bins, ff1, ff2, sinqd_table] () {
-                for (unsigned int q = q0; q < q0+bins; ++q) {
-                    exv_cache.sinqd.aa.index(ff1, ff2, q-q0) = std::inner_product(this->distance_profiles.aa.begin(ff1, ff2), this->distance_profiles.aa.end(ff1, ff2), sinqd_table->begin(q), 0.0);
-                    exv_cache.sinqd.ax.index(ff1, ff2, q-q0) = std::inner_product(exv_distance_profiles.ax.begin(ff1, ff2), exv_distance_profiles.ax.end(ff1, ff2), sinqd_table->begin(q), 0.0);
-                    exv_cache.sinqd.xx.index(ff1, ff2, q-q0) = std::inner_product(exv_distance_profiles.xx.begin(ff1, ff2), exv_distance_profiles.xx.end(ff1, ff2), sinqd_table->begin(q), 0.0);
-                }
-            });
+            transform.enqueue(this->distance_profiles.aa.begin(ff1, ff2), this->distance_profiles.aa.end(ff1, ff2), exv_cache.sinqd.aa.begin(ff1, ff2));
+            transform.enqueue(exv_distance_profiles.ax.begin(ff1, ff2), exv_distance_profiles.ax.end(ff1, ff2), exv_cache.sinqd.ax.begin(ff1, ff2));
+            transform.enqueue(exv_distance_profiles.xx.begin(ff1, ff2), exv_distance_profiles.xx.end(ff1, ff2), exv_cache.sinqd.xx.begin(ff1, ff2));
         }
-        pool->detach_task([this, q0, bins=debye_axis.bins, ff1, sinqd_table] () {
-            for (unsigned int q = q0; q < q0+bins; ++q) {
-                exv_cache.sinqd.aw.index(ff1, q-q0) = std::inner_product(this->distance_profiles.aw.begin(ff1), this->distance_profiles.aw.end(ff1), sinqd_table->begin(q), 0.0);
-                exv_cache.sinqd.wx.index(ff1, q-q0) = std::inner_product(exv_distance_profiles.wx.begin(ff1), exv_distance_profiles.wx.end(ff1), sinqd_table->begin(q), 0.0);
-            }
-        });
+        transform.enqueue(this->distance_profiles.aw.begin(ff1), this->distance_profiles.aw.end(ff1), exv_cache.sinqd.aw.begin(ff1));
+        transform.enqueue(exv_distance_profiles.wx.begin(ff1), exv_distance_profiles.wx.end(ff1), exv_cache.sinqd.wx.begin(ff1));
     }
-    pool->detach_task([&] () {
-        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            exv_cache.sinqd.ww.index(q-q0) = std::inner_product(this->distance_profiles.ww.begin(), this->distance_profiles.ww.end(), sinqd_table->begin(q), 0.0);
-        }
-    });
+    transform.enqueue(this->distance_profiles.ww.begin(), this->distance_profiles.ww.end(), exv_cache.sinqd.ww.begin());
+    transform.run();
     exv_cache.sinqd.valid = true;
-    pool->wait();
 }
 
 template<typename AA, typename AXFormFactorTableType, typename XX>
-void CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const {
-    auto pool = utility::multi_threading::get_global_pool();
-    const auto& ff_aa_table = get_ffaa_table();
+void CompositeDistanceHistogramFFExplicitBase<AA, AXFormFactorTableType, XX>::evaluate_profile(Profile profile, const FreeParameters& params, const std::vector<double>& cx, std::vector<double>& out) const {
+    const auto& ff_aa_table = this->get_ff_table();
     const auto& ff_ax_table = get_ffax_table();
     const auto& ff_xx_table = get_ffxx_table();
 
     Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
     unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin); // account for a possibly different qmin
+    assert(out.size() == debye_axis.bins && "CompositeDistanceHistogramFFExplicitBase::evaluate_profile: out.size() != debye_axis.bins");
+    assert(cx.size() == debye_axis.bins && "CompositeDistanceHistogramFFExplicitBase::evaluate_profile: cx.size() != debye_axis.bins");
 
-    if (sinqd_changed) {
-        this->cache.intensity_profiles.aa = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cw_changed) {
-        this->cache.intensity_profiles.aw = std::vector<double>(debye_axis.bins, 0);
-        this->cache.intensity_profiles.ww = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cx_changed) {
-        this->cache.intensity_profiles.ax = std::vector<double>(debye_axis.bins, 0);
-        this->cache.intensity_profiles.xx = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cw_changed || cx_changed) {
-        this->cache.intensity_profiles.wx = std::vector<double>(debye_axis.bins, 0);
-    }
-
-    std::vector<double> cx(debye_axis.bins, 0);
-    for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {cx[q-q0] = exv_factor(constants::axes::q_vals[q]);}
-
-    if (sinqd_changed) {
-        pool->detach_task([&] () {
+    switch (profile) {
+        case Profile::aa:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                        this->cache.intensity_profiles.aa[q-q0] += 
+                        out[q-q0] += 
                             exv_cache.sinqd.aa.index(ff1, ff2, q-q0)*ff_aa_table.index(ff1, ff2).evaluate(q);
                     }
                 }
             }
-        });
-    }
+            break;
 
-    if (cx_changed) {
-        pool->detach_task([&] () {
+        case Profile::ax:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                        this->cache.intensity_profiles.ax[q-q0] += 
-                            2*this->free_params.crho*cx[q]*exv_cache.sinqd.ax.index(ff1, ff2, q-q0)*ff_ax_table.index(ff1, ff2).evaluate(q);
+                        out[q-q0] += 
+                            2*params.crho*cx[q-q0]*exv_cache.sinqd.ax.index(ff1, ff2, q-q0)*ff_ax_table.index(ff1, ff2).evaluate(q);
                     }
                 }
             }
-        });
-        pool->detach_task([&] () {
+            break;
+
+        case Profile::xx:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                        this->cache.intensity_profiles.xx[q-q0] += 
-                            std::pow(cx[q]*this->free_params.crho, 2)*exv_cache.sinqd.xx.index(ff1, ff2, q-q0)*ff_xx_table.index(ff1, ff2).evaluate(q);
+                        out[q-q0] += 
+                            std::pow(cx[q-q0]*params.crho, 2)*exv_cache.sinqd.xx.index(ff1, ff2, q-q0)*ff_xx_table.index(ff1, ff2).evaluate(q);
                     }
                 }
             }
-        });
-    }
+            break;
 
-    if (cw_changed) {
-        pool->detach_task([&] () {
+        case Profile::aw:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                    this->cache.intensity_profiles.aw[q-q0] += 
-                        2*this->free_params.cw*exv_cache.sinqd.aw.index(ff1, q-q0)
+                    out[q-q0] += 
+                        2*params.cw*exv_cache.sinqd.aw.index(ff1, q-q0)
                         *ff_aa_table.index(ff1, form_factor::water_bin).evaluate(q);
                 }
             }
-        });
-        pool->detach_task([&] () {
+            break;
+
+        case Profile::ww:
             for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                this->cache.intensity_profiles.ww[q-q0] += 
-                    this->free_params.cw*this->free_params.cw*exv_cache.sinqd.ww.index(q-q0)
+                out[q-q0] += 
+                    params.cw*params.cw*exv_cache.sinqd.ww.index(q-q0)
                     *ff_aa_table.index(form_factor::water_bin, form_factor::water_bin).evaluate(q);
             }
-        });
-    }
+            break;
 
-    if (cw_changed || cx_changed) {
-        pool->detach_task([&] () {
+        case Profile::wx:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                    this->cache.intensity_profiles.wx[q-q0] += 
-                        2*this->free_params.crho*cx[q]*this->free_params.cw*exv_cache.sinqd.wx.index(ff1, q-q0)
+                    out[q-q0] += 
+                        2*params.crho*cx[q-q0]*params.cw*exv_cache.sinqd.wx.index(ff1, q-q0)
                         *ff_ax_table.index(form_factor::water_bin, ff1).evaluate(q);
                 }
             }
-        });
+            break;
     }
-    this->cache.intensity_profiles.cached_cx = this->free_params.cx;
-    this->cache.intensity_profiles.cached_crho = this->free_params.crho;
-    this->cache.intensity_profiles.cached_cw = this->free_params.cw;
-    pool->wait();    
 }
 
 template class hist::CompositeDistanceHistogramFFExplicitBase<
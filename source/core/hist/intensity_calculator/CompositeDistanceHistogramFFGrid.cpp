@@ -4,6 +4,7 @@ For more information, please refer to the LICENSE file in the project root.
 */
 
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFGrid.h>
+#include <hist/detail/BatchedDebyeTransform.h>
 #include <form_factor/PrecalculatedFormFactorProduct.h>
 #include <form_factor/ExvFormFactor.h>
 #include <table/ArrayDebyeTable.h>
@@ -37,8 +38,8 @@ void CompositeDistanceHistogramFFGrid::regenerate_ff_table(T&& ffx) {ff_table =
 template void CompositeDistanceHistogramFFGrid::regenerate_ff_table(ExvFormFactor&&);
 template void CompositeDistanceHistogramFFGrid::regenerate_ff_table(FormFactor&&);
 
-double CompositeDistanceHistogramFFGrid::exv_factor(double) const {
-    return free_params.cx;
+double CompositeDistanceHistogramFFGrid::exv_factor(double, const FreeParameters& params) const {
+    return params.cx;
 }
 
 form_factor::storage::atomic::table_t CompositeDistanceHistogramFFGrid::generate_ff_table() {
@@ -78,7 +79,6 @@ template form_factor::storage::atomic::table_t CompositeDistanceHistogramFFGrid:
 template form_factor::storage::atomic::table_t CompositeDistanceHistogramFFGrid::generate_ff_table(FormFactor&&);
 
 void CompositeDistanceHistogramFFGrid::cache_refresh_sinqd() const {
-    auto pool = utility::multi_threading::get_global_pool();
     auto sinqd_table_aa = get_sinc_table();
     auto sinqd_table_ax = get_sinc_table_ax();
     auto sinqd_table_xx = get_sinc_table_xx();
@@ -95,30 +95,25 @@ void CompositeDistanceHistogramFFGrid::cache_refresh_sinqd() const {
         cache.sinqd.ww = container::Container1D<double>(debye_axis.bins);
     }
 
+    // the profiles are batched by the table they are transformed with
+    hist::detail::BatchedDebyeTransform transform_aa(sinqd_table_aa, q0, debye_axis.bins);
+    hist::detail::BatchedDebyeTransform transform_ax(sinqd_table_ax, q0, debye_axis.bins);
     for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
         for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
-            pool->detach_task([this, q0, bins=debye_axis.bins, ff1, ff2, sinqd_table_aa] () {
-                for (unsigned int q = q0; q < q0+bins; ++q) {
-                    cache.sinqd.aa.index(ff1, ff2, q-q0) = std::inner_product(distance_profiles.aa.begin(ff1, ff2), distance_profiles.aa.end(ff1, ff2), sinqd_table_aa->begin(q), 0.0);
-                }
-            });
+            transform_aa.enqueue(distance_profiles.aa.begin(ff1, ff2), distance_profiles.aa.end(ff1, ff2), cache.sinqd.aa.begin(ff1, ff2));
         }
-        pool->detach_task([this, q0, bins=debye_axis.bins, ff1, sinqd_table_aa, sinqd_table_ax] () {
-            for (unsigned int q = q0; q < q0+bins; ++q) {
-                cache.sinqd.ax.index(ff1, q-q0) = std::inner_product(distance_profiles.aa.begin(ff1, form_factor::exv_bin), distance_profiles.aa.end(ff1, form_factor::exv_bin), sinqd_table_ax->begin(q), 0.0);
-                cache.sinqd.aw.index(ff1, q-q0) = std::inner_product(distance_profiles.aw.begin(ff1), distance_profiles.aw.end(ff1), sinqd_table_aa->begin(q), 0.0);
-            }
-        });
+        transform_ax.enqueue(distance_profiles.aa.begin(ff1, form_factor::exv_bin), distance_profiles.aa.end(ff1, form_factor::exv_bin), cache.sinqd.ax.begin(ff1));
+        transform_aa.enqueue(distance_profiles.aw.begin(ff1), distance_profiles.aw.end(ff1), cache.sinqd.aw.begin(ff1));
     }
-    pool->detach_task([&] () {
-        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            cache.sinqd.xx.index(q-q0) = std::inner_product(distance_profiles.aa.begin(form_factor::exv_bin, form_factor::exv_bin), distance_profiles.aa.end(form_factor::exv_bin, form_factor::exv_bin), sinqd_table_xx->begin(q), 0.0);
-            cache.sinqd.wx.index(q-q0) = std::inner_product(distance_profiles.aw.begin(form_factor::exv_bin), distance_profiles.aw.end(form_factor::exv_bin), sinqd_table_ax->begin(q), 0.0);
-            cache.sinqd.ww.index(q-q0) = std::inner_product(distance_profiles.ww.begin(), distance_profiles.ww.end(), sinqd_table_aa->begin(q), 0.0);
-        }
-    });
+    transform_ax.enqueue(distance_profiles.aw.begin(form_factor::exv_bin), distance_profiles.aw.end(form_factor::exv_bin), cache.sinqd.wx.begin());
+    transform_aa.enqueue(distance_profiles.ww.begin(), distance_profiles.ww.end(), cache.sinqd.ww.begin());
+    transform_aa.run();
+    transform_ax.run();
+
+    hist::detail::BatchedDebyeTransform transform_xx(sinqd_table_xx, q0, debye_axis.bins);
+    transform_xx.enqueue(distance_profiles.aa.begin(form_factor::exv_bin, form_factor::exv_bin), distance_profiles.aa.end(form_factor::exv_bin, form_factor::exv_bin), cache.sinqd.xx.begin());
+    transform_xx.run();
     cache.sinqd.valid = true;
-    pool->wait();
 }
 
 observer_ptr<const table::DebyeTable> CompositeDistanceHistogramFFGrid::get_sinc_table_ax() const {
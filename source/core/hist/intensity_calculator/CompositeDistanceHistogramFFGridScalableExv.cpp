@@ -5,6 +5,7 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFGridScalableExv.h>
 #include <settings/GridSettings.h>
+#include <utility/Exceptions.h>
 
 using namespace ausaxs;
 using namespace ausaxs::hist;
@@ -21,7 +22,32 @@ void CompositeDistanceHistogramFFGridScalableExv::apply_excluded_volume_scaling_
     sinc_tables = std::move(h->sinc_tables);
     p = std::move(h->p);
     axis = std::move(h->axis);
+    d_axis = std::move(h->d_axis);
+    weighted_sinc_table = std::move(h->weighted_sinc_table);
+    use_weighted_table = h->use_weighted_table;
     cache.sinqd.valid = false;
+    cx = k;
     auto V = std::pow(settings::grid::exv::width*k, 3);
     regenerate_ff_table(form_factor::ExvFormFactor(V));
-}
\ No newline at end of file
+}
+
+std::vector<double> CompositeDistanceHistogramFFGridScalableExv::evaluate(const FreeParameters& params) const {
+    if (params.cx != cx) {
+        throw except::invalid_operation(
+            "CompositeDistanceHistogramFFGridScalableExv::evaluate: The excluded volume scaling factor cannot be changed without recalculating the histogram. "
+            "Use apply_excluded_volume_scaling_factor instead."
+        );
+    }
+    return CompositeDistanceHistogramFFGrid::evaluate(params);
+}
+ICompositeDistanceHistogramExv::IntensityBasis CompositeDistanceHistogramFFGridScalableExv::get_intensity_basis() const {
+    auto basis = CompositeDistanceHistogramFFGrid::get_intensity_basis();
+    basis.exv_factor = nullptr;
+    return basis;
+}
+
+ICompositeDistanceHistogramExv::FreeParameters CompositeDistanceHistogramFFGridScalableExv::get_free_parameters() const {
+    auto params = CompositeDistanceHistogramFFGrid::get_free_parameters();
+    params.cx = cx;
+    return params;
+}
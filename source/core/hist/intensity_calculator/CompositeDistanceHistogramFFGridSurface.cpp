@@ -4,15 +4,17 @@ For more information, please refer to the LICENSE file in the project root.
 */
 
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFGridSurface.h>
+#include <hist/detail/BatchedDebyeTransform.h>
 #include <form_factor/PrecalculatedFormFactorProduct.h>
 #include <form_factor/ExvFormFactor.h>
 #include <table/ArrayDebyeTable.h>
 #include <settings/GridSettings.h>
 #include <settings/HistogramSettings.h>
-#include <utility/MultiThreading.h>
 #include <utility/Exceptions.h>
 #include <dataset/SimpleDataset.h>
 
+#include <cassert>
+
 using namespace ausaxs;
 using namespace ausaxs::hist;
 using namespace ausaxs::form_factor;
@@ -79,8 +81,8 @@ double CompositeDistanceHistogramFFGridSurface::exv_factor(double q, double cx)
     return std::pow(cx, 3)*std::exp(-rm2*(std::pow(cx, 2) - 1)*q*q);
 }
 
-double CompositeDistanceHistogramFFGridSurface::exv_factor(double q) const {
-    return exv_factor(q, free_params.cx);
+double CompositeDistanceHistogramFFGridSurface::exv_factor(double q, const FreeParameters& params) const {
+    return exv_factor(q, params.cx);
 }
 
 hist::Distribution1D CompositeDistanceHistogramFFGridSurface::evaluate_xx_distance_profile(double cx) const {
@@ -138,7 +140,6 @@ void CompositeDistanceHistogramFFGridSurface::initialize(std::vector<double>&& d
 }
 
 void CompositeDistanceHistogramFFGridSurface::cache_refresh_sinqd() const {
-    auto pool = utility::multi_threading::get_global_pool();
     auto sinqd_table = get_sinc_table();
 
     Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
@@ -150,129 +151,84 @@ void CompositeDistanceHistogramFFGridSurface::cache_refresh_sinqd() const {
         cache.sinqd.ww = container::Container1D<double>(debye_axis.bins);
     }
 
+    hist::detail::BatchedDebyeTransform transform(sinqd_table, q0, debye_axis.bins);
     for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
         for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
-            pool->detach_task([this, q0, bins=debye_axis.bins, ff1, ff2, sinqd_table] () {
-                for (unsigned int q = q0; q < q0+bins; ++q) {
-                    cache.sinqd.aa.index(ff1, ff2, q-q0) = std::inner_product(distance_profiles.aa.begin(ff1, ff2), distance_profiles.aa.end(ff1, ff2), sinqd_table->begin(q), 0.0);
-                }
-            });
+            transform.enqueue(distance_profiles.aa.begin(ff1, ff2), distance_profiles.aa.end(ff1, ff2), cache.sinqd.aa.begin(ff1, ff2));
         }
-        pool->detach_task([this, q0, bins=debye_axis.bins, ff1, sinqd_table] () {
-            for (unsigned int q = q0; q < q0+bins; ++q) {
-                cache.sinqd.aw.index(ff1, q-q0) = std::inner_product(distance_profiles.aw.begin(ff1), distance_profiles.aw.end(ff1), sinqd_table->begin(q), 0.0);
-            }
-        });
+        transform.enqueue(distance_profiles.aw.begin(ff1), distance_profiles.aw.end(ff1), cache.sinqd.aw.begin(ff1));
     }
-    pool->detach_task([&] () {
-        for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            cache.sinqd.ww.index(q-q0) = std::inner_product(distance_profiles.ww.begin(), distance_profiles.ww.end(), sinqd_table->begin(q), 0.0);
-        }
-    });
+    transform.enqueue(distance_profiles.ww.begin(), distance_profiles.ww.end(), cache.sinqd.ww.begin());
+    transform.run();
+
+    if (exv_cache.sinqd.xx_i.empty()) {
+        exv_cache.sinqd.ax_i = container::Container2D<double>(form_factor::get_count(), debye_axis.bins);
+        exv_cache.sinqd.ax_s = container::Container2D<double>(form_factor::get_count(), debye_axis.bins);
+        exv_cache.sinqd.xx_i = container::Container1D<double>(debye_axis.bins);
+        exv_cache.sinqd.xx_s = container::Container1D<double>(debye_axis.bins);
+        exv_cache.sinqd.xx_c = container::Container1D<double>(debye_axis.bins);
+        exv_cache.sinqd.wx_i = container::Container1D<double>(debye_axis.bins);
+        exv_cache.sinqd.wx_s = container::Container1D<double>(debye_axis.bins);
+    }
+
+    const auto& exv = exv_distance_profiles;
+    hist::detail::BatchedDebyeTransform transform_ax(get_sinc_table_ax(), q0, debye_axis.bins);
+    for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
+        transform_ax.enqueue(exv.ax_i.begin(ff1), exv.ax_i.end(ff1), exv_cache.sinqd.ax_i.begin(ff1));
+        transform_ax.enqueue(exv.ax_s.begin(ff1), exv.ax_s.end(ff1), exv_cache.sinqd.ax_s.begin(ff1));
+    }
+    transform_ax.enqueue(exv.wx_i.begin(), exv.wx_i.end(), exv_cache.sinqd.wx_i.begin());
+    transform_ax.enqueue(exv.wx_s.begin(), exv.wx_s.end(), exv_cache.sinqd.wx_s.begin());
+    transform_ax.run();
+
+    hist::detail::BatchedDebyeTransform transform_xx(get_sinc_table_xx(), q0, debye_axis.bins);
+    transform_xx.enqueue(exv.xx_i.begin(), exv.xx_i.end(), exv_cache.sinqd.xx_i.begin());
+    transform_xx.enqueue(exv.xx_s.begin(), exv.xx_s.end(), exv_cache.sinqd.xx_s.begin());
+    transform_xx.enqueue(exv.xx_c.begin(), exv.xx_c.end(), exv_cache.sinqd.xx_c.begin());
+    transform_xx.run();
     cache.sinqd.valid = true;
-    pool->wait();
 }
 
-void CompositeDistanceHistogramFFGridSurface::cache_refresh_intensity_profiles(bool sinqd_changed, bool cw_changed, bool cx_changed) const {
-    auto pool = utility::multi_threading::get_global_pool();
+void CompositeDistanceHistogramFFGridSurface::evaluate_profile(Profile profile, const FreeParameters& params, const std::vector<double>& cx, std::vector<double>& out) const {
+    if (profile != Profile::ax && profile != Profile::xx && profile != Profile::wx) {
+        CompositeDistanceHistogramFFAvg::evaluate_profile(profile, params, cx, out);
+        return;
+    }
     const auto& ff_table = get_ff_table();
-    auto sinqd_table_ax = get_sinc_table_ax();
-    auto sinqd_table_xx = get_sinc_table_xx();
 
     Axis debye_axis = constants::axes::q_axis.sub_axis(settings::axes::qmin, settings::axes::qmax);
     unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin); // account for a possibly different qmin
+    assert(out.size() == debye_axis.bins && "CompositeDistanceHistogramFFGridSurface::evaluate_profile: out.size() != debye_axis.bins");
+    assert(cx.size() == debye_axis.bins && "CompositeDistanceHistogramFFGridSurface::evaluate_profile: cx.size() != debye_axis.bins");
 
-    if (sinqd_changed) {
-        this->cache.intensity_profiles.aa = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cw_changed) {
-        this->cache.intensity_profiles.aw = std::vector<double>(debye_axis.bins, 0);
-        this->cache.intensity_profiles.ww = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cx_changed) {
-        this->cache.intensity_profiles.ax = std::vector<double>(debye_axis.bins, 0);
-        this->cache.intensity_profiles.xx = std::vector<double>(debye_axis.bins, 0);
-    }
-    if (cw_changed || cx_changed) {
-        this->cache.intensity_profiles.wx = std::vector<double>(debye_axis.bins, 0);
-    }
-
-    std::vector<double> cx(debye_axis.bins, 0);
-    for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {cx[q-q0] = exv_factor(constants::axes::q_vals[q]);}
+    // the surface scaling is q-dependent, but since the profiles are linear in it, it can be applied after the transform
 
-    if (sinqd_changed) {
-        // aa
-        pool->detach_task([&] () {
-            for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
-                for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
-                    for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                        this->cache.intensity_profiles.aa[q-q0] += 
-                            this->cache.sinqd.aa.index(ff1, ff2, q-q0)*ff_table.index(ff1, ff2).evaluate(q);
-                    }
-                }
-            }
-        });
-    }
-
-    if (cx_changed) {
-        // ax
-        pool->detach_task([&] () {
-            for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                auto ax = evaluate_ax_distance_profile(cx[q]);
-                for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
-                    double ax_sum = std::inner_product(ax.begin(ff1), ax.end(ff1), sinqd_table_ax->begin(q), 0.0);
-                    this->cache.intensity_profiles.ax[q-q0] += 
-                        2*this->free_params.crho*ax_sum*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
-                }
-            }
-        });
-
-        // xx
-        pool->detach_task([&] () {
-            for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                auto xx = evaluate_xx_distance_profile(cx[q]);
-                double xx_sum = std::inner_product(xx.begin(), xx.end(), sinqd_table_xx->begin(q), 0.0);
-                this->cache.intensity_profiles.xx[q-q0] += 
-                    this->free_params.crho*this->free_params.crho*xx_sum*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
-            }
-        });
-    }
-
-    if (cw_changed) {
-        // aw
-        pool->detach_task([&] () {
+    const auto& sinqd = exv_cache.sinqd;
+    switch (profile) {
+        case Profile::ax:
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                    this->cache.intensity_profiles.aw[q-q0] += 
-                        2*this->free_params.cw*this->cache.sinqd.aw.index(ff1, q-q0)
-                        *ff_table.index(ff1, form_factor::water_bin).evaluate(q);
+                    double ax_sum = sinqd.ax_i.index(ff1, q-q0) + cx[q-q0]*sinqd.ax_s.index(ff1, q-q0);
+                    out[q-q0] += 2*params.crho*ax_sum*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
                 }
             }
-        });
+            break;
 
-        // ww
-        pool->detach_task([&] () {
+        case Profile::xx:
             for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                this->cache.intensity_profiles.ww[q-q0] += 
-                    this->free_params.cw*this->free_params.cw*this->cache.sinqd.ww.index(q-q0)
-                    *ff_table.index(form_factor::water_bin, form_factor::water_bin).evaluate(q);
+                double xx_sum = sinqd.xx_i.index(q-q0) + cx[q-q0]*cx[q-q0]*sinqd.xx_s.index(q-q0) + cx[q-q0]*sinqd.xx_c.index(q-q0);
+                out[q-q0] += params.crho*params.crho*xx_sum*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
             }
-        });
-    }
+            break;
 
-    if (cw_changed || cx_changed) {
-        // wx
-        pool->detach_task([&] () {
+        case Profile::wx:
             for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-                auto wx = evaluate_wx_distance_profile(cx[q]);
-                double wx_sum = std::inner_product(wx.begin(), wx.end(), sinqd_table_ax->begin(q), 0.0);
-                this->cache.intensity_profiles.wx[q-q0] += 
-                    2*this->free_params.crho*wx_sum*this->free_params.cw*ff_table.index(form_factor::water_bin, form_factor::exv_bin).evaluate(q);
+                double wx_sum = sinqd.wx_i.index(q-q0) + cx[q-q0]*sinqd.wx_s.index(q-q0);
+                out[q-q0] += 2*params.crho*wx_sum*params.cw*ff_table.index(form_factor::water_bin, form_factor::exv_bin).evaluate(q);
             }
-        });
+            break;
+
+        default:
+            break;
     }
-    this->cache.intensity_profiles.cached_cx = this->free_params.cx;
-    this->cache.intensity_profiles.cached_cw = this->free_params.cw;
-    this->cache.intensity_profiles.cached_crho = this->free_params.crho;
-    pool->wait();
 }
\ No newline at end of file
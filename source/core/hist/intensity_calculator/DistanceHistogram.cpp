@@ -7,6 +7,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
 #include <hist/distribution/Distribution1D.h>
 #include <hist/Histogram.h>
+#include <hist/detail/BatchedDebyeTransform.h>
 #include <table/ArrayDebyeTable.h>
 #include <table/VectorDebyeTable.h>
 #include <dataset/SimpleDataset.h>
@@ -67,8 +68,10 @@ ScatteringProfile DistanceHistogram::debye_transform() const {
     // calculate the scattering intensity based on the Debye equation
     std::vector<double> Iq(debye_axis.bins, 0);
     unsigned int q0 = constants::axes::q_axis.get_bin(settings::axes::qmin); // account for a possibly different qmin
+    hist::detail::BatchedDebyeTransform transform(sinqd_table, q0, debye_axis.bins);
+    transform.enqueue(p.begin(), p.end(), Iq.begin());
+    transform.run();
     for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) { // iterate through all q values
-        Iq[q-q0] = std::inner_product(p.begin(), p.end(), sinqd_table->begin(q), 0.0);
         Iq[q-q0] *= std::exp(-q_axis[q]*q_axis[q]); // form factor
     }
     return ScatteringProfile(Iq, debye_axis);
@@ -84,8 +87,10 @@ SimpleDataset DistanceHistogram::debye_transform(const std::vector<double>& q) c
 
     // calculate the scattering intensity based on the Debye equation
     std::vector<double> Iq(q.size(), 0);
+    hist::detail::BatchedDebyeTransform transform(&sinqd_table, 0, q.size());
+    transform.enqueue(p.begin(), p.end(), Iq.begin());
+    transform.run();
     for (unsigned int i = 0; i < q.size(); ++i) { // iterate through all q values
-        Iq[i] = std::inner_product(p.begin(), p.end(), sinqd_table.begin(i), 0.0);
         Iq[i] *= std::exp(-q[i]*q[i]); // form factor
     }
     return SimpleDataset(q, Iq);
@@ -4,9 +4,22 @@ For more information, please refer to the LICENSE file in the project root.
 */
 
 #include <hist/intensity_calculator/ICompositeDistanceHistogramExv.h>
+#include <utility/Exceptions.h>
 
 using namespace ausaxs;
 
+std::vector<double> hist::ICompositeDistanceHistogramExv::evaluate(const FreeParameters&) const {
+    throw except::not_implemented("ICompositeDistanceHistogramExv::evaluate: Stateless evaluation is not supported by this histogram.");
+}
+
+hist::ICompositeDistanceHistogramExv::IntensityBasis hist::ICompositeDistanceHistogramExv::get_intensity_basis() const {
+    throw except::not_implemented("ICompositeDistanceHistogramExv::get_intensity_basis: Basis decomposition is not supported by this histogram.");
+}
+
+hist::ICompositeDistanceHistogramExv::FreeParameters hist::ICompositeDistanceHistogramExv::get_free_parameters() const {
+    throw except::not_implemented("ICompositeDistanceHistogramExv::get_free_parameters: Not supported by this histogram.");
+}
+
 Limit hist::ICompositeDistanceHistogramExv::get_excluded_volume_scaling_factor_limits() const {return {0.92, 1.08};}
 
 Limit hist::ICompositeDistanceHistogramExv::get_solvent_density_scaling_factor_limits() const {return {0.5, 2};}
@@ -53,8 +53,8 @@ double CompositeDistanceHistogramCrysol::exv_factor(double q, double cx, double
     return std::pow(cx, 3)*std::exp(-c*(std::pow(cx, 2) - 1)*q*q);
 }
 
-double CompositeDistanceHistogramCrysol::exv_factor(double q) const {
-    return exv_factor(q, free_params.cx, average_displaced_V);
+double CompositeDistanceHistogramCrysol::exv_factor(double q, const FreeParameters& params) const {
+    return exv_factor(q, params.cx, average_displaced_V);
 }
 
 Limit CompositeDistanceHistogramCrysol::get_excluded_volume_scaling_factor_limits() const {
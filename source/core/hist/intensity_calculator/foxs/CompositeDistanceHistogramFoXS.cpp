@@ -19,8 +19,8 @@ double CompositeDistanceHistogramFoXS::exv_factor(double q, double cx) {
     return std::pow(cx, 3)*std::exp(-c*(std::pow(cx, 2) - 1)*q*q);
 }
 
-double CompositeDistanceHistogramFoXS::exv_factor(double q) const {
-    return exv_factor(q, free_params.cx);
+double CompositeDistanceHistogramFoXS::exv_factor(double q, const FreeParameters& params) const {
+    return exv_factor(q, params.cx);
 }
 
 CompositeDistanceHistogramFoXS::CompositeDistanceHistogramFoXS(
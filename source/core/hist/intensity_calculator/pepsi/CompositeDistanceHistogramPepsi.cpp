@@ -17,8 +17,8 @@ double hist::CompositeDistanceHistogramPepsi::exv_factor(double, double cx) {
     return (1 + cx*(3-c));
 }
 
-double hist::CompositeDistanceHistogramPepsi::exv_factor(double q) const {
-    return exv_factor(q, free_params.cx);
+double hist::CompositeDistanceHistogramPepsi::exv_factor(double q, const FreeParameters& params) const {
+    return exv_factor(q, params.cx);
 }
 
 Limit hist::CompositeDistanceHistogramPepsi::get_excluded_volume_scaling_factor_limits() const {
@@ -10,18 +10,56 @@ For more information, please refer to the LICENSE file in the project root.
 #include <constants/Constants.h>
 #include <settings/GridSettings.h>
 #include <settings/MoleculeSettings.h>
+#include <utility/MultiThreading.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <mutex>
+#include <numbers>
 #include <random>
 
 using namespace ausaxs;
 
-std::function<Vector3<double>()> hydrate::RadialHydration::noise_generator = [] () {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<> gauss(0, 0.75);
-    return Vector3<double>(gauss(gen), gauss(gen), gauss(gen));
-};
+std::function<Vector3<double>()> hydrate::RadialHydration::noise_generator = nullptr;
+
+namespace {
+    // the source of the seeds of the default noise. a new seed is drawn for every hydration, such that consecutive hydrations differ
+    // different molecules may be hydrated from different threads, so the generator is only used while holding its mutex
+    struct SeedGenerator {
+        std::mutex mutex;
+        std::mt19937_64 gen{std::random_device{}()};
+    };
+
+    SeedGenerator& seed_generator() {
+        static SeedGenerator generator;
+        return generator;
+    }
+
+    std::uint64_t splitmix64(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15;
+        x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27))*0x94d049bb133111eb;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Counter-based Gaussian noise. Every (seed, atom, direction) triplet has its own independent stream, 
+     *        so the noise of a candidate does not depend on the order in which the candidates are evaluated.
+     */
+    Vector3<double> gaussian_noise(std::uint64_t seed, std::uint64_t atom, std::uint64_t direction) {
+        constexpr double sigma = 0.75;
+        std::uint64_t key = splitmix64(seed ^ splitmix64(atom ^ splitmix64(direction)));
+        std::array<double, 4> u;
+        for (unsigned int i = 0; i < 4; ++i) {u[i] = (splitmix64(key + i) >> 11)*0x1.0p-53;}
+
+        // Box-Muller transform. 1-u is in (0, 1], so the logarithm is always finite
+        double r1 = sigma*std::sqrt(-2*std::log(1 - u[0])), r2 = sigma*std::sqrt(-2*std::log(1 - u[2]));
+        double t1 = 2*std::numbers::pi*u[1], t2 = 2*std::numbers::pi*u[3];
+        return Vector3<double>(r1*std::cos(t1), r1*std::sin(t1), r2*std::cos(t2));
+    }
+}
 
 hydrate::RadialHydration::RadialHydration(observer_ptr<data::Molecule> protein) : GridBasedHydration(protein) {
     initialize();
@@ -43,33 +81,91 @@ void hydrate::RadialHydration::set_noise_generator(std::function<Vector3<double>
     noise_generator = std::move(f);
 }
 
+void hydrate::RadialHydration::set_noise_seed(unsigned int seed) {
+    auto& generator = seed_generator();
+    std::lock_guard lock(generator.mutex);
+    generator.gen.seed(seed);
+}
+
 std::span<grid::GridMember<data::Water>> hydrate::RadialHydration::generate_explicit_hydration(std::span<grid::GridMember<data::AtomFF>> atoms) {
     assert(protein != nullptr && "RadialHydration::generate_explicit_hydration: protein is nullptr.");
     auto grid = protein->get_grid();
     assert(grid != nullptr && "RadialHydration::generate_explicit_hydration: grid is nullptr.");
 
-    // we define a helper lambda
-    auto add_loc = [&] (Vector3<double> exact_loc) {
-        data::Water a(exact_loc);
-        grid::GridMember<data::Water> gm = grid->add(std::move(a), true);
-    };
+    // a custom noise generator may not be thread-safe, so its noise is drawn up front in the same order as a sequential placement would
+    // the default noise is only seeded when it is used, such that a custom generator does not advance the seeds of later hydrations
+    unsigned int directions = rot_locs.size();
+    std::uint64_t seed = 0;
+    std::vector<Vector3<double>> custom_noise;
+    if (noise_generator) {
+        custom_noise.resize(atoms.size()*directions);
+        std::generate(custom_noise.begin(), custom_noise.end(), noise_generator);
+    } else {
+        auto& generator = seed_generator();
+        std::lock_guard lock(generator.mutex);
+        seed = generator.gen();
+    }
 
+    // the candidate location along a radial line of an atom
     double rh = grid->get_hydration_radius() + settings::hydrate::shell_correction;
+    auto location = [&] (unsigned int a, unsigned int direction) {
+        const auto& atom = atoms[a];
+        double reff = grid->get_atomic_radius(atom.get_atom_type()) + rh;
+        Vector3<double> noise = noise_generator ? custom_noise[a*directions + direction] : gaussian_noise(seed, a, direction);
+        return atom.get_atom().coordinates() + rot_locs[direction]*reff + noise;
+    };
+
+    auto acceptable = [&] (const Vector3<double>& exact_loc) {
+        auto bins = grid->to_bins_bounded(exact_loc);
+        return grid->grid.is_empty_or_volume(bins.x(), bins.y(), bins.z()) && collision_check(bins);
+    };
+
     std::size_t water_start = grid->w_members.size();
-    for (const auto& atom : atoms) {
-        const auto& coords_abs = atom.get_atom().coordinates();
-        double ra = grid->get_atomic_radius(atom.get_atom_type());
-        double reff = ra + rh;
-    
-        for (unsigned int i = 0; i < rot_locs.size(); i++) {
-            auto noise = noise_generator();
-            auto bins = grid->to_bins_bounded(coords_abs + rot_locs[i]*reff + noise);
-            if (grid->grid.is_empty_or_volume(bins.x(), bins.y(), bins.z()) && collision_check({bins.x(), bins.y(), bins.z()})) {
-                Vector3<double> exact_loc = atom.get_atom().coordinates() + rot_locs[i]*reff + noise;
-                add_loc(std::move(exact_loc));
+    if (!settings::hydrate::parallel) {
+        // each candidate is checked against all previously added waters, and added immediately
+        for (unsigned int a = 0; a < atoms.size(); ++a) {
+            for (unsigned int i = 0; i < directions; ++i) {
+                Vector3<double> exact_loc = location(a, i);
+                if (acceptable(exact_loc)) {grid->add(data::Water(exact_loc), true);}
+            }
+        }
+        return {grid->w_members.begin() + water_start, grid->w_members.end()};
+    }
+
+    // propose the candidate locations around a range of atoms whose center bins are free in the current grid
+    // added waters only ever fill bins, so a candidate whose center bin is already occupied would also be rejected sequentially
+    // the collision check cannot be made here: a water occupying a bin at 1rh skips the penalties at 3rh and 5rh of that line, so an added water may raise the score of a location
+    auto propose = [&] (unsigned int begin, unsigned int end, std::vector<Vector3<double>>& candidates) {
+        for (unsigned int a = begin; a < end; ++a) {
+            for (unsigned int i = 0; i < directions; ++i) {
+                Vector3<double> exact_loc = location(a, i);
+                auto bins = grid->to_bins_bounded(exact_loc);
+                if (grid->grid.is_empty_or_volume(bins.x(), bins.y(), bins.z())) {candidates.push_back(std::move(exact_loc));}
             }
         }
+    };
+
+    // add the candidates in order, each checked in full against the grid with all earlier waters, exactly as in the sequential placement
+    auto commit = [&] (const std::vector<Vector3<double>>& candidates) {
+        for (const auto& exact_loc : candidates) {
+            if (acceptable(exact_loc)) {grid->add(data::Water(exact_loc), true);}
+        }
+    };
+
+    // the grid is not modified while proposing, so the atoms can be processed in parallel
+    // the blocks are committed in order, so the result is the same as the sequential placement and does not depend on the number of threads
+    constexpr unsigned int block_size = 64;
+    unsigned int blocks = (atoms.size() + block_size - 1)/block_size;
+    std::vector<std::vector<Vector3<double>>> candidates(blocks);
+    auto pool = utility::multi_threading::get_global_pool();
+    for (unsigned int b = 0; b < blocks; ++b) {
+        pool->detach_task([&, b] () {
+            propose(b*block_size, std::min<unsigned int>((b+1)*block_size, atoms.size()), candidates[b]);
+        });
     }
+    pool->wait();
+
+    for (const auto& block : candidates) {commit(block);}
     return {grid->w_members.begin() + water_start, grid->w_members.end()};
 }
 
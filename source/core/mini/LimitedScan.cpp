@@ -7,6 +7,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <utility/Limit.h>
 #include <mini/detail/Parameter.h>
 
+#include <algorithm>
 #include <limits>
 #include <list>
 #include <numeric>
@@ -41,11 +42,28 @@ mini::Landscape LimitedScan::landscape(unsigned int evals) {
 
     if (parameters.size() == 1) {
         const Limit& bounds = parameters[0].bounds.value();
+        std::vector<std::vector<double>> points;
+        for (double val = bounds.max; bounds.min < val; val -= bounds.span()/evals) {
+            points.push_back({val});
+        }
+
+        // the points are evaluated in batches, and only recorded until the stop condition is met
+        // since the stop condition is never checked before 70% of the evaluations, all points until then are evaluated as a single batch
         unsigned int c = 0;
         std::list<double> last_evals;
         unsigned int count = 0;
-        for (double val = bounds.max; bounds.min < val; val -= bounds.span()/evals) {
-            double fval = function({val});
+        unsigned int batch_size = get_batch_size();
+        unsigned int evaluated = 0;
+        std::vector<double> fvals(points.size());
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            if (i == evaluated) {
+                unsigned int end = std::min<unsigned int>(std::max<unsigned int>(i + batch_size, evals*0.7), points.size());
+                auto batch = evaluate_batch(std::vector<std::vector<double>>(points.begin() + i, points.begin() + end), false);
+                std::copy(batch.begin(), batch.end(), fvals.begin() + i);
+                evaluated = end;
+            }
+            double fval = fvals[i];
+            record_evaluation(points[i], fval);
             current_min = std::min(current_min, fval);
 
             // add the evaluation to the list
@@ -9,8 +9,13 @@ For more information, please refer to the LICENSE file in the project root.
 #include <mini/detail/FittedParameter.h>
 #include <utility/Exceptions.h>
 #include <settings/GeneralSettings.h>
+#include <utility/MultiThreading.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <thread>
 
 using namespace ausaxs;
 using namespace ausaxs::mini;
@@ -52,6 +57,10 @@ void Minimizer::set_function(std::function<double(std::vector<double>)>&& f) {
     function = wrapper;
 }
 
+void Minimizer::set_gradient(std::function<std::vector<double>(std::vector<double>)>&& f) {
+    gradient = std::move(f);
+}
+
 bool Minimizer::empty() const noexcept {
     return !is_function_set() && !is_parameter_set();
 }
@@ -62,6 +71,77 @@ void Minimizer::clear_parameters() noexcept {
 
 void Minimizer::record_evaluations(bool setting) {
     function = setting ? wrapper : raw;
+    recording = setting;
+}
+
+void Minimizer::set_parallel_evaluation(bool setting) noexcept {
+    parallel = setting;
+}
+
+void Minimizer::set_evaluation_threads(unsigned int threads) noexcept {
+    this->threads = threads;
+}
+
+unsigned int Minimizer::get_batch_size() const noexcept {
+    if (1 < threads) {return threads;}
+    return parallel ? utility::multi_threading::get_global_pool()->get_thread_count() : 1;
+}
+
+std::vector<double> Minimizer::evaluate_batch(const std::vector<std::vector<double>>& points, bool record) {
+    std::vector<double> fvals(points.size());
+    if ((!parallel && threads < 2) || points.size() < 2) {
+        for (unsigned int i = 0; i < points.size(); ++i) {fvals[i] = raw(points[i]);}
+    } else {
+        // evaluate the first point here to initialize any lazy state of the function
+        fvals[0] = raw(points[0]);
+        if (1 < threads) {
+            // the remaining points are distributed dynamically since the evaluation times may vary a lot
+            std::atomic<unsigned int> next = 1;
+            std::vector<std::exception_ptr> errors(std::min<unsigned int>(threads, points.size()-1));
+            std::vector<std::thread> workers;
+            for (unsigned int t = 0; t < errors.size(); ++t) {
+                workers.emplace_back([this, &points, &fvals, &next, &error = errors[t]] () {
+                    try {
+                        for (unsigned int i = next++; i < points.size(); i = next++) {fvals[i] = raw(points[i]);}
+                    } catch (...) {
+                        error = std::current_exception();
+                        next = static_cast<unsigned int>(points.size()); // stop the other workers early
+                    }
+                });
+            }
+            for (auto& worker : workers) {worker.join();}
+            for (auto& error : errors) {
+                if (error) {std::rethrow_exception(error);}
+            }
+        } else {
+            auto pool = utility::multi_threading::get_global_pool();
+            std::vector<std::exception_ptr> errors(points.size());
+            for (unsigned int i = 1; i < points.size(); ++i) {
+                pool->detach_task([this, &points, &fvals, &errors, i] () {
+                    try {
+                        fvals[i] = raw(points[i]);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                });
+            }
+            pool->wait();
+            for (auto& error : errors) {
+                if (error) {std::rethrow_exception(error);}
+            }
+        }
+    }
+
+    if (record) {
+        for (unsigned int i = 0; i < points.size(); ++i) {record_evaluation(points[i], fvals[i]);}
+    }
+    return fvals;
+}
+
+void Minimizer::record_evaluation(const std::vector<double>& point, double fval) {
+    if (!recording) {return;}
+    evaluations.evals.push_back(Evaluation(point, fval));
+    fevals++;
 }
 
 void Minimizer::add_parameter(const Parameter& param) {
@@ -79,6 +159,10 @@ bool Minimizer::is_function_set() const noexcept {
     return bool(function); // functions are explicitly convertable to a bool which is true if a function has been set
 }
 
+bool Minimizer::is_gradient_set() const noexcept {
+    return bool(gradient);
+}
+
 bool Minimizer::is_parameter_set() const noexcept {
     return !parameters.empty();
 }
@@ -91,29 +175,31 @@ mini::Landscape Minimizer::get_evaluated_points() const {
 mini::Landscape Minimizer::landscape(unsigned int bins) {
     if (parameters.empty()) {throw except::bad_order("Minimizer::landscape: No parameters were supplied.");}
 
-    mini::Landscape l;
+    // all points are known in advance, so they can be evaluated as a single batch
+    std::vector<std::vector<double>> points;
     auto bx = parameters[0].bounds.value();
     for (unsigned int i = 0; i < bins; i++) {
         double vx = bx.min + i*bx.span()/(bins-1);
-        double fval;
         if (parameters.size() == 2) {
             auto by = parameters[1].bounds.value();
             for (unsigned int j = 0; j < bins; j++) {
                 double vy = by.min + j*by.span()/(bins-1);
-                fval = function({vx, vy});
-                l.evals.emplace_back(Evaluation{{vx, vy}, fval});
+                points.push_back({vx, vy});
             }
         } else {
-            fval = function({vx});
-            l.evals.emplace_back(Evaluation{{vx}, fval});
+            points.push_back({vx});
         }
+    }
+    auto fvals = evaluate_batch(points);
 
+    mini::Landscape l;
+    for (unsigned int i = 0; i < points.size(); ++i) {
         // sanity check
-        if (std::isnan(fval) || std::isinf(fval)) {
+        if (std::isnan(fvals[i]) || std::isinf(fvals[i])) {
             if (settings::general::verbose) {std::cout << "Warning in Minimizer::landscape: Function value is nan or inf and will be skipped." << std::endl;}
-            l.evals.pop_back();
             continue;
         }
+        l.evals.emplace_back(Evaluation{std::move(points[i]), fvals[i]});
     }
     return l;
 }
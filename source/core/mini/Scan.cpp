@@ -41,9 +41,11 @@ mini::Landscape Scan::landscape(unsigned int evals) {
 
     if (parameters.size() == 1) {
         const Limit& bounds = parameters[0].bounds.value();
+        std::vector<std::vector<double>> points;
         for (double val = bounds.min; val < bounds.max; val += bounds.span()/evals) {
-            function({val});
+            points.push_back({val});
         }
+        evaluate_batch(points);
         return get_evaluated_points();
     } 
     
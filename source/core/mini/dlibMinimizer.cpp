@@ -76,6 +76,10 @@ For more information, please refer to the LICENSE file in the project root.
 
         double fmin;
         auto fwrapper = [this](dlib::matrix<double, 0, 1> x) {return this->function(std::vector<double>(x.begin(), x.end()));};
+        auto gwrapper = [this](dlib::matrix<double, 0, 1> x) {
+            auto g = this->gradient(std::vector<double>(x.begin(), x.end()));
+            return dlib::matrix<double, 0, 1>(dlib::mat(g));
+        };
         if (bounds) {
             if constexpr (algo == mini::algorithm::DLIB_GLOBAL) {
                 auto eval = dlib::find_min_global(
@@ -87,25 +91,48 @@ For more information, please refer to the LICENSE file in the project root.
                 x = eval.x;
                 fmin = eval.y;
             } else if constexpr (algo == mini::algorithm::BFGS) {
-                fmin = dlib::find_min_box_constrained(
-                    dlib::bfgs_search_strategy(), 
-                    dlib::objective_delta_stop_strategy(1e-7), 
-                    fwrapper, 
-                    dlib::derivative(fwrapper), 
-                    x, 
-                    min,
-                    max
-                );
+                if (is_gradient_set()) {
+                    fmin = dlib::find_min_box_constrained(
+                        dlib::bfgs_search_strategy(), 
+                        dlib::objective_delta_stop_strategy(1e-7), 
+                        fwrapper, 
+                        gwrapper, 
+                        x, 
+                        min,
+                        max
+                    );
+                } else {
+                    fmin = dlib::find_min_box_constrained(
+                        dlib::bfgs_search_strategy(), 
+                        dlib::objective_delta_stop_strategy(1e-7), 
+                        fwrapper, 
+                        dlib::derivative(fwrapper), 
+                        x, 
+                        min,
+                        max
+                    );
+                }
             }
         } else {
             console::print_warning("dlibMinimizer::minimize_override: No bounds supplied. Using unconstrained minimization.");
-            fmin = dlib::find_min_using_approximate_derivatives(
-                dlib::bfgs_search_strategy(),
-                dlib::objective_delta_stop_strategy(1e-7),
-                fwrapper,
-                x,
-                -1
-            );
+            if (is_gradient_set()) {
+                fmin = dlib::find_min(
+                    dlib::bfgs_search_strategy(),
+                    dlib::objective_delta_stop_strategy(1e-7),
+                    fwrapper,
+                    gwrapper,
+                    x,
+                    -1
+                );
+            } else {
+                fmin = dlib::find_min_using_approximate_derivatives(
+                    dlib::bfgs_search_strategy(),
+                    dlib::objective_delta_stop_strategy(1e-7),
+                    fwrapper,
+                    x,
+                    -1
+                );
+            }
         }
 
         Result res;
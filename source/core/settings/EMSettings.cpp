@@ -16,6 +16,8 @@ bool settings::em::save_pdb = true;
 Limit settings::em::alpha_levels = {1, 10};
 bool settings::em::fixed_weights = true;
 bool settings::em::plot_landscapes = false;
+bool settings::em::incremental_histogram = true;
+unsigned int settings::em::scan_threads = 1;
 bool settings::em::simulation::noise = true;
 bool settings::em::mass_axis = true;
 
@@ -30,6 +32,8 @@ namespace ausaxs::settings::em::io {
         settings::io::create(alpha_levels, "alpha_levels"),
         settings::io::create(fixed_weights, "fixed_weights"),
         settings::io::create(plot_landscapes, "plot_landscapes"),
+        settings::io::create(incremental_histogram, "incremental_histogram"),
+        settings::io::create(scan_threads, "scan_threads"),
         settings::io::create(simulation::noise, "simulation.noise")
     });
 }
\ No newline at end of file
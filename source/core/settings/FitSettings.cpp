@@ -16,6 +16,7 @@ bool settings::fit::fit_solvent_density = false;
 bool settings::fit::fit_hydration = true;
 bool settings::fit::fit_atomic_debye_waller = false;
 bool settings::fit::fit_exv_debye_waller = false;
+bool settings::fit::use_intensity_basis = true;
 
 namespace ausaxs::settings::fit::io {
     settings::io::SettingSection general_settings("General", {
@@ -24,6 +25,7 @@ namespace ausaxs::settings::fit::io {
         settings::io::create(max_iterations, "max_iterations"),
         settings::io::create(fit_excluded_volume, "fit_excluded_volume"),
         settings::io::create(fit_solvent_density, "fit_solvent_density"),
-        settings::io::create(fit_hydration, "fit_hydration")
+        settings::io::create(fit_hydration, "fit_hydration"),
+        settings::io::create(use_intensity_basis, "use_intensity_basis")
     });
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ double settings::grid::scaling = 0.25;
 bool settings::grid::cubic = false;
 double settings::grid::min_exv_radius = 2.15;
 unsigned int settings::grid::min_bins = 0;
+bool settings::grid::sparse = false;
 
 double settings::grid::exv::surface_thickness = 1;
 double settings::grid::exv::width = 1;
@@ -28,6 +29,7 @@ namespace ausaxs::settings::grid::io {
         settings::io::create(cell_width, "width"),
         settings::io::create(scaling, "scaling"),
         settings::io::create(cubic, "cubic"),
+        settings::io::create(sparse, "sparse"),
         settings::io::create(min_exv_radius, "rvol"),
         settings::io::create(exv::width, "exv_width"),
         settings::io::create(exv::save, "save_exv"),
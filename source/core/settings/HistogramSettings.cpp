@@ -15,6 +15,10 @@ double settings::axes::qmin = constants::axes::q_axis.min;
 double settings::axes::qmax = 0.5;
 unsigned int settings::axes::skip = 0;
 bool settings::hist::weighted_bins = true;
+bool settings::hist::detail::spatial_tiling = false;
+unsigned int settings::hist::detail::tile_size = 512;
+bool settings::hist::detail::soa_kernels = false;
+bool settings::hist::detail::lattice_exv = true;
 
 namespace ausaxs::settings::axes::io {
     settings::io::SettingSection axes_settings("Axes", {
@@ -27,7 +31,11 @@ namespace ausaxs::settings::axes::io {
 settings::hist::HistogramManagerChoice settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::PartialHistogramManagerMT;
 settings::io::SettingSection hist_settings("Histogram", {
     settings::io::create(settings::hist::histogram_manager, "histogram_manager"),
-    settings::io::create(settings::hist::weighted_bins, "weighted_bins")
+    settings::io::create(settings::hist::weighted_bins, "weighted_bins"),
+    settings::io::create(settings::hist::detail::spatial_tiling, "detail.spatial_tiling"),
+    settings::io::create(settings::hist::detail::tile_size, "detail.tile_size"),
+    settings::io::create(settings::hist::detail::soa_kernels, "detail.soa_kernels"),
+    settings::io::create(settings::hist::detail::lattice_exv, "detail.lattice_exv")
 });
 
 template<> std::string settings::io::detail::SettingRef<settings::hist::HistogramManagerChoice>::get() const {
@@ -43,6 +51,7 @@ template<> std::string settings::io::detail::SettingRef<settings::hist::Histogra
         case settings::hist::HistogramManagerChoice::PartialHistogramManagerMT: return "phmmt";
         case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg: return "phmmtff";
         case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit: return "phmmtffx";
+        case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFGrid: return "phmmtffg";
         case settings::hist::HistogramManagerChoice::FoXSManager: return "foxs";
         case settings::hist::HistogramManagerChoice::PepsiManager: return "pepsi";
         case settings::hist::HistogramManagerChoice::CrysolManager: return "crysol";
@@ -64,6 +73,7 @@ template<> void settings::io::detail::SettingRef<settings::hist::HistogramManage
     else if (str == "phmmt") {settingref = settings::hist::HistogramManagerChoice::PartialHistogramManagerMT;}
     else if (str == "phmmtff") {settingref = settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg;}
     else if (str == "phmmtffx") {settingref = settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit;}
+    else if (str == "phmmtffg") {settingref = settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFGrid;}
     // else if (str == "debug") {settingref = settings::hist::HistogramManagerChoice::DebugManager;}
     else if (str == "foxs") {settingref = settings::hist::HistogramManagerChoice::FoXSManager;}
     else if (str == "pepsi") {settingref = settings::hist::HistogramManagerChoice::PepsiManager;}
@@ -33,13 +33,15 @@ namespace ausaxs::settings::molecule::io {
 
     settings::io::SettingSection hydrate_settings("Hydrate", {
         settings::io::create(hydrate::hydration_strategy, "hydration_strategy"),
-        settings::io::create(hydrate::culling_strategy, "culling_strategy")
+        settings::io::create(hydrate::culling_strategy, "culling_strategy"),
+        settings::io::create(hydrate::parallel, "parallel")
     });
 }
 
 settings::hydrate::HydrationStrategy settings::hydrate::hydration_strategy = HydrationStrategy::RadialStrategy;
 settings::hydrate::CullingStrategy settings::hydrate::culling_strategy = CullingStrategy::NoStrategy;
 double settings::hydrate::shell_correction = -0.35;
+bool settings::hydrate::parallel = true;
 
 template<> std::string settings::io::detail::SettingRef<settings::hydrate::HydrationStrategy>::get() const {
     switch (settingref) {
@@ -0,0 +1,79 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <settings/SettingsContext.h>
+#include <settings/SettingsIORegistry.h>
+#include <hist/detail/SimpleExvModel.h>
+#include <utility/Exceptions.h>
+
+#include <algorithm>
+
+using namespace ausaxs;
+using namespace ausaxs::settings;
+
+namespace {
+    std::recursive_mutex& get_settings_mutex() {
+        static std::recursive_mutex mutex;
+        return mutex;
+    }
+}
+
+std::unique_lock<std::recursive_mutex> settings::lock_globals() {
+    return std::unique_lock(get_settings_mutex());
+}
+
+Context Context::current() {
+    auto lock = lock_globals();
+    Context context;
+    context.simple_exv_model = hist::detail::SimpleExvModel::is_enabled();
+    for (const auto& section : io::SettingSection::get_sections()) {
+        for (const auto& setting : section->settings) {
+            context.values.emplace_back(setting, setting->value());
+        }
+    }
+    return context;
+}
+
+Context::Value& Context::find(std::string_view name) {
+    auto it = std::find_if(values.begin(), values.end(), [name] (const auto& v) {
+        return std::find(v.first->names.begin(), v.first->names.end(), name) != v.first->names.end();
+    });
+    if (it == values.end()) {throw except::invalid_argument("settings::Context::find: Unknown setting \"" + std::string(name) + "\".");}
+    return *it;
+}
+
+const Context::Value& Context::find(std::string_view name) const {
+    return const_cast<Context*>(this)->find(name);
+}
+
+void Context::set(std::string_view name, const std::vector<std::string>& value) {
+    auto& [setting, stored] = find(name);
+    stored = setting->parse(value);
+}
+
+std::string Context::get(std::string_view name) const {
+    const auto& [setting, stored] = find(name);
+    return setting->to_string(stored);
+}
+
+void Context::set_simple_exv_model(bool enabled) {
+    simple_exv_model = enabled;
+}
+
+void Context::apply() const {
+    auto lock = lock_globals();
+    for (const auto& [setting, value] : values) {
+        setting->assign(value);
+    }
+    hist::detail::SimpleExvModel::set_enabled(simple_exv_model);
+}
+
+ScopedContext::ScopedContext(const Context& context) : lock(lock_globals()), previous(Context::current()) {
+    context.apply();
+}
+
+ScopedContext::~ScopedContext() {
+    previous.apply();
+}
@@ -18,6 +18,9 @@ void settings::validate_settings() {
         case settings::hist::HistogramManagerChoice::CrysolManager:
         case settings::hist::HistogramManagerChoice::HistogramManagerMTFFGrid:
         case settings::hist::HistogramManagerChoice::HistogramManagerMTFFGridSurface:
+        case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg:
+        case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit:
+        case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFGrid:
             break;
         case settings::hist::HistogramManagerChoice::HistogramManagerMTFFGridScalableExv:
             if (settings::hist::histogram_manager == settings::hist::HistogramManagerChoice::HistogramManagerMTFFGridSurface) {
@@ -0,0 +1,77 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0. 
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <utility/CPUFeatures.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+using namespace ausaxs;
+using namespace ausaxs::utility::cpu;
+
+namespace {
+    InstructionSet detect() {
+        #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {return InstructionSet::AVX512;}
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {return InstructionSet::AVX2;}
+            if (__builtin_cpu_supports("avx")) {return InstructionSet::AVX;}
+            if (__builtin_cpu_supports("sse4.1")) {return InstructionSet::SSE41;}
+            return InstructionSet::Scalar;
+        #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int info[4];
+            __cpuid(info, 0);
+            int max_leaf = info[0];
+
+            __cpuid(info, 1);
+            bool sse41   = info[2] & (1 << 19);
+            bool fma     = info[2] & (1 << 12);
+            bool osxsave = info[2] & (1 << 27);
+            bool avx     = info[2] & (1 << 28);
+
+            // the operating system must also save the extended registers on context switches
+            unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            bool os_avx    = (xcr0 & 0x06) == 0x06;
+            bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+            bool avx2 = false, avx512f = false;
+            if (7 <= max_leaf) {
+                __cpuidex(info, 7, 0);
+                avx2    = info[1] & (1 << 5);
+                avx512f = info[1] & (1 << 16);
+            }
+
+            if (avx512f && os_avx512) {return InstructionSet::AVX512;}
+            if (avx2 && fma && os_avx) {return InstructionSet::AVX2;}
+            if (avx && os_avx) {return InstructionSet::AVX;}
+            if (sse41) {return InstructionSet::SSE41;}
+            return InstructionSet::Scalar;
+        #else
+            return InstructionSet::Scalar;
+        #endif
+    }
+}
+
+InstructionSet utility::cpu::get_instruction_set() {
+    static InstructionSet set = detect();
+    return set;
+}
+
+bool utility::cpu::supports(InstructionSet set) {
+    return static_cast<int>(set) <= static_cast<int>(get_instruction_set());
+}
+
+const char* utility::cpu::to_string(InstructionSet set) {
+    switch (set) {
+        case InstructionSet::Scalar: return "scalar";
+        case InstructionSet::SSE41: return "SSE4.1";
+        case InstructionSet::AVX: return "AVX";
+        case InstructionSet::AVX2: return "AVX2";
+        case InstructionSet::AVX512: return "AVX-512";
+        default: return "unknown";
+    }
+}
@@ -31,8 +31,13 @@ float Image::index(unsigned int x, unsigned int y) const {return data.index(x, y
 float& Image::index(unsigned int x, unsigned int y) {return data.index(x, y);}
 
 std::list<data::EMAtom> Image::generate_atoms(double cutoff) const {
+    std::vector<data::EMAtom> atoms;
+    generate_atoms(atoms, cutoff);
+    return std::list<data::EMAtom>(atoms.begin(), atoms.end());
+}
+
+void Image::generate_atoms(std::vector<data::EMAtom>& atoms, double cutoff) const {
     if (header == nullptr) [[unlikely]] {throw except::invalid_operation("Image::generate_atoms: Header must be initialized to use this method.");}
-    std::list<data::EMAtom> atoms;
     auto map_axes = header->get_axes();
 
     // loop through all pixels in this image
@@ -53,7 +58,6 @@ std::list<data::EMAtom> Image::generate_atoms(double cutoff) const {
             atoms.emplace_back(Vector3{x*xscale, y*yscale, z*zscale}, weight(val), val);
         }
     }
-    return atoms;
 }
 
 unsigned int Image::count_voxels(double cutoff) const {
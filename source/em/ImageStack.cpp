@@ -12,6 +12,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <mini/detail/Parameter.h>
 #include <em/detail/ExtendedLandscape.h>
 #include <em/manager/ProteinManager.h>
+#include <em/manager/ProteinManagerFactory.h>
 #include <data/Molecule.h>
 #include <utility/Console.h>
 #include <utility/Limit.h>
@@ -27,6 +28,9 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <fstream>
 #include <cassert>
+#include <mutex>
+#include <numeric>
+#include <algorithm>
 
 using namespace ausaxs;
 using namespace ausaxs::em;
@@ -62,6 +66,30 @@ std::unique_ptr<EMFitResult> ImageStack::fit(const io::ExistingFile& file, mini:
 }
 
 std::shared_ptr<FitResult> last_fit; //? not the prettiest option, but it works for now
+namespace {
+    /**
+     * @brief The state needed to evaluate the chi2 of a single cutoff value. 
+     *        Each concurrent evaluation uses its own evaluator, since both the protein manager and the fitter are modified by the evaluation.
+     */
+    struct CutoffEvaluator {
+        std::unique_ptr<em::managers::ProteinManager> owned_manager;
+        observer_ptr<em::managers::ProteinManager> manager;
+        std::shared_ptr<SmartFitter> fitter;
+    };
+
+    /**
+     * @brief The state shared between all evaluations of a fitting function.
+     */
+    struct ScanState {
+        std::mutex mutex;
+        std::unique_ptr<CutoffEvaluator> primary;               // the evaluator using the fitter and protein manager of the ImageStack itself, or nullptr if it is in use
+        std::vector<std::unique_ptr<CutoffEvaluator>> idle;    // the additional evaluators which are not currently in use
+        double last_c = 5;                                      // the most recently fitted water scaling factor, used as the next guess. It is ignored by the scan of the water scaling. 
+        settings::hist::HistogramManagerChoice histogram_manager;  // the histogram manager of all evaluators, such that they never depend on the global setting
+        unsigned int counter = 0;                               // the number of evaluations so far
+    };
+}
+
 std::function<double(std::vector<double>)> ImageStack::prepare_function(std::shared_ptr<SmartFitter> _fitter) {
     // convert the calculated intensities to absolute scale
     // utility::print_warning("Warning in ImageStack::prepare_function: Not using absolute scale.");
@@ -73,43 +101,71 @@ std::function<double(std::vector<double>)> ImageStack::prepare_function(std::sha
     // double I0 = DrhoV2*re2*c/m;
     // fitter.normalize_intensity(I0);
 
-    // stored vars for optimization
-    static double last_c;
-    static unsigned int counter;
-    last_c = 5;
-    counter = 0;
+    // the primary evaluator is always preferred, such that sequential evaluations behave as before and leave the final fit in the given fitter
+    // additional evaluators with their own copies are only created when multiple cutoffs are evaluated concurrently
+    auto state = std::make_shared<ScanState>();
+    state->histogram_manager = get_protein_manager()->get_histogram_manager();
+    auto data = _fitter->get_data();
+    state->primary = std::make_unique<CutoffEvaluator>(nullptr, get_protein_manager(), std::move(_fitter));
 
-    // fitter is captured by value to guarantee its lifetime will be the same as the lambda
+    // the state is captured by value to guarantee its lifetime will be the same as the lambda
     // 'this' is ok since prepare_function is private and thus only used within the class itself
     hydrate::RadialHydration::set_noise_generator([] () {return Vector3<double>{0, 0, 0};}); // ensure hydration shell is deterministic
-    return [this, fitter = std::move(_fitter)] (const std::vector<double>& params) -> double {
-        auto p = get_protein_manager()->get_protein(params[0]);
-        if (settings::em::hydrate) {
-            p->clear_grid();                // clear grid from previous iteration
-            p->generate_new_hydration();    // generate a new hydration layer
+    return [this, state, data = std::move(data)] (const std::vector<double>& params) -> double {
+        std::unique_ptr<CutoffEvaluator> evaluator;
+        double last_c;
+        {
+            std::lock_guard lock(state->mutex);
+            if (state->primary) {
+                evaluator = std::move(state->primary);
+            } else if (!state->idle.empty()) {
+                evaluator = std::move(state->idle.back());
+                state->idle.pop_back();
+            }
+            last_c = state->last_c;
+        }
+        if (!evaluator) {
+            auto manager = factory::create_manager(this);
+            manager->set_histogram_manager(state->histogram_manager);
+            auto ptr = manager.get();
+            evaluator = std::make_unique<CutoffEvaluator>(std::move(manager), ptr, std::make_shared<SmartFitter>(data));
+        }
+
+        // the charge levels of our own manager may have been updated since the evaluator was created
+        if (auto levels = get_protein_manager()->get_charge_levels(); evaluator->manager->get_charge_levels() != levels) {
+            evaluator->manager->set_charge_levels(levels);
+        }
 
-            // pointer cast is ok since the type should always be HydrationFitter when hydration is enabled
+        auto& fitter = evaluator->fitter;
+        auto p = evaluator->manager->get_protein(params[0]);
+        p->clear_grid();                                        // clear grid from previous iteration
+        if (settings::em::hydrate) {
+            p->generate_new_hydration();                        // generate a new hydration layer
             fitter->set_guess({mini::Parameter{constants::fit::to_string(constants::fit::Parameters::SCALING_WATER), last_c, {0, 200}}});
             fitter->set_algorithm(mini::algorithm::SCAN);
-            fitter->set_model(p->get_histogram());
-
-            auto mass = p->get_excluded_volume_mass()/1e3;                                                // mass in kDa
-            last_fit = fitter->fit();                                                                     // do the fit
-            water_factors.push_back(last_fit->get_parameter(constants::fit::Parameters::SCALING_WATER));  // record c value
-            last_c = last_fit->get_parameter(constants::fit::Parameters::SCALING_WATER).value;            // update c for next iteration
-            evals.push_back(detail::ExtendedLandscape(params[0], mass, p->get_volume_grid(), std::move(last_fit->evaluated_points)));  // record evaluated points
-        } else {
-            p->clear_grid();                                    // clear grid from previous iteration
-            auto mass = p->get_excluded_volume_mass()/1e3;      // mass in kDa
-            fitter->set_model(p->get_histogram());
-            last_fit = fitter->fit();
-            evals.push_back(detail::ExtendedLandscape(params[0], mass, p->get_volume_grid(), std::move(last_fit->evaluated_points)));  // record evaluated points
         }
+        auto mass = p->get_excluded_volume_mass()/1e3;          // mass in kDa
+        fitter->set_model(p->get_histogram());
+        std::shared_ptr<FitResult> fit = fitter->fit();         // do the fit
+        detail::ExtendedLandscape landscape(params[0], mass, p->get_volume_grid(), std::move(fit->evaluated_points));
 
-        double val = last_fit->fval;
-        progress.notify(counter++);
+        double val = fit->fval;
+        unsigned int step;
+        {
+            std::lock_guard lock(state->mutex);
+            if (settings::em::hydrate) {
+                water_factors.push_back(fit->get_parameter(constants::fit::Parameters::SCALING_WATER));  // record c value
+                state->last_c = fit->get_parameter(constants::fit::Parameters::SCALING_WATER).value;     // update c for next iteration
+            }
+            evals.push_back(std::move(landscape));              // record evaluated points
+            last_fit = std::move(fit);
+            if (evaluator->owned_manager) {state->idle.push_back(std::move(evaluator));}
+            else {state->primary = std::move(evaluator);}
+            step = state->counter++;
+            progress.notify(step);
+        }
         if (settings::fit::verbose) {
-            console::print_text_minor("Step " + std::to_string(counter) + ": Evaluated cutoff value " + std::to_string(params[0]) + " with chi2 " + std::to_string(val));
+            console::print_text_minor("Step " + std::to_string(step+1) + ": Evaluated cutoff value " + std::to_string(params[0]) + " with chi2 " + std::to_string(val));
         }
         return val;
     }; 
@@ -132,15 +188,36 @@ std::unique_ptr<EMFitResult> ImageStack::fit_helper(std::shared_ptr<SmartFitter>
 
     EMFitResult::EMFitInfo plots;
 
+    // concurrent evaluations are recorded in the order they finish, so the results of each scan are sorted by their cutoff afterwards
+    auto sort_results = [this] (std::size_t first_eval, std::size_t first_water) {
+        std::vector<std::size_t> order(this->evals.size() - first_eval);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this, first_eval] (std::size_t a, std::size_t b) {return this->evals[first_eval+a].cutoff < this->evals[first_eval+b].cutoff;});
+
+        // the water factors are only recorded with hydration enabled, in which case there is one for each evaluation
+        bool sort_water = water_factors.size() - first_water == order.size();
+        std::vector<detail::ExtendedLandscape> sorted_evals;
+        std::vector<mini::FittedParameter> sorted_water;
+        for (auto i : order) {
+            sorted_evals.push_back(std::move(this->evals[first_eval+i]));
+            if (sort_water) {sorted_water.push_back(std::move(water_factors[first_water+i]));}
+        }
+        std::move(sorted_evals.begin(), sorted_evals.end(), this->evals.begin() + first_eval);
+        if (sort_water) {std::move(sorted_water.begin(), sorted_water.end(), water_factors.begin() + first_water);}
+    };
+
     //##########################################################//
     //###                DETERMINE LANDSCAPE                 ###//
     //##########################################################//
     mini::LimitedScan minimizer(func, param, settings::fit::max_iterations);
     minimizer.set_limit(5, true);
+    minimizer.set_evaluation_threads(settings::em::scan_threads); // the evaluations wait on the global pool, so dedicated threads are required
     SimpleDataset chi2_data;
     {
         logging::log("ImageStack: running scan with " + std::to_string(settings::fit::max_iterations) + " iterations");
+        std::size_t first_eval = this->evals.size(), first_water = water_factors.size();
         auto l = minimizer.landscape(settings::fit::max_iterations);
+        sort_results(first_eval, first_water);
         evals.append(l);
         chi2_data = l.as_dataset();
     }
@@ -166,8 +243,11 @@ std::unique_ptr<EMFitResult> ImageStack::fit_helper(std::shared_ptr<SmartFitter>
         // prepare a new minimizer with the new bounds
         console::print_warning("Function is varying strongly. Sampling more points around the minimum.");
         mini::LimitedScan mini2(func, mini::Parameter("cutoff", bounds), settings::fit::max_iterations/4);
+        mini2.set_evaluation_threads(settings::em::scan_threads);
         {
+            std::size_t first_eval = this->evals.size(), first_water = water_factors.size();
             auto l = mini2.landscape(settings::fit::max_iterations/2);
+            sort_results(first_eval, first_water);
             evals.append(l);
             chi2_data = l.as_dataset();
         }
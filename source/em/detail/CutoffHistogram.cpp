@@ -0,0 +1,90 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <em/detail/CutoffHistogram.h>
+#include <em/detail/VoxelIndex.h>
+#include <hist/distance_calculator/SimpleCalculator.h>
+#include <hist/detail/RequiredBins.h>
+
+#include <algorithm>
+
+using namespace ausaxs;
+using namespace ausaxs::em::detail;
+
+template<bool weighted_bins>
+CutoffHistogram<weighted_bins>::CutoffHistogram(std::shared_ptr<const VoxelIndex> index) : index(std::move(index)), coords(this->index->size()) {
+    auto atoms = this->index->get_atoms(this->index->get_min_cutoff());
+    std::transform(atoms.begin(), atoms.end(), coords.get_data().begin(), [] (const data::EMAtom& atom) {
+        return hist::detail::CompactCoordinatesData(atom.get_atom().coordinates(), atom.get_atom().weight());
+    });
+    bins = hist::detail::required_bins(coords);
+    p_aa = GenericDistribution1D_t(bins);
+    begin = coords.size();
+}
+
+template<bool weighted_bins>
+const typename CutoffHistogram<weighted_bins>::GenericDistribution1D_t& CutoffHistogram<weighted_bins>::get_histogram(double cutoff) {
+    std::size_t end = coords.size();
+    std::size_t next = index->lower_bound(cutoff);
+    if (next == begin) {return p_aa;}
+
+    // the changed atoms are always the slice between the two positions, and the unchanged atoms are the part of the tail included by both cutoffs
+    std::size_t changed = next < begin ? begin - next : next - begin;
+    std::size_t unchanged = end - std::max(next, begin);
+
+    // when removing most of the atoms, it is cheaper to calculate the remaining atoms from scratch
+    hist::distance_calculator::SimpleCalculator<weighted_bins> calculator(bins);
+    if (begin < next && (end-next)*(end-next) < changed*changed + 2*changed*unchanged) {
+        auto remaining = slice(next, end);
+        calculator.enqueue_calculate_self(remaining);
+        p_aa = std::move(calculator.run().self[0]);
+        begin = next;
+        return p_aa;
+    }
+
+    auto delta = slice(std::min(next, begin), std::max(next, begin));
+    auto tail = slice(std::max(next, begin), end);
+    calculator.enqueue_calculate_self(delta);
+    calculator.enqueue_calculate_cross(delta, tail);
+    auto res = calculator.run();
+
+    if (next < begin) {
+        p_aa += res.self[0];
+        p_aa += res.cross[0];
+    } else {
+        p_aa -= res.self[0];
+        p_aa -= res.cross[0];
+
+        // the pair counts are exact, so emptied bins can be reset to discard the rounding errors of the subtraction
+        // the first bin is skipped since the self-correlation terms are added without counting them
+        if constexpr (weighted_bins) {
+            for (unsigned int i = 1; i < p_aa.size(); ++i) {
+                if (p_aa.index(i).count == 0) {p_aa.index(i) = hist::detail::WeightedEntry();}
+            }
+        }
+    }
+    begin = next;
+    return p_aa;
+}
+
+template<bool weighted_bins>
+hist::detail::CompactCoordinates CutoffHistogram<weighted_bins>::get_coordinates() const {
+    return slice(begin, coords.size());
+}
+
+template<bool weighted_bins>
+const std::shared_ptr<const VoxelIndex>& CutoffHistogram<weighted_bins>::get_index() const {
+    return index;
+}
+
+template<bool weighted_bins>
+hist::detail::CompactCoordinates CutoffHistogram<weighted_bins>::slice(std::size_t start, std::size_t end) const {
+    hist::detail::CompactCoordinates res(end - start);
+    std::copy(coords.get_data().begin() + start, coords.get_data().begin() + end, res.get_data().begin());
+    return res;
+}
+
+template class em::detail::CutoffHistogram<false>;
+template class em::detail::CutoffHistogram<true>;
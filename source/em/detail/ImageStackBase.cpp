@@ -8,6 +8,7 @@ For more information, please refer to the LICENSE file in the project root.
 #include <em/detail/header/HeaderFactory.h>
 #include <em/manager/ProteinManagerFactory.h>
 #include <em/ObjectBounds3D.h>
+#include <em/detail/VoxelIndex.h>
 #include <em/Image.h>
 #include <data/Molecule.h>
 #include <mini/detail/FittedParameter.h>
@@ -70,7 +71,10 @@ void ImageStackBase::save(double cutoff, const io::File& path) const {
     protein->save(path);
 }
 
-Image& ImageStackBase::image(unsigned int layer) {return data[layer];}
+Image& ImageStackBase::image(unsigned int layer) {
+    voxel_index = nullptr; // the image may be modified through the returned reference
+    return data[layer];
+}
 
 const Image& ImageStackBase::image(unsigned int layer) const {return data[layer];}
 
@@ -187,6 +191,7 @@ observer_ptr<em::detail::header::IMapHeader> ImageStackBase::get_header() const
 }
 
 void ImageStackBase::set_header(std::unique_ptr<em::detail::header::IMapHeader> header) {
+    voxel_index = nullptr;
     this->header = std::move(header);
     for (auto& image : data) {
         image.set_header(this->header.get());
@@ -202,6 +207,7 @@ double ImageStackBase::mean() const {
 }
 
 ObjectBounds3D ImageStackBase::minimum_volume(double cutoff) {
+    voxel_index = nullptr;
     ObjectBounds3D bounds(size_x, size_y, size_z);
     for (unsigned int z = 0; z < size_z; z++) {
         bounds[z] = image(z).setup_bounds(cutoff);
@@ -211,9 +217,21 @@ ObjectBounds3D ImageStackBase::minimum_volume(double cutoff) {
 }
 
 void ImageStackBase::set_minimum_bounds(double min_val) {
+    voxel_index = nullptr;
+    minimum_bound = min_val;
     std::for_each(data.begin(), data.end(), [&min_val] (Image& image) {image.setup_bounds(min_val);});
 }
 
+std::shared_ptr<const em::detail::VoxelIndex> ImageStackBase::get_voxel_index(double cutoff) const {
+    std::lock_guard lock(voxel_index_mutex);
+    if (voxel_index == nullptr || cutoff < voxel_index->get_min_cutoff() || !voxel_index->is_current()) {
+        // index everything down to the smallest cutoff of interest, such that a scan from above does not have to rebuild it for every step
+        double min_cutoff = std::min(cutoff, minimum_bound.value_or(from_level(settings::em::alpha_levels.min)));
+        voxel_index = std::make_shared<const em::detail::VoxelIndex>(data, min_cutoff);
+    }
+    return voxel_index;
+}
+
 double ImageStackBase::from_level(double sigma) const {
     return sigma*rms();
 }
@@ -0,0 +1,57 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <em/detail/VoxelIndex.h>
+#include <em/Image.h>
+#include <settings/EMSettings.h>
+#include <utility/Exceptions.h>
+
+#include <algorithm>
+
+using namespace ausaxs;
+using namespace ausaxs::em::detail;
+
+VoxelIndex::VoxelIndex(const std::vector<Image>& images, double min_cutoff)
+    : min_cutoff(min_cutoff), sample_frequency(settings::em::sample_frequency), fixed_weights(settings::em::fixed_weights)
+{
+    for (unsigned int i = 0; i < images.size(); i += sample_frequency) {
+        images[i].generate_atoms(atoms, min_cutoff);
+    }
+
+    std::sort(atoms.begin(), atoms.end(), [] (const data::EMAtom& a1, const data::EMAtom& a2) {return a1.charge_density() < a2.charge_density();});
+    densities.resize(atoms.size());
+    std::transform(atoms.begin(), atoms.end(), densities.begin(), [] (const data::EMAtom& a) {return static_cast<float>(a.charge_density());});
+}
+
+std::size_t VoxelIndex::lower_bound(double cutoff) const {
+    if (cutoff < min_cutoff) [[unlikely]] {
+        throw except::out_of_bounds("VoxelIndex::lower_bound: The cutoff " + std::to_string(cutoff) + " is smaller than the minimum cutoff " + std::to_string(min_cutoff) + " of the index.");
+    }
+
+    // the densities are exactly representable as floats, so the comparison is done in double precision to match the atom generation
+    return std::lower_bound(densities.begin(), densities.end(), cutoff, [] (float density, double cutoff) {return density < cutoff;}) - densities.begin();
+}
+
+std::span<const data::EMAtom> VoxelIndex::get_atoms(double cutoff) const {
+    return std::span(atoms).subspan(lower_bound(cutoff));
+}
+
+std::span<const data::EMAtom> VoxelIndex::get_atoms(double min, double max) const {
+    std::size_t start = lower_bound(min);
+    std::size_t end = std::max(start, lower_bound(std::max(max, min_cutoff)));
+    return std::span(atoms).subspan(start, end - start);
+}
+
+double VoxelIndex::get_min_cutoff() const noexcept {
+    return min_cutoff;
+}
+
+bool VoxelIndex::is_current() const noexcept {
+    return sample_frequency == settings::em::sample_frequency && fixed_weights == settings::em::fixed_weights;
+}
+
+std::size_t VoxelIndex::size() const noexcept {
+    return atoms.size();
+}
@@ -0,0 +1,117 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0.
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <em/manager/CutoffHistogramManager.h>
+#include <em/detail/CutoffHistogram.h>
+#include <em/detail/ImageStackBase.h>
+#include <em/detail/VoxelIndex.h>
+#include <hist/intensity_calculator/CompositeDistanceHistogram.h>
+#include <hist/distance_calculator/SimpleCalculator.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/detail/RequiredBins.h>
+#include <hist/detail/SimpleExvModel.h>
+#include <data/Molecule.h>
+#include <utility/Exceptions.h>
+
+using namespace ausaxs;
+using namespace ausaxs::em::managers;
+
+template<bool use_weighted_distribution>
+CutoffHistogramManager<use_weighted_distribution>::CutoffHistogramManager(observer_ptr<const data::Molecule> protein, observer_ptr<const em::ImageStackBase> images)
+    : protein(protein), images(images)
+{}
+
+template<bool use_weighted_distribution>
+CutoffHistogramManager<use_weighted_distribution>::~CutoffHistogramManager() = default;
+
+template<bool use_weighted_distribution>
+void CutoffHistogramManager<use_weighted_distribution>::set_cutoff(double cutoff) {
+    this->cutoff = cutoff;
+}
+
+template<bool use_weighted_distribution>
+std::unique_ptr<hist::DistanceHistogram> CutoffHistogramManager<use_weighted_distribution>::calculate() {return calculate_all();}
+
+template<bool use_weighted_distribution>
+std::unique_ptr<hist::ICompositeDistanceHistogram> CutoffHistogramManager<use_weighted_distribution>::calculate_all() {
+    using GenericDistribution1D_t = typename hist::GenericDistribution1D<use_weighted_distribution>::type;
+
+    // the simple excluded volume model changes the charge of every atom by an amount depending on the volume of the entire molecule
+    // this cannot be updated incrementally, so the atomic histogram is then recalculated from scratch exactly as in HistogramManagerMT
+    bool simple_exv = hist::detail::SimpleExvModel::is_enabled();
+    GenericDistribution1D_t p_aa;
+    hist::detail::CompactCoordinates data_a;
+    if (simple_exv) {
+        data_a = hist::detail::CompactCoordinates(protein->get_bodies());
+        hist::detail::SimpleExvModel::apply_simple_excluded_volume(data_a, protein);
+    } else {
+        // the index is replaced by the images whenever it can no longer represent the cutoff, in which case we have to start over
+        auto index = images->get_voxel_index(cutoff);
+        if (histogram == nullptr || histogram->get_index() != index) {
+            histogram = std::make_unique<detail::CutoffHistogram<use_weighted_distribution>>(std::move(index));
+        }
+        p_aa = histogram->get_histogram(cutoff);
+        data_a = histogram->get_coordinates();
+
+        // the index is only a faster way of selecting the voxels of the molecule, so it must agree with the atoms of its bodies
+        if (data_a.size() != protein->size_atom()) {
+            throw except::unexpected(
+                "CutoffHistogramManager::calculate_all: The voxel index selects " + std::to_string(data_a.size()) + " atoms at cutoff " 
+                + std::to_string(cutoff) + ", but the molecule has " + std::to_string(protein->size_atom()) + "."
+            );
+        }
+    }
+
+    // the waters may extend beyond the atoms of the index, so the bins are expanded to fit both
+    hist::detail::CompactCoordinates data_w(protein->get_waters());
+    unsigned int bins = std::max<unsigned int>(p_aa.size(), hist::detail::required_bins(data_a, data_w));
+    p_aa.resize(bins);
+
+    hist::distance_calculator::SimpleCalculator<use_weighted_distribution> calculator(bins);
+    if (simple_exv) {calculator.enqueue_calculate_self(data_a);}
+    int id_w = calculator.enqueue_calculate_self(data_w);
+    calculator.enqueue_calculate_cross(data_a, data_w);
+    auto res = calculator.run();
+
+    if (simple_exv) {p_aa = std::move(res.self[0]);}
+    auto p_ww = res.self[id_w];
+    auto p_aw = res.cross[0];
+
+    // calculate p_tot
+    GenericDistribution1D_t p_tot(bins);
+    for (unsigned int i = 0; i < p_tot.size(); ++i) {p_tot.index(i) = p_aa.index(i) + p_ww.index(i) + p_aw.index(i);}
+
+    // downsize our axes to only the relevant area
+    unsigned int max_bin = 10; // minimum size is 10
+    for (int i = p_tot.size()-1; i >= 10; i--) {
+        if (p_tot.index(i) != 0) {
+            max_bin = i+1; // +1 since we usually use this for looping (i.e. i < max_bin)
+            break;
+        }
+    }
+    p_aa.resize(max_bin);
+    p_ww.resize(max_bin);
+    p_aw.resize(max_bin);
+    p_tot.resize(max_bin);
+
+    if constexpr (use_weighted_distribution) {
+        return std::make_unique<hist::CompositeDistanceHistogram>(
+            std::move(hist::Distribution1D(std::move(p_aa))),
+            std::move(hist::Distribution1D(std::move(p_aw))),
+            std::move(hist::Distribution1D(std::move(p_ww))),
+            std::move(p_tot)
+        );
+    } else {
+        return std::make_unique<hist::CompositeDistanceHistogram>(
+            std::move(p_aa),
+            std::move(p_aw),
+            std::move(p_ww),
+            std::move(p_tot)
+        );
+    }
+}
+
+template class em::managers::CutoffHistogramManager<false>;
+template class em::managers::CutoffHistogramManager<true>;
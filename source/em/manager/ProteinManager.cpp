@@ -8,21 +8,34 @@ For more information, please refer to the LICENSE file in the project root.
 #include <em/ImageStack.h>
 #include <settings/EMSettings.h>
 #include <settings/MoleculeSettings.h>
+#include <settings/HistogramSettings.h>
+#include <settings/SettingsContext.h>
 
 using namespace ausaxs;
 using namespace ausaxs::em::managers;
 
 ProteinManager::~ProteinManager() = default;
 
-ProteinManager::ProteinManager(observer_ptr<const em::ImageStackBase> images) : images(images) {
-    settings::molecule::center = false;                 // centering doesn't make sense for dummy structures
-    settings::molecule::implicit_hydrogens = false;     // likewise we don't know how many hydrogens are attached
+ProteinManager::ProteinManager(observer_ptr<const em::ImageStackBase> images) : images(images), histogram_manager(settings::hist::histogram_manager) {
+    {   // additional managers may be created concurrently by the scan threads, so the global settings are locked while they are written
+        auto lock = settings::lock_globals();
+        settings::molecule::center = false;                 // centering doesn't make sense for dummy structures
+        settings::molecule::implicit_hydrogens = false;     // likewise we don't know how many hydrogens are attached
+    }
     double max = images->from_level(settings::em::alpha_levels.max);
     double min = images->from_level(settings::em::alpha_levels.min);
     Axis axis(min, max, settings::em::charge_levels);
     set_charge_levels(axis.as_vector());
 }
 
+void ProteinManager::set_histogram_manager(settings::hist::HistogramManagerChoice choice) noexcept {
+    histogram_manager = choice;
+}
+
+settings::hist::HistogramManagerChoice ProteinManager::get_histogram_manager() const noexcept {
+    return histogram_manager;
+}
+
 std::vector<double> ProteinManager::get_charge_levels() const noexcept {
     return charge_levels;
 }
@@ -5,13 +5,16 @@ For more information, please refer to the LICENSE file in the project root.
 
 #include <em/manager/SmartProteinManager.h>
 #include <em/detail/ImageStackBase.h>
+#include <em/detail/VoxelIndex.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogram.h>
+#include <hist/histogram_manager/HistogramManagerFactory.h>
 #include <data/Molecule.h>
 #include <data/Body.h>
 #include <utility/Console.h>
 #include <settings/HistogramSettings.h>
 #include <settings/EMSettings.h>
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <functional>
@@ -28,86 +31,75 @@ std::unique_ptr<hist::ICompositeDistanceHistogram> SmartProteinManager::get_hist
 }
 
 std::vector<EMAtom> SmartProteinManager::generate_atoms(double cutoff) const {
-    // we use a list since we will have to append quite a few other lists to it
-    std::list<EMAtom> atoms;
-    const auto& imagestack = images->images();
-    unsigned int step = settings::em::sample_frequency;
-    for (unsigned int i = 0; i < imagestack.size(); i += step) {
-        std::list<EMAtom> im_atoms = imagestack[i].generate_atoms(cutoff);
-        atoms.splice(atoms.end(), im_atoms); // move im_atoms to end of atoms
-    }
+    auto atoms = images->get_voxel_index(cutoff)->get_atoms(cutoff);
+    return std::vector<EMAtom>(atoms.begin(), atoms.end());
+}
 
-    // convert list to vector
-    return std::vector<EMAtom>(std::make_move_iterator(std::begin(atoms)), std::make_move_iterator(std::end(atoms)));
+Body SmartProteinManager::generate_body(const em::detail::VoxelIndex& index, double cutoff, unsigned int charge_index) const {
+    // each body contains the atoms with a density in the range [previous level, current level), limited from below by the cutoff
+    double min = charge_index == 0 ? cutoff : std::max(cutoff, charge_levels[charge_index-1]);
+    auto atoms = index.get_atoms(min, charge_levels[charge_index]);
+    std::vector<Atom> converted(atoms.size());
+    std::transform(atoms.begin(), atoms.end(), converted.begin(), [] (const EMAtom& atom) {return atom.get_atom();});
+    return Body(std::move(converted));
 }
 
 std::unique_ptr<data::Molecule> SmartProteinManager::generate_protein(double cutoff) const {
-    std::vector<EMAtom> atoms = generate_atoms(cutoff);
-    std::vector<Body> bodies(charge_levels.size());
-    std::vector<Atom> current_atoms(atoms.size());
+    if (charge_levels.empty()) {
+        throw except::out_of_bounds("SmartProteinManager::generate_protein: charge_levels is empty.");
+    }
 
-    if (atoms.empty()) {
+    auto index = images->get_voxel_index(cutoff);
+    std::vector<Body> bodies(charge_levels.size());
+    if (index->get_atoms(cutoff).empty()) {
         console::print_warning("Warning in SmartProteinManager::generate_protein: No voxels found for cutoff \"" + std::to_string(cutoff) + "\".");
         return std::make_unique<data::Molecule>(bodies);
     }
 
-    if (charge_levels.empty()) {
-        throw except::out_of_bounds("SmartProteinManager::generate_protein: charge_levels is empty.");
+    if (!index->get_atoms(std::max(cutoff, charge_levels.back())).empty()) {
+        throw except::unexpected("SmartProteinManager::generate_protein: Reached end of charge levels list.");
     }
 
-    // sort vector so we can slice it into levels of charge density
-    std::function<bool(double, double)> compare_func = [] (double v1, double v2) {return v1 < v2;};
-    std::sort(atoms.begin(), atoms.end(), [&compare_func] (const EMAtom& atom1, const EMAtom& atom2) {return compare_func(atom1.charge_density(), atom2.charge_density());});
-
-    unsigned int charge_index = 0, atom_index = 0, current_index = 0;
-    double charge = charge_levels[charge_index]; // initialize charge
-
-    while (compare_func(atoms[atom_index].charge_density(), cutoff)) {++atom_index;} // search for first atom with charge larger than the cutoff
-    while (compare_func(charge, cutoff)) {charge = charge_levels[++charge_index];} // search for first charge level larger than the cutoff 
-    while (atom_index < atoms.size()) {
-        if (compare_func(atoms[atom_index].charge_density(), charge)) {
-            current_atoms[current_index++] = atoms[atom_index++].get_atom();
-        } else {
-            // create the body for this charge bin
-            current_atoms.resize(current_index);
-            bodies[charge_index] = Body(current_atoms);
-
-            // prepare the next body
-            current_index = 0;
-            current_atoms.resize(atoms.size());
-
-            // increment the charge level
-            if (charge_index+1 == charge_levels.size()) [[unlikely]] {
-                throw except::unexpected("SmartProteinManager::generate_protein: Reached end of charge levels list.");
-            }
-            charge = charge_levels[++charge_index];
-        }
+    for (unsigned int charge_index = 0; charge_index < charge_levels.size(); ++charge_index) {
+        bodies[charge_index] = generate_body(*index, cutoff, charge_index);
     }
-    
-    // create the final body of the loop
-    current_atoms.resize(current_index);
-    bodies[charge_index] = Body(current_atoms);
-
     return std::make_unique<data::Molecule>(std::move(bodies));
 }
 
-void SmartProteinManager::toggle_histogram_manager_init(bool state) {
-    static settings::hist::HistogramManagerChoice previous = settings::hist::histogram_manager;
-    if (state) {
-        settings::hist::histogram_manager = previous;
-    } else {
-        previous = settings::hist::histogram_manager;
-        settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::None;
+namespace {
+    // the incremental histogram manager only supports the managers without form factors or excluded volume
+    bool supports_incremental_histogram(settings::hist::HistogramManagerChoice choice) {
+        switch (choice) {
+            case settings::hist::HistogramManagerChoice::HistogramManager:
+            case settings::hist::HistogramManagerChoice::HistogramManagerMT:
+            case settings::hist::HistogramManagerChoice::PartialHistogramManager:
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMT:
+                return true;
+            default:
+                return false;
+        }
     }
 }
 
 void SmartProteinManager::update_protein(double cutoff) {
     if (protein == nullptr || protein->size_atom() == 0) {
-        toggle_histogram_manager_init(true);
         protein = generate_protein(cutoff); 
         protein->bind_body_signallers();
+        cutoff_manager = nullptr;
+
+        // the histogram manager choice of this object is used instead of the global setting, which is never modified here
+        // this allows multiple managers to be initialized concurrently
+        if (settings::em::incremental_histogram && supports_incremental_histogram(histogram_manager)) {
+            std::unique_ptr<ICutoffHistogramManager> manager;
+            if (settings::hist::weighted_bins) {manager = std::make_unique<CutoffHistogramManager<true>>(protein.get(), images);}
+            else {manager = std::make_unique<CutoffHistogramManager<false>>(protein.get(), images);}
+            cutoff_manager = manager.get();
+            cutoff_manager->set_cutoff(cutoff);
+            protein->set_histogram_manager(std::move(manager));
+        } else if (histogram_manager != settings::hist::histogram_manager) {
+            protein->set_histogram_manager(hist::factory::construct_histogram_manager(protein.get(), histogram_manager, settings::hist::weighted_bins));
+        }
         previous_cutoff = cutoff;
-        toggle_histogram_manager_init(false);
         return;
     }
 
@@ -115,13 +107,18 @@ void SmartProteinManager::update_protein(double cutoff) {
         return;
     }
 
+    if (cutoff_manager != nullptr) {cutoff_manager->set_cutoff(cutoff);}
+
     // sanity check
     if (charge_levels.empty()) {
         throw except::unexpected("SmartProteinManager::update_protein: charge_levels is empty.");
     }
 
-    std::unique_ptr<data::Molecule> new_protein = generate_protein(cutoff);
-    // std::cout << "Found " << new_protein->atom_size() << " voxels with a cutoff larger than " << cutoff << std::endl;
+    // only the bodies which are actually replaced are generated from the index
+    auto index = images->get_voxel_index(cutoff);
+    if (!index->get_atoms(std::max(cutoff, charge_levels.back())).empty()) {
+        throw except::unexpected("SmartProteinManager::update_protein: Reached end of charge levels list.");
+    }
 
     std::function<bool(double, double)> compare_positive = [] (double v1, double v2) {return v1 < v2;};
     std::function<bool(double, double)> compare_negative = [] (double v1, double v2) {return v1 > v2;};
@@ -142,15 +139,16 @@ void SmartProteinManager::update_protein(double cutoff) {
             // check if the current bin is inside the range
             if (compare_func(charge_levels[charge_index], previous_cutoff)) {
                 // if so, we replace it with the new contents
-                protein->get_body(charge_index) = std::move(new_protein->get_body(charge_index));
+                protein->get_body(charge_index) = generate_body(*index, cutoff, charge_index);
             } else {
                 // if we have the same number of atoms as earlier, nothing has changed
-                if (new_protein->get_body(charge_index).size_atom() == protein->get_body(charge_index).size_atom()) {
+                Body body = generate_body(*index, cutoff, charge_index);
+                if (body.size_atom() == protein->get_body(charge_index).size_atom()) {
                     break;
                 }
 
                 // otherwise we replace it and stop iterating
-                protein->get_body(charge_index) = std::move(new_protein->get_body(charge_index));
+                protein->get_body(charge_index) = std::move(body);
                 break;
             }
         }
@@ -169,10 +167,10 @@ void SmartProteinManager::update_protein(double cutoff) {
             // check if the current bin is inside the range
             if (compare_func(charge_levels[charge_index], cutoff)) {
                 // if so, we replace it with the new contents
-                protein->get_body(charge_index) = std::move(new_protein->get_body(charge_index));
+                protein->get_body(charge_index) = generate_body(*index, cutoff, charge_index);
             } else {
                 // otherwise we replace it and stop iterating
-                protein->get_body(charge_index) = std::move(new_protein->get_body(charge_index));
+                protein->get_body(charge_index) = generate_body(*index, cutoff, charge_index);
                 break;
             }
         }
@@ -0,0 +1,95 @@
+/*
+This software is distributed under the GNU Lesser General Public License v3.0. 
+For more information, please refer to the LICENSE file in the project root.
+*/
+
+#include <math/CubicSplineResampler.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cassert>
+
+using namespace ausaxs::math;
+
+CubicSplineResampler::CubicSplineResampler(const std::vector<double>& x, const std::vector<double>& z) : points(z) {
+    int n = x.size();
+    if (n < 4) {throw std::invalid_argument("CubicSplineResampler: x must have at least four elements.");}
+
+    // factorize the slope system exactly as CubicSpline::setup does, since it does not depend on y
+    std::vector<double> h(n-1), D(n);
+    inv_h.resize(n-1);
+    r.resize(n-2);
+    Q.resize(n-1);
+    inv_D.resize(n);
+    for (int i = 0; i < n-1; ++i) {
+        h[i] = x[i+1]-x[i];
+        inv_h[i] = 1/h[i];
+    }
+    D[0] = 2; Q[0] = 1; D[n-1] = 2;
+    for (int i = 0; i < n-2; ++i) {
+        r[i] = h[i]/h[i+1];
+        D[i+1] = 2*r[i] + 2;
+        Q[i+1] = r[i];
+    }
+    for (int i = 1; i < n; ++i) {
+        D[i] -= Q[i-1]/D[i-1];
+    }
+    std::transform(D.begin(), D.end(), inv_D.begin(), [] (double d) {return 1/d;});
+
+    // the Hermite weights of each point in its interval
+    weights.resize(z.size());
+    for (unsigned int k = 0; k < z.size(); ++k) {
+        int i = std::max<int>(std::upper_bound(x.begin(), x.end(), z[k]) - x.begin() - 1, 0);
+        if (i == n-1) {i--;} // special case for interpolating outside the range
+        double s = (z[k] - x[i])*inv_h[i];
+        double s2 = s*s, s3 = s2*s;
+        weights[k] = {
+            static_cast<unsigned int>(i),
+            1 - 3*s2 + 2*s3,
+            3*s2 - 2*s3,
+            h[i]*(s - 2*s2 + s3),
+            h[i]*(s3 - s2)
+        };
+    }
+}
+
+void CubicSplineResampler::resample(const std::vector<double>& y, std::vector<double>& out) const {
+    assert(y.size() == inv_D.size() && "CubicSplineResampler::resample: y must have the same size as the grid.");
+    int n = y.size();
+
+    // forward elimination of the right-hand side
+    std::vector<double> b(n);
+    double p_prev = (y[1]-y[0])*inv_h[0];
+    b[0] = 3*p_prev;
+    for (int i = 0; i < n-2; ++i) {
+        double p_next = (y[i+2]-y[i+1])*inv_h[i+1];
+        b[i+1] = 3*(p_prev + p_next*r[i]) - b[i]*inv_D[i];
+        p_prev = p_next;
+    }
+    b[n-1] = 3*p_prev - b[n-2]*inv_D[n-2];
+
+    // back substitution for the slopes
+    b[n-1] *= inv_D[n-1];
+    for (int i = n-2; 0 <= i; --i) {
+        b[i] = (b[i] - Q[i]*b[i+1])*inv_D[i];
+    }
+
+    out.resize(weights.size());
+    for (unsigned int k = 0; k < weights.size(); ++k) {
+        const auto& w = weights[k];
+        out[k] = w.w0*y[w.i] + w.w1*y[w.i+1] + w.v0*b[w.i] + w.v1*b[w.i+1];
+    }
+}
+
+std::vector<double> CubicSplineResampler::resample(const std::vector<double>& y) const {
+    std::vector<double> out;
+    resample(y, out);
+    return out;
+}
+
+unsigned int CubicSplineResampler::size_grid() const {return inv_D.size();}
+
+unsigned int CubicSplineResampler::size() const {return weights.size();}
+
+const std::vector<double>& CubicSplineResampler::get_points() const {return points;}
@@ -68,7 +68,7 @@ std::shared_ptr<fitter::FitResult> RigidBody::optimize(const io::ExistingFile& m
     }
 
     // save the best configuration in a simple struct
-    detail::BestConf best(std::make_shared<grid::Grid>(*get_grid()), get_waters(), fitter->fit_chi2_only());
+    detail::BestConf best(fitter->fit_chi2_only());
 
     if (settings::general::verbose) {
         console::print_info("\nStarting rigid body optimization.");
@@ -99,10 +99,42 @@ std::shared_ptr<fitter::FitResult> RigidBody::optimize(const io::ExistingFile& m
 }
 
 bool RigidBody::optimize_step(detail::BestConf& best) {
-    auto grid = get_grid();
+    // the step is reverted when this goes out of scope unless it was accepted, such that an exception thrown during the step also restores the old state
+    struct Step {
+        RigidBody& rigidbody;
+        grid::Grid& grid;
+        std::vector<std::vector<data::Water>> old_waters;
+        bool transformed = false, accepted = false;
+
+        Step(RigidBody& rigidbody, grid::Grid& grid) : rigidbody(rigidbody), grid(grid), old_waters(rigidbody.size_body()) {
+            // all changes to the grid are recorded such that they can be cheaply reverted if the step is rejected
+            grid.begin_transaction();
+
+            // move the current hydration layer out of the bodies so it can be restored without copying
+            for (unsigned int i = 0; i < rigidbody.size_body(); ++i) {
+                std::swap(old_waters[i], rigidbody.get_body(i).get_waters());
+            }
+        }
+
+        ~Step() {
+            if (accepted) {return;}
+            if (transformed) {rigidbody.transform->undo();} // undo the body transforms
+            grid.rollback();                                // restore the old grid
+            for (unsigned int i = 0; i < rigidbody.size_body(); ++i) {
+                rigidbody.get_body(i).get_waters() = std::move(old_waters[i]); // restore the old waters
+            }
+            rigidbody.signal_modified_hydration_layer();
+        }
 
-    // select a body to be modified this iteration
+        void accept() {
+            grid.commit();
+            accepted = true;
+        }
+    } step(*this, *get_grid());
+
+    // select a body to be modified this iteration. the transforms back up the bodies they modify before anything else
     auto [ibody, iconstraint] = body_selector->next();
+    step.transformed = true;
     if (iconstraint == -1) {    // transform free body
         Parameter param = parameter_generator->next(ibody);
         transform->apply(std::move(param), ibody);
@@ -119,18 +151,13 @@ bool RigidBody::optimize_step(detail::BestConf& best) {
 
     // if the old configuration was better
     if (new_chi2 >= best.chi2) {
-        transform->undo();          // undo the body transforms
-        *grid = *best.grid;         // restore the old grid
-        get_waters() = best.waters; // restore the old waters
-        signal_modified_hydration_layer();
         return false;
-    } else {
-        // accept the changes
-        best.grid = std::make_shared<grid::Grid>(*grid);
-        best.waters = get_waters();
-        best.chi2 = new_chi2;
-        return true;
     }
+
+    // accept the changes
+    step.accept();
+    best.chi2 = new_chi2;
+    return true;
 }
 
 void RigidBody::apply_calibration(std::unique_ptr<fitter::FitResult> calibration) {
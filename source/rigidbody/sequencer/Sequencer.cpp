@@ -51,7 +51,7 @@ std::shared_ptr<fitter::FitResult> Sequencer::execute() {
 
     // prepare the fitter for the actual optimization
     rigidbody->prepare_fitter(saxs_path);
-    best = std::make_unique<detail::BestConf>(std::make_shared<grid::Grid>(*rigidbody->get_grid()), rigidbody->get_waters(), rigidbody->fitter->fit_chi2_only());
+    best = std::make_unique<detail::BestConf>(rigidbody->fitter->fit_chi2_only());
 
     for (auto& e : LoopElement::elements) {
         e->run();
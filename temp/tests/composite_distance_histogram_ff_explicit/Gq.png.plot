@@ -0,0 +1,224 @@
+PlotDataset
+  1.00000000e-04   3.37499997e+00   0.00000000e+00 
+  5.09950000e-03   3.37492802e+00   0.00000000e+00 
+  1.00990000e-02   3.37471771e+00   0.00000000e+00 
+  1.50985000e-02   3.37436907e+00   0.00000000e+00 
+  2.00980000e-02   3.37388214e+00   0.00000000e+00 
+  2.50975000e-02   3.37325698e+00   0.00000000e+00 
+  3.00970000e-02   3.37249367e+00   0.00000000e+00 
+  3.50965000e-02   3.37159229e+00   0.00000000e+00 
+  4.00960000e-02   3.37055297e+00   0.00000000e+00 
+  4.50955000e-02   3.36937583e+00   0.00000000e+00 
+  5.00950000e-02   3.36806102e+00   0.00000000e+00 
+  5.50945000e-02   3.36660869e+00   0.00000000e+00 
+  6.00940000e-02   3.36501902e+00   0.00000000e+00 
+  6.50935000e-02   3.36329222e+00   0.00000000e+00 
+  7.00930000e-02   3.36142848e+00   0.00000000e+00 
+  7.50925000e-02   3.35942805e+00   0.00000000e+00 
+  8.00920000e-02   3.35729116e+00   0.00000000e+00 
+  8.50915000e-02   3.35501807e+00   0.00000000e+00 
+  9.00910000e-02   3.35260908e+00   0.00000000e+00 
+  9.50905000e-02   3.35006446e+00   0.00000000e+00 
+  1.00090000e-01   3.34738454e+00   0.00000000e+00 
+  1.05089500e-01   3.34456963e+00   0.00000000e+00 
+  1.10089000e-01   3.34162009e+00   0.00000000e+00 
+  1.15088500e-01   3.33853628e+00   0.00000000e+00 
+  1.20088000e-01   3.33531857e+00   0.00000000e+00 
+  1.25087500e-01   3.33196735e+00   0.00000000e+00 
+  1.30087000e-01   3.32848303e+00   0.00000000e+00 
+  1.35086500e-01   3.32486604e+00   0.00000000e+00 
+  1.40086000e-01   3.32111683e+00   0.00000000e+00 
+  1.45085500e-01   3.31723583e+00   0.00000000e+00 
+  1.50085000e-01   3.31322353e+00   0.00000000e+00 
+  1.55084500e-01   3.30908042e+00   0.00000000e+00 
+  1.60084000e-01   3.30480699e+00   0.00000000e+00 
+  1.65083500e-01   3.30040377e+00   0.00000000e+00 
+  1.70083000e-01   3.29587129e+00   0.00000000e+00 
+  1.75082500e-01   3.29121010e+00   0.00000000e+00 
+  1.80082000e-01   3.28642076e+00   0.00000000e+00 
+  1.85081500e-01   3.28150386e+00   0.00000000e+00 
+  1.90081000e-01   3.27645997e+00   0.00000000e+00 
+  1.95080500e-01   3.27128972e+00   0.00000000e+00 
+  2.00080000e-01   3.26599373e+00   0.00000000e+00 
+  2.05079500e-01   3.26057263e+00   0.00000000e+00 
+  2.10079000e-01   3.25502708e+00   0.00000000e+00 
+  2.15078500e-01   3.24935774e+00   0.00000000e+00 
+  2.20078000e-01   3.24356529e+00   0.00000000e+00 
+  2.25077500e-01   3.23765043e+00   0.00000000e+00 
+  2.30077000e-01   3.23161386e+00   0.00000000e+00 
+  2.35076500e-01   3.22545630e+00   0.00000000e+00 
+  2.40076000e-01   3.21917850e+00   0.00000000e+00 
+  2.45075500e-01   3.21278119e+00   0.00000000e+00 
+  2.50075000e-01   3.20626514e+00   0.00000000e+00 
+  2.55074500e-01   3.19963113e+00   0.00000000e+00 
+  2.60074000e-01   3.19287994e+00   0.00000000e+00 
+  2.65073500e-01   3.18601237e+00   0.00000000e+00 
+  2.70073000e-01   3.17902923e+00   0.00000000e+00 
+  2.75072500e-01   3.17193136e+00   0.00000000e+00 
+  2.80072000e-01   3.16471958e+00   0.00000000e+00 
+  2.85071500e-01   3.15739475e+00   0.00000000e+00 
+  2.90071000e-01   3.14995773e+00   0.00000000e+00 
+  2.95070500e-01   3.14240940e+00   0.00000000e+00 
+  3.00070000e-01   3.13475062e+00   0.00000000e+00 
+  3.05069500e-01   3.12698232e+00   0.00000000e+00 
+  3.10069000e-01   3.11910538e+00   0.00000000e+00 
+  3.15068500e-01   3.11112073e+00   0.00000000e+00 
+  3.20068000e-01   3.10302930e+00   0.00000000e+00 
+  3.25067500e-01   3.09483203e+00   0.00000000e+00 
+  3.30067000e-01   3.08652988e+00   0.00000000e+00 
+  3.35066500e-01   3.07812379e+00   0.00000000e+00 
+  3.40066000e-01   3.06961475e+00   0.00000000e+00 
+  3.45065500e-01   3.06100373e+00   0.00000000e+00 
+  3.50065000e-01   3.05229172e+00   0.00000000e+00 
+  3.55064500e-01   3.04347973e+00   0.00000000e+00 
+  3.60064000e-01   3.03456877e+00   0.00000000e+00 
+  3.65063500e-01   3.02555986e+00   0.00000000e+00 
+  3.70063000e-01   3.01645402e+00   0.00000000e+00 
+  3.75062500e-01   3.00725228e+00   0.00000000e+00 
+  3.80062000e-01   2.99795571e+00   0.00000000e+00 
+  3.85061500e-01   2.98856535e+00   0.00000000e+00 
+  3.90061000e-01   2.97908226e+00   0.00000000e+00 
+  3.95060500e-01   2.96950752e+00   0.00000000e+00 
+  4.00060000e-01   2.95984220e+00   0.00000000e+00 
+  4.05059500e-01   2.95008739e+00   0.00000000e+00 
+  4.10059000e-01   2.94024418e+00   0.00000000e+00 
+  4.15058500e-01   2.93031367e+00   0.00000000e+00 
+  4.20058000e-01   2.92029698e+00   0.00000000e+00 
+  4.25057500e-01   2.91019521e+00   0.00000000e+00 
+  4.30057000e-01   2.90000948e+00   0.00000000e+00 
+  4.35056500e-01   2.88974093e+00   0.00000000e+00 
+  4.40056000e-01   2.87939069e+00   0.00000000e+00 
+  4.45055500e-01   2.86895990e+00   0.00000000e+00 
+  4.50055000e-01   2.85844969e+00   0.00000000e+00 
+  4.55054500e-01   2.84786124e+00   0.00000000e+00 
+  4.60054000e-01   2.83719568e+00   0.00000000e+00 
+  4.65053500e-01   2.82645419e+00   0.00000000e+00 
+  4.70053000e-01   2.81563792e+00   0.00000000e+00 
+  4.75052500e-01   2.80474806e+00   0.00000000e+00 
+  4.80052000e-01   2.79378577e+00   0.00000000e+00 
+  4.85051500e-01   2.78275223e+00   0.00000000e+00 
+  4.90051000e-01   2.77164864e+00   0.00000000e+00 
+  4.95050500e-01   2.76047617e+00   0.00000000e+00 
+  5.00050000e-01   2.74923603e+00   0.00000000e+00 
+  5.05049500e-01   2.73792940e+00   0.00000000e+00 
+  5.10049000e-01   2.72655749e+00   0.00000000e+00 
+  5.15048500e-01   2.71512149e+00   0.00000000e+00 
+  5.20048000e-01   2.70362261e+00   0.00000000e+00 
+  5.25047500e-01   2.69206206e+00   0.00000000e+00 
+  5.30047000e-01   2.68044105e+00   0.00000000e+00 
+  5.35046500e-01   2.66876078e+00   0.00000000e+00 
+  5.40046000e-01   2.65702248e+00   0.00000000e+00 
+  5.45045500e-01   2.64522736e+00   0.00000000e+00 
+  5.50045000e-01   2.63337663e+00   0.00000000e+00 
+  5.55044500e-01   2.62147152e+00   0.00000000e+00 
+  5.60044000e-01   2.60951324e+00   0.00000000e+00 
+  5.65043500e-01   2.59750302e+00   0.00000000e+00 
+  5.70043000e-01   2.58544207e+00   0.00000000e+00 
+  5.75042500e-01   2.57333162e+00   0.00000000e+00 
+  5.80042000e-01   2.56117290e+00   0.00000000e+00 
+  5.85041500e-01   2.54896711e+00   0.00000000e+00 
+  5.90041000e-01   2.53671550e+00   0.00000000e+00 
+  5.95040500e-01   2.52441927e+00   0.00000000e+00 
+  6.00040000e-01   2.51207965e+00   0.00000000e+00 
+  6.05039500e-01   2.49969787e+00   0.00000000e+00 
+  6.10039000e-01   2.48727514e+00   0.00000000e+00 
+  6.15038500e-01   2.47481268e+00   0.00000000e+00 
+  6.20038000e-01   2.46231171e+00   0.00000000e+00 
+  6.25037500e-01   2.44977345e+00   0.00000000e+00 
+  6.30037000e-01   2.43719912e+00   0.00000000e+00 
+  6.35036500e-01   2.42458992e+00   0.00000000e+00 
+  6.40036000e-01   2.41194706e+00   0.00000000e+00 
+  6.45035500e-01   2.39927177e+00   0.00000000e+00 
+  6.50035000e-01   2.38656524e+00   0.00000000e+00 
+  6.55034500e-01   2.37382868e+00   0.00000000e+00 
+  6.60034000e-01   2.36106329e+00   0.00000000e+00 
+  6.65033500e-01   2.34827028e+00   0.00000000e+00 
+  6.70033000e-01   2.33545082e+00   0.00000000e+00 
+  6.75032500e-01   2.32260613e+00   0.00000000e+00 
+  6.80032000e-01   2.30973738e+00   0.00000000e+00 
+  6.85031500e-01   2.29684577e+00   0.00000000e+00 
+  6.90031000e-01   2.28393247e+00   0.00000000e+00 
+  6.95030500e-01   2.27099867e+00   0.00000000e+00 
+  7.00030000e-01   2.25804553e+00   0.00000000e+00 
+  7.05029500e-01   2.24507422e+00   0.00000000e+00 
+  7.10029000e-01   2.23208592e+00   0.00000000e+00 
+  7.15028500e-01   2.21908178e+00   0.00000000e+00 
+  7.20028000e-01   2.20606295e+00   0.00000000e+00 
+  7.25027500e-01   2.19303059e+00   0.00000000e+00 
+  7.30027000e-01   2.17998584e+00   0.00000000e+00 
+  7.35026500e-01   2.16692984e+00   0.00000000e+00 
+  7.40026000e-01   2.15386374e+00   0.00000000e+00 
+  7.45025500e-01   2.14078864e+00   0.00000000e+00 
+  7.50025000e-01   2.12770569e+00   0.00000000e+00 
+  7.55024500e-01   2.11461599e+00   0.00000000e+00 
+  7.60024000e-01   2.10152066e+00   0.00000000e+00 
+  7.65023500e-01   2.08842080e+00   0.00000000e+00 
+  7.70023000e-01   2.07531752e+00   0.00000000e+00 
+  7.75022500e-01   2.06221190e+00   0.00000000e+00 
+  7.80022000e-01   2.04910503e+00   0.00000000e+00 
+  7.85021500e-01   2.03599799e+00   0.00000000e+00 
+  7.90021000e-01   2.02289186e+00   0.00000000e+00 
+  7.95020500e-01   2.00978769e+00   0.00000000e+00 
+  8.00020000e-01   1.99668655e+00   0.00000000e+00 
+  8.05019500e-01   1.98358948e+00   0.00000000e+00 
+  8.10019000e-01   1.97049754e+00   0.00000000e+00 
+  8.15018500e-01   1.95741175e+00   0.00000000e+00 
+  8.20018000e-01   1.94433315e+00   0.00000000e+00 
+  8.25017500e-01   1.93126275e+00   0.00000000e+00 
+  8.30017000e-01   1.91820158e+00   0.00000000e+00 
+  8.35016500e-01   1.90515062e+00   0.00000000e+00 
+  8.40016000e-01   1.89211089e+00   0.00000000e+00 
+  8.45015500e-01   1.87908337e+00   0.00000000e+00 
+  8.50015000e-01   1.86606904e+00   0.00000000e+00 
+  8.55014500e-01   1.85306887e+00   0.00000000e+00 
+  8.60014000e-01   1.84008382e+00   0.00000000e+00 
+  8.65013500e-01   1.82711486e+00   0.00000000e+00 
+  8.70013000e-01   1.81416292e+00   0.00000000e+00 
+  8.75012500e-01   1.80122895e+00   0.00000000e+00 
+  8.80012000e-01   1.78831387e+00   0.00000000e+00 
+  8.85011500e-01   1.77541860e+00   0.00000000e+00 
+  8.90011000e-01   1.76254406e+00   0.00000000e+00 
+  8.95010500e-01   1.74969114e+00   0.00000000e+00 
+  9.00010000e-01   1.73686074e+00   0.00000000e+00 
+  9.05009500e-01   1.72405374e+00   0.00000000e+00 
+  9.10009000e-01   1.71127102e+00   0.00000000e+00 
+  9.15008500e-01   1.69851343e+00   0.00000000e+00 
+  9.20008000e-01   1.68578183e+00   0.00000000e+00 
+  9.25007500e-01   1.67307708e+00   0.00000000e+00 
+  9.30007000e-01   1.66039999e+00   0.00000000e+00 
+  9.35006500e-01   1.64775141e+00   0.00000000e+00 
+  9.40006000e-01   1.63513214e+00   0.00000000e+00 
+  9.45005500e-01   1.62254300e+00   0.00000000e+00 
+  9.50005000e-01   1.60998477e+00   0.00000000e+00 
+  9.55004500e-01   1.59745825e+00   0.00000000e+00 
+  9.60004000e-01   1.58496421e+00   0.00000000e+00 
+  9.65003500e-01   1.57250341e+00   0.00000000e+00 
+  9.70003000e-01   1.56007663e+00   0.00000000e+00 
+  9.75002500e-01   1.54768459e+00   0.00000000e+00 
+  9.80002000e-01   1.53532803e+00   0.00000000e+00 
+  9.85001500e-01   1.52300769e+00   0.00000000e+00 
+  9.90001000e-01   1.51072427e+00   0.00000000e+00 
+  9.95000500e-01   1.49847849e+00   0.00000000e+00 
+
+PlotOptions 
+color k
+marker_style .
+line_style -
+line_width 1
+marker_size 5
+draw_line 1
+draw_errors 0
+draw_markers 0
+logx 0
+logy 0
+title 
+xlabel x
+x2label 
+ylabel y
+zlabel z
+legend 
+normalize 0
+ylimits 0 0
+xlimits 0 0
+zorder 0
+
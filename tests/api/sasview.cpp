@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <api/sasview.h>
+
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Evaluate the Debye equation directly for every pair of points.
+ */
+std::vector<double> debye(const std::vector<double>& q, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::vector<double>& w) {
+    std::vector<double> Iq(q.size(), 0);
+    for (unsigned int k = 0; k < q.size(); ++k) {
+        for (unsigned int i = 0; i < x.size(); ++i) {
+            for (unsigned int j = 0; j < x.size(); ++j) {
+                double r = std::sqrt(std::pow(x[i]-x[j], 2) + std::pow(y[i]-y[j], 2) + std::pow(z[i]-z[j], 2));
+                double qr = q[k]*r;
+                Iq[k] += w[i]*w[j]*(qr < 1e-9 ? 1 : std::sin(qr)/qr);
+            }
+        }
+    }
+    return Iq;
+}
+
+struct Structure {
+    Structure(unsigned int n, unsigned int seed) : x(n), y(n), z(n), w(n) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> pos(-15, 15), weight(1, 8);
+        for (unsigned int i = 0; i < n; ++i) {x[i] = pos(gen); y[i] = pos(gen); z[i] = pos(gen); w[i] = weight(gen);}
+    }
+    std::vector<double> x, y, z, w;
+};
+
+void require_close(const std::vector<double>& result, const std::vector<double>& expected) {
+    REQUIRE(result.size() == expected.size());
+    for (unsigned int i = 0; i < result.size(); ++i) {
+        REQUIRE_THAT(result[i], Catch::Matchers::WithinAbs(expected[i], 1e-3*expected[0]));
+    }
+}
+
+TEST_CASE("sasview: handle api") {
+    std::vector<double> q;
+    for (double v = 1e-3; v < 0.5; v += 0.01) {q.push_back(v);}
+    int nq = q.size();
+
+    Structure s1(100, 1), s2(150, 2);
+    int status = -1;
+    int h1 = sasview_create_context(s1.x.data(), s1.y.data(), s1.z.data(), s1.w.data(), s1.x.size(), &status);
+    REQUIRE(status == 0);
+    int h2 = sasview_create_context(s2.x.data(), s2.y.data(), s2.z.data(), s2.w.data(), s2.x.size(), &status);
+    REQUIRE(status == 0);
+    REQUIRE(h1 != h2);
+
+    SECTION("single") {
+        std::vector<double> Iq(nq);
+        sasview_evaluate(h1, q.data(), nq, &status, Iq.data());
+        REQUIRE(status == 0);
+        require_close(Iq, debye(q, s1.x, s1.y, s1.z, s1.w));
+
+        // a different q-set reuses the histogram
+        std::vector<double> q2 = {0.05, 0.1, 0.2};
+        std::vector<double> Iq2(q2.size());
+        sasview_evaluate(h1, q2.data(), q2.size(), &status, Iq2.data());
+        REQUIRE(status == 0);
+        require_close(Iq2, debye(q2, s1.x, s1.y, s1.z, s1.w));
+    }
+
+    SECTION("in-place update") {
+        std::vector<double> Iq(nq);
+        sasview_evaluate(h1, q.data(), nq, &status, Iq.data());
+        for (auto& v : s1.x) {v *= 1.1;}
+        sasview_update_coordinates(h1, s1.x.data(), s1.y.data(), s1.z.data(), s1.w.data(), s1.x.size(), &status);
+        REQUIRE(status == 0);
+        sasview_evaluate(h1, q.data(), nq, &status, Iq.data());
+        REQUIRE(status == 0);
+        require_close(Iq, debye(q, s1.x, s1.y, s1.z, s1.w));
+    }
+
+    SECTION("many") {
+        std::vector<int> handles = {h1, h2};
+        std::vector<double> Iq(2*nq);
+        sasview_evaluate_many(handles.data(), handles.size(), q.data(), nq, &status, Iq.data());
+        REQUIRE(status == 0);
+        require_close(std::vector<double>(Iq.begin(), Iq.begin()+nq), debye(q, s1.x, s1.y, s1.z, s1.w));
+        require_close(std::vector<double>(Iq.begin()+nq, Iq.end()), debye(q, s2.x, s2.y, s2.z, s2.w));
+    }
+
+    SECTION("concurrent") {
+        // overlapping calls from different threads, including the same handle several times in one call
+        std::vector<int> handles_a = {h1, h2}, handles_b = {h2, h1, h1};
+        std::vector<double> Iq_a(2*nq), Iq_b(3*nq);
+        int status_a = -1, status_b = -1;
+        std::thread thread_a([&] () {
+            for (int i = 0; i < 10; ++i) {
+                sasview_update_coordinates(h1, s1.x.data(), s1.y.data(), s1.z.data(), s1.w.data(), s1.x.size(), &status_a);
+                sasview_evaluate_many(handles_a.data(), handles_a.size(), q.data(), nq, &status_a, Iq_a.data());
+            }
+        });
+        std::thread thread_b([&] () {
+            for (int i = 0; i < 10; ++i) {
+                sasview_update_coordinates(h2, s2.x.data(), s2.y.data(), s2.z.data(), s2.w.data(), s2.x.size(), &status_b);
+                sasview_evaluate_many(handles_b.data(), handles_b.size(), q.data(), nq, &status_b, Iq_b.data());
+            }
+        });
+        thread_a.join();
+        thread_b.join();
+        REQUIRE(status_a == 0);
+        REQUIRE(status_b == 0);
+
+        auto I1 = debye(q, s1.x, s1.y, s1.z, s1.w), I2 = debye(q, s2.x, s2.y, s2.z, s2.w);
+        require_close(std::vector<double>(Iq_a.begin(), Iq_a.begin()+nq), I1);
+        require_close(std::vector<double>(Iq_a.begin()+nq, Iq_a.end()), I2);
+        require_close(std::vector<double>(Iq_b.begin(), Iq_b.begin()+nq), I2);
+        require_close(std::vector<double>(Iq_b.begin()+nq, Iq_b.begin()+2*nq), I1);
+        require_close(std::vector<double>(Iq_b.begin()+2*nq, Iq_b.end()), I1);
+    }
+
+    SECTION("invalid") {
+        std::vector<double> Iq(nq);
+        sasview_evaluate(-5, q.data(), nq, &status, Iq.data());
+        CHECK(status == 1);
+        sasview_create_context(nullptr, s1.y.data(), s1.z.data(), s1.w.data(), s1.x.size(), &status);
+        CHECK(status == 2);
+    }
+
+    sasview_destroy_context(h1);
+    sasview_destroy_context(h2);
+    std::vector<double> Iq(nq);
+    sasview_evaluate(h1, q.data(), nq, &status, Iq.data());
+    REQUIRE(status == 1);
+}
@@ -5,6 +5,9 @@
 #include <settings/GeneralSettings.h>
 #include <utility/MultiThreading.h>
 
+#include <thread>
+#include <vector>
+
 using namespace ausaxs;
 using namespace container;
 
@@ -12,19 +15,19 @@ TEST_CASE("ThreadLocalWrapper::ThreadLocalWrapper") {
     SECTION("default") {
         ThreadLocalWrapper<int> wrapper;
         CHECK(wrapper.get() == 0);
-        CHECK(wrapper.size() == settings::general::threads+1);
+        CHECK(wrapper.size() == utility::multi_threading::get_global_pool()->get_thread_count()+1);
     }
 
     SECTION("Args&&...") {
         SECTION("int") {
             ThreadLocalWrapper<int> wrapper(5);
             CHECK(wrapper.get() == 5);
-            CHECK(wrapper.size() == settings::general::threads+1);
+            CHECK(wrapper.size() == utility::multi_threading::get_global_pool()->get_thread_count()+1);
         }
 
         SECTION("container1D") {
             ThreadLocalWrapper<Container1D<double>> wrapper(std::vector<double>{0.5, 1, 1.5, 2});
-            CHECK(wrapper.size() == settings::general::threads+1);
+            CHECK(wrapper.size() == utility::multi_threading::get_global_pool()->get_thread_count()+1);
             for (const auto& t : wrapper.get_all()) {
                 CHECK(t.get().index(0) == 0.5);
                 CHECK(t.get().index(1) == 1);
@@ -44,4 +47,41 @@ TEST_CASE("ThreadLocalWrapper::ops") {
     pool->wait();
     auto merged = wrapper.merge();
     CHECK(merged == 100);
-}
\ No newline at end of file
+}
+
+TEST_CASE("ThreadLocalWrapper::lazy") {
+    const auto& pool = utility::multi_threading::get_global_pool();
+    ThreadLocalWrapper<Container1D<double>> wrapper(std::vector<double>{0, 0});
+    CHECK(wrapper.get_all().empty());
+
+    // only threads which access their instance should allocate it
+    wrapper.get().index(0) = 1;
+    CHECK(wrapper.get_all().size() == 1);
+
+    for (unsigned int i = 0; i < 100; ++i) {
+        pool->detach_task([&wrapper](){wrapper.get().index(1) += 1;});
+    }
+    pool->wait();
+    CHECK(wrapper.get_all().size() <= wrapper.size());
+
+    auto merged = wrapper.merge();
+    CHECK(merged.index(0) == 1);
+    CHECK(merged.index(1) == 100);
+}
+
+TEST_CASE("ThreadLocalWrapper::foreign threads") {
+    ThreadLocalWrapper<int> wrapper(0);
+    wrapper.get() += 1;
+
+    // threads outside the global pool must not share the slot of the owner
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < 4; ++i) {
+        threads.emplace_back([&wrapper] () {
+            for (unsigned int j = 0; j < 1000; ++j) {wrapper.get() += 1;}
+        });
+    }
+    for (auto& t : threads) {t.join();}
+    CHECK(wrapper.get() == 1);
+    CHECK(wrapper.get_all().size() == 5);
+    CHECK(wrapper.merge() == 4001);
+}
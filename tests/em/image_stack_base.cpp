@@ -11,6 +11,7 @@
 #include <em/manager/ProteinManager.h>
 #include <hist/HistFwd.h>
 #include <em/ObjectBounds3D.h>
+#include <em/detail/VoxelIndex.h>
 #include <data/Molecule.h>
 #include <settings/All.h>
 
@@ -112,6 +113,42 @@ TEST_CASE_METHOD(fixture, "ImageStackBase::count_voxels") {
     }
 }
 
+TEST_CASE_METHOD(fixture, "ImageStackBase::get_voxel_index") {
+    settings::em::sample_frequency = 1;
+    em::ImageStackBase isb(images);
+    std::unique_ptr header = std::make_unique<em::detail::header::MRCHeader>();
+    std::unique_ptr header_data = std::make_unique<em::detail::header::MRCData>();
+    header_data->cella_x = 3; header_data->cella_y = 3; header_data->cella_z = 3;
+    header->set_data(std::move(header_data));
+    isb.set_header(std::move(header));
+
+    auto index = isb.get_voxel_index(5);
+    REQUIRE(index->size() == 23);
+    for (double cutoff : {5., 9.5, 10., 26., 27., 30.}) {
+        // the index must contain the same atoms as those generated directly from the images
+        std::vector<data::EMAtom> expected;
+        for (const auto& image : isb.images()) {image.generate_atoms(expected, cutoff);}
+        auto atoms = index->get_atoms(cutoff);
+        REQUIRE(atoms.size() == expected.size());
+        for (unsigned int i = 1; i < atoms.size(); ++i) {
+            CHECK(atoms[i-1].charge_density() <= atoms[i].charge_density());
+        }
+        for (const auto& atom : expected) {
+            CHECK(std::find_if(atoms.begin(), atoms.end(), [&atom] (const data::EMAtom& a) {return a.coordinates() == atom.coordinates();}) != atoms.end());
+        }
+    }
+    CHECK(index->get_atoms(10, 20).size() == 10);
+    CHECK(index->get_atoms(10, 5).empty());
+
+    // larger cutoffs reuse the index, while smaller ones or changed settings rebuild it
+    CHECK(isb.get_voxel_index(20) == index);
+    CHECK(isb.get_voxel_index(1) != index);
+    index = isb.get_voxel_index(1);
+    settings::em::fixed_weights = !settings::em::fixed_weights;
+    CHECK(isb.get_voxel_index(1) != index);
+    settings::em::fixed_weights = !settings::em::fixed_weights;
+}
+
 TEST_CASE_METHOD(fixture, "ImageStackBase::get_protein") {
     em::ImageStackBase isb("tests/files/A2M_2020_Q4.ccp4");
     REQUIRE(isb.get_protein(5) == isb.get_protein_manager()->get_protein(5));
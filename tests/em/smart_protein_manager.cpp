@@ -1,11 +1,20 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
 #include <hydrate/generation/RadialHydration.h>
 #include <em/manager/SimpleProteinManager.h>
 #include <em/manager/SmartProteinManager.h>
 #include <em/ImageStack.h>
+#include <em/detail/CutoffHistogram.h>
+#include <em/detail/VoxelIndex.h>
+#include <em/detail/header/data/MRCData.h>
+#include <em/detail/header/MRCHeader.h>
+#include <hist/distance_calculator/SimpleCalculator.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/detail/SimpleExvModel.h>
+#include <hist/histogram_manager/HistogramManagerMT.h>
 #include <data/Molecule.h>
 #include <settings/All.h>
 
@@ -112,4 +121,94 @@ TEST_CASE("SmartProteinManager: consistency", "[files]") {
         REQUIRE(images.get_protein_manager()->get_charge_levels().size() == charge_levels+1);
         REQUIRE_THAT(images.fit("tests/files/SASDJG5.dat")->fval, Catch::Matchers::WithinRel(res->fval, 1e-3));
     }
+}
+TEST_CASE("SmartProteinManager: incremental histogram") {
+    settings::em::sample_frequency = 1;
+    settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::HistogramManagerMT;
+
+    // a small stack with a spread of densities, such that every cutoff step moves a different number of voxels
+    std::vector<em::Image> images;
+    for (unsigned int z = 0; z < 6; ++z) {
+        Matrix<float> data(6, 6);
+        for (unsigned int i = 0; i < 6; ++i) {
+            for (unsigned int j = 0; j < 6; ++j) {
+                data.index(i, j) = (7*i + 13*j + 5*z) % 31 + 1;
+            }
+        }
+        images.emplace_back(data);
+        images.back().set_z(z);
+    }
+    em::ImageStack stack(images);
+    {
+        std::unique_ptr header = std::make_unique<em::detail::header::MRCHeader>();
+        std::unique_ptr header_data = std::make_unique<em::detail::header::MRCData>();
+        header_data->cella_x = 12; header_data->cella_y = 12; header_data->cella_z = 12;
+        header_data->nx = 6; header_data->ny = 6; header_data->nz = 6;
+        header->set_data(std::move(header_data));
+        stack.set_header(std::move(header));
+    }
+    std::vector<double> cutoffs = {20, 10, 25, 5, 30, 1, 15, 16, 2};
+
+    SECTION("CutoffHistogram") {
+        auto index = stack.get_voxel_index(1);
+        em::detail::CutoffHistogram<false> histogram(index);
+        for (double cutoff : cutoffs) {
+            auto atoms = index->get_atoms(cutoff);
+            hist::detail::CompactCoordinates coords(atoms.size());
+            std::transform(atoms.begin(), atoms.end(), coords.get_data().begin(), [] (const data::EMAtom& a) {
+                return hist::detail::CompactCoordinatesData(a.get_atom().coordinates(), a.get_atom().weight());
+            });
+
+            const auto& p = histogram.get_histogram(cutoff);
+            hist::distance_calculator::SimpleCalculator<false> calculator(p.size());
+            calculator.enqueue_calculate_self(coords);
+            auto expected = calculator.run().self[0];
+            REQUIRE(histogram.get_coordinates().size() == atoms.size());
+            for (unsigned int i = 0; i < p.size(); ++i) {
+                REQUIRE_THAT(p.index(i), Catch::Matchers::WithinAbs(expected.index(i), 1e-6));
+            }
+        }
+    }
+
+    SECTION("matches full calculation") {
+        auto weighted = GENERATE(true, false);
+        settings::hist::weighted_bins = weighted;
+
+        settings::em::incremental_histogram = false;
+        em::managers::SmartProteinManager reference(&stack);
+        reference.get_protein(cutoffs[0]);
+        settings::em::incremental_histogram = true;
+        em::managers::SmartProteinManager incremental(&stack);
+        incremental.get_protein(cutoffs[0]);
+
+        for (double cutoff : cutoffs) {
+            auto expected = reference.get_histogram(cutoff);
+            auto result = incremental.get_histogram(cutoff);
+            REQUIRE(result->get_total_counts().size() == expected->get_total_counts().size());
+            for (unsigned int i = 0; i < result->get_total_counts().size(); ++i) {
+                REQUIRE_THAT(result->get_total_counts()[i], Catch::Matchers::WithinAbs(expected->get_total_counts()[i], 1e-6));
+                REQUIRE_THAT(result->get_d_axis()[i], Catch::Matchers::WithinAbs(expected->get_d_axis()[i], 1e-6));
+            }
+        }
+        settings::hist::weighted_bins = true;
+    }
+
+    SECTION("simple excluded volume model") {
+        // the model changes the charges of all atoms, so the result must match HistogramManagerMT with the model applied
+        settings::hist::weighted_bins = true;
+        settings::em::incremental_histogram = true;
+        hist::detail::SimpleExvModel::enable();
+        em::managers::SmartProteinManager incremental(&stack);
+        incremental.get_protein(cutoffs[0]);
+
+        for (double cutoff : cutoffs) {
+            auto result = incremental.get_histogram(cutoff);
+            auto expected = hist::HistogramManagerMT<true>(incremental.get_protein()).calculate_all();
+            REQUIRE(result->get_total_counts().size() == expected->get_total_counts().size());
+            for (unsigned int i = 0; i < result->get_total_counts().size(); ++i) {
+                REQUIRE_THAT(result->get_total_counts()[i], Catch::Matchers::WithinAbs(expected->get_total_counts()[i], 1e-6));
+            }
+        }
+        hist::detail::SimpleExvModel::disable();
+    }
 }
\ No newline at end of file
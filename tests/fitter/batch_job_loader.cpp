@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fitter/BatchJobLoader.h>
+#include <data/Molecule.h>
+#include <dataset/SimpleDataset.h>
+#include <settings/All.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace ausaxs;
+
+namespace {
+    std::vector<fitter::BatchJob> load(const std::string& manifest, unsigned int capacity = 1) {
+        std::istringstream stream(manifest);
+        utility::BoundedQueue<fitter::BatchJob> queue(capacity);
+        std::thread loader([&stream, &queue] () {fitter::load_batch_jobs(stream, queue);});
+
+        std::vector<fitter::BatchJob> jobs;
+        while (auto job = queue.pop()) {jobs.push_back(std::move(*job));}
+        loader.join();
+        return jobs;
+    }
+}
+
+TEST_CASE("load_batch_jobs: empty") {
+    CHECK(load("").empty());
+    CHECK(load("\n\n# only a comment\n   \n").empty());
+}
+
+TEST_CASE("load_batch_jobs: valid") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    auto jobs = load(
+        "# structure measurement\n"
+        "tests/files/2epe.pdb tests/files/2epe.dat\n"
+        "\n"
+        "tests/files/2epe.pdb tests/files/2epe.dat\n"
+    );
+    REQUIRE(jobs.size() == 2);
+    CHECK(jobs[0].line == 2);
+    CHECK(jobs[1].line == 4);
+    for (const auto& job : jobs) {
+        CHECK(job.error.empty());
+        CHECK(job.structure == "tests/files/2epe.pdb");
+        CHECK(job.measurement == "tests/files/2epe.dat");
+        REQUIRE(job.protein != nullptr);
+        REQUIRE(job.data != nullptr);
+        CHECK(job.protein->size_atom() != 0);
+        CHECK(job.data->size() != 0);
+    }
+}
+
+TEST_CASE("load_batch_jobs: errors") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    auto jobs = load(
+        "tests/files/2epe.pdb\n"                                // missing measurement
+        "tests/files/missing.pdb tests/files/2epe.dat\n"        // missing structure file
+        "tests/files/2epe.dat tests/files/2epe.dat\n"           // wrong structure extension
+        "tests/files/2epe.pdb tests/files/2epe.pdb\n"           // wrong measurement extension
+        "tests/files/2epe.pdb tests/files/2epe.dat\n"           // errors do not stop the remaining jobs
+    );
+    REQUIRE(jobs.size() == 5);
+    for (unsigned int i = 0; i < 4; ++i) {
+        CHECK(jobs[i].line == i+1);
+        CHECK(!jobs[i].error.empty());
+        CHECK(jobs[i].protein == nullptr);
+        CHECK(jobs[i].data == nullptr);
+    }
+    CHECK(jobs[4].error.empty());
+    CHECK(jobs[4].protein != nullptr);
+}
\ No newline at end of file
@@ -13,6 +13,9 @@
 #include <data/Body.h>
 #include <em/detail/ExtendedLandscape.h>
 #include <fitter/SmartFitter.h>
+#include <fitter/detail/BasisChi2.h>
+#include <fitter/detail/LinearLeastSquares.h>
+#include <math/CubicSplineResampler.h>
 #include <mini/detail/FittedParameter.h>
 
 using namespace ausaxs;
@@ -152,6 +155,124 @@ TEST_CASE("SmartFitter::fit") {
     }
 }
 
+TEST_CASE("SmartFitter: intensity basis") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    settings::hist::histogram_manager = GENERATE(
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFAvg,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFExplicit,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFGrid,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFGridSurface,
+        settings::hist::HistogramManagerChoice::CrysolManager
+    );
+    Molecule protein("tests/files/2epe.pdb");
+    SimpleDataset data("tests/files/2epe.dat");
+    auto h = protein.get_histogram();
+    auto h_cast = static_cast<hist::ICompositeDistanceHistogramExv*>(h.get());
+
+    using FreeParameters = hist::ICompositeDistanceHistogramExv::FreeParameters;
+    std::vector<FreeParameters> params = {
+        {}, 
+        {.cw=2}, 
+        {.cw=0.5, .cx=1.05}, 
+        {.cw=1.5, .cx=0.95, .crho=1.1}, 
+        {.cw=1.5, .cx=1.02, .crho=0.9, .DW_sigma_atomic=0.5, .DW_sigma_exv=1}
+    };
+    fitter::detail::BasisChi2 basis(h_cast->get_intensity_basis(), data);
+
+    SECTION("chi2") {
+        math::CubicSplineResampler resampler(h->get_q_axis(), data.x());
+        std::vector<double> inv_sigma(data.size());
+        std::transform(data.yerr().begin(), data.yerr().end(), inv_sigma.begin(), [] (double sigma) {return 1./sigma;});
+        for (const auto& p : params) {
+            double expected = fitter::detail::LinearLeastSquares::optimal_chi2(resampler.resample(h_cast->evaluate(p)), data.y(), inv_sigma);
+            REQUIRE_THAT(basis.chi2(p), Catch::Matchers::WithinRel(expected, 1e-6));
+        }
+    }
+
+    SECTION("gradient") {
+        for (const auto& p : params) {
+            FreeParameters g;
+            double chi2 = basis.chi2(p, g);
+            auto check = [&] (double FreeParameters::* member) {
+                constexpr double h = 1e-5;
+                FreeParameters p_plus = p, p_minus = p;
+                p_plus.*member += h;
+                p_minus.*member -= h;
+                double expected = (basis.chi2(p_plus) - basis.chi2(p_minus))/(2*h);
+                REQUIRE_THAT(g.*member, Catch::Matchers::WithinRel(expected, 1e-3) || Catch::Matchers::WithinAbs(expected, 1e-6*chi2));
+            };
+            check(&FreeParameters::cw);
+            check(&FreeParameters::cx);
+            check(&FreeParameters::crho);
+            check(&FreeParameters::DW_sigma_atomic);
+            check(&FreeParameters::DW_sigma_exv);
+        }
+    }
+
+    SECTION("fit") {
+        settings::fit::fit_solvent_density = false;
+        settings::fit::fit_atomic_debye_waller = false;
+        settings::fit::fit_exv_debye_waller = false;
+        // the default minimizer only supports a single parameter
+        auto compare = [&] (constants::fit::Parameters parameter) {
+            fitter::SmartFitter fitter(data, protein.get_histogram());
+            settings::fit::use_intensity_basis = false;
+            auto direct = fitter.fit();
+            settings::fit::use_intensity_basis = true;
+            auto fast = fitter.fit();
+            REQUIRE_THAT(fast->fval, Catch::Matchers::WithinRel(direct->fval, 1e-6));
+            REQUIRE_THAT(fast->get_parameter(parameter).value, Catch::Matchers::WithinAbs(direct->get_parameter(parameter).value, 1e-4));
+        };
+
+        settings::fit::fit_hydration = true;
+        settings::fit::fit_excluded_volume = false;
+        compare(constants::fit::Parameters::SCALING_WATER);
+
+        settings::fit::fit_hydration = false;
+        settings::fit::fit_excluded_volume = true;
+        compare(constants::fit::Parameters::SCALING_EXV);
+    }
+}
+
+TEST_CASE("SmartFitter: multiple datasets") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    settings::fit::fit_hydration = true;
+    settings::fit::fit_excluded_volume = false;
+    settings::fit::fit_solvent_density = false;
+    settings::fit::fit_atomic_debye_waller = false;
+    settings::fit::fit_exv_debye_waller = false;
+
+    // without excluded volume the datasets are fitted sequentially, otherwise in parallel using the intensity basis
+    settings::hist::histogram_manager = GENERATE(
+        settings::hist::HistogramManagerChoice::HistogramManagerMT,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFAvg
+    );
+    Molecule protein("tests/files/2epe.pdb");
+
+    std::vector<SimpleDataset> datasets(3, SimpleDataset("tests/files/2epe.dat"));
+    datasets[1].scale_y(2);
+    datasets[2].limit_x(0.02, 0.3);
+
+    fitter::SmartFitter fitter(datasets[0], protein.get_histogram());
+    auto results = fitter.fit(datasets);
+    REQUIRE(results.size() == datasets.size());
+    for (unsigned int i = 0; i < datasets.size(); ++i) {
+        auto expected = fitter::SmartFitter(datasets[i], protein.get_histogram()).fit();
+        REQUIRE(results[i]->dof == expected->dof);
+        REQUIRE(results[i]->curves.size_rows() == datasets[i].size());
+        REQUIRE_THAT(results[i]->fval, Catch::Matchers::WithinRel(expected->fval, 1e-6));
+        REQUIRE_THAT(
+            results[i]->get_parameter(constants::fit::Parameters::SCALING_WATER).value, 
+            Catch::Matchers::WithinAbs(expected->get_parameter(constants::fit::Parameters::SCALING_WATER).value, 1e-4)
+        );
+    }
+
+    // the fitter must still fit its own dataset afterwards
+    REQUIRE_THAT(fitter.fit()->fval, Catch::Matchers::WithinRel(results[0]->fval, 1e-6));
+}
+
 TEST_CASE("fitter: correct dof", "[files]") {
     settings::general::verbose = false;
     settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::HistogramManagerMTFFExplicit;
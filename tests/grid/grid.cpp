@@ -4,6 +4,8 @@
 
 #include <vector>
 #include <string>
+#include <cmath>
+#include <array>
 
 #include <data/Body.h>
 #include <data/Molecule.h>
@@ -1129,6 +1131,167 @@ TEST_CASE("Grid::operator=", "[files]") {
     }
 }
 
+TEST_CASE("Grid::transaction", "[files]") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    data::Molecule protein("tests/files/2epe.pdb");
+    protein.generate_new_hydration();
+    auto grid = protein.get_grid();
+    grid->expand_volume();
+
+    // modify the grid in every way used during rigid body optimization
+    auto modify = [&] () {
+        auto& body = protein.get_body(0);
+        grid->remove(body);
+        body.translate({2, -1, 1});
+        grid->add(body);
+        protein.generate_new_hydration();
+        grid->generate_excluded_volume(true);
+    };
+
+    auto equal_contents = [] (const Grid& g1, const Grid& g2) {
+        if (!(g1 == g2)) {return false;}
+        if (!(g1.grid == g2.grid)) {return false;}
+        for (unsigned int i = 0; i < g1.w_members.size(); ++i) {
+            if (g1.w_members[i].get_bin_loc() != g2.w_members[i].get_bin_loc()) {return false;}
+            if (g1.w_members[i].is_expanded() != g2.w_members[i].is_expanded()) {return false;}
+        }
+        for (unsigned int i = 0; i < g1.a_members.size(); ++i) {
+            if (g1.a_members[i].get_bin_loc() != g2.a_members[i].get_bin_loc()) {return false;}
+        }
+        return true;
+    };
+
+    SECTION("rollback") {
+        Grid original = *grid;
+        grid->begin_transaction();
+        modify();
+        REQUIRE_FALSE(equal_contents(*grid, original));
+        grid->rollback();
+        REQUIRE(equal_contents(*grid, original));
+    }
+
+    SECTION("commit") {
+        grid->begin_transaction();
+        modify();
+        Grid modified = *grid;
+        grid->commit();
+        REQUIRE(equal_contents(*grid, modified));
+
+        // a new transaction starts from the committed state
+        grid->begin_transaction();
+        grid->clear_waters();
+        grid->rollback();
+        REQUIRE(equal_contents(*grid, modified));
+    }
+}
+
+TEST_CASE("Grid: parallel expansion", "[files]") {
+    settings::molecule::implicit_hydrogens = false;
+    settings::general::verbose = false;
+    settings::grid::min_exv_radius = GENERATE(0, 2.5);
+    data::Molecule protein("tests/files/LAR1-2.pdb");
+    protein.generate_new_hydration();
+    auto waters = protein.get_waters();
+
+    // the members are expanded together in the first grid, and one at a time in the second
+    Limit3D axes(-100, 100, -100, 100, -100, 100);
+    Grid grid2(axes);
+    settings::grid::sparse = GENERATE(false, true);
+    Grid grid1(axes);
+    settings::grid::sparse = false;
+    for (const auto& body : protein.get_bodies()) {
+        grid1.add(body, false);
+        grid2.add(body, true);
+    }
+    grid1.add(waters, false);
+    grid2.add(waters, true);
+    grid1.expand_volume();
+
+    REQUIRE(grid1.a_members.size() >= 1000);
+    CHECK(grid1.get_volume() == grid2.get_volume());
+    CHECK(grid1.grid == grid2.grid);
+    if (grid1.grid.is_sparse()) {CHECK(grid1.grid.allocated_size() < grid2.grid.allocated_size()/2);}
+
+    SECTION("rollback") {
+        Grid original = grid1;
+        grid1.begin_transaction();
+        settings::grid::min_exv_radius += 3;
+        grid1.force_expand_volume();
+        REQUIRE(grid1.get_volume() != original.get_volume());
+        grid1.rollback();
+        CHECK(grid1.get_volume() == original.get_volume());
+        CHECK(grid1.grid == original.grid);
+    }
+    settings::grid::min_exv_radius = 2.15;
+}
+
+TEST_CASE("Grid: stencil expansion") {
+    settings::general::verbose = false;
+
+    // the original expansion, checking the distance to every bin in the bounding box of the sphere
+    auto fill_reference = [] (GridObj& grid, const Vector3<int>& loc, double rvdw, double rvol, State value) {
+        int x = loc.x(), y = loc.y(), z = loc.z();
+        double rvdw2 = std::pow(rvdw, 2), rvol2 = std::pow(rvol, 2);
+        int r = std::ceil(std::max(rvdw, rvol));
+        int added_volume = 0;
+        for (int i = std::max(x - r, 0); i < std::min<int>(x + r + 1, grid.size_x()); ++i) {
+            for (int j = std::max(y - r, 0); j < std::min<int>(y + r + 1, grid.size_y()); ++j) {
+                for (int k = std::max(z - r, 0); k < std::min<int>(z + r + 1, grid.size_z()); ++k) {
+                    double dist = std::pow(x - i, 2) + std::pow(y - j, 2) + std::pow(z - k, 2);
+                    if (value == W_AREA) {
+                        if (dist <= rvdw2 && grid.is_empty(i, j, k)) {grid.index(i, j, k) = W_AREA;}
+                        continue;
+                    }
+                    if (dist <= rvdw2) {
+                        if (!grid.is_empty_or_volume(i, j, k)) {continue;}
+                        added_volume += !grid.is_volume(i, j, k);
+                        grid.index(i, j, k) = A_AREA;
+                    } else if (dist <= rvol2) {
+                        if (!grid.is_empty(i, j, k)) {continue;}
+                        grid.index(i, j, k) = VOLUME;
+                        added_volume++;
+                    }
+                }
+            }
+        }
+        return added_volume;
+    };
+
+    double ra = GENERATE(0.7, 1.35, 1.5, 2.45, 3.05);
+    double rvol = GENERATE(0., 1.8, 2.5, 3.6);
+    settings::grid::min_exv_radius = rvol;
+
+    GridDebug grid({-10, 10, -10, 10, -10, 10});
+    grid.set_atomic_radius(ra);
+    grid.set_hydration_radius(ra + 0.35);
+
+    // overlapping spheres, and spheres cut off by the edges of the grid
+    Body body{std::vector{
+        AtomFF({0, 0, 0}, form_factor::form_factor_t::C),
+        AtomFF({1, -2, 2}, form_factor::form_factor_t::C),
+        AtomFF({9, 9, -10}, form_factor::form_factor_t::C)
+    }};
+    std::vector<Water> waters = {Water({3, 0, 1}), Water({-10, 5, 10})};
+    grid.add(body, false);
+    grid.add(waters, false);
+
+    auto reference = grid.grid;
+    int added = 0;
+    for (const auto& atom : body.get_atoms()) {
+        added += fill_reference(reference, grid.to_bins(atom.coordinates()), ra/settings::grid::cell_width, rvol/settings::grid::cell_width, A_AREA);
+    }
+    for (const auto& water : waters) {
+        fill_reference(reference, grid.to_bins(water.coordinates()), (ra + 0.35)/settings::grid::cell_width, 0, W_AREA);
+    }
+
+    auto volume = grid.get_volume_without_expanding();
+    grid.expand_volume();
+    CHECK(grid.get_volume_without_expanding() - volume == added);
+    CHECK(grid.grid == reference);
+    settings::grid::min_exv_radius = 2.15;
+}
+
 TEST_CASE("Grid: hydration") {
     settings::general::verbose = false;
 
@@ -1167,6 +1330,50 @@ TEST_CASE("Grid: hydration") {
     }
 }
 
+TEST_CASE("RadialHydration: parallel", "[files]") {
+    settings::molecule::implicit_hydrogens = false;
+    settings::general::verbose = false;
+    auto strategy = settings::hydrate::hydration_strategy;
+    bool parallel = settings::hydrate::parallel;
+    settings::hydrate::hydration_strategy = settings::hydrate::HydrationStrategy::RadialStrategy;
+    hydrate::RadialHydration::set_noise_generator(nullptr);
+
+    auto hydrate = [] (data::Molecule& protein, bool parallel) {
+        settings::hydrate::parallel = parallel;
+        hydrate::RadialHydration::set_noise_seed(42);
+        protein.generate_new_hydration();
+        return protein.get_waters();
+    };
+
+    // with this seed, one of the waters of 168l is only accepted because an earlier water occupies one of its 1rh bins, which skips the penalties of that line
+    // a parallel proposal which already ran the collision check against the grid without the new waters would therefore miss it
+    std::vector<std::array<std::vector<data::Water>, 3>> waters;
+    for (std::string file : {"tests/files/LAR1-2.pdb", "tests/files/168l.pdb"}) {
+        data::Molecule protein(file);
+        auto w1 = hydrate(protein, true);
+        auto w2 = hydrate(protein, true);
+        auto w3 = hydrate(protein, false);
+        waters.push_back({std::move(w1), std::move(w2), std::move(w3)});
+    }
+    settings::hydrate::hydration_strategy = strategy;
+    settings::hydrate::parallel = parallel;
+
+    for (const auto& [w1, w2, w3] : waters) {
+        // the same seed must give the same hydration
+        REQUIRE(w1.size() == w2.size());
+        for (unsigned int i = 0; i < w1.size(); ++i) {
+            REQUIRE(w1[i].coords == w2[i].coords);
+        }
+
+        // the proposals are only filtered on their center bins, which added waters can only occupy, so both modes must give the same waters
+        REQUIRE(!w1.empty());
+        REQUIRE(w1.size() == w3.size());
+        for (unsigned int i = 0; i < w1.size(); ++i) {
+            REQUIRE(w1[i].coords == w3[i].coords);
+        }
+    }
+}
+
 TEST_CASE("Grid::add:remove") {
     // SECTION("single") {
     //     Body b(std::vector<AtomFF>{
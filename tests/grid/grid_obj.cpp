@@ -104,4 +104,43 @@ TEST_CASE("GridObj: logical operators") {
     CHECK_FALSE(s & W_AREA);
     CHECK_FALSE(s & VOLUME);
     CHECK_FALSE(s & EMPTY);
-}
\ No newline at end of file
+}
+TEST_CASE("GridObj: sparse storage") {
+    GridObj dense(100, 40, 90), sparse(100, 40, 90, true);
+    CHECK(sparse.allocated_size() == 0);
+    CHECK(sparse.index(99, 39, 89) == EMPTY);
+
+    auto write = [] (GridObj& g) {
+        for (unsigned int i = 0; i < 100; i += 3) {
+            g.index(i, (2*i) % 40, (5*i) % 90) = A_CENTER;
+            g.index(i, 0, 89) = W_AREA;
+        }
+    };
+    write(dense);
+    write(sparse);
+    CHECK(sparse == dense);
+    CHECK(sparse.allocated_size() < dense.allocated_size());
+
+    SECTION("segments") {
+        // segments end at the block boundaries
+        auto [bins, length] = sparse.segment(3, 4, 14);
+        CHECK(length == 2);
+        CHECK(*bins == EMPTY);
+        std::tie(bins, length) = sparse.segment(3, 4, 40);
+        CHECK(length == 8);
+        std::tie(bins, length) = sparse.segment(3, 4, 85);
+        CHECK(length == 5);
+        CHECK(dense.segment(3, 4, 14).second == 76);
+    }
+
+    SECTION("rollback") {
+        GridObj original = sparse;
+        sparse.begin_transaction();
+        sparse.index(20, 19, 30) = VOLUME;
+        sparse.index(3, 6, 15) = EMPTY;
+        sparse.index(3, 6, 15) = W_CENTER;
+        CHECK_FALSE(sparse == original);
+        sparse.rollback();
+        CHECK(sparse == original);
+    }
+}
@@ -12,6 +12,13 @@
 using namespace ausaxs;
 using namespace data;
 
+// Expose the radial lines used by the surface detection.
+struct RadialLines : grid::detail::RadialLineGenerator {
+    using RadialLineGenerator::rot_bins_1;
+    using RadialLineGenerator::rot_bins_2;
+    using RadialLineGenerator::rot_bins_3;
+};
+
 class GridDebug : public grid::Grid {
     public: 
         using Grid::Grid;
@@ -309,4 +316,47 @@ TEST_CASE("GridSurfaceDetection: thickness") {
     //     GridDebug::generate_debug_grid(protein);
     //     auto vol = protein.get_grid()->generate_excluded_volume(true);
     // }
-}
\ No newline at end of file
+}
+
+// Compare the batched collision checks against a direct evaluation of the radial lines on the grid.
+TEST_CASE("GridSurfaceDetection: collision checks", "[files]") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    settings::molecule::center = true;
+    settings::grid::exv::surface_thickness = 1;
+    settings::grid::min_exv_radius = 2.15;
+    settings::grid::sparse = GENERATE(false, true);
+
+    Molecule protein("tests/files/LAR1-2.pdb");
+    protein.generate_new_hydration();
+    auto grid = protein.get_grid();
+    auto vol = grid->generate_excluded_volume(true);
+    settings::grid::sparse = false;
+    REQUIRE(!vol.surface.empty());
+    REQUIRE(!vol.interior.empty());
+
+    const auto& gobj = std::as_const(grid->grid);
+    auto blocked = [&] (const Vector3<int>& v) -> int {
+        if (v.x() < 0 || v.y() < 0 || v.z() < 0 || (int) gobj.size_x() <= v.x() || (int) gobj.size_y() <= v.y() || (int) gobj.size_z() <= v.z()) {return -1;}
+        return !gobj.is_empty_or_water(v.x(), v.y(), v.z());
+    };
+    auto is_interior = [&] (const Vector3<double>& loc) {
+        auto bins = grid->to_bins(loc);
+        int score = 0;
+        for (unsigned int i = 0; i < RadialLines::rot_bins_1.size(); ++i) {
+            std::array<int, 3> states = {blocked(bins + RadialLines::rot_bins_1[i]), blocked(bins + RadialLines::rot_bins_2[i]), blocked(bins + RadialLines::rot_bins_3[i])};
+            std::array<int, 3> scores = {0, 3, 5};
+            int line = 7;
+            for (unsigned int r = 0; r < 3; ++r) {
+                if (states[r] == 0) {continue;}
+                if (states[r] == 1) {line = scores[r];}
+                break;
+            }
+            score += line;
+        }
+        return score < 42;
+    };
+
+    for (const auto& v : vol.interior) {REQUIRE(is_interior(v));}
+    for (const auto& v : vol.surface)  {REQUIRE(!is_interior(v));}
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <hist/detail/BatchedDebyeTransform.h>
+#include <table/ArrayDebyeTable.h>
+#include <constants/ConstantsAxes.h>
+
+#include <numeric>
+#include <random>
+
+using namespace ausaxs;
+
+TEST_CASE("BatchedDebyeTransform::run") {
+    const auto& table = table::ArrayDebyeTable::get_default_table();
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0, 10);
+    std::uniform_real_distribution<double> occupancy(0, 1);
+    double fill = 1;
+    auto generate_profile = [&] (unsigned int size) {
+        std::vector<double> profile(size, 0);
+        for (auto& v : profile) {
+            if (occupancy(gen) < fill) {v = dist(gen);}
+        }
+        return profile;
+    };
+
+    // the profile lengths are chosen to exercise both the register blocks, the partial blocks, and the uneven tails
+    auto check = [&] (const std::vector<unsigned int>& sizes, unsigned int q0, unsigned int q_bins) {
+        std::vector<std::vector<double>> profiles, results;
+        for (auto size : sizes) {
+            profiles.push_back(generate_profile(size));
+            results.emplace_back(q_bins, -1);
+        }
+
+        hist::detail::BatchedDebyeTransform transform(&table, q0, q_bins);
+        for (unsigned int i = 0; i < profiles.size(); ++i) {
+            transform.enqueue(profiles[i].begin(), profiles[i].end(), results[i].begin());
+        }
+        transform.run();
+
+        for (unsigned int i = 0; i < profiles.size(); ++i) {
+            for (unsigned int q = 0; q < q_bins; ++q) {
+                double expected = std::inner_product(profiles[i].begin(), profiles[i].end(), table.begin(q0+q), 0.0);
+                REQUIRE_THAT(results[i][q], Catch::Matchers::WithinRel(expected, 1e-9) || Catch::Matchers::WithinAbs(expected, 1e-9));
+            }
+        }
+    };
+
+    SECTION("equal lengths") {
+        check(std::vector<unsigned int>(20, 1000), 0, constants::axes::q_axis.bins);
+    }
+
+    SECTION("uneven lengths") {
+        check({1, 7, 513, 1024, 3, 2000, 0, 999, 1500, 17, 8000}, 0, constants::axes::q_axis.bins);
+    }
+
+    SECTION("q subrange") {
+        check({100, 200, 300, 400, 500}, 13, 101);
+    }
+
+    SECTION("sparse profiles") {
+        for (double f : {0.5, 0.05, 0.002, 0.}) {
+            fill = f;
+            check({1, 7, 513, 1024, 3, 2000, 0, 999, 1500, 17, 8000, 8000, 4000}, 0, constants::axes::q_axis.bins);
+        }
+    }
+
+    SECTION("clustered profiles") {
+        // profiles with large empty regions both before, between, and after the occupied bins
+        std::vector<std::vector<double>> profiles, results;
+        for (unsigned int i = 0; i < 9; ++i) {
+            std::vector<double> profile(3000, 0);
+            for (unsigned int d = 100*i; d < 100*i + 300; ++d) {profile[d] = dist(gen);}
+            if (i % 3 == 0) {for (unsigned int d = 2000; d < 2050; ++d) {profile[d] = dist(gen);}}
+            profiles.push_back(std::move(profile));
+            results.emplace_back(constants::axes::q_axis.bins, -1);
+        }
+
+        hist::detail::BatchedDebyeTransform transform(&table, 0, constants::axes::q_axis.bins);
+        for (unsigned int i = 0; i < profiles.size(); ++i) {
+            transform.enqueue(profiles[i].begin(), profiles[i].end(), results[i].begin());
+        }
+        transform.run();
+
+        for (unsigned int i = 0; i < profiles.size(); ++i) {
+            for (unsigned int q = 0; q < constants::axes::q_axis.bins; ++q) {
+                double expected = std::inner_product(profiles[i].begin(), profiles[i].end(), table.begin(q), 0.0);
+                REQUIRE_THAT(results[i][q], Catch::Matchers::WithinRel(expected, 1e-9) || Catch::Matchers::WithinAbs(expected, 1e-9));
+            }
+        }
+    }
+
+    SECTION("empty batch") {
+        hist::detail::BatchedDebyeTransform transform(&table, 0, constants::axes::q_axis.bins);
+        CHECK_NOTHROW(transform.run());
+    }
+}
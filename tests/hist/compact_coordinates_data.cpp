@@ -2,6 +2,7 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <hist/detail/CompactCoordinatesData.h>
+#include <hist/distance_calculator/detail/EvaluatorDispatch.h>
 #include <constants/Constants.h>
 #include <math/Vector3.h>
 
@@ -217,4 +218,40 @@ TEST_CASE("CompactCoordinatesData::evaluate") {
             octo_tests_rounded([](const DebugData& data, const DebugData& data1, const DebugData& data2, const DebugData& data3, const DebugData& data4, const DebugData& data5, const DebugData& data6, const DebugData& data7, const DebugData& data8) { return data.evaluate_rounded_avx(data1, data2, data3, data4, data5, data6, data7, data8); });
         }
     #endif
-}
\ No newline at end of file
+}
+
+TEST_CASE("dispatch::get_evaluators") {
+    using utility::cpu::InstructionSet;
+    for (auto set : {InstructionSet::Scalar, InstructionSet::SSE41, InstructionSet::AVX, InstructionSet::AVX2, InstructionSet::AVX512}) {
+        if (!utility::cpu::supports(set)) {continue;}
+        auto evaluators = hist::distance_calculator::detail::dispatch::get_evaluators(set);
+        DYNAMIC_SECTION(utility::cpu::to_string(set)) {
+            // the evaluators expect the other atoms to be stored consecutively
+            single_tests([&](const DebugData& data1, const DebugData& data2) { 
+                std::array<CompactCoordinatesData, 1> others{data2};
+                return evaluators.evaluate1(data1, others.data()); 
+            });
+            quad_tests([&](const DebugData& data, const DebugData& data1, const DebugData& data2, const DebugData& data3, const DebugData& data4) { 
+                std::array<CompactCoordinatesData, 4> others{data1, data2, data3, data4};
+                return evaluators.evaluate4(data, others.data()); 
+            });
+            octo_tests([&](const DebugData& data, const DebugData& data1, const DebugData& data2, const DebugData& data3, const DebugData& data4, const DebugData& data5, const DebugData& data6, const DebugData& data7, const DebugData& data8) { 
+                std::array<CompactCoordinatesData, 8> others{data1, data2, data3, data4, data5, data6, data7, data8};
+                return evaluators.evaluate8(data, others.data()); 
+            });
+
+            single_tests_rounded([&](const DebugData& data1, const DebugData& data2) { 
+                std::array<CompactCoordinatesData, 1> others{data2};
+                return evaluators.evaluate1_rounded(data1, others.data()); 
+            });
+            quad_tests_rounded([&](const DebugData& data, const DebugData& data1, const DebugData& data2, const DebugData& data3, const DebugData& data4) { 
+                std::array<CompactCoordinatesData, 4> others{data1, data2, data3, data4};
+                return evaluators.evaluate4_rounded(data, others.data()); 
+            });
+            octo_tests_rounded([&](const DebugData& data, const DebugData& data1, const DebugData& data2, const DebugData& data3, const DebugData& data4, const DebugData& data5, const DebugData& data6, const DebugData& data7, const DebugData& data8) { 
+                std::array<CompactCoordinatesData, 8> others{data1, data2, data3, data4, data5, data6, data7, data8};
+                return evaluators.evaluate8_rounded(data, others.data()); 
+            });
+        }
+    }
+}
@@ -12,6 +12,7 @@
 #include <table/DebyeTable.h>
 #include <settings/All.h>
 #include <constants/Constants.h>
+#include <utility/MultiThreading.h>
 
 #include "hist/hist_test_helper.h"
 
@@ -291,4 +292,57 @@ TEST_CASE("CompositeDistanceHistogramFFAvg: Debye-Waller factors") {
         auto Iq = h_cast->debye_transform();
         REQUIRE(compare_hist(Iq_exp, Iq));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("CompositeDistanceHistogramFF: evaluate") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    settings::hist::histogram_manager = GENERATE(
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFAvg,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFExplicit,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFGrid,
+        settings::hist::HistogramManagerChoice::HistogramManagerMTFFGridSurface,
+        settings::hist::HistogramManagerChoice::CrysolManager
+    );
+    data::Molecule protein("tests/files/2epe.pdb");
+    auto h = protein.get_histogram();
+    auto h_cast = static_cast<hist::ICompositeDistanceHistogramExv*>(h.get());
+
+    std::vector<hist::ICompositeDistanceHistogramExv::FreeParameters> params = {
+        {}, 
+        {.cw=2}, 
+        {.cw=0.5, .cx=1.05}, 
+        {.cw=1.5, .cx=0.95, .crho=1.1}, 
+        {.cw=1.5, .cx=1.02, .crho=0.9, .DW_sigma_atomic=0.5, .DW_sigma_exv=1}
+    };
+
+    // the stateless evaluation must match applying the parameters to the histogram
+    std::vector<std::vector<double>> expected;
+    for (const auto& p : params) {
+        h_cast->apply_water_scaling_factor(p.cw);
+        h_cast->apply_excluded_volume_scaling_factor(p.cx);
+        h_cast->apply_solvent_density_scaling_factor(p.crho);
+        h_cast->apply_atomic_debye_waller_factor(p.DW_sigma_atomic);
+        h_cast->apply_exv_debye_waller_factor(p.DW_sigma_exv);
+        expected.push_back(h_cast->debye_transform().get_counts());
+    }
+    h_cast->apply_water_scaling_factor(1);
+    h_cast->apply_excluded_volume_scaling_factor(1);
+    h_cast->apply_solvent_density_scaling_factor(1);
+    h_cast->apply_atomic_debye_waller_factor(0);
+    h_cast->apply_exv_debye_waller_factor(0);
+
+    for (unsigned int i = 0; i < params.size(); ++i) {
+        REQUIRE(compare_hist(expected[i], h_cast->evaluate(params[i])));
+    }
+
+    // and must also be safe to call concurrently
+    std::vector<std::vector<double>> results(params.size());
+    auto pool = utility::multi_threading::get_global_pool();
+    for (unsigned int i = 0; i < params.size(); ++i) {
+        pool->detach_task([&, i] () {results[i] = h_cast->evaluate(params[i]);});
+    }
+    pool->wait();
+    for (unsigned int i = 0; i < params.size(); ++i) {
+        REQUIRE(compare_hist(expected[i], results[i]));
+    }
+}
@@ -66,7 +66,7 @@ struct DebugCompositeDistanceHistogramFFAvg : public CompositeDistanceHistogramF
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 double ax_sum = std::inner_product(distance_profiles.aa.begin(ff1, form_factor::exv_bin), distance_profiles.aa.end(ff1, form_factor::exv_bin), sinqd_table->begin(q), 0.0);
                 Iq[q-q0] += 2*cx*ax_sum*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
@@ -84,7 +84,7 @@ struct DebugCompositeDistanceHistogramFFAvg : public CompositeDistanceHistogramF
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             double xx_sum = std::inner_product(distance_profiles.aa.begin(form_factor::exv_bin, form_factor::exv_bin), distance_profiles.aa.end(form_factor::exv_bin, form_factor::exv_bin), sinqd_table->begin(q), 0.0);
             Iq[q-q0] += cx*cx*xx_sum*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
         }
@@ -100,7 +100,7 @@ struct DebugCompositeDistanceHistogramFFAvg : public CompositeDistanceHistogramF
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             double ew_sum = std::inner_product(distance_profiles.aw.begin(form_factor::exv_bin), distance_profiles.aw.end(form_factor::exv_bin), sinqd_table->begin(q), 0.0);
             Iq[q-q0] += 2*cx*free_params.cw*ew_sum*ff_table.index(form_factor::exv_bin, form_factor::water_bin).evaluate(q);
         }
@@ -150,7 +150,7 @@ struct DebugCompositeDistanceHistogramFFAvg : public CompositeDistanceHistogramF
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 // atom-atom
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
@@ -255,7 +255,7 @@ struct DebugCompositeDistanceHistogramFFExplicit : public CompositeDistanceHisto
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(constants::axes::q_vals[q]);
+            double cx = exv_factor(constants::axes::q_vals[q], free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     double ax_sum = std::inner_product(exv_distance_profiles.ax.begin(ff1, ff2), exv_distance_profiles.ax.end(ff1, ff2), sinqd_table->begin(q), 0.0);
@@ -275,7 +275,7 @@ struct DebugCompositeDistanceHistogramFFExplicit : public CompositeDistanceHisto
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx2 = std::pow(exv_factor(constants::axes::q_vals[q]), 2);
+            double cx2 = std::pow(exv_factor(constants::axes::q_vals[q], free_params), 2);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     double xx_sum = std::inner_product(exv_distance_profiles.xx.begin(ff1, ff2), exv_distance_profiles.xx.end(ff1, ff2), sinqd_table->begin(q), 0.0);
@@ -296,7 +296,7 @@ struct DebugCompositeDistanceHistogramFFExplicit : public CompositeDistanceHisto
         std::vector<double> Iq(debye_axis.bins, 0);
         unsigned int ff_w_index = static_cast<int>(form_factor::form_factor_t::OH);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(constants::axes::q_vals[q]);
+            double cx = exv_factor(constants::axes::q_vals[q], free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 double wx_sum = std::inner_product(exv_distance_profiles.wx.begin(ff1), exv_distance_profiles.wx.end(ff1), sinqd_table->begin(q), 0.0);
                 Iq[q-q0] += 2*cx*this->free_params.cw*wx_sum*ff_ax_table.index(ff_w_index, ff1).evaluate(q);
@@ -318,7 +318,7 @@ struct DebugCompositeDistanceHistogramFFExplicit : public CompositeDistanceHisto
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(constants::axes::q_vals[q]);
+            double cx = exv_factor(constants::axes::q_vals[q], free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
                     // atom-atom
@@ -423,7 +423,7 @@ struct DebugCompositeDistanceHistogramFFGrid : public CompositeDistanceHistogram
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 double ax_sum = std::inner_product(distance_profiles.aa.begin(ff1, form_factor::exv_bin), distance_profiles.aa.end(ff1, form_factor::exv_bin), sinqd_table->begin(q), 0.0);
                 Iq[q-q0] += 2*cx*ax_sum*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
@@ -441,7 +441,7 @@ struct DebugCompositeDistanceHistogramFFGrid : public CompositeDistanceHistogram
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             double ew_sum = std::inner_product(distance_profiles.aw.begin(form_factor::exv_bin), distance_profiles.aw.end(form_factor::exv_bin), sinqd_table->begin(q), 0.0);
             Iq[q-q0] += 2*cx*free_params.cw*ew_sum*ff_table.index(form_factor::exv_bin, form_factor::water_bin).evaluate(q);
         }
@@ -457,7 +457,7 @@ struct DebugCompositeDistanceHistogramFFGrid : public CompositeDistanceHistogram
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             double xx_sum = std::inner_product(distance_profiles.aa.begin(form_factor::exv_bin, form_factor::exv_bin), distance_profiles.aa.end(form_factor::exv_bin, form_factor::exv_bin), sinqd_table->begin(q), 0.0);
             Iq[q-q0] += cx*cx*xx_sum*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
         }
@@ -477,7 +477,7 @@ struct DebugCompositeDistanceHistogramFFGrid : public CompositeDistanceHistogram
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(q);
+            double cx = exv_factor(q, free_params);
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 // atom-atom
                 for (unsigned int ff2 = 0; ff2 < form_factor::get_count_without_excluded_volume(); ++ff2) {
@@ -583,7 +583,7 @@ struct DebugCompositeDistanceHistogramFFGridSurface : public CompositeDistanceHi
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            auto ax = evaluate_ax_distance_profile(exv_factor(constants::axes::q_vals[q]));
+            auto ax = evaluate_ax_distance_profile(exv_factor(constants::axes::q_vals[q], free_params));
             for (unsigned int ff1 = 0; ff1 < form_factor::get_count_without_excluded_volume(); ++ff1) {
                 double ax_sum = std::inner_product(ax.begin(ff1), ax.end(ff1), sinqd_table->begin(q), 0.0);
                 Iq[q-q0] += 2*ax_sum*ff_table.index(ff1, form_factor::exv_bin).evaluate(q);
@@ -602,7 +602,7 @@ struct DebugCompositeDistanceHistogramFFGridSurface : public CompositeDistanceHi
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            auto wx = evaluate_wx_distance_profile(exv_factor(constants::axes::q_vals[q]));
+            auto wx = evaluate_wx_distance_profile(exv_factor(constants::axes::q_vals[q], free_params));
             double ew_sum = std::inner_product(wx.begin(), wx.end(), sinqd_table->begin(q), 0.0);
             Iq[q-q0] += 2*free_params.cw*ew_sum*ff_table.index(form_factor::exv_bin, form_factor::water_bin).evaluate(q);
         }
@@ -619,7 +619,7 @@ struct DebugCompositeDistanceHistogramFFGridSurface : public CompositeDistanceHi
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            auto xx = evaluate_xx_distance_profile(exv_factor(constants::axes::q_vals[q]));
+            auto xx = evaluate_xx_distance_profile(exv_factor(constants::axes::q_vals[q], free_params));
             double xx_sum = std::inner_product(xx.begin(), xx.end(), sinqd_table->begin(q), 0.0);
             Iq[q-q0] += xx_sum*ff_table.index(form_factor::exv_bin, form_factor::exv_bin).evaluate(q);
         }
@@ -639,7 +639,7 @@ struct DebugCompositeDistanceHistogramFFGridSurface : public CompositeDistanceHi
 
         std::vector<double> Iq(debye_axis.bins, 0);
         for (unsigned int q = q0; q < q0+debye_axis.bins; ++q) {
-            double cx = exv_factor(constants::axes::q_vals[q]);
+            double cx = exv_factor(constants::axes::q_vals[q], free_params);
             auto xx = evaluate_xx_distance_profile(cx);
             auto wx = evaluate_wx_distance_profile(cx);
             auto ax = evaluate_ax_distance_profile(cx);
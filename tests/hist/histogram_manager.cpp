@@ -13,6 +13,7 @@
 #include <hist/histogram_manager/PartialHistogramManager.h>
 #include <hist/histogram_manager/PartialHistogramManagerMT.h>
 #include <hist/intensity_calculator/CompositeDistanceHistogramFFAvg.h>
+#include <hist/detail/RequiredBins.h>
 #include <form_factor/FormFactor.h>
 #include <io/ExistingFile.h>
 #include <settings/All.h>
@@ -310,6 +311,32 @@ TEST_CASE_METHOD(analytical_histogram, "HistogramManager::calculate_all") {
     }
 }
 
+TEST_CASE("required_bins") {
+    settings::general::verbose = false;
+    Molecule protein("tests/files/2epe.pdb");
+    protein.generate_new_hydration();
+    hist::detail::CompactCoordinates data_a(protein.get_bodies());
+    hist::detail::CompactCoordinates data_w(protein.get_waters());
+
+    // find the largest bin by brute force
+    unsigned int max_bin = 0;
+    for (const auto& a : data_a.get_data()) {
+        for (const auto& b : data_w.get_data()) {
+            max_bin = std::max<unsigned int>(max_bin, std::round(a.value.pos.distance(b.value.pos)*constants::axes::d_inv_width));
+        }
+        for (const auto& b : data_a.get_data()) {
+            max_bin = std::max<unsigned int>(max_bin, std::round(a.value.pos.distance(b.value.pos)*constants::axes::d_inv_width));
+        }
+    }
+
+    // the bounding sphere must contain all distances, but should not be much larger
+    unsigned int bins = hist::detail::required_bins(data_a, data_w);
+    CHECK(max_bin < bins);
+    CHECK(bins < 2*max_bin+3);
+    CHECK(bins < constants::axes::d_axis.bins);
+    CHECK(hist::detail::required_bins(hist::detail::CompactCoordinates()) == 1);
+}
+
 TEST_CASE("PartialHistogramManager::get_probe") {
     settings::general::verbose = false;
     Molecule protein("tests/files/2epe.pdb");
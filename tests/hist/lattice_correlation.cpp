@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <hist/detail/LatticeCorrelation.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <hist/detail/RequiredBins.h>
+#include <hist/distance_calculator/SimpleCalculator.h>
+#include <settings/All.h>
+
+using namespace ausaxs;
+using namespace ausaxs::hist;
+
+namespace {
+    // a cube of lattice points with some holes, split into an inner and an outer part
+    std::pair<hist::detail::CompactCoordinates, hist::detail::CompactCoordinates> generate_lattice(double spacing, int size, Vector3<double> origin) {
+        std::vector<Vector3<double>> inner, outer;
+        for (int x = 0; x < size; ++x) {
+            for (int y = 0; y < size; ++y) {
+                for (int z = 0; z < size; ++z) {
+                    if ((7*x + 3*y + z) % 5 == 0) {continue;}
+                    Vector3<double> v = origin + Vector3<double>(x, y, z)*spacing;
+                    bool is_outer = x < 3 || y < 3 || z < 3 || size-3 <= x || size-3 <= y || size-3 <= z;
+                    (is_outer ? outer : inner).push_back(v);
+                }
+            }
+        }
+        return {hist::detail::CompactCoordinates(std::move(inner), 1), hist::detail::CompactCoordinates(std::move(outer), 1)};
+    }
+
+    void compare(const WeightedDistribution1D& result, const WeightedDistribution1D& expected) {
+        REQUIRE(result.size() == expected.size());
+        for (unsigned int i = 0; i < result.size(); ++i) {
+            REQUIRE(result.index(i).count == expected.index(i).count);
+            REQUIRE_THAT(result.index(i).value, Catch::Matchers::WithinAbs(expected.index(i).value, 1e-6));
+            REQUIRE_THAT(result.index(i).bin_center, Catch::Matchers::WithinRel(expected.index(i).bin_center, 1e-5));
+        }
+    }
+}
+
+TEST_CASE("LatticeCorrelation::self") {
+    for (double spacing : {1., 1.5}) {
+        auto [inner, outer] = generate_lattice(spacing, 24, {0.3, -2.1, 5});
+        unsigned int bins = hist::detail::required_bins(inner, outer);
+        auto lattice = hist::detail::LatticeCorrelation::create({&inner, &outer}, spacing);
+        REQUIRE(lattice.has_value());
+
+        for (auto set : {0u, 1u}) {
+            const auto& data = set == 0 ? inner : outer;
+            distance_calculator::SimpleCalculator<true> calculator(bins);
+            calculator.enqueue_calculate_self(data);
+            auto expected = calculator.run().self[0];
+
+            // the pairwise calculation also includes the self-correlation terms
+            expected.index(0) -= hist::detail::WeightedEntry(data.size(), 1, 0);
+            compare(lattice->self(set, bins), expected);
+        }
+
+        // the cross-correlation now reuses the autocorrelations of the individual sets
+        distance_calculator::SimpleCalculator<true> calculator(bins);
+        calculator.enqueue_calculate_cross(inner, outer);
+        compare(lattice->cross(0, 1, bins, 2), calculator.run().cross[0]);
+    }
+}
+
+TEST_CASE("LatticeCorrelation::cross") {
+    auto [inner, outer] = generate_lattice(1, 24, {-10, 4, 0.5});
+    unsigned int bins = hist::detail::required_bins(inner, outer);
+    auto lattice = hist::detail::LatticeCorrelation::create({&inner, &outer}, 1);
+    REQUIRE(lattice.has_value());
+
+    distance_calculator::SimpleCalculator<true> calculator(bins);
+    calculator.enqueue_calculate_cross(inner, outer);
+    compare(lattice->cross(0, 1, bins, 2), calculator.run().cross[0]);
+}
+
+TEST_CASE("LatticeCorrelation::create") {
+    SECTION("coarser lattice") {
+        auto [inner, outer] = generate_lattice(2, 24, {0, 0, 0});
+        unsigned int bins = hist::detail::required_bins(inner);
+        auto lattice = hist::detail::LatticeCorrelation::create({&inner}, 1);
+        REQUIRE(lattice.has_value());
+
+        distance_calculator::SimpleCalculator<true> calculator(bins);
+        calculator.enqueue_calculate_self(inner);
+        auto expected = calculator.run().self[0];
+        expected.index(0) -= hist::detail::WeightedEntry(inner.size(), 1, 0);
+        compare(lattice->self(0, bins), expected);
+    }
+
+    SECTION("off-lattice points") {
+        auto [inner, outer] = generate_lattice(1, 24, {0, 0, 0});
+        inner[100].value.pos.x() += 0.5;
+        CHECK_FALSE(hist::detail::LatticeCorrelation::create({&inner}, 1).has_value());
+    }
+
+    SECTION("different weights") {
+        auto [inner, outer] = generate_lattice(1, 24, {0, 0, 0});
+        inner[100].value.w = 2;
+        CHECK_FALSE(hist::detail::LatticeCorrelation::create({&inner}, 1).has_value());
+    }
+
+    SECTION("small sets") {
+        auto [inner, outer] = generate_lattice(1, 5, {0, 0, 0});
+        CHECK_FALSE(hist::detail::LatticeCorrelation::create({&inner, &outer}, 1).has_value());
+    }
+}
@@ -5,6 +5,10 @@
 #include <hist/histogram_manager/HistogramManagerMT.h>
 #include <hist/histogram_manager/PartialHistogramManager.h>
 #include <hist/histogram_manager/PartialHistogramManagerMT.h>
+#include <hist/histogram_manager/HistogramManagerMTFFAvg.h>
+#include <hist/histogram_manager/HistogramManagerMTFFExplicit.h>
+#include <hist/histogram_manager/HistogramManagerMTFFGrid.h>
+#include <hist/intensity_calculator/ICompositeDistanceHistogram.h>
 #include <data/state/Signaller.h>
 #include <settings/All.h>
 
@@ -117,4 +121,67 @@ TEST_CASE("PartialHistogramManager: subsequent calculations") {
             REQUIRE(compare_hist(p_exp, phm_mt, 0, 1e-2));
         }
     }
-}
\ No newline at end of file
+}
+// Test that the form factor managers attached to a molecule only update what was changed, and still agree with their full equivalents
+TEST_CASE("PartialHistogramManagerMTFF: incremental updates") {
+    settings::general::verbose = false;
+    settings::molecule::implicit_hydrogens = false;
+    settings::hist::weighted_bins = true;
+    auto choice = GENERATE(
+        settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg,
+        settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit,
+        settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFGrid
+    );
+    settings::hist::histogram_manager = choice;
+
+    data::Molecule protein({
+        Body("tests/files/2epe.pdb"), 
+        Body{std::vector{AtomFF({0, 0, 0}, form_factor::form_factor_t::C), AtomFF({1, 1, 1}, form_factor::form_factor_t::O)}},
+        Body{std::vector{AtomFF({5, 0, 0}, form_factor::form_factor_t::N)}}
+    });
+    protein.clear_hydration();
+
+    auto check = [&] () {
+        std::unique_ptr<hist::ICompositeDistanceHistogram> h_exp;
+        switch (choice) {
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFAvg: 
+                h_exp = hist::HistogramManagerMTFFAvg<true>(&protein).calculate_all(); break;
+            case settings::hist::HistogramManagerChoice::PartialHistogramManagerMTFFExplicit: 
+                h_exp = hist::HistogramManagerMTFFExplicit<true>(&protein).calculate_all(); break;
+            default: 
+                h_exp = hist::HistogramManagerMTFFGrid(&protein).calculate_all(); break;
+        }
+        auto h = protein.get_histogram();
+        REQUIRE(compare_hist(h_exp->get_total_counts(), h->get_total_counts(), 1e-6, 1e-6));
+        REQUIRE(compare_hist(h_exp->debye_transform(), h->debye_transform(), 0, 1e-6));
+    };
+
+    // initial calculation
+    check();
+
+    // external change of a small body
+    protein.get_body(1).translate({1, 1, 1});
+    check();
+
+    // external change of the large body
+    protein.get_body(0).translate({-2, 1, 0});
+    check();
+
+    // internal change
+    protein.get_body(2).get_atom(0).weight() = 10;
+    protein.get_body(2).get_signaller()->internal_change();
+    check();
+
+    // hydration change
+    protein.generate_new_hydration();
+    check();
+
+    // external change followed by rehydration, as done during rigid body optimization
+    protein.get_body(2).translate({0, 3, 0});
+    protein.generate_new_hydration();
+    check();
+
+    // no change
+    check();
+    settings::hist::histogram_manager = settings::hist::HistogramManagerChoice::PartialHistogramManagerMT;
+}
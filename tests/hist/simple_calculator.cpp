@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <hist/distance_calculator/SimpleCalculator.h>
+#include <hist/distance_calculator/detail/SpatialTiling.h>
+#include <hist/distance_calculator/detail/LanePrivateHistogram.h>
+#include <hist/detail/CompactCoordinates.h>
+#include <settings/HistogramSettings.h>
+#include <utility/CPUFeatures.h>
+
+#include <random>
+
+using namespace ausaxs;
+using namespace ausaxs::hist;
+
+auto generate_coordinates = [] (unsigned int size, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> pos(-30, 30);
+    std::uniform_real_distribution<double> w(0.5, 2);
+    hist::detail::CompactCoordinates data(size);
+    for (unsigned int i = 0; i < size; ++i) {
+        data[i] = hist::detail::CompactCoordinatesData(Vector3<double>(pos(gen), pos(gen), pos(gen)), w(gen));
+    }
+    return data;
+};
+
+template<bool weighted_bins>
+auto run_calculator(const hist::detail::CompactCoordinates& a, const hist::detail::CompactCoordinates& b) {
+    distance_calculator::SimpleCalculator<weighted_bins> calculator;
+    calculator.enqueue_calculate_self(a);
+    calculator.enqueue_calculate_self(b, 2);
+    calculator.enqueue_calculate_cross(a, b);
+    return calculator.run();
+}
+
+auto compare_histograms = [] (const auto& r1, const auto& r2) {
+    auto compare = [] (const auto& p1, const auto& p2) {
+        REQUIRE(p1.size() == p2.size());
+        for (unsigned int i = 0; i < p1.size(); ++i) {
+            REQUIRE_THAT(p1.get_content(i), Catch::Matchers::WithinAbs(p2.get_content(i), 1e-3));
+        }
+    };
+    compare(r1.self[0], r2.self[0]);
+    compare(r1.self[1], r2.self[1]);
+    compare(r1.cross[0], r2.cross[0]);
+};
+
+template<bool weighted_bins>
+void compare_tiled() {
+    auto a = generate_coordinates(1503, 1);
+    auto b = generate_coordinates(417, 2);
+
+    settings::hist::detail::spatial_tiling = false;
+    auto untiled = run_calculator<weighted_bins>(a, b);
+
+    settings::hist::detail::spatial_tiling = true;
+    settings::hist::detail::tile_size = 64;
+    auto tiled = run_calculator<weighted_bins>(a, b);
+    settings::hist::detail::spatial_tiling = false;
+
+    compare_histograms(untiled, tiled);
+}
+
+template<bool weighted_bins>
+void compare_soa() {
+    auto a = generate_coordinates(1503, 1);
+    auto b = generate_coordinates(417, 2);
+
+    auto legacy = run_calculator<weighted_bins>(a, b);
+
+    settings::hist::detail::soa_kernels = true;
+    auto soa = run_calculator<weighted_bins>(a, b);
+
+    settings::hist::detail::spatial_tiling = true;
+    settings::hist::detail::tile_size = 64;
+    auto soa_tiled = run_calculator<weighted_bins>(a, b);
+    settings::hist::detail::spatial_tiling = false;
+    settings::hist::detail::soa_kernels = false;
+
+    compare_histograms(legacy, soa);
+    compare_histograms(legacy, soa_tiled);
+}
+
+TEST_CASE("SimpleCalculator: spatial tiling") {
+    SECTION("unweighted") {
+        compare_tiled<false>();
+    }
+
+    SECTION("weighted") {
+        compare_tiled<true>();
+    }
+}
+
+TEST_CASE("SimpleCalculator: soa kernels") {
+    SECTION("unweighted") {
+        compare_soa<false>();
+    }
+
+    SECTION("weighted") {
+        compare_soa<true>();
+    }
+}
+
+TEST_CASE("SoAKernels: dispatch") {
+    // the kernels for every supported instruction set must agree with the scalar fallback, including the padded remainder
+    auto data = generate_coordinates(37, 4);
+    hist::detail::CompactCoordinatesSoA soa(data);
+    std::array<float, 4> atom{soa.x()[0], soa.y()[0], soa.z()[0], soa.w()[0]};
+    int n = static_cast<int>(soa.size());
+    std::vector<float> d_ref(n+16), w_ref(n+16), d(n+16), w(n+16);
+    std::vector<int32_t> b_ref(n+16), b(n+16);
+
+    using utility::cpu::InstructionSet;
+    auto scalar = distance_calculator::detail::soa::get_kernels(InstructionSet::Scalar);
+    scalar.evaluate(atom.data(), soa.x(), soa.y(), soa.z(), soa.w(), n, d_ref.data(), w_ref.data());
+    scalar.evaluate_rounded(atom.data(), soa.x(), soa.y(), soa.z(), soa.w(), n, 4, b_ref.data(), w_ref.data());
+    for (auto set : {InstructionSet::SSE41, InstructionSet::AVX, InstructionSet::AVX2, InstructionSet::AVX512}) {
+        if (!utility::cpu::supports(set)) {continue;}
+        auto kernels = distance_calculator::detail::soa::get_kernels(set);
+        kernels.evaluate(atom.data(), soa.x(), soa.y(), soa.z(), soa.w(), n, d.data(), w.data());
+        kernels.evaluate_rounded(atom.data(), soa.x(), soa.y(), soa.z(), soa.w(), n, 4, b.data(), w.data());
+        for (int i = 0; i < n; ++i) {
+            CHECK(d[i] == d_ref[i]);
+            CHECK(b[i] == b_ref[i]);
+            CHECK(w[i] == w_ref[i]);
+        }
+    }
+}
+
+TEST_CASE("SimpleCalculator: spatial_sort") {
+    auto data = generate_coordinates(1000, 3);
+    auto sorted = distance_calculator::detail::spatial_sort(data);
+    REQUIRE(sorted.size() == data.size());
+
+    // the sorted data must be a permutation of the original data
+    auto key = [] (const hist::detail::CompactCoordinatesData& d) {return d.data;};
+    std::vector<std::array<float, 4>> original, permuted;
+    std::transform(data.get_data().begin(), data.get_data().end(), std::back_inserter(original), key);
+    std::transform(sorted.get_data().begin(), sorted.get_data().end(), std::back_inserter(permuted), key);
+    std::sort(original.begin(), original.end());
+    std::sort(permuted.begin(), permuted.end());
+    CHECK(original == permuted);
+}
+
+TEST_CASE("LanePrivateHistogram: merge") {
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int32_t> bin(0, 500);
+    std::uniform_real_distribution<float> weight(0.5, 2);
+
+    // mix short sequences with long ones, such that both the scalar and vectorized paths are used
+    hist::Distribution1D expected(constants::axes::d_axis.bins), result(constants::axes::d_axis.bins);
+    distance_calculator::detail::LanePrivateHistogram<false> bins(expected.size());
+    for (int rep = 0; rep < 100; ++rep) {
+        int n = rep % 3 == 0 ? 7 : 256 + rep;
+        std::vector<int32_t> distances(n);
+        std::vector<float> weights(n);
+        for (int k = 0; k < n; ++k) {
+            distances[k] = bin(gen);
+            weights[k] = weight(gen);
+            expected.add_index<2>(distances[k], weights[k]);
+        }
+        bins.add<2>(distances.data(), weights.data(), n);
+    }
+    bins.merge_into(result);
+
+    for (unsigned int i = 0; i < expected.size(); ++i) {
+        REQUIRE_THAT(result.get_content(i), Catch::Matchers::WithinAbs(expected.get_content(i), 1e-6));
+    }
+
+    // distances outside the histogram must not be dropped silently
+    hist::Distribution1D small(400);
+    CHECK_THROWS(bins.merge_into(small));
+
+    // neither must distances beyond the size the lane-private histogram was created with
+    distance_calculator::detail::LanePrivateHistogram<false> overflow(400);
+    std::vector<int32_t> far(64, 450);
+    std::vector<float> ones(64, 1);
+    overflow.add<1>(far.data(), ones.data(), 64);
+    CHECK_THROWS(overflow.merge_into(small));
+}
@@ -6,6 +6,7 @@
 #include <math/Vector.h>
 #include <math/Vector3.h>
 #include <math/CubicSpline.h>
+#include <math/CubicSplineResampler.h>
 #include <math/LUPDecomposition.h>
 #include <math/QRDecomposition.h>
 #include <math/Statistics.h>
@@ -71,4 +72,28 @@ TEST_CASE("math: orthonormal_rotations") {
         Matrix Ri = R.T();
         REQUIRE(R*Ri == matrix::identity(3));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("math: CubicSplineResampler") {
+    // an uneven grid to make sure the spacing ratios are handled correctly
+    std::vector<double> x(50);
+    for (unsigned int i = 0; i < x.size(); ++i) {x[i] = 0.01*i + 0.0005*i*i;}
+
+    std::vector<double> z;
+    for (double q = -0.05; q < x.back() + 0.05; q += 0.0137) {z.push_back(q);}
+    z.push_back(x.front());
+    z.push_back(x.back());
+
+    math::CubicSplineResampler resampler(x, z);
+    REQUIRE(resampler.size_grid() == x.size());
+    REQUIRE(resampler.size() == z.size());
+    for (int trial = 0; trial < 3; ++trial) {
+        std::vector<double> y(x.size());
+        for (unsigned int i = 0; i < y.size(); ++i) {y[i] = std::exp(-x[i]*(trial+1))*std::sin(5*x[i]) + GenRandScalar()/1000;}
+
+        math::CubicSpline spline(x, y);
+        auto resampled = resampler.resample(y);
+        for (unsigned int i = 0; i < z.size(); ++i) {
+            REQUIRE_THAT(resampled[i], Catch::Matchers::WithinAbs(spline.spline(z[i]), 1e-9));
+        }
+    }
+}
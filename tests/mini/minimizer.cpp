@@ -5,6 +5,7 @@
 
 #include <mini/All.h>
 #include <plots/All.h>
+#include <utility/MultiThreading.h>
 
 using std::vector;
 using namespace ausaxs;
@@ -106,6 +107,66 @@ TEST_CASE("scan_minimizer") {
     SECTION("problem18 rough") {ScanTest1DRough(problem18);}
 }
 
+TEST_CASE("scan_minimizer: parallel evaluation") {
+    auto compare = [] (const mini::Landscape& l1, const mini::Landscape& l2) {
+        REQUIRE(l1.evals.size() == l2.evals.size());
+        for (unsigned int i = 0; i < l1.evals.size(); ++i) {
+            CHECK(l1.evals[i].vals == l2.evals[i].vals);
+            CHECK(l1.evals[i].fval == l2.evals[i].fval);
+        }
+    };
+
+    SECTION("scan") {
+        auto run = [] (bool parallel) {
+            mini::Scan mini(problem04.function, {"a", problem04.bounds[0]}, 200);
+            mini.set_parallel_evaluation(parallel);
+            auto res = mini.minimize();
+            CHECK_THAT(res.get_parameter("a").value, Catch::Matchers::WithinAbs(problem04.min[0], mini.tol));
+            return mini.landscape(200);
+        };
+        compare(run(false), run(true));
+    }
+
+    SECTION("limited scan") {
+        auto run = [] (bool parallel) {
+            mini::LimitedScan mini(problem18.function, {"a", problem18.bounds[0]}, 200);
+            mini.set_limit(2, true);
+            mini.set_parallel_evaluation(parallel);
+            return mini.landscape(200);
+        };
+        auto l1 = run(false);
+        REQUIRE(l1.evals.size() < 200); // make sure the scan actually terminated early
+        compare(l1, run(true));
+    }
+
+    SECTION("limited scan with dedicated threads") {
+        // the function waits on the global pool itself, which is only allowed when using dedicated threads
+        auto function = [] (std::vector<double> x) {
+            double fval;
+            auto pool = utility::multi_threading::get_global_pool();
+            pool->detach_task([&fval, &x] () {fval = problem18.function(x);});
+            pool->wait();
+            return fval;
+        };
+        auto run = [&function] (unsigned int threads) {
+            mini::LimitedScan mini(function, {"a", problem18.bounds[0]}, 200);
+            mini.set_limit(2, true);
+            mini.set_evaluation_threads(threads);
+            return mini.landscape(200);
+        };
+        compare(run(1), run(4));
+    }
+
+    SECTION("landscape") {
+        auto run = [] (bool parallel) {
+            mini::Golden mini(problem13.function, {"a", problem13.bounds[0]});
+            mini.set_parallel_evaluation(parallel);
+            return mini.landscape(100);
+        };
+        compare(run(false), run(true));
+    }
+}
+
 // TEST_CASE("minimum_explorer", "[manual]") {
 //     auto ExplorerTest1D = [] (const TestFunction& test) {
 //         mini::dlibMinimizer<mini::algorithm::BFGS> mini1(test.function, {{"a", test.bounds[0]}});
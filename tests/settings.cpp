@@ -3,6 +3,7 @@
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 #include <settings/All.h>
+#include <hist/detail/SimpleExvModel.h>
 
 using namespace ausaxs;
 
@@ -14,4 +15,48 @@ TEST_CASE("settings") {
     SECTION("read_settings") {
         settings::read("temp/settings/settings.txt");
     }
+}
+TEST_CASE("settings: context") {
+    double qmax = settings::axes::qmax;
+    auto context = settings::Context::current();
+    context.set("qmax", {"0.123456789"});
+    context.set("weighted_bins", !settings::hist::weighted_bins);
+    context.set("use_intensity_basis", !settings::fit::use_intensity_basis);
+    CHECK(settings::axes::qmax == qmax);
+    CHECK_THAT(std::stod(context.get("qmax")), Catch::Matchers::WithinRel(0.123456789, 1e-5));
+    CHECK_THROWS(context.set("qmax", 1));
+    CHECK_THROWS(context.set("not_a_setting", {"1"}));
+
+    bool weighted_bins = settings::hist::weighted_bins, use_intensity_basis = settings::fit::use_intensity_basis;
+    {
+        settings::ScopedContext scope(context);
+        CHECK(settings::axes::qmax == 0.123456789);
+        CHECK(settings::hist::weighted_bins == !weighted_bins);
+        CHECK(settings::fit::use_intensity_basis == !use_intensity_basis);
+
+        // nested contexts on the same thread are allowed
+        auto inner = settings::Context::current();
+        inner.set("qmax", 0.2);
+        {
+            settings::ScopedContext inner_scope(inner);
+            CHECK(settings::axes::qmax == 0.2);
+        }
+        CHECK(settings::axes::qmax == 0.123456789);
+    }
+    CHECK(settings::hist::weighted_bins == weighted_bins);
+    CHECK(settings::fit::use_intensity_basis == use_intensity_basis);
+    CHECK(settings::axes::qmax == qmax);
+}
+
+TEST_CASE("settings: context with simple exv model") {
+    hist::detail::SimpleExvModel::enable();
+    auto context = settings::Context::current();
+    context.set_simple_exv_model(false);
+    CHECK(hist::detail::SimpleExvModel::is_enabled());
+    {
+        settings::ScopedContext scope(context);
+        CHECK(!hist::detail::SimpleExvModel::is_enabled());
+    }
+    CHECK(hist::detail::SimpleExvModel::is_enabled());
+    hist::detail::SimpleExvModel::disable();
 }
\ No newline at end of file
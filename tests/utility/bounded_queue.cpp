@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <utility/BoundedQueue.h>
+
+#include <thread>
+#include <vector>
+
+using namespace ausaxs;
+
+TEST_CASE("BoundedQueue::BoundedQueue") {
+    CHECK_THROWS(utility::BoundedQueue<int>(0));
+    CHECK_NOTHROW(utility::BoundedQueue<int>(1));
+}
+
+TEST_CASE("BoundedQueue: single thread") {
+    utility::BoundedQueue<int> queue(3);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    queue.close();
+
+    // the remaining items can still be consumed after closing
+    CHECK(queue.pop() == 1);
+    CHECK(queue.pop() == 2);
+    CHECK(queue.pop() == 3);
+    CHECK(queue.pop() == std::nullopt);
+    CHECK(queue.pop() == std::nullopt);
+    CHECK_THROWS(queue.push(4));
+}
+
+TEST_CASE("BoundedQueue: empty") {
+    utility::BoundedQueue<int> queue(2);
+    std::thread producer([&queue] () {queue.close();});
+    CHECK(queue.pop() == std::nullopt);
+    producer.join();
+}
+
+TEST_CASE("BoundedQueue: producer and consumer") {
+    // the capacity is much smaller than the number of items, so the producer must wait for the consumer
+    utility::BoundedQueue<int> queue(2);
+    std::thread producer([&queue] () {
+        for (int i = 0; i < 1000; ++i) {queue.push(int(i));}
+        queue.close();
+    });
+
+    std::vector<int> items;
+    while (auto item = queue.pop()) {items.push_back(*item);}
+    producer.join();
+
+    REQUIRE(items.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {CHECK(items[i] == i);}
+}
+
+TEST_CASE("BoundedQueue: close releases a waiting producer") {
+    utility::BoundedQueue<int> queue(1);
+    queue.push(1);
+    bool threw = false;
+    std::thread producer([&queue, &threw] () {
+        try {
+            queue.push(2);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+    });
+    queue.close();
+    producer.join();
+    CHECK(threw);
+    CHECK(queue.pop() == 1);
+    CHECK(queue.pop() == std::nullopt);
+}
\ No newline at end of file